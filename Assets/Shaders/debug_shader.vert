@@ -2,8 +2,11 @@
 layout (location = 0) in vec2 aPos;   // the position variable has attribute position 0
 
 uniform mat3 model;
-uniform mat3 view;
-uniform mat3 projection;
+layout (std140) uniform Camera
+{
+    mat3 view;
+    mat3 projection;
+};
 
 void main()
 {
@@ -4,8 +4,12 @@ layout (location = 1) in vec3 aColor; // the color variable has attribute positi
 layout (location = 2) in vec2 aTexCoord;
 
 uniform mat3 model;     // Model transformation matrix
-uniform mat3 view;      // View transformation matrix for camera translation
-uniform mat3 projection; // Projection matrix for zoom (and perspective/orthographic projection)
+// Camera, shared by every shader (see CAMERA_UNIFORM_BINDING)
+layout (std140) uniform Camera
+{
+    mat3 view;       // View transformation matrix for camera translation
+    mat3 projection; // Projection matrix for zoom (and perspective/orthographic projection)
+};
 
 out vec3 oColor; // output a color to the fragment shader
 out vec2 oTexCoord;
@@ -8,6 +8,7 @@ uniform float uAlpha;
 
 void main()
 {    
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
+    // The glyph atlas is swizzled to sample as (1, 1, 1, coverage)
+    vec4 sampled = texture(text, TexCoords);
     FragColor = vec4(textColor, uAlpha) * sampled;
 }
\ No newline at end of file
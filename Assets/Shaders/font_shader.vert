@@ -2,8 +2,11 @@
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
 out vec2 TexCoords;
 
-uniform mat3 view;
-uniform mat3 projection;
+layout (std140) uniform Camera
+{
+    mat3 view;
+    mat3 projection;
+};
 
 
 void main()
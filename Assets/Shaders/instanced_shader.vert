@@ -11,8 +11,11 @@ out vec3 ourColor;
 out vec2 TexCoord;
 out float alpha;
 
-uniform mat3 view;
-uniform mat3 projection;
+layout (std140) uniform Camera
+{
+    mat3 view;
+    mat3 projection;
+};
 
 void main()
 {
@@ -0,0 +1,62 @@
+#version 460 core
+in vec3 ourColor;
+in vec2 TexCoord;
+in float alpha;
+flat in vec4 uvRect;
+flat in vec4 borderSize;
+flat in vec2 spriteSize;
+flat in vec2 textureSize;
+flat in vec2 flags;
+
+out vec4 FragColor;
+
+uniform sampler2D ourTexture;
+
+// Same mapping as default_shader.frag, see there for details
+float sliceCoord(float uvCoord, float finalSize, float borderA, float borderB, float texSize)
+{
+    float pixelPos = uvCoord * finalSize;
+
+    if (pixelPos < borderA)
+    {
+        return (pixelPos / borderA) * (borderA / texSize);
+    }
+
+    float rightStart = finalSize - borderB;
+    if (pixelPos > rightStart)
+    {
+        float distIntoCorner = pixelPos - rightStart;
+        float cornerUvStart = (texSize - borderB) / texSize;
+        return cornerUvStart + (distIntoCorner / borderB) * (borderB / texSize);
+    }
+
+    float centerWidth = finalSize - borderA - borderB;
+    float distIntoMid = pixelPos - borderA;
+    float uvCenterStart = borderA / texSize;
+    float uvCenterSize = 1.0 - (borderB / texSize) - uvCenterStart;
+
+    return uvCenterStart + (distIntoMid / centerWidth) * uvCenterSize;
+}
+
+void main()
+{
+    vec2 uv = TexCoord;
+
+    if (flags.y > 0.5)
+    {
+        uv = vec2(sliceCoord(uv.x, spriteSize.x, borderSize.x, borderSize.y, textureSize.x),
+                  sliceCoord(uv.y, spriteSize.y, borderSize.z, borderSize.w, textureSize.y));
+    }
+
+    // Into the sprite's rectangle of its texture (atlas region, animation frame)
+    uv = mix(uvRect.xy, uvRect.zw, uv);
+
+    if (flags.x > 0.5)
+    {
+        FragColor = texture(ourTexture, uv) * vec4(ourColor, alpha);
+    }
+    else
+    {
+        FragColor = vec4(ourColor, alpha);
+    }
+}
@@ -0,0 +1,42 @@
+#version 460 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in mat3 aInstanceMatrix;
+layout (location = 6) in vec3 aInstanceColor;
+layout (location = 7) in float aInstanceAlpha;
+layout (location = 8) in vec4 aInstanceUVRect;    // UV rectangle (animation / hover frame, in atlas space)
+layout (location = 9) in vec4 aInstanceBorderSize; // 9-slice borders in pixels
+layout (location = 10) in vec2 aInstanceSpriteSize;
+layout (location = 11) in vec2 aInstanceTextureSize;
+layout (location = 12) in vec2 aInstanceFlags;    // x: sample the texture, y: 9-slice
+
+out vec3 ourColor;
+out vec2 TexCoord;
+out float alpha;
+flat out vec4 uvRect;
+flat out vec4 borderSize;
+flat out vec2 spriteSize;
+flat out vec2 textureSize;
+flat out vec2 flags;
+
+layout (std140) uniform Camera
+{
+    mat3 view;
+    mat3 projection;
+};
+
+void main()
+{
+    vec3 pos = projection * view * aInstanceMatrix * vec3(aPos, 1.0);
+    gl_Position = vec4(pos.xy, 0.0, 1.0);
+    ourColor = aColor * aInstanceColor;
+    alpha = aInstanceAlpha;
+    TexCoord = aTexCoord;
+    uvRect = aInstanceUVRect;
+
+    borderSize = aInstanceBorderSize;
+    spriteSize = aInstanceSpriteSize;
+    textureSize = aInstanceTextureSize;
+    flags = aInstanceFlags;
+}
@@ -10,6 +10,7 @@
 \brief
     This is the source file for the main application executable entry point.
     Loads the main DLL and runs the application.
+    With --build-assets, runs the headless asset build instead (CI / packaging).
 
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
@@ -91,8 +92,14 @@ int WINAPI _tWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdL
 
     if (!dll) return -1; // error out
 
-    // Get the function pointer
-    AppFunc app = reinterpret_cast<AppFunc>(GetProcAddress(dll, "App"));
+    // Get the function pointer, the asset build does not open a window
+    const bool buildAssets = _tcsstr(GetCommandLine(), TEXT("--build-assets")) != nullptr;
+    AppFunc app = reinterpret_cast<AppFunc>(GetProcAddress(dll, buildAssets ? "BuildAssets" : "App"));
+    if (!app)
+    {
+        FreeLibrary(dll);
+        return -1; // error out
+    }
 
     int result = app(); // run the app
 
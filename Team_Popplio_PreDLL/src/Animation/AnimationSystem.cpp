@@ -23,7 +23,7 @@ Technology is prohibited.
 
 namespace Popplio
 {
-    AnimationSystem::AnimationSystem()
+    AnimationSystem::AnimationSystem(Registry& r) : reg(r)
     {
         RequireComponent<AnimationComponent>();
     }
@@ -35,162 +35,144 @@ namespace Popplio
 
     void AnimationSystem::StopAll()
     {
-        for (auto& entity : GetSystemEntities())
+        reg.View<ActiveComponent, AnimationComponent>(*this).Each(
+            [](ActiveComponent& active, AnimationComponent& animation)
         {
-            if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-            if (!entity.HasComponent<AnimationComponent>()) continue;
-            if (!entity.GetComponent<AnimationComponent>().isActive) continue;
-
-            auto& animation = entity.GetComponent<AnimationComponent>();
+            if (!active.isActive || !animation.isActive) return;
 
             // If there is no current animation skip this entity
-            if (animation.currentAnimation.empty()) continue;
+            if (animation.currentAnimation.empty()) return;
 
             animation.Stop(); // why is there no stop?
-        }
+        });
     }
 
     void AnimationSystem::PauseAll()
     {
-        for (auto& entity : GetSystemEntities())
+        reg.View<ActiveComponent, AnimationComponent>(*this).Each(
+            [](ActiveComponent& active, AnimationComponent& animation)
         {
-            if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-            if (!entity.HasComponent<AnimationComponent>()) continue;
-            if (!entity.GetComponent<AnimationComponent>().isActive) continue;
-
-            auto& animation = entity.GetComponent<AnimationComponent>();
+            if (!active.isActive || !animation.isActive) return;
 
             // If there is no current animation skip this entity
-            if (animation.currentAnimation.empty()) continue;
+            if (animation.currentAnimation.empty()) return;
 
             if (animation.isPlaying) animation.Pause(); // why is there no stop?
-        }
+        });
     }
 
     void AnimationSystem::StartAll()
     {
-        for (auto& entity : GetSystemEntities())
+        reg.View<ActiveComponent, AnimationComponent>(*this).Each(
+            [](ActiveComponent& active, AnimationComponent& animation)
         {
-            if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-            if (!entity.HasComponent<AnimationComponent>()) continue;
-            if (!entity.GetComponent<AnimationComponent>().isActive) continue;
-
-            auto& animation = entity.GetComponent<AnimationComponent>();
+            if (!active.isActive || !animation.isActive) return;
 
             // If there is no current animation skip this entity
-            if (animation.currentAnimation.empty()) continue;
+            if (animation.currentAnimation.empty()) return;
 
             // Initialize dimensions
             animation.CalculateDimensions();
 
             animation.Play(); // why is there no start?
-        }
+        });
     }
 
     void AnimationSystem::ResumeAll()
     {
-        for (auto& entity : GetSystemEntities())
+        reg.View<ActiveComponent, AnimationComponent>(*this).Each(
+            [](ActiveComponent& active, AnimationComponent& animation)
         {
-            if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-            if (!entity.HasComponent<AnimationComponent>()) continue;
-            if (!entity.GetComponent<AnimationComponent>().isActive) continue;
-
-            auto& animation = entity.GetComponent<AnimationComponent>();
+            if (!active.isActive || !animation.isActive) return;
 
             // If there is no current animation skip this entity
-            if (animation.currentAnimation.empty()) continue;
+            if (animation.currentAnimation.empty()) return;
 
             // Initialize dimensions
             animation.CalculateDimensions();
 
             animation.Resume(); // why is there no start?
-        }
+        });
     }
 
     void AnimationSystem::Update(float deltaTime)
     {
+        auto view = reg.View<ActiveComponent, AnimationComponent>(*this);
+
         // Iterate through all entities managed by this system
         for (int step = 0; step < Engine::timer.GetCurrentNumberOfSteps(); ++step)
         {
-            for (auto& entity : GetSystemEntities())
+            view.Each([deltaTime](ActiveComponent& active, AnimationComponent& animation)
             {
-                if (entity.GetComponent<ActiveComponent>().isActive == false) continue;
+                if (!active.isActive || !animation.isActive) return;
 
-                // Check if the entity has an AnimationComponent
-                if (entity.HasComponent<AnimationComponent>())
-                {
-                    if (!entity.GetComponent<AnimationComponent>().isActive) continue;
+                // If there is no current animation or the animation is paused, skip this entity
+                if (animation.currentAnimation.empty() || animation.isPaused)
+                    return;
 
-                    auto& animation = entity.GetComponent<AnimationComponent>();
+                // Get the current animation data using the animation name
+                const auto& currentAnim = animation.animations[animation.currentAnimation];
 
-                    // If there is no current animation or the animation is paused, skip this entity
-                    if (animation.currentAnimation.empty() || animation.isPaused)
-                        continue;
+                // Accumulate the delta time (time elapsed since the last frame)
+                animation.timeAccumulator += deltaTime;
+                animation.elapsedTimeSinceLastResume += deltaTime;
+                animation.elapsedTimeCurrentCycle += deltaTime;
 
-                    // Get the current animation data using the animation name
-                    const auto& currentAnim = animation.animations[animation.currentAnimation];
+                // If enough time has passed to advance the animation frame
+                if (animation.timeAccumulator >= currentAnim.animationSpeed)
+                {
+                    // Calculate how many frames to advance
+                    int framesToAdvance = static_cast<int>(animation.timeAccumulator / currentAnim.animationSpeed);
 
-                    // Accumulate the delta time (time elapsed since the last frame)
-                    animation.timeAccumulator += deltaTime;
-                    animation.elapsedTimeSinceLastResume += deltaTime;
-                    animation.elapsedTimeCurrentCycle += deltaTime;
+                    // Reduce the accumulator by the amount of time for the advanced frames
+                    animation.timeAccumulator = fmod(animation.timeAccumulator, currentAnim.animationSpeed);
 
-                    // If enough time has passed to advance the animation frame
-                    if (animation.timeAccumulator >= currentAnim.animationSpeed)
+                    // Update the current frame index based on the frames to advance
+                    for (int i = 0; i < framesToAdvance; ++i)
                     {
-                        // Calculate how many frames to advance
-                        int framesToAdvance = static_cast<int>(animation.timeAccumulator / currentAnim.animationSpeed);
+                        //Logger::Critical(std::to_string(animation.currentFrameX));
+                        //Logger::Critical(std::to_string(animation.currentFrameY));
 
-                        // Reduce the accumulator by the amount of time for the advanced frames
-                        animation.timeAccumulator = fmod(animation.timeAccumulator, currentAnim.animationSpeed);
+                        ++animation.currentFrameX;
 
-                        // Update the current frame index based on the frames to advance
-                        for (int i = 0; i < framesToAdvance; ++i)
+                        // If the end of the animation is reached, loop back to the start
+                        if (animation.currentFrameX > currentAnim.endX)
                         {
-                            //Logger::Critical(std::to_string(animation.currentFrameX));
-                            //Logger::Critical(std::to_string(animation.currentFrameY));
+                            // do not restart prematurely if end row is not reached and
+                            // the current frame X is less than the dimension X
+                            if (currentAnim.dimensionX > animation.currentFrameX &&
+                                animation.currentFrameY > currentAnim.endY)
+                            {
+                                continue;
+                            }
 
-                            ++animation.currentFrameX;
+                            if (animation.currentFrameY > currentAnim.endY)
+                                animation.currentFrameX = 0;
+                            else
+                                animation.currentFrameX = currentAnim.startX;
 
-                            // If the end of the animation is reached, loop back to the start
-                            if (animation.currentFrameX > currentAnim.endX)
+                            if (animation.currentFrameY <= currentAnim.endY || 
+                                animation.currentFrameY <= 0)
                             {
-                                // do not restart prematurely if end row is not reached and
-                                // the current frame X is less than the dimension X
-                                if (currentAnim.dimensionX > animation.currentFrameX &&
-                                    animation.currentFrameY > currentAnim.endY)
-                                {
-                                    continue;
-                                }
+                                animation.currentFrameY = currentAnim.startY;
+                                
+                                animation.elapsedTimeCurrentCycle = 0.f;
 
-                                if (animation.currentFrameY > currentAnim.endY)
-                                    animation.currentFrameX = 0;
-                                else
-                                    animation.currentFrameX = currentAnim.startX;
-
-                                if (animation.currentFrameY <= currentAnim.endY || 
-                                    animation.currentFrameY <= 0)
-                                {
-                                    animation.currentFrameY = currentAnim.startY;
-                                    
-                                    animation.elapsedTimeCurrentCycle = 0.f;
-
-                                    // If the animation is set to play only once, stop it after one cycle
-                                    if (animation.playOnce)
-                                    {
-                                        animation.Stop();
-                                        break;
-                                    }
-                                }
-                                else
+                                // If the animation is set to play only once, stop it after one cycle
+                                if (animation.playOnce)
                                 {
-                                    --animation.currentFrameY;
+                                    animation.Stop();
+                                    break;
                                 }
                             }
+                            else
+                            {
+                                --animation.currentFrameY;
+                            }
                         }
                     }
                 }
-            }
+            });
         }
     }
 }
\ No newline at end of file
@@ -33,8 +33,11 @@ namespace Popplio
 		\brief
 		Constructor for the AnimationSystem class.
 
+		\param[in] r
+		[Registry&] Registry owning the animation components.
+
 		*******************************************************************************/
-		AnimationSystem();
+		AnimationSystem(Registry& r);
 
 		/*!*****************************************************************************
 		\brief
@@ -80,6 +83,8 @@ namespace Popplio
 
 	private:
 
+		Registry& reg;
+
 		//bool isMoving = false;
 		//bool isAttacking = false;
 		//bool idle = true;
@@ -19,6 +19,7 @@ Technology is prohibited.
 #include <pch.h>
 
 #include "App.h"
+#include "AssetStore/AssetLoader.h"
 
 extern "C" DLL_EXPORT int App()
 {
@@ -34,4 +35,12 @@ extern "C" DLL_EXPORT int App()
     engine.Destroy();
 
 	return 0;
+}
+
+extern "C" DLL_EXPORT int BuildAssets()
+{
+    Popplio::Logger::Initialize(Popplio::LogLevel::INFO_LOG);
+    const bool built = Popplio::AssetLoader::BuildTextureAtlasManifest();
+    Popplio::Logger::Shutdown();
+    return built ? 0 : 1;
 }
\ No newline at end of file
@@ -26,3 +26,10 @@ Technology is prohibited.
 *   @returns int | The exit code of the core engine DLL.
 */
 extern "C" DLL_EXPORT int App(); 
+
+/*
+*   Headless asset build, run by the executable with --build-assets.
+*   Writes the texture atlas manifest without opening a window, for CI / packaging.
+*   @returns int | 0 if the manifest is up to date or was written.
+*/
+extern "C" DLL_EXPORT int BuildAssets();
@@ -22,6 +22,13 @@ Technology is prohibited.
 #include <pch.h>
 #include "AssetBatchLoader.h"
 #include "../Logging/Logger.h"
+#include "../PerformanceViewer/Profiler.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
 
 namespace Popplio {
 
@@ -29,11 +36,26 @@ namespace Popplio {
         : type(type), filepath(path), assetName(Serializer::GenerateAssetName(path.filename().string())) {
     }
 
-    AssetBatchLoader::AssetBatchLoader(AudioSystem& audioSystem, LogicSystem& logicSystem, size_t batchSize)
-        : audioSystem(audioSystem), logicSystem(logicSystem), batchSize(batchSize), isLoading(false), totalAssets(0), loadedAssets(0) {
+    AssetBatchLoader::AssetBatchLoader(AudioSystem& audioSystem, LogicSystem& logicSystem, size_t workerCount, double uploadBudgetMs)
+        : audioSystem(audioSystem), logicSystem(logicSystem), workerCount(workerCount), uploadBudgetMs(uploadBudgetMs),
+        storeResults(true), isLoading(false), totalAssets(0), loadedAssets(0), nextTask(0), loadMs(0.0), uploadMs(0.0) {
+        if (this->workerCount == 0) {
+            // Leave a hardware thread for the main thread uploading and rendering the loading screen
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            this->workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+    }
+
+    AssetBatchLoader::~AssetBatchLoader() {
+        StopWorkers();
     }
 
     void AssetBatchLoader::ScanAssets(const fs::path& directory) {
+        if (isLoading) {
+            Logger::Warning("Unable to scan assets while loading");
+            return;
+        }
+
         Logger::Info("Scanning assets in: " + directory.string());
 
         std::vector<fs::path> assetFiles;
@@ -45,8 +67,9 @@ namespace Popplio {
         // Get all asset files and meta files
         std::tie(assetFiles, metaFiles) = ListFilesRecursively(directory);
 
-        // Clear the queue and reset counters
-        while (!loadQueue.empty()) loadQueue.pop();
+        // Clear the tasks and reset counters
+        tasks.clear();
+        tasks.reserve(assetFiles.size());
         totalAssets = 0;
         loadedAssets = 0;
 
@@ -55,7 +78,7 @@ namespace Popplio {
             fs::path metaPath = file;
             metaPath.replace_extension(AssetLoader::_metaExtension);
 
-            // Create meta file if it doesn't exist
+            // Create meta file if it doesn't exist, before the workers read it
             if (metaFiles.find(metaPath) == metaFiles.end()) {
                 Serializer::SerializeMetaFile(file);
             }
@@ -64,7 +87,7 @@ namespace Popplio {
             QueueAssetLoad(file);
         }
 
-        totalAssets = loadQueue.size();
+        totalAssets = tasks.size();
         Logger::Info("Found " + std::to_string(totalAssets) + " assets to load");
     }
 
@@ -74,6 +97,18 @@ namespace Popplio {
         this->progressCallback = callback;
         isLoading = true;
         loadedAssets = 0;
+        loadMs = 0.0;
+        uploadMs = 0.0;
+        loadStart = std::chrono::steady_clock::now();
+
+        // Start the workers, no more than there are tasks
+        nextTask.store(0);
+        completedTasks.clear();
+        uploadQueue.clear();
+        size_t threadCount = std::min(workerCount, tasks.size());
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back(&AssetBatchLoader::RunWorker, this, i);
+        }
 
         // Report initial progress
         if (progressCallback) {
@@ -84,41 +119,72 @@ namespace Popplio {
     }
 
     bool AssetBatchLoader::ProcessBatch() {
-        if (!isLoading || loadQueue.empty()) {
-            if (isLoading) {
-                isLoading = false;
-                Logger::Info("Asset loading complete");
-
-                // Report final progress
-                if (progressCallback) {
-                    progressCallback(1.0f);
+        if (!isLoading) return false;
+
+        {
+            POPPLIO_PROFILE_ZONE("Asset Upload");
+
+            const auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(uploadBudgetMs));
+
+            while (loadedAssets < totalAssets) {
+                if (uploadQueue.empty()) {
+                    // Nothing decoded yet, sleep until a worker finishes a task instead of spinning
+                    std::unique_lock<std::mutex> lock(completedMutex);
+                    completedCondition.wait_until(lock, deadline, [this] { return !completedTasks.empty(); });
+                    uploadQueue.insert(uploadQueue.end(), completedTasks.begin(), completedTasks.end());
+                    completedTasks.clear();
+
+                    if (uploadQueue.empty()) break; // budget spent waiting
+                }
+                else if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
                 }
-            }
-            return false;
-        }
 
-        size_t currentBatchSize = std::min(batchSize, loadQueue.size());
-        Logger::Info("Processing batch of " + std::to_string(currentBatchSize) + " assets");
+                AssetLoadTask& task = tasks[uploadQueue.front()];
+                uploadQueue.pop_front();
 
-        for (size_t i = 0; i < currentBatchSize; ++i) {
-            if (loadQueue.empty()) break;
+                auto uploadStart = std::chrono::steady_clock::now();
+                LoadAsset(task);
+                uploadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
 
-            AssetLoadTask task = loadQueue.front();
-            loadQueue.pop();
+                // The decoded data is on the GPU now
+                task.image = TextureImage{};
+                task.glyphs = std::vector<GlyphBitmaps>{};
+
+                // Update progress
+                loadedAssets++;
+            }
+        }
+
+        if (loadedAssets < totalAssets) {
+            // Report progress
+            if (progressCallback) {
+                progressCallback(GetProgress());
+            }
+            return true;
+        }
 
-            // Load the asset
-            LoadAsset(task);
+        StopWorkers();
+        isLoading = false;
+        loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
 
-            // Update progress
-            loadedAssets++;
+        // Every texture is loaded, pack the small ones into atlas pages
+        if (storeResults) {
+            AssetLoader::LoadTextureAtlas();
         }
 
-        // Report progress
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(1) << "Asset loading complete: " << totalAssets << " assets in " << loadMs
+            << " ms with " << workerCount << " workers, " << uploadMs << " ms on the main thread";
+        Logger::Info(ss.str());
+
+        // Report final progress
         if (progressCallback) {
-            progressCallback(GetProgress());
+            progressCallback(1.0f);
         }
 
-        return !loadQueue.empty();
+        return false;
     }
 
     bool AssetBatchLoader::IsLoading() const {
@@ -130,6 +196,22 @@ namespace Popplio {
         return static_cast<float>(loadedAssets) / static_cast<float>(totalAssets);
     }
 
+    void AssetBatchLoader::SetStoreResults(bool store) {
+        storeResults = store;
+    }
+
+    size_t AssetBatchLoader::GetWorkerCount() const {
+        return workerCount;
+    }
+
+    double AssetBatchLoader::GetLoadTimeMs() const {
+        return loadMs;
+    }
+
+    double AssetBatchLoader::GetUploadTimeMs() const {
+        return uploadMs;
+    }
+
     std::pair<std::vector<fs::path>, std::unordered_set<fs::path>> AssetBatchLoader::ListFilesRecursively(const fs::path& directory) {
         std::vector<fs::path> assetFiles;
         std::unordered_set<fs::path> metaFiles;
@@ -158,40 +240,132 @@ namespace Popplio {
         std::string extension = filepath.extension().string();
 
         if (extension == ".wav") {
-            auto task = AssetLoadTask(AssetLoadTask::Type::Audio, filepath);
-            // Audio parameters will be set later from meta file
-            loadQueue.push(task);
+            // Audio parameters are read from the meta file by a worker
+            tasks.emplace_back(AssetLoadTask::Type::Audio, filepath);
         }
         else if (extension == ".png") {
-            loadQueue.push(AssetLoadTask(AssetLoadTask::Type::Texture, filepath));
+            tasks.emplace_back(AssetLoadTask::Type::Texture, filepath);
         }
         else if (extension == ".vert" || extension == ".frag") {
             // Only queue shader once per pair (using .vert as the trigger)
             if (extension == ".vert") {
-                loadQueue.push(AssetLoadTask(AssetLoadTask::Type::Shader, filepath));
+                tasks.emplace_back(AssetLoadTask::Type::Shader, filepath);
             }
         }
         else if (extension == ".ttf") {
-            auto task = AssetLoadTask(AssetLoadTask::Type::Font, filepath);
-            // Font sizes will be set later from meta file
-            loadQueue.push(task);
+            // Font sizes are read from the meta file by a worker
+            tasks.emplace_back(AssetLoadTask::Type::Font, filepath);
         }
         else if (extension == ".cpp" || extension == ".h") {
             // Only queue scripts once (using .cpp as the trigger)
             if (extension == ".cpp") {
-                loadQueue.push(AssetLoadTask(AssetLoadTask::Type::Script, filepath));
+                tasks.emplace_back(AssetLoadTask::Type::Script, filepath);
             }
         }
         else if (extension == ".scene") {
-            loadQueue.push(AssetLoadTask(AssetLoadTask::Type::Scene, filepath));
+            tasks.emplace_back(AssetLoadTask::Type::Scene, filepath);
+        }
+    }
+
+    void AssetBatchLoader::RunWorker(size_t workerIndex) {
+        Profiler::SetThreadName("Asset Loader " + std::to_string(workerIndex));
+
+        for (size_t index = nextTask.fetch_add(1); index < tasks.size(); index = nextTask.fetch_add(1)) {
+            PrepareAsset(tasks[index]);
+
+            {
+                std::lock_guard<std::mutex> lock(completedMutex);
+                completedTasks.push_back(index);
+            }
+            completedCondition.notify_one();
+        }
+    }
+
+    void AssetBatchLoader::StopWorkers() {
+        // Workers finish the task they hold and find none left
+        nextTask.store(tasks.size());
+        for (std::thread& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        workers.clear();
+    }
+
+    void AssetBatchLoader::PrepareAsset(AssetLoadTask& task) {
+        POPPLIO_PROFILE_ZONE("Asset Decode");
+
+        try {
+            ReadMeta(task);
+
+            switch (task.type) {
+            case AssetLoadTask::Type::Texture:
+                task.image = Texture::Decode(task.filepath.string());
+                break;
+
+            case AssetLoadTask::Type::Font:
+                for (unsigned int size : task.fontSizes) {
+                    GlyphBitmaps glyphs{};
+                    if (Font::RasterizeSize(task.filepath.string(), size, glyphs)) {
+                        task.glyphs.push_back(std::move(glyphs));
+                    }
+                }
+                break;
+
+            default:
+                // Audio goes through FMOD, shaders are compiled by GL, scripts and scenes touch the engine
+                break;
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("Failed to decode asset: " + task.filepath.string() + " - " + e.what());
+        }
+    }
+
+    void AssetBatchLoader::ReadMeta(AssetLoadTask& task) {
+        if (task.type != AssetLoadTask::Type::Audio && task.type != AssetLoadTask::Type::Font) return;
+
+        fs::path metaPath = task.filepath;
+        metaPath.replace_extension(AssetLoader::_metaExtension);
+
+        std::ifstream inFile(metaPath);
+        if (!inFile) {
+            Logger::Warning("Failed to open meta file, loading with defaults: " + metaPath.string());
+            return;
+        }
+
+        rapidjson::Document metaDoc;
+        {
+            rapidjson::IStreamWrapper isw(inFile);
+            metaDoc.ParseStream(isw);
+        }
+
+        if (metaDoc.HasParseError() || !metaDoc.IsObject()) {
+            Logger::Warning("Failed to parse meta file, loading with defaults: " + metaPath.string());
+            return;
+        }
+
+        // Same fields as Serializer::DeserializeMetaFile
+        if (task.type == AssetLoadTask::Type::Audio && metaDoc.HasMember("Audio")) {
+            const auto& audioMeta = metaDoc["Audio"];
+            if (audioMeta.HasMember("channelGroup")) task.channelGroup = audioMeta["channelGroup"].GetInt();
+            if (audioMeta.HasMember("beatsPM")) task.bpm = audioMeta["beatsPM"].GetFloat();
+            if (audioMeta.HasMember("timeSignature") && audioMeta["timeSignature"].IsArray()) {
+                const auto& tsArray = audioMeta["timeSignature"].GetArray();
+                task.timeSig = { tsArray[0].GetInt(), tsArray[1].GetInt() };
+            }
+        }
+        else if (task.type == AssetLoadTask::Type::Font && metaDoc.HasMember("Font") &&
+            metaDoc["Font"].HasMember("sizes") && metaDoc["Font"]["sizes"].IsArray()) {
+            for (const auto& size : metaDoc["Font"]["sizes"].GetArray()) {
+                task.fontSizes.push_back(size.GetUint());
+            }
         }
     }
 
     bool AssetBatchLoader::LoadAsset(const AssetLoadTask& task) {
         try {
-            // Load meta data first
-            fs::path metaPath = task.filepath;
-            metaPath.replace_extension(AssetLoader::_metaExtension);
+            if (!storeResults) {
+                return UploadAndRelease(task);
+            }
 
             switch (task.type) {
             case AssetLoadTask::Type::Audio:
@@ -203,13 +377,13 @@ namespace Popplio {
                     task.timeSig);
 
             case AssetLoadTask::Type::Texture:
-                return AssetLoader::LoadTexture(task.filepath.string());
+                return AssetLoader::LoadTexture(task.filepath.string(), task.image);
 
             case AssetLoadTask::Type::Shader:
                 return AssetLoader::LoadShader(task.filepath.string());
 
             case AssetLoadTask::Type::Font:
-                return AssetLoader::LoadFont(task.filepath.string(), task.fontSizes);
+                return AssetLoader::LoadFont(task.filepath.string(), task.glyphs);
 
             case AssetLoadTask::Type::Script:
                 return AssetLoader::LoadCPPScripts(task.assetName);
@@ -228,4 +402,25 @@ namespace Popplio {
         }
     }
 
+    bool AssetBatchLoader::UploadAndRelease(const AssetLoadTask& task) {
+        switch (task.type) {
+        case AssetLoadTask::Type::Texture: {
+            GLuint texture = Texture(task.image).GetTextureID();
+            glDeleteTextures(1, &texture);
+            return static_cast<bool>(task.image.pixels);
+        }
+
+        case AssetLoadTask::Type::Font: {
+            Font font(task.filepath.string());
+            for (const GlyphBitmaps& size : task.glyphs) {
+                font.UploadSize(size);
+            }
+            return true;
+        }
+
+        default:
+            return true;
+        }
+    }
+
 } // namespace Popplio
\ No newline at end of file
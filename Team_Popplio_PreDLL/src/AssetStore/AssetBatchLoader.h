@@ -14,6 +14,10 @@ and scenes. The class provides progress updates to prevent blocking the main
 thread during loading, allowing the loading screen to update and render between
 batches.
 
+Reading the meta files, decoding textures and rasterizing font glyphs run on a
+pool of worker threads, the main thread only does the GL uploads and the loads
+that must stay on it within a time budget per batch.
+
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
 without the prior written consent of DigiPen Institute of
@@ -21,9 +25,14 @@ Technology is prohibited.
 */
 /******************************************************************************/
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <functional>
-#include <queue>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -32,6 +41,8 @@ Technology is prohibited.
 #include "AssetLoader.h"
 #include "../Audio/AudioSystem.h"
 #include "../Script/LogicSystem.h"
+#include "../Graphic/Texture/Texture.h"
+#include "../Graphic/Font/Font.h"
 
 namespace Popplio {
 
@@ -55,30 +66,50 @@ namespace Popplio {
         fs::path filepath;
         std::string assetName;
 
-        // Additional parameters for specific asset types
+        // Additional parameters for specific asset types, read from the meta file by a worker
         int channelGroup = 0;
         float bpm = 0.0f;
         std::pair<int, int> timeSig = { 4, 4 };
         std::list<unsigned int> fontSizes;
 
+        // Decoded by a worker, released once the main thread uploaded it
+        TextureImage image;
+        std::vector<GlyphBitmaps> glyphs;
+
         AssetLoadTask(Type type, const fs::path& path);
     };
 
     /**
      * @class AssetBatchLoader
-     * @brief Manages asset loading in batches with progress feedback
+     * @brief Manages asset loading on worker threads with progress feedback
+     *
+     * Workers take the tasks in scan order and push them to a completion queue once
+     * decoded, each ProcessBatch call drains that queue on the main thread until the
+     * upload budget is spent.
      */
     class AssetBatchLoader {
     public:
         using ProgressCallback = std::function<void(float)>;
 
+        static constexpr double DEFAULT_UPLOAD_BUDGET_MS = 8.0; // half a frame at 60 FPS
+
         /**
          * @brief Constructor
          * @param audioSystem Reference to the audio system
          * @param logicSystem Reference to the logic system
-         * @param batchSize Number of assets to load per batch
+         * @param workerCount Number of worker threads, 0 for one per hardware thread besides the main thread
+         * @param uploadBudgetMs Main thread time spent uploading assets per batch
          */
-        AssetBatchLoader(AudioSystem& audioSystem, LogicSystem& logicSystem, size_t batchSize = 20);
+        AssetBatchLoader(AudioSystem& audioSystem, LogicSystem& logicSystem, size_t workerCount = 0,
+            double uploadBudgetMs = DEFAULT_UPLOAD_BUDGET_MS);
+
+        /**
+         * @brief Destructor, stops the workers of an unfinished load
+         */
+        ~AssetBatchLoader();
+
+        AssetBatchLoader(const AssetBatchLoader&) = delete;
+        AssetBatchLoader& operator=(const AssetBatchLoader&) = delete;
 
         /**
          * @brief Scan for assets recursively and prepare them for loading
@@ -87,14 +118,15 @@ namespace Popplio {
         void ScanAssets(const fs::path& directory = fs::current_path());
 
         /**
-         * @brief Begin loading assets in batches
+         * @brief Begin loading assets, starting the workers
          * @param callback Progress callback function
          * @return True if loading has started, false if already loading
          */
         bool StartLoading(ProgressCallback callback);
 
         /**
-         * @brief Process a single batch of assets
+         * @brief Upload the assets the workers decoded, waiting for them when none are ready,
+         *        until the upload budget is spent
          * @return True if there are more assets to load, false if loading is complete
          */
         bool ProcessBatch();
@@ -111,15 +143,51 @@ namespace Popplio {
          */
         float GetProgress() const;
 
+        /**
+         * @brief Set whether loaded assets are stored. When false, textures and fonts are
+         *        uploaded then released and the other assets are skipped, to time the
+         *        pipeline without touching the asset store
+         * @param store Whether to store the assets, true by default
+         */
+        void SetStoreResults(bool store);
+
+        size_t GetWorkerCount() const;
+
+        /**
+         * @brief Get the wall time of the last load, from StartLoading to the last upload
+         * @return Time in milliseconds
+         */
+        double GetLoadTimeMs() const;
+
+        /**
+         * @brief Get the main thread time of the last load spent uploading and loading assets
+         * @return Time in milliseconds
+         */
+        double GetUploadTimeMs() const;
+
     private:
         AudioSystem& audioSystem;
         LogicSystem& logicSystem;
-        size_t batchSize;
+        size_t workerCount;
+        double uploadBudgetMs;
+        bool storeResults;
         bool isLoading;
         size_t totalAssets;
         size_t loadedAssets;
         ProgressCallback progressCallback;
-        std::queue<AssetLoadTask> loadQueue;
+
+        std::vector<AssetLoadTask> tasks; // not resized while the workers run
+        std::vector<std::thread> workers;
+        std::atomic<size_t> nextTask; // next task a worker takes
+
+        std::mutex completedMutex;
+        std::condition_variable completedCondition;
+        std::vector<size_t> completedTasks; // decoded, guarded by completedMutex
+        std::deque<size_t> uploadQueue; // decoded, main thread only
+
+        std::chrono::steady_clock::time_point loadStart;
+        double loadMs;
+        double uploadMs;
 
         /**
          * @brief Recursively list all files in a directory
@@ -135,11 +203,41 @@ namespace Popplio {
         void QueueAssetLoad(const fs::path& filepath);
 
         /**
-         * @brief Load a single asset based on its task parameters
+         * @brief Worker thread, prepares tasks until none are left
+         * @param workerIndex Index of the worker, for its thread name
+         */
+        void RunWorker(size_t workerIndex);
+
+        /**
+         * @brief Stop the workers from taking tasks and join them
+         */
+        void StopWorkers();
+
+        /**
+         * @brief Read the meta file and decode the asset, without touching OpenGL or the asset store
+         * @param task Asset loading task, filled with the decoded data
+         */
+        static void PrepareAsset(AssetLoadTask& task);
+
+        /**
+         * @brief Read the load parameters of audio and fonts from the meta file
+         * @param task Asset loading task, keeps the defaults if the meta file is missing or invalid
+         */
+        static void ReadMeta(AssetLoadTask& task);
+
+        /**
+         * @brief Load a single prepared asset based on its task parameters, main thread only
          * @param task Asset loading task
          * @return True if loaded successfully, false otherwise
          */
         bool LoadAsset(const AssetLoadTask& task);
+
+        /**
+         * @brief Upload a prepared texture or font and release it, for SetStoreResults(false)
+         * @param task Asset loading task
+         * @return True if the asset was decoded
+         */
+        static bool UploadAndRelease(const AssetLoadTask& task);
     };
 
-} // namespace Popplio
\ No newline at end of file
+} // namespace Popplio
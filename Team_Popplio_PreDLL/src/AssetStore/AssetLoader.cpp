@@ -37,6 +37,38 @@ namespace Popplio {
 	AudioSystem* AssetLoader::audioSystemRef = nullptr;
 	LogicSystem* AssetLoader::logicSystemRef = nullptr;
 	const std::string& AssetLoader::_metaExtension{ ".cyndaquil" };
+	const std::string& AssetLoader::_atlasManifestPath{ "Assets/Textures/TextureAtlas.atlas" };
+
+	// Copies a texture into its atlas region, extruding its edges into the padding around it
+	void CopyIntoAtlasPage(unsigned int texture, unsigned int page, const AtlasRegion& region, int extrude)
+	{
+		auto copy = [texture, page](int srcX, int srcY, int dstX, int dstY, int width, int height)
+		{
+			glCopyImageSubData(texture, GL_TEXTURE_2D, 0, srcX, srcY, 0,
+				page, GL_TEXTURE_2D, 0, dstX, dstY, 0, width, height, 1);
+		};
+
+		const int right = region.width - 1;
+		const int top = region.height - 1;
+		copy(0, 0, region.x, region.y, region.width, region.height);
+		for (int e = 1; e <= extrude; ++e)
+		{
+			copy(0, 0, region.x - e, region.y, 1, region.height);
+			copy(right, 0, region.x + right + e, region.y, 1, region.height);
+			copy(0, 0, region.x, region.y - e, region.width, 1);
+			copy(0, top, region.x, region.y + top + e, region.width, 1);
+		}
+		for (int ex = 1; ex <= extrude; ++ex)
+		{
+			for (int ey = 1; ey <= extrude; ++ey)
+			{
+				copy(0, 0, region.x - ex, region.y - ey, 1, 1);
+				copy(right, 0, region.x + right + ex, region.y - ey, 1, 1);
+				copy(0, top, region.x - ex, region.y + top + ey, 1, 1);
+				copy(right, top, region.x + right + ex, region.y + top + ey, 1, 1);
+			}
+		}
+	}
 
 	std::pair<std::vector<fs::path>, std::unordered_set<fs::path>> ListFilesRecursively(const fs::path& directory)
 	{
@@ -84,6 +116,8 @@ namespace Popplio {
 		}
 
 		PerformanceViewer::GetInstance()->EndRealTime("GetMetaFiles");
+
+		LoadTextureAtlas();
 	}
 
 	void AssetLoader::TotalWipe()
@@ -178,6 +212,90 @@ namespace Popplio {
 		return true;
 	}
 
+	bool AssetLoader::LoadTexture(const std::string& filepath, const TextureImage& image)
+	{
+		if (!image.pixels) return false; // Texture::Decode logged the error
+
+		try {
+			AssetStore::StoreTextureAsset(
+				Serializer::GenerateAssetName(filepath),
+				Texture(image).GetTextureID()
+			);
+		}
+		catch (const std::exception&) {
+			Logger::Error("Failed to load texture: " + filepath);
+			return false;
+		}
+		return true;
+	}
+
+	// Loads the manifest, repacking and saving it only when the textures changed
+	bool UpdateAtlasManifest(const std::vector<AtlasImage>& images, AtlasManifest& manifest)
+	{
+		if (manifest.Load(AssetLoader::_atlasManifestPath) && AtlasPacker::IsUpToDate(manifest, images)) return true;
+
+		manifest = AtlasPacker::Pack(images);
+		if (!manifest.Save(AssetLoader::_atlasManifestPath))
+		{
+			Logger::Warning("Unable to save texture atlas manifest: " + AssetLoader::_atlasManifestPath);
+			return false;
+		}
+		Logger::Info("Texture atlas manifest written: " + AssetLoader::_atlasManifestPath);
+		return true;
+	}
+
+	bool AssetLoader::BuildTextureAtlasManifest(const std::filesystem::path& directory)
+	{
+		AtlasManifest manifest{};
+		if (!UpdateAtlasManifest(AtlasPacker::ScanImages(directory), manifest)) return false;
+
+		Logger::Info("Texture atlas manifest: " + std::to_string(manifest.regions.size()) + " textures in " +
+			std::to_string(manifest.pageCount) + " pages");
+		return true;
+	}
+
+	bool AssetLoader::LoadTextureAtlas()
+	{
+		std::vector<AtlasImage> images{};
+		for (const auto& [name, texture] : AssetStore::GetAllTextures())
+		{
+			auto [width, height] = AssetStore::GetTextureSize(name);
+			images.push_back({ name, width, height });
+		}
+		std::sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b) { return a.name < b.name; });
+
+		AtlasManifest manifest{};
+		UpdateAtlasManifest(images, manifest);
+
+		std::vector<unsigned int> pages(manifest.pageCount, 0);
+		if (!pages.empty()) glGenTextures(static_cast<GLsizei>(pages.size()), pages.data());
+		for (unsigned int page : pages)
+		{
+			glBindTexture(GL_TEXTURE_2D, page);
+			glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, manifest.pageSize, manifest.pageSize);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glClearTexImage(page, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// The loaded textures are copied on the GPU, no image is decoded again
+		std::unordered_map<std::string, TextureRegion> regions{};
+		for (const auto& [name, region] : manifest.regions)
+		{
+			const unsigned int page = pages[region.page];
+			CopyIntoAtlasPage(AssetStore::GetTexture(name), page, region, manifest.padding / 2);
+			regions[name] = TextureRegion{ page, manifest.GetUVRect(region) };
+		}
+
+		Logger::Info("Packed " + std::to_string(regions.size()) + " textures into " +
+			std::to_string(pages.size()) + " atlas pages");
+		AssetStore::StoreTextureAtlas(std::move(pages), std::move(regions));
+		return true;
+	}
+
 	bool AssetLoader::LoadShader(const std::string& filepath)
 	{
 		try {
@@ -222,6 +340,26 @@ namespace Popplio {
 		return true;
 	}
 
+	bool AssetLoader::LoadFont(const std::string& filepath, const std::vector<GlyphBitmaps>& glyphs)
+	{
+		std::string assetName = Serializer::GenerateAssetName(filepath);
+
+		// Upload the sizes rasterized on the loader workers
+		auto font = std::make_unique<Font>(filepath);
+		for (const GlyphBitmaps& size : glyphs) {
+			font->UploadSize(size);
+		}
+
+		try {
+			AssetStore::StoreFontAsset(assetName, std::move(font));
+		}
+		catch (const std::exception&) {
+			Logger::Error("Failed to load font: " + filepath);
+			return false;
+		}
+		return true;
+	}
+
 	bool AssetLoader::LoadCPPScripts(const std::string& scriptClass)
 	{
 		try
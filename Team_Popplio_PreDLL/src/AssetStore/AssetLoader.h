@@ -22,6 +22,8 @@ Technology is prohibited.
 #include "../Serialization/Serialization.h"
 #include "../Script/LogicSystem.h"
 #include "../ChartEditor/LevelChart.h"
+#include "../Graphic/Texture/Texture.h"
+#include "../Graphic/Font/Font.h"
 namespace Popplio
 {
 	class AssetLoader
@@ -36,6 +38,8 @@ namespace Popplio
 
 		// extension for meta files
 		static const std::string& _metaExtension;
+		// texture atlas manifest, next to the texture meta files
+		static const std::string& _atlasManifestPath;
 
 		/**
 		 * \brief Function to assign audio system and logic system for loader
@@ -70,6 +74,23 @@ namespace Popplio
 		 * \return returns true if the asset can be loaded into memory
 		 */
 		static bool LoadTexture(const std::string& filepath);
+		/**
+		 * \brief Loads Texture Asset from an image decoded by Texture::Decode, main thread only
+		 * \return returns true if the asset can be loaded into memory
+		 */
+		static bool LoadTexture(const std::string& filepath, const TextureImage& image);
+		/**
+		 * \brief Packs the small loaded textures into atlas pages, reusing the manifest if it is up to date
+		 * \return returns true if the atlas was built
+		 */
+		static bool LoadTextureAtlas();
+		/**
+		 * \brief Writes the texture atlas manifest for the textures under a directory, without OpenGL,
+		 * so an asset build can produce it before the game runs
+		 * \param directory Directory scanned for textures, the one the assets are loaded from
+		 * \return returns true if the manifest is up to date or was written
+		 */
+		static bool BuildTextureAtlasManifest(const std::filesystem::path& directory = std::filesystem::current_path());
 		/**
 		 * \brief Loads Shader Asset
 		 * \return returns true if the asset can be loaded into memory
@@ -80,6 +101,11 @@ namespace Popplio
 		 * \return returns true if the asset can be loaded into memory
 		 */
 		static bool LoadFont(const std::string& filepath, std::list<unsigned int> fontsize);
+		/**
+		 * \brief Loads Font Asset from sizes rasterized by Font::RasterizeSize, main thread only
+		 * \return returns true if the asset can be loaded into memory
+		 */
+		static bool LoadFont(const std::string& filepath, const std::vector<GlyphBitmaps>& glyphs);
 		/**
 		 * \brief Loads Script Asset (ONLY C++ SCRIPTS)
 		 * C# scripts will be loaded elsewhere
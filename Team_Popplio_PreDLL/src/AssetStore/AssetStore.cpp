@@ -27,6 +27,8 @@ namespace Popplio
 
 	std::unordered_map<std::string, std::filesystem::path> AssetStore::sceneList;
 	std::unordered_map<std::string, std::pair<int, int>> AssetStore::textureSizeList;
+	std::unordered_map<std::string, TextureRegion> AssetStore::textureRegionList;
+	std::vector<unsigned int> AssetStore::atlasPageList;
 
 	void AssetStore::StoreAudioAsset(const std::string& assetId, FMOD::Sound* sound)
 	{
@@ -54,6 +56,17 @@ namespace Popplio
 		textureSizeList[assetId] = { width, height };
 	}
 
+	void AssetStore::StoreTextureAtlas(std::vector<unsigned int> pages, std::unordered_map<std::string, TextureRegion> regions)
+	{
+		if (!atlasPageList.empty())
+		{
+			glDeleteTextures(static_cast<GLsizei>(atlasPageList.size()), atlasPageList.data());
+		}
+
+		atlasPageList = std::move(pages);
+		textureRegionList = std::move(regions);
+	}
+
 	void AssetStore::StoreMeshAsset(MeshType type, const Mesh& mesh)
 	{
 		meshList.emplace(type, mesh);
@@ -116,6 +129,21 @@ namespace Popplio
 		return 0;
 	}
 
+	TextureRegion AssetStore::GetTextureRegion(const std::string& assetId)
+	{
+		auto it = textureRegionList.find(assetId);
+		if (it != textureRegionList.end())
+		{
+			return it->second;
+		}
+		return TextureRegion{ GetTexture(assetId) };
+	}
+
+	const std::vector<unsigned int>& AssetStore::GetAtlasPages()
+	{
+		return atlasPageList;
+	}
+
 	Font* AssetStore::GetFont(const std::string& assetId)
 	{
 		auto it = fontList.find(assetId);
@@ -220,6 +248,8 @@ namespace Popplio
 	{
 		shaderList.clear();
 		textureList.clear();
+		textureRegionList.clear();
+		atlasPageList.clear();
 		fontList.clear();
 		meshList.clear();
 
@@ -33,6 +33,7 @@ Technology is prohibited.
 #include "../Graphic/Mesh/Mesh.h"
 #include "../Graphic/Shader/Shader.h"
 #include "../Graphic/Texture/Texture.h"
+#include "../Graphic/Texture/TextureAtlas.h"
 #include "../Graphic/Font/Font.h"
 #include "../Graphic/GraphicComponent.h"
 #include "../Script/LogicScript.h"
@@ -60,6 +61,8 @@ namespace Popplio
 
 		static std::unordered_map<std::string, std::filesystem::path> chartList;
 		static std::unordered_map<std::string, std::pair<int, int>> textureSizeList; // Stores texture sizes
+		static std::unordered_map<std::string, TextureRegion> textureRegionList; // Textures packed into atlas pages
+		static std::vector<unsigned int> atlasPageList;
 
 	public:
 
@@ -84,6 +87,12 @@ namespace Popplio
 		 * \param texture The texture asset to be saved into the assetstore
 		 */
 		static void StoreTextureAsset(const std::string& assetId, unsigned int texture);
+		/**
+		 * \brief Stores the Texture Atlas, replacing (and deleting the pages of) the previous one
+		 * \param pages The atlas page textures
+		 * \param regions The region of every packed texture, by texture asset ID
+		 */
+		static void StoreTextureAtlas(std::vector<unsigned int> pages, std::unordered_map<std::string, TextureRegion> regions);
 		/**
 		 * \brief Stores Mesh Asset
 		 * \param assetID The ID to save the asset to
@@ -137,6 +146,17 @@ namespace Popplio
 		 * \return The Texture asset
 		 */
 		static unsigned int GetTexture(const std::string& assetId);
+		/**
+		 * \brief Getter for the region of a Texture Asset to sample it from
+		 * \param assetID The ID key of the asset
+		 * \return The atlas page and UV rect if the texture is packed, otherwise the texture itself and the full UV rect
+		 */
+		static TextureRegion GetTextureRegion(const std::string& assetId);
+		/**
+		 * \brief Getter for the Texture Atlas pages
+		 * \return The atlas page textures
+		 */
+		static const std::vector<unsigned int>& GetAtlasPages();
 		/**
 		 * \brief Getter for Mesh
 		 * \param type The MeshType of the mesh
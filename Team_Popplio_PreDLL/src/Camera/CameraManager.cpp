@@ -98,4 +98,19 @@ namespace Popplio
         return gameCamera.GetProjectionMatrix();
 #endif
 	}
+
+	glm::vec4 CameraManager::GetViewBounds() const
+	{
+		// The corners of clip space back in world space, the view may be rotated
+		const glm::mat3 clipToWorld = glm::inverse(GetProjectionMatrix().ToGLM() * GetViewMatrix().ToGLM());
+		glm::vec2 minCorner(std::numeric_limits<float>::max());
+		glm::vec2 maxCorner(std::numeric_limits<float>::lowest());
+		for (const glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+		{
+			const glm::vec3 world = clipToWorld * glm::vec3(corner, 1.0f);
+			minCorner = glm::min(minCorner, glm::vec2(world));
+			maxCorner = glm::max(maxCorner, glm::vec2(world));
+		}
+		return glm::vec4(minCorner, maxCorner);
+	}
 }
\ No newline at end of file
@@ -96,6 +96,12 @@ namespace Popplio
          */
         PopplioMath::M3x3f GetProjectionMatrix() const;
 
+        /**
+         * \brief Gets the world-space bounds of what the active camera sees.
+         * \return The bounds as (min x, min y, max x, max y).
+         */
+        glm::vec4 GetViewBounds() const;
+
 	private:
 #ifndef IMGUI_DISABLE
 		EditorCamera editorCamera;
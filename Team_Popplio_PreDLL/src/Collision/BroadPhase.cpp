@@ -0,0 +1,258 @@
+/******************************************************************************/
+/*!
+\file   BroadPhase.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for the collision broad phase
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "BroadPhase.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Popplio
+{
+    namespace
+    {
+        bool Overlaps(BroadPhaseProxy const& a, BroadPhaseProxy const& b)
+        {
+            return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+        }
+
+        BroadPhasePair MakePair(BroadPhaseProxy const& a, BroadPhaseProxy const& b)
+        {
+            return a.body < b.body ? BroadPhasePair(a.body, b.body) : BroadPhasePair(b.body, a.body);
+        }
+
+        // sorts the pairs and removes duplicates found through several cells
+        void SortUnique(std::vector<BroadPhasePair>& pairs)
+        {
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        }
+
+        // cell coordinates stay well inside int so that looping up to the last cell cannot overflow
+        const float MAX_CELL_COORDINATE = 1073741824.f; // 2^30
+
+        bool IsFinite(BroadPhaseProxy const& proxy)
+        {
+            return std::isfinite(proxy.minX) && std::isfinite(proxy.maxX) &&
+                std::isfinite(proxy.minY) && std::isfinite(proxy.maxY);
+        }
+
+        // position must be finite, far away positions are clamped to the outermost cells
+        int CellCoordinate(float position, float inverseCellSize)
+        {
+            return static_cast<int>(std::clamp(std::floor(position * inverseCellSize), -MAX_CELL_COORDINATE, MAX_CELL_COORDINATE));
+        }
+    }
+
+    void BruteForceBroadPhase::FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs)
+    {
+        pairs.clear();
+        for (size_t i = 0; i < proxies.size(); ++i)
+        {
+            for (size_t j = i + 1; j < proxies.size(); ++j)
+            {
+                pairs.push_back(MakePair(proxies[i], proxies[j]));
+            }
+        }
+
+        // Already sorted when the proxies are in body order
+        if (!std::is_sorted(pairs.begin(), pairs.end()))
+        {
+            std::sort(pairs.begin(), pairs.end());
+        }
+    }
+
+    SpatialHashBroadPhase::SpatialHashBroadPhase(float cellSize)
+        : inverseCellSize(1.f / (cellSize > 0.f ? cellSize : 1.f))
+    {
+    }
+
+    void SpatialHashBroadPhase::FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs)
+    {
+        pairs.clear();
+        entries.clear();
+        oversized.clear();
+
+        // Bin every proxy into the cells its bounds cover
+        for (int p = 0; p < static_cast<int>(proxies.size()); ++p)
+        {
+            BroadPhaseProxy const& proxy = proxies[p];
+
+            // NaN / infinite bounds have no cell, test them against everything like the brute force does
+            if (!IsFinite(proxy))
+            {
+                oversized.push_back(p);
+                continue;
+            }
+
+            const int x0 = CellCoordinate(proxy.minX, inverseCellSize);
+            const int x1 = CellCoordinate(proxy.maxX, inverseCellSize);
+            const int y0 = CellCoordinate(proxy.minY, inverseCellSize);
+            const int y1 = CellCoordinate(proxy.maxY, inverseCellSize);
+
+            const long long cellCount = (static_cast<long long>(x1) - x0 + 1) * (static_cast<long long>(y1) - y0 + 1);
+            if (cellCount > MAX_CELLS_PER_PROXY)
+            {
+                oversized.push_back(p);
+                continue;
+            }
+
+            for (int x = x0; x <= x1; ++x)
+            {
+                for (int y = y0; y <= y1; ++y)
+                {
+                    const std::uint64_t cell = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+                        static_cast<std::uint32_t>(y);
+                    entries.push_back({ cell, p });
+                }
+            }
+        }
+
+        // Group the entries of each cell together
+        std::sort(entries.begin(), entries.end(), [](CellEntry const& a, CellEntry const& b)
+            { return a.cell < b.cell || (a.cell == b.cell && a.proxy < b.proxy); });
+
+        for (size_t first = 0; first < entries.size();)
+        {
+            size_t last = first + 1;
+            while (last < entries.size() && entries[last].cell == entries[first].cell) ++last;
+
+            for (size_t a = first; a < last; ++a)
+            {
+                for (size_t b = a + 1; b < last; ++b)
+                {
+                    BroadPhaseProxy const& proxyA = proxies[entries[a].proxy];
+                    BroadPhaseProxy const& proxyB = proxies[entries[b].proxy];
+                    if (Overlaps(proxyA, proxyB))
+                    {
+                        pairs.push_back(MakePair(proxyA, proxyB));
+                    }
+                }
+            }
+            first = last;
+        }
+
+        // Proxies spanning many cells are tested against everything instead
+        for (int o : oversized)
+        {
+            for (int p = 0; p < static_cast<int>(proxies.size()); ++p)
+            {
+                if (p != o && Overlaps(proxies[o], proxies[p]))
+                {
+                    pairs.push_back(MakePair(proxies[o], proxies[p]));
+                }
+            }
+        }
+
+        SortUnique(pairs);
+    }
+
+    void SortAndSweepBroadPhase::FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs)
+    {
+        pairs.clear();
+
+        const size_t count = proxies.size();
+        auto lessMinX = [&proxies](int a, int b) { return proxies[a].minX < proxies[b].minX; };
+
+        if (order.size() != count)
+        {
+            order.resize(count);
+            for (size_t i = 0; i < count; ++i) order[i] = static_cast<int>(i);
+            std::sort(order.begin(), order.end(), lessMinX);
+        }
+        else
+        {
+            // Bodies move little between steps, so the previous order is nearly sorted
+            // Fall back to a full sort if the insertion sort has to move too much
+            const size_t moveLimit = count * 4;
+            size_t moves = 0;
+            for (size_t i = 1; i < count && moves <= moveLimit; ++i)
+            {
+                const int key = order[i];
+                size_t j = i;
+                while (j > 0 && lessMinX(key, order[j - 1]) && moves <= moveLimit)
+                {
+                    order[j] = order[j - 1];
+                    --j;
+                    ++moves;
+                }
+                order[j] = key;
+            }
+
+            if (moves > moveLimit)
+            {
+                std::sort(order.begin(), order.end(), lessMinX);
+            }
+        }
+
+        // Sweep: only proxies starting before the current one ends can overlap it on X
+        for (size_t i = 0; i < count; ++i)
+        {
+            BroadPhaseProxy const& proxyA = proxies[order[i]];
+            for (size_t k = i + 1; k < count; ++k)
+            {
+                BroadPhaseProxy const& proxyB = proxies[order[k]];
+                if (proxyB.minX > proxyA.maxX) break;
+
+                if (proxyA.minY <= proxyB.maxY && proxyB.minY <= proxyA.maxY)
+                {
+                    pairs.push_back(MakePair(proxyA, proxyB));
+                }
+            }
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+    std::unique_ptr<BroadPhase> CreateBroadPhase(BroadPhaseType type, float cellSize)
+    {
+        switch (type)
+        {
+        case BroadPhaseType::BRUTE_FORCE:
+            return std::make_unique<BruteForceBroadPhase>();
+        case BroadPhaseType::SPATIAL_HASH:
+            return std::make_unique<SpatialHashBroadPhase>(cellSize);
+        case BroadPhaseType::SORT_AND_SWEEP:
+        default:
+            return std::make_unique<SortAndSweepBroadPhase>();
+        }
+    }
+
+    std::string BroadPhaseTypeToString(BroadPhaseType type)
+    {
+        switch (type)
+        {
+        case BroadPhaseType::BRUTE_FORCE:
+            return "brute force";
+        case BroadPhaseType::SPATIAL_HASH:
+            return "spatial hash";
+        case BroadPhaseType::SORT_AND_SWEEP:
+        default:
+            return "sort and sweep";
+        }
+    }
+
+    BroadPhaseType BroadPhaseTypeFromString(std::string const& name)
+    {
+        if (name == "brute force") return BroadPhaseType::BRUTE_FORCE;
+        if (name == "spatial hash") return BroadPhaseType::SPATIAL_HASH;
+        return BroadPhaseType::SORT_AND_SWEEP;
+    }
+}
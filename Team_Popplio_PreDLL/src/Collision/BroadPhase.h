@@ -0,0 +1,156 @@
+/******************************************************************************/
+/*!
+\file   BroadPhase.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for the collision broad phase
+
+        A broad phase finds the pairs of bodies whose bounds overlap, so only
+        those pairs are passed to the narrow phase of the CollisionSystem
+        Brute force (every pair), uniform spatial hash and sort and sweep on X
+        are provided, selectable per scene
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Popplio
+{
+    /**
+    * @brief The available broad phase algorithms.
+    */
+    enum class BroadPhaseType
+    {
+        BRUTE_FORCE, /**< Every pair of bodies, O(n^2). */
+        SPATIAL_HASH, /**< Bodies binned into a uniform grid of cells. */
+        SORT_AND_SWEEP /**< Bodies sorted by their left edge, swept along X. */
+    };
+
+    /**
+    * @brief Axis-aligned bounds of one body, with the index of the body it belongs to.
+    */
+    struct BroadPhaseProxy
+    {
+        int body; /**< Index of the body in the caller's body array. */
+        float minX, minY, maxX, maxY;
+    };
+
+    /**
+    * @brief A pair of body indices, first < second.
+    */
+    using BroadPhasePair = std::pair<int, int>;
+
+    /**
+    * @brief Finds the candidate pairs of bodies that may collide.
+    */
+    class BroadPhase
+    {
+    public:
+        virtual ~BroadPhase() = default;
+
+        /**
+        * @brief Finds every pair of proxies whose bounds overlap (edges touching counts as overlapping).
+        *
+        * @param proxies The bounds of the bodies to test.
+        * @param pairs Filled with the candidate pairs, sorted and without duplicates.
+        */
+        virtual void FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs) = 0;
+
+        /**
+        * @brief Gets the type of the broad phase.
+        */
+        virtual BroadPhaseType GetType() const = 0;
+    };
+
+    /**
+    * @brief Returns every pair of proxies without testing their bounds (the narrow phase tests them all).
+    */
+    class BruteForceBroadPhase : public BroadPhase
+    {
+    public:
+        void FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs) override;
+        BroadPhaseType GetType() const override { return BroadPhaseType::BRUTE_FORCE; }
+    };
+
+    /**
+    * @brief Bins proxies into square cells of a uniform grid and tests proxies sharing a cell.
+    *
+    * Works best when the cell size is close to the size of a typical body.
+    */
+    class SpatialHashBroadPhase : public BroadPhase
+    {
+    public:
+        static constexpr int MAX_CELLS_PER_PROXY = 64; /**< Larger proxies are tested against every proxy. */
+
+        /**
+        * @brief Constructs the spatial hash.
+        *
+        * @param cellSize The width / height of one cell in world units.
+        */
+        explicit SpatialHashBroadPhase(float cellSize);
+
+        void FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs) override;
+        BroadPhaseType GetType() const override { return BroadPhaseType::SPATIAL_HASH; }
+
+    private:
+        struct CellEntry
+        {
+            std::uint64_t cell; /**< Packed cell coordinates. */
+            int proxy; /**< Index into the proxies. */
+        };
+
+        float inverseCellSize;
+        std::vector<CellEntry> entries{}; /**< Reused between steps. */
+        std::vector<int> oversized{}; /**< Proxies covering too many cells. */
+    };
+
+    /**
+    * @brief Sorts proxies by their left edge and only tests proxies whose X intervals overlap.
+    *
+    * Works well for any body size; the sort is nearly free when bodies move little between steps.
+    */
+    class SortAndSweepBroadPhase : public BroadPhase
+    {
+    public:
+        void FindPairs(std::vector<BroadPhaseProxy> const& proxies, std::vector<BroadPhasePair>& pairs) override;
+        BroadPhaseType GetType() const override { return BroadPhaseType::SORT_AND_SWEEP; }
+
+    private:
+        std::vector<int> order{}; /**< Proxy indices sorted by minX, kept between steps. */
+    };
+
+    /**
+    * @brief Creates a broad phase of the given type.
+    *
+    * @param type The broad phase algorithm.
+    * @param cellSize The cell size used by the spatial hash.
+    * @return std::unique_ptr<BroadPhase> The broad phase.
+    */
+    std::unique_ptr<BroadPhase> CreateBroadPhase(BroadPhaseType type, float cellSize);
+
+    /**
+    * @brief Gets the name of a broad phase type, as written in scene files.
+    */
+    std::string BroadPhaseTypeToString(BroadPhaseType type);
+
+    /**
+    * @brief Gets the broad phase type from its name, SORT_AND_SWEEP if the name is unknown.
+    */
+    BroadPhaseType BroadPhaseTypeFromString(std::string const& name);
+}
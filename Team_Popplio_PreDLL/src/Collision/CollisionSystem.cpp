@@ -30,10 +30,13 @@ Technology is prohibited.
 #include "../Physics/MovementSystem.h"
 #include "../Logging/Logger.h"
 
+#include <limits>
+
 namespace Popplio
 {
 	CollisionSystem::CollisionSystem(EventBus& e, LayerManager& layerMgr) 
-		: event(e), layerManager(layerMgr)
+		: event(e), layerManager(layerMgr),
+		broadPhase(CreateBroadPhase(BroadPhaseType::SORT_AND_SWEEP, DEFAULT_CELL_SIZE)), cellSize(DEFAULT_CELL_SIZE)
 	{
 		RequireComponent<TransformComponent>();
 		RequireComponent<RigidBodyComponent>();
@@ -41,8 +44,38 @@ namespace Popplio
 
 		//collisions.reserve(256);
   //      triggers.reserve(256);
+        bodies.reserve(1024);
         collisionCount.reserve(1024);
         triggerCount.reserve(1024);
+        proxies.reserve(1024);
+	}
+
+	void CollisionSystem::SetBroadPhase(BroadPhaseType type, float size)
+	{
+		cellSize = size > 0.f ? size : DEFAULT_CELL_SIZE;
+		broadPhase = CreateBroadPhase(type, cellSize);
+		Logger::Info("Collision broad phase set to " + BroadPhaseTypeToString(type));
+	}
+
+	BroadPhaseType CollisionSystem::GetBroadPhaseType() const
+	{
+		return broadPhase->GetType();
+	}
+
+	float CollisionSystem::GetCellSize() const
+	{
+		return cellSize;
+	}
+
+	size_t CollisionSystem::GetPairsTested() const
+	{
+		return pairsTested;
+	}
+
+	void CollisionSystem::ClearContacts()
+	{
+		collisions.Clear();
+		triggers.Clear();
 	}
 
 	//check for collision between two box colliders
@@ -106,71 +139,187 @@ namespace Popplio
 		);
 	}
 
+	void CollisionSystem::GatherBodies(Registry& registry)
+	{
+		bodies.clear();
+
+		registry.View<ActiveComponent, TransformComponent, RigidBodyComponent>(*this).Each(
+			[&](Entity entity, ActiveComponent& active, TransformComponent& transform, RigidBodyComponent& rigidBody)
+		{
+			bodies.push_back({ entity, &active, &transform, &rigidBody,
+				registry.TryGetComponent<BoxColliderComponent>(entity),
+				registry.TryGetComponent<CircleColliderComponent>(entity) });
+		});
+	}
+
+	void CollisionSystem::BuildProxies(float deltaTime)
+	{
+		proxies.clear();
+
+		for (int i = 0; i < static_cast<int>(bodies.size()); ++i)
+		{
+			const CollisionBody& body = bodies[i];
+
+			if (body.active->isActive == false) continue;
+			if (!(body.rigidBody->isActive)) continue;
+			if (!body.box && !body.circle) continue;
+
+			const float x = body.transform->position.x;
+			const float y = body.transform->position.y;
+
+			BroadPhaseProxy proxy{ i,
+				std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+				std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+			if (body.box)
+			{
+				const float halfW = std::abs(body.box->size.x) / 2;
+				const float halfH = std::abs(body.box->size.y) / 2;
+				proxy.minX = std::min(proxy.minX, x + body.box->offset.x - halfW);
+				proxy.maxX = std::max(proxy.maxX, x + body.box->offset.x + halfW);
+				proxy.minY = std::min(proxy.minY, y + body.box->offset.y - halfH);
+				proxy.maxY = std::max(proxy.maxY, y + body.box->offset.y + halfH);
+			}
+			if (body.circle)
+			{
+				const float radius = std::abs(body.circle->radius);
+				proxy.minX = std::min(proxy.minX, x + body.circle->offset.x - radius);
+				proxy.maxX = std::max(proxy.maxX, x + body.circle->offset.x + radius);
+				proxy.minY = std::min(proxy.minY, y + body.circle->offset.y - radius);
+				proxy.maxY = std::max(proxy.maxY, y + body.circle->offset.y + radius);
+			}
+
+			// Box - box tests are swept over the step, so extend the bounds along the velocity
+			const float dx = body.rigidBody->velocity.x * deltaTime;
+			const float dy = body.rigidBody->velocity.y * deltaTime;
+			proxy.minX += std::min(dx, 0.f);
+			proxy.maxX += std::max(dx, 0.f);
+			proxy.minY += std::min(dy, 0.f);
+			proxy.maxY += std::max(dy, 0.f);
+
+			proxies.push_back(proxy);
+		}
+	}
+
+	bool CollisionSystem::CanCollide(const CollisionBody& body)
+	{
+		if (body.active->isActive == false || !(body.rigidBody->isActive)) return false;
+		if (!body.box && !body.circle) return false;
+		if (body.box && (!body.box->isActive || !body.box->isEnabled)) return false;
+		if (body.circle && (!body.circle->isActive || !body.circle->isEnabled)) return false;
+		return true;
+	}
+
+	void CollisionSystem::ExitSeparatedPairs(ContactPairTable& tracked, bool isTrigger)
+	{
+		tracked.EndStep(exitedPairs);
+		for (std::uint64_t key : exitedPairs)
+		{
+			const int id1 = ContactPairTable::FirstId(key);
+			const int id2 = ContactPairTable::SecondId(key);
+
+			// Entities that are gone (or lost their rigid body / transform) are dropped without an exit
+			if (id2 >= static_cast<int>(bodyOfEntity.size()) || bodyOfEntity[id1] < 0 || bodyOfEntity[id2] < 0) continue;
+
+			// Same conditions as the pair loop, which skips the pair instead of separating it,
+			// the pair is kept so it exits once it is tested again and no longer touches
+			const CollisionBody& body1 = bodies[bodyOfEntity[id1]];
+			const CollisionBody& body2 = bodies[bodyOfEntity[id2]];
+			if (!CanCollide(body1) || !CanCollide(body2) ||
+				!layerManager.ShouldLayerIdsInteract(layerManager.GetEntityLayerId(id1), layerManager.GetEntityLayerId(id2)))
+			{
+				tracked.Touch(id1, id2);
+				continue;
+			}
+
+			if (isTrigger)
+			{
+				event.QueueEvent<TriggerEvent>(id1, id2,
+					Engine::timer.GetAccumulatedTime(), TriggerEvent::EXIT);
+			}
+			else
+			{
+				event.QueueEvent<CollisionEvent>(id1, id2,
+					Engine::timer.GetAccumulatedTime(), CollisionEvent::EXIT);
+			}
+		}
+	}
+
 	void CollisionSystem::Update(Popplio::Registry& registry, float deltaTime)
 	{
-		for (int step = 0; step < Engine::timer.GetCurrentNumberOfSteps(); ++step)
+		Simulate(registry, deltaTime, Engine::timer.GetCurrentNumberOfSteps());
+	}
+
+	void CollisionSystem::Simulate(Popplio::Registry& registry, float deltaTime, int steps)
+	{
+		for (int step = 0; step < steps; ++step)
 		{
-			auto systemEntities = GetSystemEntities();
+			GatherBodies(registry);
 
-			// expensive?
-            //std::vector<std::vector<int>> collisionCount(systemEntities.size());
-            //std::vector<std::vector<int>> triggerCount(systemEntities.size());
+			// Only pairs with overlapping bounds reach the narrow phase
+			BuildProxies(deltaTime);
+			broadPhase->FindPairs(proxies, candidatePairs);
+			pairsTested = candidatePairs.size();
 
-			unsigned int iIndex = 0;
-			for (auto i = systemEntities.begin(); i != systemEntities.end(); ++i)
+			bodyOfEntity.assign(bodyOfEntity.size(), -1);
+			for (int i = 0; i < static_cast<int>(bodies.size()); ++i)
 			{
-				if (i->GetComponent<ActiveComponent>().isActive == false) continue;
-				if (!(i->GetComponent<RigidBodyComponent>().isActive)) continue;
+				const int entityId = bodies[i].entity.GetId();
+				if (entityId >= static_cast<int>(bodyOfEntity.size())) bodyOfEntity.resize(entityId + 1, -1);
+				bodyOfEntity[entityId] = i;
+			}
 
-				collisionCount[iIndex] = 0;
-                triggerCount[iIndex] = 0;
+			collisionCount.assign(bodies.size(), 0);
+			triggerCount.assign(bodies.size(), 0);
 
-				// Get first entity's layer
-				std::string layer1 = layerManager.GetEntityLayer(*i);
+			// Pairs not touched again this step exit contact at the end of the step
+			collisions.BeginStep();
+			triggers.BeginStep();
 
-				auto& transform1 = registry.GetComponent<TransformComponent>(*i);
-				auto& rigidBody1 = registry.GetComponent<RigidBodyComponent>(*i);
+			size_t nextPair = 0;
+			for (size_t i = 0; i < bodies.size(); ++i)
+			{
+				CollisionBody& body1 = bodies[i];
 
-				//checking for box and circle components
-				bool hasBox1 = registry.HasComponent<BoxColliderComponent>(*i);
-				bool hasCircle1 = registry.HasComponent<CircleColliderComponent>(*i);
+				// Candidate pairs are sorted, so the pairs of body i are contiguous
+				const size_t firstPair = nextPair;
+				while (nextPair < candidatePairs.size() && candidatePairs[nextPair].first == static_cast<int>(i)) ++nextPair;
 
-				if (!hasBox1 && !hasCircle1) continue;
+				if (body1.active->isActive == false) continue;
+				if (!(body1.rigidBody->isActive)) continue;
 
-				//if (!(i->GetComponent<BoxColliderComponent>().isActive)) continue;
-				//if (!(i->GetComponent<CircleColliderComponent>().isActive)) continue;
+				// Get first entity's layer
+				const int layer1 = layerManager.GetEntityLayerId(body1.entity.GetId());
 
-    //            bool atLeastOneCollision = false;
-				//bool atLeastOneTrigger = false;
+				//checking for box and circle components
+				if (!body1.box && !body1.circle) continue;
 
-				for (auto j = i + 1; j != systemEntities.end(); ++j)
+				for (size_t pairIndex = firstPair; pairIndex < nextPair; ++pairIndex)
 				{
-					if (j->GetComponent<ActiveComponent>().isActive == false) continue;
-					if (!(j->GetComponent<RigidBodyComponent>().isActive)) continue;
+					const size_t j = static_cast<size_t>(candidatePairs[pairIndex].second);
+
+					CollisionBody& body2 = bodies[j];
+
+					if (body2.active->isActive == false) continue;
+					if (!(body2.rigidBody->isActive)) continue;
 
 					// Get second entity's layer
-					std::string layer2 = layerManager.GetEntityLayer(*j);
+					const int layer2 = layerManager.GetEntityLayerId(body2.entity.GetId());
 
 					// Check if layers should interact
 					// If either entity has no layer, allow collision (default behavior)
 					// Otherwise, check layer interaction matrix
-					if (!layer1.empty() && !layer2.empty() &&
-						!layerManager.ShouldLayersInteract(layer1, layer2))
+					if (!layerManager.ShouldLayerIdsInteract(layer1, layer2))
 					{
 						continue;  // Skip collision check if layers shouldn't interact
 					}
 
-					auto& transform2 = registry.GetComponent<TransformComponent>(*j);
-					auto& rigidBody2 = registry.GetComponent<RigidBodyComponent>(*j);
-
 					//checking for box and circle components
-					bool hasBox2 = registry.HasComponent<BoxColliderComponent>(*j);
-					bool hasCircle2 = registry.HasComponent<CircleColliderComponent>(*j);
+					if (!body2.box && !body2.circle) continue;
 
-					if (!hasBox2 && !hasCircle2) continue;
-
-					//if (!(j->GetComponent<BoxColliderComponent>().isActive)) continue;
-					//if (!(j->GetComponent<CircleColliderComponent>().isActive)) continue;
+					TransformComponent& transform1 = *body1.transform;
+					TransformComponent& transform2 = *body2.transform;
+					RigidBodyComponent& rigidBody1 = *body1.rigidBody;
+					RigidBodyComponent& rigidBody2 = *body2.rigidBody;
 
 					bool collision = false;
 					bool isTrigger1 = false;
@@ -178,14 +327,12 @@ namespace Popplio
 					float firstCollisionTime = 0.0f;
 
 					// Box - Box collision
-					if (hasBox1 && hasBox2) 
+					if (body1.box && body2.box) 
 					{
-						if (!(i->GetComponent<BoxColliderComponent>().isActive)) continue;
-                        if (!(j->GetComponent<BoxColliderComponent>().isActive)) continue;
-
-						auto& box1 = registry.GetComponent<BoxColliderComponent>(*i);
-						auto& box2 = registry.GetComponent<BoxColliderComponent>(*j);
+						auto& box1 = *body1.box;
+						auto& box2 = *body2.box;
 
+						if (!box1.isActive || !box2.isActive) continue;
 						if (!box1.isEnabled || !box2.isEnabled) continue;
 
 						isTrigger1 = box1.isTrigger;
@@ -198,14 +345,12 @@ namespace Popplio
 					}
 
 					// Circle - Circle Collision
-					else if (hasCircle1 && hasCircle2) 
+					else if (body1.circle && body2.circle) 
 					{
-						if (!(i->GetComponent<CircleColliderComponent>().isActive)) continue;
-						if (!(j->GetComponent<CircleColliderComponent>().isActive)) continue;
-
-						auto& circle1 = registry.GetComponent<CircleColliderComponent>(*i);
-						auto& circle2 = registry.GetComponent<CircleColliderComponent>(*j);
+						auto& circle1 = *body1.circle;
+						auto& circle2 = *body2.circle;
 
+						if (!circle1.isActive || !circle2.isActive) continue;
 						if (!circle1.isEnabled || !circle2.isEnabled) continue;
 
 						isTrigger1 = circle1.isTrigger;
@@ -215,14 +360,12 @@ namespace Popplio
 					}
 
 					// Box - Circle Collision
-					else if (hasBox1 && hasCircle2) 
+					else if (body1.box && body2.circle) 
 					{
-						if (!(i->GetComponent<BoxColliderComponent>().isActive)) continue;
-						if (!(j->GetComponent<CircleColliderComponent>().isActive)) continue;
-
-						auto& box = registry.GetComponent<BoxColliderComponent>(*i);
-						auto& circle = registry.GetComponent<CircleColliderComponent>(*j);
+						auto& box = *body1.box;
+						auto& circle = *body2.circle;
 
+						if (!box.isActive || !circle.isActive) continue;
 						if (!box.isEnabled || !circle.isEnabled) continue;
 
 						isTrigger1 = box.isTrigger;
@@ -232,14 +375,12 @@ namespace Popplio
 					}
 
 					//circle - box collision
-					else if (hasCircle1 && hasBox2) 
+					else if (body1.circle && body2.box) 
 					{
-						if (!(i->GetComponent<CircleColliderComponent>().isActive)) continue;
-						if (!(j->GetComponent<BoxColliderComponent>().isActive)) continue;
-
-						auto& circle = registry.GetComponent<CircleColliderComponent>(*i);
-						auto& box = registry.GetComponent<BoxColliderComponent>(*j);
+						auto& circle = *body1.circle;
+						auto& box = *body2.box;
 
+						if (!circle.isActive || !box.isActive) continue;
 						if (!circle.isEnabled || !box.isEnabled) continue;
 
 						isTrigger1 = circle.isTrigger;
@@ -248,183 +389,102 @@ namespace Popplio
 						collision = CheckBoxToCircleCollision(transform2, box, transform1, circle);
 					}
 
+					const int id1 = body1.entity.GetId();
+					const int id2 = body2.entity.GetId();
+
 					//collision is detected
 					if (collision)
 					{
 						if (!isTrigger1 && !isTrigger2) // collision w/o trigger
 						{
-                            collisions.insert(std::make_pair(static_cast<int>(iIndex), static_cast<int>(j - systemEntities.begin())));
-
-                            ++collisionCount[iIndex];
-                            ++collisionCount[static_cast<int>(j - systemEntities.begin())];
-
-							bool isFirstCollision1 = true;
-                            bool isFirstCollision2 = true;
-							if (hasCircle1)
-							{
-								// emit collision event, clients need to differentiate entities
-                                if (i->GetComponent<CircleColliderComponent>().isColliding) isFirstCollision1 = false;
-								i->GetComponent<CircleColliderComponent>().isColliding = true;
-							}
-							else
-							{
-                                if (i->GetComponent<BoxColliderComponent>().isColliding) isFirstCollision1 = false;
-								i->GetComponent<BoxColliderComponent>().isColliding = true;
-							}
-
-							if (hasCircle2)
-							{
-                                if (j->GetComponent<CircleColliderComponent>().isColliding) isFirstCollision2 = false;
-								j->GetComponent<CircleColliderComponent>().isColliding = true;
-							}
-							else
-							{
-                                if (j->GetComponent<BoxColliderComponent>().isColliding) isFirstCollision2 = false;
-								j->GetComponent<BoxColliderComponent>().isColliding = true;
-							}
-
-							Logger::Debug("Collision detected between Entity " + std::to_string(i->GetId()) +
-								" and Entity " + std::to_string(j->GetId()));
-							// emit collision event, clients need to differentiate entities
-                            if (isFirstCollision1 || isFirstCollision2) // first collision if either
-								event.EmitEvent<CollisionEvent>(i->GetId(), j->GetId(), 
+                            const bool wasColliding = collisions.Touch(id1, id2);
+
+                            ++collisionCount[i];
+                            ++collisionCount[j];
+
+							if (body1.circle) body1.circle->isColliding = true;
+							else body1.box->isColliding = true;
+
+							if (body2.circle) body2.circle->isColliding = true;
+							else body2.box->isColliding = true;
+
+							POPPLIO_LOG_DEBUG("Collision detected between Entity " + std::to_string(id1) +
+								" and Entity " + std::to_string(id2));
+							// queue collision event, clients need to differentiate entities
+                            if (!wasColliding) // pair was not in contact last step
+								event.QueueEvent<CollisionEvent>(id1, id2, 
 									Engine::timer.GetAccumulatedTime(), CollisionEvent::ENTER);
-							else event.EmitEvent<CollisionEvent>(i->GetId(), j->GetId(), 
+							else event.QueueEvent<CollisionEvent>(id1, id2, 
 								Engine::timer.GetAccumulatedTime(), CollisionEvent::STAY);
 
-							MovementSystem::HandleCollisionResponse(transform1, rigidBody1,
-								transform2, rigidBody2, isTrigger1, isTrigger2, firstCollisionTime);
-
-                            // skip circle collider for now TODO: implement circle collider
-							//if (hasBox1 && hasBox2)
-							//{
-       //                         BoxColliderComponent& box1 = i->GetComponent<BoxColliderComponent>();
-       //                         BoxColliderComponent& box2 = j->GetComponent<BoxColliderComponent>();
-
-							//	MovementSystem::HandleCollisionResponse(transform1, rigidBody1, box1,
-							//		transform2, rigidBody2, box2, isTrigger1, isTrigger2, firstCollisionTime);
-							//}
-							//else
-							//{
-							//	MovementSystem::HandleCollisionResponse(transform1, rigidBody1, 
-							//		transform2, rigidBody2, isTrigger1, isTrigger2, firstCollisionTime);
-							//}
+							MovementSystem::HandleCollisionResponse(*body1.transform, *body1.rigidBody,
+								*body2.transform, *body2.rigidBody, isTrigger1, isTrigger2, firstCollisionTime);
 						}
 						else // emit trigger event, clients need to differentiate entities
 						{
-							triggers.insert(std::make_pair(static_cast<int>(iIndex), static_cast<int>(j - systemEntities.begin())));
-
-                            ++triggerCount[iIndex];
-                            ++triggerCount[static_cast<int>(j - systemEntities.begin())];
-
-							bool isFirstTrigger1 = true;
-							bool isFirstTrigger2 = true;
-							if (hasCircle1)
-							{
-								if (i->GetComponent<CircleColliderComponent>().isTriggering) isFirstTrigger1 = false;
-								i->GetComponent<CircleColliderComponent>().isTriggering = true;
-							}
-							else
-							{
-								if (i->GetComponent<BoxColliderComponent>().isTriggering) isFirstTrigger1 = false;
-								i->GetComponent<BoxColliderComponent>().isTriggering = true;
-							}
-
-							if (hasCircle2)
-							{
-								if (j->GetComponent<CircleColliderComponent>().isTriggering) isFirstTrigger2 = false;
-								j->GetComponent<CircleColliderComponent>().isTriggering = true;
-							}
-							else
-							{
-								if (j->GetComponent<BoxColliderComponent>().isTriggering) isFirstTrigger2 = false;
-								j->GetComponent<BoxColliderComponent>().isTriggering = true;
-							}
-
-							Logger::Debug("Trigger detected between Entity " + std::to_string(i->GetId()) +
-								" and Entity " + std::to_string(j->GetId()));
-							// emit trigger event, clients need to differentiate entities
-                            if (isFirstTrigger1 || isFirstTrigger2) // first trigger if either
-                                event.EmitEvent<TriggerEvent>(i->GetId(), j->GetId(), 
+							const bool wasTriggering = triggers.Touch(id1, id2);
+
+                            ++triggerCount[i];
+                            ++triggerCount[j];
+
+							if (body1.circle) body1.circle->isTriggering = true;
+							else body1.box->isTriggering = true;
+
+							if (body2.circle) body2.circle->isTriggering = true;
+							else body2.box->isTriggering = true;
+
+							POPPLIO_LOG_DEBUG("Trigger detected between Entity " + std::to_string(id1) +
+								" and Entity " + std::to_string(id2));
+							// queue trigger event, clients need to differentiate entities
+                            if (!wasTriggering) // pair was not in contact last step
+                                event.QueueEvent<TriggerEvent>(id1, id2, 
 									Engine::timer.GetAccumulatedTime(), TriggerEvent::ENTER);
-                            else event.EmitEvent<TriggerEvent>(i->GetId(), j->GetId(), 
+                            else event.QueueEvent<TriggerEvent>(id1, id2, 
 								Engine::timer.GetAccumulatedTime(), TriggerEvent::STAY);
 						}
-						//MovementSystem::HandleCollisionResponse(transform1, rigidBody1, transform2, rigidBody2, isTrigger1, isTrigger2);
-					}
-					else // OnCollisionExit / OnTriggerExit
-					{
-						std::pair<int, int> pair1 = std::make_pair(static_cast<int>(iIndex), static_cast<int>(j - systemEntities.begin()));
-                        std::pair<int, int> pair2 = std::make_pair(
-							static_cast<int>(j - systemEntities.begin()), static_cast<int>(iIndex));
-						if (collisions.contains(pair1) || collisions.contains(pair2))
-						{
-							event.EmitEvent<CollisionEvent>(i->GetId(), j->GetId(), 
-								Engine::timer.GetAccumulatedTime(), CollisionEvent::EXIT);
-                            collisions.erase(pair1);
-                            collisions.erase(pair2);
-						}
-                        if (triggers.contains(pair1) || triggers.contains(pair2))
-                        {
-							event.EmitEvent<TriggerEvent>(i->GetId(), j->GetId(), 
-                                Engine::timer.GetAccumulatedTime(), TriggerEvent::EXIT);
-                            triggers.erase(pair1);
-                            triggers.erase(pair2);
-                        }
 					}
 				}
 
                 // OnCollisionExit / OnTriggerExit
-
-				if (collisionCount[iIndex] <= 0)
+				if (collisionCount[i] <= 0)
 				{
-					if (hasCircle1)
+					if (body1.circle)
 					{
-						if (!i->GetComponent<CircleColliderComponent>().isTrigger && 
-							i->GetComponent<CircleColliderComponent>().isColliding)
+						if (!body1.circle->isTrigger && body1.circle->isColliding)
 						{
-							i->GetComponent<CircleColliderComponent>().isColliding = false;
-                            // emit OnCollisionExit event
-							//event.EmitEvent<CollisionEvent>(i->GetId(), -1, Engine::timer.GetAccumulatedTime(), CollisionEvent::EXIT);
+							body1.circle->isColliding = false;
 						}
 					}
-					else
+					else if (body1.box)
 					{
-						if (!i->GetComponent<BoxColliderComponent>().isTrigger && 
-							i->GetComponent<BoxColliderComponent>().isColliding)
+						if (!body1.box->isTrigger && body1.box->isColliding)
 						{
-                            i->GetComponent<BoxColliderComponent>().isColliding = false;
-                            // emit OnCollisionExit event
-							//event.EmitEvent<CollisionEvent>(i->GetId(), -1, Engine::timer.GetAccumulatedTime(), CollisionEvent::EXIT);
+                            body1.box->isColliding = false;
 						}
 					}
 				}
-				if (triggerCount[iIndex] <= 0)
+				if (triggerCount[i] <= 0)
                 {
-                    if (hasCircle1)
+                    if (body1.circle)
                     {
-                        if (//i->GetComponent<CircleColliderComponent>().isTrigger && 
-							i->GetComponent<CircleColliderComponent>().isTriggering)
+                        if (body1.circle->isTriggering)
                         {
-                            i->GetComponent<CircleColliderComponent>().isTriggering = false;
-                            // emit OnTriggerExit event
-							//event.EmitEvent<TriggerEvent>(i->GetId(), -1, Engine::timer.GetAccumulatedTime(), TriggerEvent::EXIT);
+                            body1.circle->isTriggering = false;
                         }
                     }
-                    else
+                    else if (body1.box)
                     {
-                        if (//i->GetComponent<BoxColliderComponent>().isTrigger && 
-							i->GetComponent<BoxColliderComponent>().isTriggering)
+                        if (body1.box->isTriggering)
                         {
-                            i->GetComponent<BoxColliderComponent>().isTriggering = false;
-                            // emit OnTriggerExit event
-							//event.EmitEvent<TriggerEvent>(i->GetId(), -1, Engine::timer.GetAccumulatedTime(), TriggerEvent::EXIT);
+                            body1.box->isTriggering = false;
                         }
                     }
                 }
-
-				++iIndex;
 			}
+
+			// OnCollisionExit / OnTriggerExit for pairs in contact last step but not this step
+			ExitSeparatedPairs(collisions, false);
+			ExitSeparatedPairs(triggers, true);
 		}
 	}
 }
\ No newline at end of file
@@ -23,29 +23,84 @@ Technology is prohibited.
 #include "../Collision/CircleColliderComponent.h"
 #include "../Transformation/TransformComponent.h"
 #include "../Physics/RigidBodyComponent.h"
+#include "../Script/ActiveComponent.h"
 #include "../Layering/LayerManager.h"
+#include "BroadPhase.h"
+#include "ContactPairTable.h"
 
 #include <iostream>
+#include <functional>
 
 namespace Popplio
 {
     // System
     class CollisionSystem : public System
     {
+        // Components of one collidable entity, gathered once per step
+        // Events are queued, so no handler can move the components before the step ends
+        struct CollisionBody
+        {
+            Entity entity;
+            ActiveComponent* active;
+            TransformComponent* transform;
+            RigidBodyComponent* rigidBody;
+            BoxColliderComponent* box;
+            CircleColliderComponent* circle;
+        };
+
         EventBus& event;
 		LayerManager& layerManager;
 
-        std::unordered_map<int, int> collisionCount{};
-        std::unordered_map<int, int> triggerCount{};
-        std::set<std::pair<int, int>> collisions{};
-        std::set<std::pair<int, int>> triggers{};
+        std::vector<CollisionBody> bodies{};
+        std::vector<int> collisionCount{}; // per body
+        std::vector<int> triggerCount{}; // per body
+        ContactPairTable collisions{}; // entity id pairs in contact
+        ContactPairTable triggers{}; // entity id pairs in contact
+        std::vector<std::uint64_t> exitedPairs{}; // pairs of the table that left contact this step
+
+        // Broad phase
+        std::unique_ptr<BroadPhase> broadPhase;
+        float cellSize;
+        std::vector<BroadPhaseProxy> proxies{}; // bounds of the collidable bodies
+        std::vector<BroadPhasePair> candidatePairs{}; // body index pairs for the narrow phase
+        std::vector<int> bodyOfEntity{}; // entity id -> body index, -1 if not gathered
+        size_t pairsTested = 0; // candidate pairs of the last step
 
     public:
+        static constexpr float DEFAULT_CELL_SIZE = 128.f;
+
         CollisionSystem(EventBus& e, LayerManager& layerMgr);
 
         void Update(Popplio::Registry& registry, float deltaTime);
+
+        // Runs the given number of fixed steps of collision detection and response
+        void Simulate(Popplio::Registry& registry, float deltaTime, int steps);
+
+        // Selects the broad phase (per scene), cellSize is used by the spatial hash
+        void SetBroadPhase(BroadPhaseType type, float cellSize = DEFAULT_CELL_SIZE);
+        BroadPhaseType GetBroadPhaseType() const;
+        float GetCellSize() const;
+
+        // Number of pairs passed to the narrow phase in the last step
+        size_t GetPairsTested() const;
+
+        // Forgets the pairs in contact without exit events, the entity ids are reused by the next scene
+        void ClearContacts();
     private: 
 
+        // Collect every active collidable entity with its component pointers
+        void GatherBodies(Registry& registry);
+
+        // Bounds of every collidable body, swept by its velocity over the step
+        void BuildProxies(float deltaTime);
+
+        // Whether the pair loop tests the body at all
+        static bool CanCollide(const CollisionBody& body);
+
+        // Queues exit events for the pairs of the table not in contact this step
+        // Pairs the pair loop skipped (deactivated or layer filtered) stay in contact without an exit
+        void ExitSeparatedPairs(ContactPairTable& tracked, bool isTrigger);
+
         bool CheckBoxToBoxCollision(
             const TransformComponent& transform1,
             const BoxColliderComponent& box1,
@@ -0,0 +1,133 @@
+/******************************************************************************/
+/*!
+\file   ContactPairTable.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for the collision contact pair table
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "ContactPairTable.h"
+
+#include <utility>
+
+namespace Popplio
+{
+    std::uint64_t ContactPairTable::MakeKey(int id1, int id2)
+    {
+        if (id2 < id1) std::swap(id1, id2);
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(id1)) << 32) | static_cast<std::uint32_t>(id2);
+    }
+
+    ContactPairTable::ContactPairTable()
+        : slots(MIN_CAPACITY, Slot{ 0, 0, EMPTY })
+    {
+    }
+
+    size_t ContactPairTable::SlotOf(std::uint64_t key) const
+    {
+        // Mix both ids into the low bits used by the mask
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        return static_cast<size_t>(key) & (slots.size() - 1);
+    }
+
+    void ContactPairTable::BeginStep()
+    {
+        ++stamp;
+    }
+
+    bool ContactPairTable::Touch(int id1, int id2)
+    {
+        const std::uint64_t key = MakeKey(id1, id2);
+        const size_t mask = slots.size() - 1;
+
+        size_t insertAt = slots.size();
+        for (size_t i = SlotOf(key);; i = (i + 1) & mask)
+        {
+            Slot& slot = slots[i];
+            if (slot.state == EMPTY)
+            {
+                if (insertAt == slots.size()) insertAt = i;
+                break;
+            }
+            if (slot.state == REMOVED)
+            {
+                if (insertAt == slots.size()) insertAt = i;
+            }
+            else if (slot.key == key)
+            {
+                slot.stamp = stamp;
+                return true;
+            }
+        }
+
+        if (slots[insertAt].state == REMOVED) --removed;
+        slots[insertAt] = Slot{ key, stamp, OCCUPIED };
+        ++count;
+
+        // Keep the load (tombstones included) at most half so probe sequences stay short
+        if ((count + removed) * 2 > slots.size())
+        {
+            Rehash(count * 4 > slots.size() ? slots.size() * 2 : slots.size());
+        }
+        return false;
+    }
+
+    void ContactPairTable::EndStep(std::vector<std::uint64_t>& exited)
+    {
+        exited.clear();
+        for (Slot& slot : slots)
+        {
+            if (slot.state == OCCUPIED && slot.stamp != stamp)
+            {
+                exited.push_back(slot.key);
+                slot.state = REMOVED;
+                --count;
+                ++removed;
+            }
+        }
+
+        if (removed * 4 > slots.size())
+        {
+            Rehash(slots.size());
+        }
+    }
+
+    void ContactPairTable::Clear()
+    {
+        slots.assign(MIN_CAPACITY, Slot{ 0, 0, EMPTY });
+        count = 0;
+        removed = 0;
+    }
+
+    void ContactPairTable::Rehash(size_t capacity)
+    {
+        std::vector<Slot> old(capacity, Slot{ 0, 0, EMPTY });
+        old.swap(slots);
+        removed = 0;
+
+        const size_t mask = slots.size() - 1;
+        for (const Slot& slot : old)
+        {
+            if (slot.state != OCCUPIED) continue;
+
+            size_t i = SlotOf(slot.key);
+            while (slots[i].state != EMPTY) i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+}
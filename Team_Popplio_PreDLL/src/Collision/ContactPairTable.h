@@ -0,0 +1,109 @@
+/******************************************************************************/
+/*!
+\file   ContactPairTable.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for the collision contact pair table
+
+        The table remembers which pairs of entities were in contact in the
+        previous step, keyed by both entity ids packed into 64 bits
+        It is a flat open addressing hash table with a frame stamp per pair, so
+        ENTER / STAY come from one lookup and EXIT from one pass over the table
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Popplio
+{
+    /**
+    * @brief Pairs of entities in contact, tracked across collision steps.
+    */
+    class ContactPairTable
+    {
+    public:
+        /**
+        * @brief Packs a pair of entity ids into a key, the smaller id in the high bits.
+        */
+        static std::uint64_t MakeKey(int id1, int id2);
+
+        /**
+        * @brief Gets the smaller entity id of a key.
+        */
+        static int FirstId(std::uint64_t key) { return static_cast<int>(key >> 32); }
+
+        /**
+        * @brief Gets the larger entity id of a key.
+        */
+        static int SecondId(std::uint64_t key) { return static_cast<int>(key & 0xFFFFFFFFu); }
+
+        ContactPairTable();
+
+        /**
+        * @brief Starts a new step, pairs must be touched again to stay in contact.
+        */
+        void BeginStep();
+
+        /**
+        * @brief Records that a pair is in contact this step.
+        *
+        * @return true if the pair was already in contact last step (STAY), false if it is new (ENTER).
+        */
+        bool Touch(int id1, int id2);
+
+        /**
+        * @brief Removes every pair not touched this step.
+        *
+        * @param exited Filled with the keys of the removed pairs (EXIT).
+        */
+        void EndStep(std::vector<std::uint64_t>& exited);
+
+        /**
+        * @brief Gets the number of pairs in contact.
+        */
+        size_t Size() const { return count; }
+
+        /**
+        * @brief Removes every pair without reporting them.
+        */
+        void Clear();
+
+    private:
+        enum SlotState : std::uint8_t
+        {
+            EMPTY,
+            OCCUPIED,
+            REMOVED /**< Tombstone, keeps probe sequences through it intact. */
+        };
+
+        struct Slot
+        {
+            std::uint64_t key;
+            std::uint32_t stamp; /**< Step in which the pair was last touched. */
+            SlotState state;
+        };
+
+        static constexpr size_t MIN_CAPACITY = 64; /**< Power of two. */
+
+        std::vector<Slot> slots;
+        size_t count = 0; /**< Occupied slots. */
+        size_t removed = 0; /**< Tombstones. */
+        std::uint32_t stamp = 0; /**< Current step. */
+
+        size_t SlotOf(std::uint64_t key) const;
+        void Rehash(size_t capacity);
+    };
+}
@@ -0,0 +1,264 @@
+/******************************************************************************/
+/*!
+\file   Archetype.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for the archetype component storage of the
+        Entity Component System of the engine
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#include <pch.h>
+
+#include "Archetype.h"
+
+namespace Popplio
+{
+    namespace
+    {
+        size_t AlignUp(size_t value, size_t align)
+        {
+            return (value + align - 1) / align * align;
+        }
+    }
+
+    // Archetype
+
+    Archetype::Archetype(Signature const& sig, std::vector<ComponentTypeInfo> const& typeInfos)
+        : signature(sig), columnOfComponent(MAX_COMPONENTS, -1), chunkCapacity(1), chunkBytes(0)
+    {
+        size_t rowBytes = 0;
+        for (int id = 0; id < static_cast<int>(MAX_COMPONENTS); ++id)
+        {
+            if (!signature.test(id)) continue;
+
+            columnOfComponent[id] = static_cast<int>(columns.size());
+            columns.push_back({ id, 0, typeInfos[id] });
+            rowBytes += typeInfos[id].size;
+        }
+
+        // Fit as many rows as possible into one chunk, leaving room for column alignment padding
+        if (rowBytes > 0)
+        {
+            size_t padding = 0;
+            for (Column const& column : columns) padding += column.info.align;
+            if (CHUNK_BYTES > padding + rowBytes)
+            {
+                chunkCapacity = static_cast<int>((CHUNK_BYTES - padding) / rowBytes);
+            }
+        }
+
+        // Lay out the columns one after another within a chunk
+        size_t offset = 0;
+        for (Column& column : columns)
+        {
+            offset = AlignUp(offset, column.info.align);
+            column.offset = offset;
+            offset += column.info.size * chunkCapacity;
+        }
+        chunkBytes = AlignUp(offset, alignof(std::max_align_t));
+    }
+
+    Archetype::~Archetype()
+    {
+        for (int row = 0; row < Size(); ++row)
+        {
+            for (int column = 0; column < static_cast<int>(columns.size()); ++column)
+            {
+                columns[column].info.destroy(GetComponent(column, row));
+            }
+        }
+    }
+
+    void* Archetype::GetComponent(int column, int row) const
+    {
+        Column const& col = columns[column];
+        return chunks[row / chunkCapacity].get() + col.offset + col.info.size * (row % chunkCapacity);
+    }
+
+    int Archetype::AllocateRow(int entityId)
+    {
+        const int row = Size();
+        if (row / chunkCapacity >= ChunkCount())
+        {
+            // operator new[] aligns to at least alignof(std::max_align_t)
+            chunks.emplace_back(new std::byte[chunkBytes == 0 ? 1 : chunkBytes]);
+        }
+        entityIds.push_back(entityId);
+        return row;
+    }
+
+    int Archetype::RemoveRow(int row)
+    {
+        const int last = Size() - 1;
+        for (int column = 0; column < static_cast<int>(columns.size()); ++column)
+        {
+            ComponentTypeInfo const& info = columns[column].info;
+            void* removed = GetComponent(column, row);
+            info.destroy(removed);
+            if (row != last)
+            {
+                void* moved = GetComponent(column, last);
+                info.moveConstruct(removed, moved);
+                info.destroy(moved);
+            }
+        }
+
+        int movedEntityId = -1;
+        if (row != last)
+        {
+            movedEntityId = entityIds[last];
+            entityIds[row] = movedEntityId;
+        }
+        entityIds.pop_back();
+        return movedEntityId;
+    }
+
+    void Archetype::DiscardLastRow(int constructedColumns)
+    {
+        const int last = Size() - 1;
+        for (int column = 0; column < constructedColumns; ++column)
+        {
+            columns[column].info.destroy(GetComponent(column, last));
+        }
+        entityIds.pop_back();
+    }
+
+    // ArchetypeStorage
+
+    void ArchetypeStorage::Remove(int entityId, int componentId)
+    {
+        if (Get(entityId, componentId) == nullptr) return;
+
+        Signature newSignature = GetSignature(entityId);
+        newSignature.reset(componentId);
+
+        if (newSignature.none())
+        {
+            RemoveEntity(entityId);
+            return;
+        }
+        MoveEntity(entityId, newSignature);
+    }
+
+    void ArchetypeStorage::RemoveEntity(int entityId)
+    {
+        if (entityId < 0 || entityId >= static_cast<int>(locations.size())) return;
+
+        EntityLocation& location = locations[entityId];
+        if (location.archetype == nullptr) return;
+
+        RemoveRow(location);
+        location = EntityLocation{};
+    }
+
+    void* ArchetypeStorage::Get(int entityId, int componentId) const
+    {
+        if (entityId < 0 || entityId >= static_cast<int>(locations.size())) return nullptr;
+
+        EntityLocation const& location = locations[entityId];
+        if (location.archetype == nullptr) return nullptr;
+
+        const int column = location.archetype->ColumnOf(componentId);
+        if (column < 0) return nullptr;
+
+        return location.archetype->GetComponent(column, location.row);
+    }
+
+    std::vector<Archetype*> ArchetypeStorage::GetMatchingArchetypes(Signature const& required) const
+    {
+        std::vector<Archetype*> matches;
+        for (Archetype* archetype : archetypeList)
+        {
+            if (archetype->GetSignature().Contains(required)) matches.push_back(archetype);
+        }
+        return matches;
+    }
+
+    void ArchetypeStorage::Clear()
+    {
+        archetypeList.clear();
+        archetypes.clear();
+        locations.clear();
+    }
+
+    Signature ArchetypeStorage::GetSignature(int entityId) const
+    {
+        if (entityId < 0 || entityId >= static_cast<int>(locations.size()) ||
+            locations[entityId].archetype == nullptr)
+        {
+            return Signature{};
+        }
+        return locations[entityId].archetype->GetSignature();
+    }
+
+    Archetype* ArchetypeStorage::GetOrCreateArchetype(Signature const& signature)
+    {
+        auto it = archetypes.find(signature);
+        if (it != archetypes.end()) return it->second.get();
+
+        auto archetype = std::make_unique<Archetype>(signature, typeInfos);
+        Archetype* ptr = archetype.get();
+        archetypes.emplace(signature, std::move(archetype));
+        archetypeList.push_back(ptr);
+        return ptr;
+    }
+
+    ArchetypeStorage::EntityLocation const& ArchetypeStorage::MoveEntity(int entityId, Signature const& newSignature,
+        int addedId, void* added)
+    {
+        if (entityId >= static_cast<int>(locations.size()))
+        {
+            locations.resize(entityId + 1);
+        }
+
+        Archetype* target = GetOrCreateArchetype(newSignature);
+        EntityLocation& location = locations[entityId];
+        Archetype* source = location.archetype;
+        const int newRow = target->AllocateRow(entityId);
+
+        // Fill every column of the new row, the source components not moved are destroyed by RemoveRow
+        int column = 0;
+        try
+        {
+            for (; column < target->ColumnCount(); ++column)
+            {
+                const int id = target->ComponentOfColumn(column);
+                void* from = id == addedId ? added : source->GetComponent(source->ColumnOf(id), location.row);
+                typeInfos[id].moveConstruct(target->GetComponent(column, newRow), from);
+            }
+        }
+        catch (...)
+        {
+            target->DiscardLastRow(column);
+            throw;
+        }
+
+        if (source != nullptr)
+        {
+            RemoveRow(location);
+        }
+
+        location.archetype = target;
+        location.row = newRow;
+        return location;
+    }
+
+    void ArchetypeStorage::RemoveRow(EntityLocation& location)
+    {
+        const int movedEntityId = location.archetype->RemoveRow(location.row);
+        if (movedEntityId >= 0)
+        {
+            locations[movedEntityId].row = location.row;
+        }
+    }
+}
@@ -0,0 +1,341 @@
+/******************************************************************************/
+/*!
+\file   Archetype.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for the archetype component storage of the
+        Entity Component System of the engine
+
+        Entities with an identical signature are stored together in fixed-size
+        chunks, one packed array per component type (structure of arrays)
+        Entities move between archetypes when components are added / removed
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Signature.h"
+
+namespace Popplio
+{
+    /**
+    * @brief Type-erased operations of a component type, used to move components between archetypes.
+    */
+    struct ComponentTypeInfo
+    {
+        size_t size = 0; /**< sizeof the component, 0 if the type is not registered. */
+        size_t align = 0; /**< alignof the component. */
+        void (*moveConstruct)(void* dst, void* src) = nullptr; /**< Move-constructs dst from src. */
+        void (*destroy)(void* obj) = nullptr; /**< Calls the destructor of obj. */
+
+        /**
+        * @brief Gets the type info of component type T.
+        *
+        * @tparam T The component type.
+        * @return ComponentTypeInfo The type info of T.
+        */
+        template <typename T>
+        static ComponentTypeInfo Of()
+        {
+            ComponentTypeInfo info{};
+            info.size = sizeof(T);
+            info.align = alignof(T);
+            info.moveConstruct = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); };
+            info.destroy = [](void* obj) { static_cast<T*>(obj)->~T(); };
+            return info;
+        }
+    };
+
+    /**
+    * @brief Storage for all entities sharing one signature.
+    *
+    * Rows are packed: row r lives in chunk r / ChunkCapacity() at index r % ChunkCapacity().
+    * Each chunk holds one contiguous array per component type (a column).
+    */
+    class Archetype
+    {
+    public:
+        static const size_t CHUNK_BYTES = 16 * 1024; /**< Target size of one chunk. */
+
+        /**
+        * @brief Constructs an archetype for the given signature.
+        *
+        * @param signature The component signature of the archetype.
+        * @param typeInfos The type infos of all component types, indexed by component id.
+        */
+        Archetype(Signature const& signature, std::vector<ComponentTypeInfo> const& typeInfos);
+
+        ~Archetype();
+
+        Archetype(Archetype const&) = delete;
+        Archetype& operator=(Archetype const&) = delete;
+
+        /**
+        * @brief Gets the signature of the archetype.
+        */
+        Signature const& GetSignature() const { return signature; }
+
+        /**
+        * @brief Gets the number of entities in the archetype.
+        */
+        int Size() const { return static_cast<int>(entityIds.size()); }
+
+        /**
+        * @brief Gets the number of rows that fit in one chunk.
+        */
+        int ChunkCapacity() const { return chunkCapacity; }
+
+        /**
+        * @brief Gets the number of allocated chunks (some may be empty).
+        */
+        int ChunkCount() const { return static_cast<int>(chunks.size()); }
+
+        /**
+        * @brief Gets the number of used rows in the given chunk.
+        */
+        int ChunkSize(int chunk) const
+        {
+            const int used = Size() - chunk * chunkCapacity;
+            return used <= 0 ? 0 : (used < chunkCapacity ? used : chunkCapacity);
+        }
+
+        /**
+        * @brief Gets the column index of the component, or -1 if the archetype does not contain it.
+        */
+        int ColumnOf(int componentId) const { return columnOfComponent[componentId]; }
+
+        /**
+        * @brief Gets the number of columns (component types) of the archetype.
+        */
+        int ColumnCount() const { return static_cast<int>(columns.size()); }
+
+        /**
+        * @brief Gets the component id stored in a column.
+        */
+        int ComponentOfColumn(int column) const { return columns[column].componentId; }
+
+        /**
+        * @brief Gets the packed array of a column within a chunk.
+        *
+        * @tparam T The component type of the column.
+        * @param chunk The chunk index.
+        * @param column The column index (see ColumnOf).
+        * @return T* The first component of the column in the chunk.
+        */
+        template <typename T>
+        T* ColumnData(int chunk, int column) const
+        {
+            return std::launder(reinterpret_cast<T*>(chunks[chunk].get() + columns[column].offset));
+        }
+
+        /**
+        * @brief Gets the entity ids of the rows in a chunk.
+        */
+        int const* ChunkEntityIds(int chunk) const { return entityIds.data() + chunk * chunkCapacity; }
+
+        /**
+        * @brief Gets the entity id of a row.
+        */
+        int GetEntityId(int row) const { return entityIds[row]; }
+
+        /**
+        * @brief Gets the address of a component of a row.
+        *
+        * @param column The column index (see ColumnOf).
+        * @param row The row index.
+        * @return void* The address of the component.
+        */
+        void* GetComponent(int column, int row) const;
+
+        /**
+        * @brief Appends a row for the entity. The components of the row are left unconstructed.
+        *
+        * @param entityId The id of the entity.
+        * @return int The new row.
+        */
+        int AllocateRow(int entityId);
+
+        /**
+        * @brief Destroys the components of a row and moves the last row into it to keep the rows packed.
+        *
+        * @param row The row to remove.
+        * @return int The id of the entity moved into row, or -1 if the last row was removed.
+        */
+        int RemoveRow(int row);
+
+        /**
+        * @brief Removes the last row when filling it failed part way.
+        *
+        * @param constructedColumns The number of leading columns of the row that were constructed.
+        */
+        void DiscardLastRow(int constructedColumns);
+
+    private:
+        struct Column
+        {
+            int componentId;
+            size_t offset; /**< Byte offset of the column from the start of a chunk. */
+            ComponentTypeInfo info;
+        };
+
+        Signature signature;
+        std::vector<Column> columns;
+        std::vector<int> columnOfComponent; /**< Component id -> column index, -1 if absent. */
+        int chunkCapacity;
+        size_t chunkBytes;
+
+        std::vector<std::unique_ptr<std::byte[]>> chunks; /**< Never shrinks, chunks are reused. */
+        std::vector<int> entityIds; /**< Row -> entity id. */
+    };
+
+    /**
+    * @brief Owns every archetype and tracks the archetype / row of each entity.
+    */
+    class ArchetypeStorage
+    {
+    public:
+        /**
+        * @brief Registers the type info of component type T if not done yet.
+        *
+        * @tparam T The component type.
+        * @param componentId The id of the component type.
+        */
+        template <typename T>
+        void RegisterType(int componentId)
+        {
+            if (typeInfos[componentId].size == 0)
+            {
+                typeInfos[componentId] = ComponentTypeInfo::Of<T>();
+            }
+        }
+
+        /**
+        * @brief Adds or replaces the component of type T of an entity.
+        *
+        * Adding moves the entity into the archetype of its new signature, which invalidates references
+        * to its components and to the components of the entity moved into its old row.
+        * The component is constructed before the move, so args may refer to the entity's components,
+        * and the entity is left untouched if the constructor throws.
+        *
+        * @tparam T The component type.
+        * @tparam TArgs The types of the arguments to forward to the component's constructor.
+        * @param entityId The id of the entity.
+        * @param componentId The id of the component type.
+        * @param args The arguments to forward to the component's constructor.
+        * @return T& The reference to the component.
+        */
+        template <typename T, typename ...TArgs>
+        T& Set(int entityId, int componentId, TArgs&& ...args)
+        {
+            if (T* existing = Get<T>(entityId, componentId))
+            {
+                // If the element already exists, simply replace the component object
+                *existing = T(std::forward<TArgs>(args)...);
+                return *existing;
+            }
+
+            RegisterType<T>(componentId);
+
+            T component(std::forward<TArgs>(args)...);
+
+            Signature newSignature = GetSignature(entityId);
+            newSignature.set(componentId);
+            EntityLocation const& location = MoveEntity(entityId, newSignature, componentId, &component);
+
+            return *std::launder(static_cast<T*>(
+                location.archetype->GetComponent(location.archetype->ColumnOf(componentId), location.row)));
+        }
+
+        /**
+        * @brief Removes a component from an entity, moving the entity to the archetype of its new signature.
+        *
+        * References to the entity's components and to the components of the entity moved into its
+        * old row are invalidated.
+        *
+        * @param entityId The id of the entity.
+        * @param componentId The id of the component type.
+        */
+        void Remove(int entityId, int componentId);
+
+        /**
+        * @brief Removes all components of an entity.
+        *
+        * @param entityId The id of the entity.
+        */
+        void RemoveEntity(int entityId);
+
+        /**
+        * @brief Gets the address of a component of an entity.
+        *
+        * @param entityId The id of the entity.
+        * @param componentId The id of the component type.
+        * @return void* The component, or nullptr if the entity does not have it.
+        */
+        void* Get(int entityId, int componentId) const;
+
+        template <typename T>
+        T* Get(int entityId, int componentId) const
+        {
+            return std::launder(static_cast<T*>(Get(entityId, componentId)));
+        }
+
+        /**
+        * @brief Gets every archetype whose signature contains all components of the given signature.
+        *
+        * @param required The required components.
+        * @return std::vector<Archetype*> The matching archetypes.
+        */
+        std::vector<Archetype*> GetMatchingArchetypes(Signature const& required) const;
+
+        /**
+        * @brief Gets the number of archetypes created so far.
+        */
+        size_t GetArchetypeCount() const { return archetypeList.size(); }
+
+        /**
+        * @brief Destroys every component and archetype.
+        */
+        void Clear();
+
+    private:
+        struct EntityLocation
+        {
+            Archetype* archetype = nullptr;
+            int row = -1;
+        };
+
+        Signature GetSignature(int entityId) const;
+
+        Archetype* GetOrCreateArchetype(Signature const& signature);
+
+        // Moves the entity's components into the archetype of newSignature, returns its new location
+        // The component addedId is move-constructed from added instead of the entity's current row
+        // If a move throws, the new row is discarded and the entity stays in its current row
+        EntityLocation const& MoveEntity(int entityId, Signature const& newSignature, int addedId = -1, void* added = nullptr);
+
+        // Removes the row of the entity from its archetype and fixes the location of the moved entity
+        void RemoveRow(EntityLocation& location);
+
+        std::vector<ComponentTypeInfo> typeInfos = std::vector<ComponentTypeInfo>(MAX_COMPONENTS);
+        std::unordered_map<Signature, std::unique_ptr<Archetype>> archetypes;
+        std::vector<Archetype*> archetypeList; /**< Archetypes in creation order. */
+        std::vector<EntityLocation> locations; /**< Entity id -> location. */
+    };
+}
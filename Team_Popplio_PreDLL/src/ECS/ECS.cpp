@@ -19,6 +19,8 @@ Technology is prohibited.
 /******************************************************************************/
 #include <pch.h>
 
+#include <bit>
+
 #ifndef IMGUI_DISABLE
 #include "../Editor/Editor.h"
 #endif
@@ -38,7 +40,8 @@ namespace Popplio
 
     bool Entity::Exists() const
     {
-        return registry->EntityExists(id);
+        if (generation == ANY_GENERATION) return registry->EntityExists(id);
+        return registry->IsAlive(MakeEntityHandle(id, generation));
     }
 
     int Entity::GetId() const
@@ -46,6 +49,21 @@ namespace Popplio
         return id;
     }
 
+    std::uint32_t Entity::GetGeneration() const
+    {
+        return generation;
+    }
+
+    EntityHandle Entity::GetHandle() const
+    {
+        if (id < 0) return INVALID_ENTITY_HANDLE;
+        if (generation == ANY_GENERATION)
+        {
+            return MakeEntityHandle(id, registry ? registry->GetEntityGeneration(id) : 0);
+        }
+        return MakeEntityHandle(id, generation);
+    }
+
     void Entity::Kill()
     {
         registry->KillEntity(*this);
@@ -93,26 +111,51 @@ namespace Popplio
     {
         if (!HasEntity(entity))
         {
-            entities.push_back(entity);
+            const auto entityId = static_cast<size_t>(entity.GetId());
+            if (entityId >= indices.size())
+            {
+                indices.resize(entityId + 1, -1);
+            }
+            std::vector<Entity>& dense = MutableEntities();
+            indices[entityId] = static_cast<int>(dense.size());
+            dense.push_back(entity);
         }
     }
 
     void System::RemoveEntityFromSystem(Entity entity)
     {
-        entities.erase(std::remove_if(entities.begin(), entities.end(), [&entity](Entity other)
-        {
-            return entity == other;
-        }), entities.end());
+        if (!HasEntity(entity)) return;
+
+        // Move the last entity into the removed slot to keep the array packed
+        std::vector<Entity>& dense = MutableEntities();
+        const int index = indices[entity.GetId()];
+        const Entity last = dense.back();
+        dense[index] = last;
+        indices[last.GetId()] = index;
+
+        dense.pop_back();
+        indices[entity.GetId()] = -1;
     }
 
     bool System::HasEntity(Entity entity) const
 	{
-		return std::find(entities.begin(), entities.end(), entity) != entities.end();
+        const auto entityId = entity.GetId();
+		return entityId >= 0 && static_cast<size_t>(entityId) < indices.size() && indices[entityId] >= 0;
 	}
 
-    std::vector<Entity> System::GetSystemEntities() const
+    SystemEntities System::GetSystemEntities() const
     {
-        return entities;
+        return SystemEntities(entities);
+    }
+
+    std::vector<Entity>& System::MutableEntities()
+    {
+        // A snapshot is iterating the array, leave it to the snapshot and change a copy
+        if (entities.use_count() > 1)
+        {
+            entities = std::make_shared<std::vector<Entity>>(*entities);
+        }
+        return *entities;
     }
 
     const Signature& System::GetComponentSignature() const
@@ -120,6 +163,11 @@ namespace Popplio
         return componentSignature;
     }
 
+    const Signature& System::GetWatchedSignature() const
+    {
+        return watchedSignature;
+    }
+
     const std::vector<Entity>& Registry::GetAllEntities() const
 	{
 		return entities;
@@ -203,7 +251,7 @@ namespace Popplio
                 {
                     entityComponentSignatures.resize(entityId + 1);
                 }
-                Logger::Debug("Created entity with ID: " + std::to_string(entityId));
+                POPPLIO_LOG_DEBUG("Created entity with ID: " + std::to_string(entityId));
             }
             else
             {
@@ -229,10 +277,16 @@ namespace Popplio
             return Entity(-1);
         }
 
-        Entity entity(entityId);
+        if (entityId >= entityGenerations.size())
+        {
+            entityGenerations.resize(entityId + 1, 0);
+        }
+
+        Entity entity(entityId, entityGenerations[entityId]);
         clonedFromIds[entityId] = original;
         entity.registry = this;
-        entitiesToBeAdded.insert(entity);
+        PendingFlags(entityId) |= PENDING_CREATE;
+        entitiesToBeAdded.push_back(entity);
 
         // Add ActiveComponent by default
         entity.AddComponent<ActiveComponent>();
@@ -264,7 +318,7 @@ namespace Popplio
         }
     }
 
-    std::set<Entity>& Registry::KillEntitySecondPass(Entity entity, std::set<Entity>& killedEntities)
+    void Registry::KillEntitySecondPass(Entity entity, std::vector<Entity>& killedEntities)
     {
         // Remove from parent's children list if this entity is a child
         if (entity.HasComponent<ParentComponent>())
@@ -280,49 +334,39 @@ namespace Popplio
             }
 
             // Then handle destroying children
-            //std::vector<Entity>& childrenToDestroy = parentComp.children;
-            //for (auto& child : childrenToDestroy)
-            std::set<Entity> temp{};
             for (auto child : parentComp.children)
             {
-                //std::set<Entity> temp = killedEntities;
-                temp = KillEntitySecondPass(child, killedEntities);
-
-                //killedEntities.insert(temp.begin(), temp.end());
-            }
-
-            for (Entity e : temp)
-            {
-                killedEntities.insert(e);
+                KillEntitySecondPass(child, killedEntities);
             }
         }
-        killedEntities.insert(entity);
-        return killedEntities;
+        killedEntities.push_back(entity);
     }
 
     void Registry::KillEntityRuntime(Entity entity)
     {
         KillEntityFirstPass(entity);
 
-        std::set<Entity> killedEntities{};
+        std::vector<Entity> killedEntities{};
 
         KillEntitySecondPass(entity, killedEntities);
 
-        //killedEntities.insert(entity);
-
         for (Entity e : killedEntities)
         {
-            Logger::Debug("Entity queued for deletion. ID: " + std::to_string(entity.GetId()));
-            entitiesToBeKilled.insert(e);
+            KillEntity(e);
         }
     }
 
     void Registry::KillEntity(Entity entity)
     {
-        //std::set<Entity> temp = KillEntityRuntime(entity);
+        if (entity.GetId() < 0) return;
+
+        // Already queued
+        std::uint8_t& flags = PendingFlags(entity.GetId());
+        if (flags & PENDING_KILL) return;
 
-        Logger::Debug("Entity queued for deletion. ID: " + std::to_string(entity.GetId()));
-        entitiesToBeKilled.insert(entity);
+        POPPLIO_LOG_DEBUG("Entity queued for deletion. ID: " + std::to_string(entity.GetId()));
+        flags |= PENDING_KILL;
+        entitiesToBeKilled.push_back(entity);
     }
 
     void Registry::KillAllEntities()
@@ -346,7 +390,28 @@ namespace Popplio
             return Entity(-1);
             //throw std::runtime_error("Attempted to get non-existent entity.");
         }
-        Entity entity(entityId);
+        Entity entity(entityId, GetEntityGeneration(entityId));
+        entity.registry = this;
+        return entity;
+    }
+
+    bool Registry::IsAlive(EntityHandle handle) const
+    {
+        const int entityId = GetHandleId(handle);
+        return EntityExists(entityId) && GetEntityGeneration(entityId) == GetHandleGeneration(handle);
+    }
+
+    std::uint32_t Registry::GetEntityGeneration(int entityId) const
+    {
+        if (entityId < 0 || entityId >= entityGenerations.size()) return 0;
+        return entityGenerations[entityId];
+    }
+
+    Entity Registry::GetEntityByHandle(EntityHandle handle)
+    {
+        if (!IsAlive(handle)) return Entity(-1);
+
+        Entity entity(GetHandleId(handle), GetHandleGeneration(handle));
         entity.registry = this;
         return entity;
     }
@@ -361,7 +426,7 @@ namespace Popplio
         {
             const auto& systemComponentSignature = system.second->GetComponentSignature();
 
-            bool isInterested = (entityComponentSignature & systemComponentSignature) == systemComponentSignature;
+            bool isInterested = entityComponentSignature.Contains(systemComponentSignature);
 
             // Add entity to system if entityComponentSignature matches systemConponentSignature
             if (isInterested)
@@ -489,44 +554,217 @@ namespace Popplio
 
     void Registry::Update()
     {
+        // Apply deferred component changes before new entities join their systems
+        ApplyComponentCommands();
+        ProcessPendingEntities();
+    }
+
+    void Registry::ProcessPendingEntities()
+    {
+        auto byId = [](Entity const& lhs, Entity const& rhs) { return lhs.GetId() < rhs.GetId(); };
+
         // Process the entities that are waiting to be created to the active Systems
-        for (const auto& entity : entitiesToBeAdded)
+        // The queues are taken so that entities queued by callbacks are handled by the nested update
+        if (!entitiesToBeAdded.empty())
         {
-            AddEntityToSystems(entity);
-            OnEntityCreate(entity);
+            std::vector<Entity> added{};
+            added.swap(entitiesToBeAdded);
+            std::sort(added.begin(), added.end(), byId);
+
+            for (const auto& entity : added)
+            {
+                PendingFlags(entity.GetId()) &= ~PENDING_CREATE;
+            }
+            for (const auto& entity : added)
+            {
+                AddEntityToSystems(entity);
+                OnEntityCreate(entity);
+                ++frameStats.entitiesCreated;
+            }
         }
-        entitiesToBeAdded.clear();
+
+        if (entitiesToBeKilled.empty()) return;
+
+        std::vector<Entity> killed{};
+        killed.swap(entitiesToBeKilled);
+        std::sort(killed.begin(), killed.end(), byId);
 
         // Process the entities that are waiting to be killed to the active Systems
-        for (const auto& entity : entitiesToBeKilled)
+        size_t killedCount = 0;
+        for (const auto& entity : killed)
         {
+            PendingFlags(entity.GetId()) &= ~PENDING_KILL;
+
             if (!entity.Exists()) continue;
             //OnEntityDestroy(entity);
             RemoveEntityFromSystems(entity);
             entityComponentSignatures[entity.GetId()].reset();
 
             // Remove the entity from component pools
-            for (auto pool : componentPools)
+            for (auto& pool : componentPools)
             {
                 if (pool)
                 {
                     pool->RemoveEntityFromPool(entity.GetId());
                 }
             }
+            archetypeStorage.RemoveEntity(entity.GetId());
+            ++componentVersion;
 
-            // Make the entity id available to be reused
-            freeIds.push_back(entity.GetId());
+            // Invalidate handles to this entity
+            ++entityGenerations[entity.GetId()];
 
             // Remove any traces of that entity from the tag/group maps
             RemoveEntityTag(entity);
             RemoveEntityGroup(entity);
 
-            // Remove the entity from the entities vector
-            entities.erase(std::remove_if(entities.begin(), entities.end(),
-                [&entity](const Entity& e) { return e.GetId() == entity.GetId(); }),
-                entities.end());
+            pendingFlags[entity.GetId()] |= KILLED;
+            killed[killedCount++] = entity;
+            ++frameStats.entitiesDestroyed;
+        }
+        killed.erase(killed.begin() + killedCount, killed.end());
+
+        // Remove the killed entities from the entities vector in a single pass
+        entities.erase(std::remove_if(entities.begin(), entities.end(),
+            [this](const Entity& e) { return e.GetId() < static_cast<int>(pendingFlags.size()) && (pendingFlags[e.GetId()] & KILLED); }),
+            entities.end());
+
+        // Make the entity ids available to be reused
+        for (const auto& entity : killed)
+        {
+            pendingFlags[entity.GetId()] &= ~KILLED;
+            freeIds.push_back(entity.GetId());
+        }
+    }
+
+    std::uint8_t& Registry::PendingFlags(int entityId)
+    {
+        if (entityId >= static_cast<int>(pendingFlags.size()))
+        {
+            pendingFlags.resize(entityId + 1, 0);
+        }
+        return pendingFlags[entityId];
+    }
+
+    void Registry::RemoveComponentData(int entityId, int componentId)
+    {
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            archetypeStorage.Remove(entityId, componentId);
+        }
+        else
+        {
+            // Remove the component from the component pool for that entity
+            componentPools[componentId]->RemoveEntityFromPool(entityId);
+        }
+        ++componentVersion;
+        ++frameStats.componentsRemoved;
+
+        // Set the component signature for that entity to false
+        entityComponentSignatures[entityId].set(componentId, false);
+    }
+
+    void Registry::ReconcileSystems(Entity entity, const Signature& before, const Signature& after)
+    {
+        // Only the systems requiring or watching a changed component can gain or lose the entity
+        touchedSystems.clear();
+        const Signature changed = before ^ after;
+        for (unsigned int word = 0; word < Signature::WORD_COUNT; ++word)
+        {
+            for (std::uint64_t bits = changed.GetWord(word); bits; bits &= bits - 1)
+            {
+                const int componentId = static_cast<int>(word * Signature::WORD_BITS) + std::countr_zero(bits);
+                for (System* system : systemsPerComponent[componentId])
+                {
+                    if (std::find(touchedSystems.begin(), touchedSystems.end(), system) == touchedSystems.end())
+                    {
+                        touchedSystems.push_back(system);
+                    }
+                }
+            }
+        }
+
+        for (System* system : touchedSystems)
+        {
+            bool isInterested = after.Contains(system->GetComponentSignature());
+            bool alreadyTracking = system->HasEntity(entity);
+
+            if (isInterested && !alreadyTracking)
+            {
+                system->AddEntityToSystem(entity);
+            }
+            else if (!isInterested && alreadyTracking)
+            {
+                system->RemoveEntityFromSystem(entity);
+            }
+            // The entity kept the required components, so a watched one changed
+            else if (alreadyTracking)
+            {
+                system->OnWatchedComponentChanged(entity);
+            }
+        }
+    }
+
+    void Registry::ApplyComponentCommands()
+    {
+        if (componentCommands.empty()) return;
+
+        // Take the buffer so that commands recorded by callbacks wait for the next Update()
+        std::vector<ComponentCommand> commands{};
+        commands.swap(componentCommands);
+
+        // Group the commands per entity, keeping the recorded order within an entity
+        std::stable_sort(commands.begin(), commands.end(), [](ComponentCommand const& lhs, ComponentCommand const& rhs)
+            { return lhs.entity.GetId() < rhs.entity.GetId(); });
+
+        for (size_t first = 0; first < commands.size();)
+        {
+            const int entityId = commands[first].entity.GetId();
+            size_t last = first;
+            while (last < commands.size() && commands[last].entity.GetId() == entityId) ++last;
+
+            // Commands on killed entities (or entities about to be) are dropped
+            const std::uint32_t generation = commands[first].entity.GetGeneration();
+            const bool alive = generation == Entity::ANY_GENERATION ? EntityExists(entityId) :
+                IsAlive(MakeEntityHandle(entityId, generation));
+            if (!alive || (PendingFlags(entityId) & PENDING_KILL))
+            {
+                first = last;
+                continue;
+            }
+
+            const Signature before = entityComponentSignatures[entityId];
+            for (size_t i = first; i < last; ++i)
+            {
+                ComponentCommand const& command = commands[i];
+                if (command.add)
+                {
+                    deferredComponents[command.componentId]->Apply(*this, entityId, command.componentId, command.payload);
+                }
+                else if (entityComponentSignatures[entityId].test(command.componentId))
+                {
+                    RemoveComponentData(entityId, command.componentId);
+                }
+                ++frameStats.deferredCommands;
+            }
+
+            // Entities waiting to be created join their systems with their final signature in Update()
+            if (!(PendingFlags(entityId) & PENDING_CREATE))
+            {
+                Entity entity(entityId, entityGenerations[entityId]);
+                entity.registry = this;
+                ReconcileSystems(entity, before, entityComponentSignatures[entityId]);
+            }
+            first = last;
+        }
+
+        // Components recorded while applying still index into the typed arrays
+        if (!componentCommands.empty()) return;
+
+        for (auto& deferred : deferredComponents)
+        {
+            if (deferred) deferred->Clear();
         }
-        entitiesToBeKilled.clear();
     }
 
     void Registry::RuntimeUpdate(Entity e)
@@ -537,12 +775,17 @@ namespace Popplio
         if (GetSystem<Editor>().editorState == Editor::EDITING) return;
 #endif
 
-        std::set<Entity>::iterator i = std::find(entitiesToBeAdded.begin(), entitiesToBeAdded.end(), e);
+        if (e.GetId() < 0 || !(PendingFlags(e.GetId()) & PENDING_CREATE)) return;
+
+        auto i = std::find_if(entitiesToBeAdded.begin(), entitiesToBeAdded.end(),
+            [&e](const Entity& entity) { return entity.GetId() == e.GetId(); });
         if (i != entitiesToBeAdded.end())
         {
+            entitiesToBeAdded.erase(i);
+            PendingFlags(e.GetId()) &= ~PENDING_CREATE;
             AddEntityToSystems(e);
             OnEntityCreate(e);
-            entitiesToBeAdded.erase(i);
+            ++frameStats.entitiesCreated;
         }
     }
 
@@ -553,36 +796,49 @@ namespace Popplio
 #ifndef IMGUI_DISABLE
         if (GetSystem<Editor>().editorState == Editor::EDITING) return;
 #endif
+        if (e.GetId() >= 0 && (PendingFlags(e.GetId()) & PENDING_CREATE))
+        {
+            entitiesToBeAdded.erase(std::remove_if(entitiesToBeAdded.begin(), entitiesToBeAdded.end(),
+                [&e](const Entity& entity) { return entity.GetId() == e.GetId(); }),
+                entitiesToBeAdded.end());
+            PendingFlags(e.GetId()) &= ~PENDING_CREATE;
+            ++frameStats.entitiesCreated;
+        }
         AddEntityToSystems(e);
         OnEntityCreate(e);
-        entitiesToBeAdded.erase(e);
     }
 
-    void Registry::EntitySignatureChanged(Entity entity, const Signature& entitySignature)
+    void Registry::EntitySignatureChanged(Entity entity, const Signature& entitySignature, int changedComponentId)
 	{
-		// Notify each system that an entity's signature has changed
-		for (auto& system : systems)
+        // Pending creates join all their systems with their final signature in Update()
+        if (PendingFlags(entity.GetId()) & PENDING_CREATE) return;
+
+		// Notify the systems requiring or watching the changed component, no other system can gain or lose the entity
+		for (System* system : systemsPerComponent[changedComponentId])
 		{
-			const auto& systemComponentSignature = system.second->GetComponentSignature();
+			const auto& systemComponentSignature = system->GetComponentSignature();
 
             // Check if system is interested in this entity
-			bool isInterested = (entitySignature & systemComponentSignature) == systemComponentSignature;
+			bool isInterested = entitySignature.Contains(systemComponentSignature);
 			
-            bool alreadyTracking = system.second->HasEntity(entity);
+            bool alreadyTracking = system->HasEntity(entity);
 
 			// Add entity to system if entityComponentSignature matches systemConponentSignature
 			if (isInterested && !alreadyTracking)
 			{
-				system.second->AddEntityToSystem(entity);
+				system->AddEntityToSystem(entity);
 			}
 			// Remove entity from system if entityComponentSignature does not match systemConponentSignature
 			else if (!isInterested && alreadyTracking)
 			{
-				system.second->RemoveEntityFromSystem(entity);
+				system->RemoveEntityFromSystem(entity);
+			}
+			// A required component cannot change while the entity stays in the system, so it is a watched one
+			else if (alreadyTracking)
+			{
+				system->OnWatchedComponentChanged(entity);
 			}
 		}
-
-        Update();
 	}
 
     void Registry::ClearInstancedEntities()
@@ -622,6 +878,63 @@ namespace Popplio
         //numEntities = cacheNumEntities;
     }
 
+    unsigned int Registry::GetComponentVersion() const
+    {
+        return componentVersion;
+    }
+
+    void Registry::SetStorageMode(StorageMode mode)
+    {
+        if (mode == storageMode) return;
+
+        if (!entities.empty() || !entitiesToBeAdded.empty())
+        {
+            Logger::Warning("Cannot change the component storage mode while entities exist");
+            return;
+        }
+
+        componentPools.clear();
+        archetypeStorage.Clear();
+        storageMode = mode;
+        ++componentVersion;
+
+        Logger::Info(std::string("Component storage mode set to ") +
+            (mode == StorageMode::ARCHETYPE ? "archetype" : "sparse set"));
+    }
+
+    Registry::StorageMode Registry::GetStorageMode() const
+    {
+        return storageMode;
+    }
+
+    void Registry::BeginFrame()
+    {
+        lastFrameStats = frameStats;
+        frameStats = {};
+    }
+
+    const Registry::StructuralChangeStats& Registry::GetStructuralChangeStats() const
+    {
+        return lastFrameStats;
+    }
+
+    void Registry::RebuildSystemIndex()
+    {
+        systemsPerComponent.assign(MAX_COMPONENTS, {});
+        for (auto& system : systems)
+        {
+            const Signature& systemComponentSignature = system.second->GetComponentSignature();
+            const Signature& systemWatchedSignature = system.second->GetWatchedSignature();
+            for (unsigned int componentId = 0; componentId < MAX_COMPONENTS; ++componentId)
+            {
+                if (systemComponentSignature.test(componentId) || systemWatchedSignature.test(componentId))
+                {
+                    systemsPerComponent[componentId].push_back(system.second.get());
+                }
+            }
+        }
+    }
+
     int Registry::GetFreeIdCount() const
     {
         return static_cast<int>(freeIds.size());
@@ -638,6 +951,12 @@ namespace Popplio
     void Registry::ResetEntityComponentSignatures()
     {
         entityComponentSignatures.clear();
+
+        // Every entity is gone, so every handle becomes stale
+        for (std::uint32_t& generation : entityGenerations)
+        {
+            ++generation;
+        }
     }
 
     Entity Registry::GetClonedFrom(Entity entity) 
@@ -664,7 +983,7 @@ namespace Popplio
     void Registry::RestorePersistentEntities(std::vector<Signature>& signatures)
     {
         std::vector<Entity> persistentEntities{};
-        for (Signature sig : signatures)
+        for (Signature const& sig : signatures)
         {
             persistentEntities.push_back(CreateEntity());
         }
@@ -680,7 +999,8 @@ namespace Popplio
     void Registry::OnEntityCreate(Entity const& entity)
     {
 #ifndef IMGUI_DISABLE
-        if (GetSystem<Editor>().IsEditorRunning())
+        // Registries without an editor (tests & benchmarks) have no scripts to notify
+        if (HasSystem<Editor>() && GetSystem<Editor>().IsEditorRunning())
         {
 #endif
             if (entity.HasComponent<LogicComponent>())
@@ -700,7 +1020,7 @@ namespace Popplio
     void Registry::OnEntityDestroy(Entity entity)
     {
 #ifndef IMGUI_DISABLE
-        if (GetSystem<Editor>().IsEditorRunning())
+        if (HasSystem<Editor>() && GetSystem<Editor>().IsEditorRunning())
         {
 #endif
             if (entity.HasComponent<LogicComponent>())
@@ -27,16 +27,20 @@ Technology is prohibited.
 #include <set>
 #include <memory>
 #include <deque>
+#include <algorithm>
+#include <tuple>
+#include <cstdint>
+#include <array>
+#include <utility>
 
 #include "../EventBus/Event.h"
 #include "../Logging/Logger.h"
 
+#include "Signature.h"
+#include "Archetype.h"
+
 namespace Popplio
 {
-	static const unsigned int MAX_COMPONENTS = 32;
-
-	using Signature = std::bitset<MAX_COMPONENTS>;
-
     /**
     * @brief An interface class for components in the ECS system.
     * 
@@ -65,25 +69,87 @@ namespace Popplio
     */
 		static int GetId()
 		{
-			static auto id = nextId++;
+			static auto id = NextId();
 			return id;
 		}
+
+    private:
+        static int NextId()
+        {
+            if (nextId >= static_cast<int>(MAX_COMPONENTS))
+            {
+                Logger::Critical("Too many component types, increase POPPLIO_MAX_COMPONENTS (currently " +
+                    std::to_string(MAX_COMPONENTS) + ")");
+                throw std::out_of_range("Component id exceeds MAX_COMPONENTS");
+            }
+            return nextId++;
+        }
     };
 
+    /**
+    * @brief A 64-bit entity handle: generation in the high 32 bits, entity id in the low 32 bits.
+    * 
+    * Ids are recycled, generations are not: a handle to a killed entity never refers to the
+    * entity that later reuses its id.
+    */
+    using EntityHandle = std::uint64_t;
+
+    static const EntityHandle INVALID_ENTITY_HANDLE = ~EntityHandle{ 0 };
+
+    /**
+    * @brief Packs an entity id and generation into a handle.
+    */
+    inline EntityHandle MakeEntityHandle(int id, std::uint32_t generation)
+    {
+        return (static_cast<EntityHandle>(generation) << 32) | static_cast<std::uint32_t>(id);
+    }
+
+    /**
+    * @brief Gets the entity id of a handle.
+    */
+    inline int GetHandleId(EntityHandle handle)
+    {
+        return static_cast<int>(static_cast<std::uint32_t>(handle));
+    }
+
+    /**
+    * @brief Gets the generation of a handle.
+    */
+    inline std::uint32_t GetHandleGeneration(EntityHandle handle)
+    {
+        return static_cast<std::uint32_t>(handle >> 32);
+    }
+
     /**
     * @brief Represents an entity in the ECS system.
     * 
     * This class provides methods to manipulate and query an entity in the ECS system.
+    * Entities obtained from the registry remember the generation of their id, so a copy kept
+    * after the entity is killed stops existing even if the id is reused.
+    * Entities constructed from a raw id are unversioned and refer to whichever entity owns the id.
     */
     class Entity
     {
     public:
         /**
-        * @brief Constructs an Entity object with the given id.
+        * @brief Generation of entities constructed from a raw id (matches any generation).
+        */
+        static const std::uint32_t ANY_GENERATION = 0xFFFFFFFFu;
+
+        /**
+        * @brief Constructs an unversioned Entity object with the given id.
         * 
         * @param id The id of the entity.
         */
-        Entity(int id) : id(id), registry(nullptr) {};
+        Entity(int id) : registry(nullptr), id(id), generation(ANY_GENERATION) {};
+
+        /**
+        * @brief Constructs an Entity object with the given id and generation.
+        * 
+        * @param id The id of the entity.
+        * @param generation The generation of the id.
+        */
+        Entity(int id, std::uint32_t generation) : registry(nullptr), id(id), generation(generation) {};
 
         /**
         * @brief Kills the entity.
@@ -92,6 +158,13 @@ namespace Popplio
         */
         void Kill();
 
+        /**
+        * @brief Checks if the entity is alive, in O(1).
+        * 
+        * For versioned entities this also fails if the id was reused by a newer entity.
+        * 
+        * @return bool True if the entity exists.
+        */
         bool Exists() const;
 
         /**
@@ -101,6 +174,22 @@ namespace Popplio
         */
         int GetId() const;
 
+        /**
+        * @brief Gets the generation of the entity's id.
+        * 
+        * @return std::uint32_t The generation, or ANY_GENERATION if the entity is unversioned.
+        */
+        std::uint32_t GetGeneration() const;
+
+        /**
+        * @brief Gets the generational handle of the entity.
+        * 
+        * Unversioned entities take the current generation of their id.
+        * 
+        * @return EntityHandle The handle of the entity.
+        */
+        EntityHandle GetHandle() const;
+
         /**
         * @brief Tags the entity with the given tag.
         * 
@@ -183,6 +272,7 @@ namespace Popplio
 
     private:
         int id;
+        std::uint32_t generation; /**< Generation of the id when this entity was obtained. */
         //int clonedFrom; // id of entity that this entity was cloned from
     };
 
@@ -193,6 +283,30 @@ namespace Popplio
         EntityRef(Entity& e) : entity(e) {}
     };
 
+    /**
+    * @brief Read-only snapshot of the entities in a system.
+    * 
+    * The snapshot shares the system's array instead of copying it. Adding or removing entities while
+    * a snapshot is alive copies the system's array first, so loops over a snapshot can change
+    * components or kill entities and still visit exactly the entities they started with.
+    */
+    class SystemEntities
+    {
+    public:
+        using const_iterator = std::vector<Entity>::const_iterator;
+
+        explicit SystemEntities(std::shared_ptr<const std::vector<Entity>> entities) : entities(std::move(entities)) {}
+
+        const_iterator begin() const { return entities->begin(); }
+        const_iterator end() const { return entities->end(); }
+        size_t size() const { return entities->size(); }
+        bool empty() const { return entities->empty(); }
+        const Entity& operator[](size_t index) const { return (*entities)[index]; }
+
+    private:
+        std::shared_ptr<const std::vector<Entity>> entities;
+    };
+
     /**
     * @brief Represents a system in the ECS system.
     * 
@@ -211,21 +325,31 @@ namespace Popplio
         * 
         * @param entity The entity to add.
         */
-        void AddEntityToSystem(Entity entity);
+        virtual void AddEntityToSystem(Entity entity);
 
         /**
         * @brief Removes an entity from the system.
         * 
         * @param entity The entity to remove.
         */
-        void RemoveEntityFromSystem(Entity entity);
+        virtual void RemoveEntityFromSystem(Entity entity);
 
         /**
-        * @brief Gets the entities in the system.
+        * @brief Called when a watched component is added to or removed from an entity the system keeps.
+        * 
+        * @param entity The entity whose components changed.
+        */
+        virtual void OnWatchedComponentChanged(Entity entity) {}
+
+        /**
+        * @brief Gets the entities in the system, without copying them.
+        *
+        * Removing an entity moves the last entity into its slot, so the order is not the order the
+        * entities were added in.
         * 
-        * @return std::vector<Entity> The entities in the system.
+        * @return SystemEntities A snapshot of the entities in the system.
         */
-        std::vector<Entity> GetSystemEntities() const;
+        SystemEntities GetSystemEntities() const;
 
         /**
         * @brief Gets the component signature of the system.
@@ -234,6 +358,19 @@ namespace Popplio
         */
         const Signature& GetComponentSignature() const;
 
+        /**
+        * @brief Gets the components the system is told about without requiring them.
+        * 
+        * @return const Signature& The watched components of the system.
+        */
+        const Signature& GetWatchedSignature() const;
+
+        /**
+        * @brief Checks if the entity is tracked by the system.
+        * 
+        * @param entity The entity to check.
+        * @return bool True if the entity is in the system.
+        */
         bool HasEntity(Entity entity) const;
 
         /**
@@ -243,9 +380,25 @@ namespace Popplio
         */
         template <typename TComponent>
         void RequireComponent();
+
+        /**
+        * @brief Calls OnWatchedComponentChanged when the component type is added to or removed from an entity
+        * the system keeps, without requiring it.
+        * 
+        * @tparam TComponent The component type.
+        */
+        template <typename TComponent>
+        void WatchComponent();
     private:
+        /**
+        * @brief Gets the entities for a change, copying them first if a snapshot still uses them.
+        */
+        std::vector<Entity>& MutableEntities();
+
         Signature componentSignature; /**< The component signature for the system. */
-        std::vector<Entity> entities; /**< The entities in the system. */
+        Signature watchedSignature; /**< The components the system is told about without requiring them. */
+        std::shared_ptr<std::vector<Entity>> entities = std::make_shared<std::vector<Entity>>(); /**< The entities in the system (dense, unordered). */
+        std::vector<int> indices; /**< Entity id -> index in entities, -1 if not tracked. */
     };
 
 	/**
@@ -273,22 +426,26 @@ namespace Popplio
     /**
     * @brief Represents a pool of objects of type T in the ECS system.
     * 
-    * This class template provides methods to manage a pool of objects of type T in the ECS system.
+    * This class template stores components as a paged sparse set.
+    * The sparse pages map an entity id to an index into the packed dense arrays,
+    * so Get/Has/Remove are O(1) array lookups and iteration over the components is contiguous.
     * It inherits from the IPool interface.
     */
     template <typename T>
     class Pool : public IPool
     {
     public:
+        static const int PAGE_SIZE = 1024; /**< Number of entity ids covered by one sparse page. */
+        static const int INVALID_INDEX = -1; /**< Sparse value for an entity without a component. */
+
 		/**
 		* @brief Constructs a Pool object with the given capacity.
 		* 
 		* @param capacity The capacity of the pool.
 		*/
 		Pool(int capacity = 100)
-		: size(0)
 		{
-			data.resize(capacity);
+			Resize(capacity);
 		}
 
 		/**
@@ -303,7 +460,7 @@ namespace Popplio
 		*/
 		bool IsEmpty() const
 		{
-			return size == 0;
+			return data.empty();
 		}
 
 		/**
@@ -313,112 +470,106 @@ namespace Popplio
 		*/
 		int GetSize() const
 		{
-			return size;
+			return static_cast<int>(data.size());
 		}
 
         /**
-        * @brief Resizes the pool to the specified size.
+        * @brief Reserves space in the pool for the specified number of components.
         * 
-        * @param n The new size of the pool.
+        * @param n The new capacity of the pool.
         */
         void Resize(int n)
         {
-			data.resize(n);
+			data.reserve(n);
+			indexToEntityId.reserve(n);
         }
 
         /**
         * @brief Clears the pool.
         * 
-        * This method removes all elements from the pool and resets the size to 0.
+        * This method removes all elements and sparse pages from the pool.
         */
         void Clear()
         {
 			data.clear();
-			size = 0;
+			indexToEntityId.clear();
+			sparsePages.clear();
         }
 
         /**
-        * @brief Adds an object to the pool.
+        * @brief Checks if the entity with the specified id has an object in the pool.
         * 
-        * @param object The object to add to the pool.
+        * @param entityId The id of the entity.
+        * @return bool True if the entity has an object in the pool, false otherwise.
         */
-        void Add(T&& object)
+        bool Has(int entityId) const
         {
-			data.push_back(std::move(object));
+			return GetIndex(entityId) != INVALID_INDEX;
         }
 
         /**
         * @brief Sets the object at the specified entity id in the pool.
         * 
         * If the entity id already exists in the pool, the existing object is replaced with the new object.
-        * If the entity id is new, the object is added to the pool and the entity id is tracked.
-        * If the pool capacity is reached, the pool is resized by doubling its current capacity.
+        * If the entity id is new, the object is appended to the packed array and the entity id is tracked.
         * 
         * @param entityId The id of the entity.
         * @param object The object to set in the pool.
         */
         void Set(int entityId, T&& object)
         {
-			if (entityIdToIndex.find(entityId) != entityIdToIndex.end())
+			int& index = SparseSlot(entityId);
+			if (index != INVALID_INDEX)
 			{
 				// If the element already exists, simply replace the component object
-				int index = entityIdToIndex[entityId];
 				data[index] = std::move(object);
+				return;
 			}
-			else
-			{
-				// When a new object, we keep track of the entity ids and their vector index
-				int index = size;
-				entityIdToIndex.emplace(entityId, index);
-				indexToEntityId.emplace(index, entityId);
-				if (index >= data.capacity())
-				{
-					// necessary, we resize by always doubling the current capacity
-					data.resize(size * 2);
-				}
 
-				data[index] = std::move(object);
-				++size;
-			}
+			// When a new object, we keep track of the entity ids and their vector index
+			index = static_cast<int>(data.size());
+			data.push_back(std::move(object));
+			indexToEntityId.push_back(entityId);
         }
 
         /**
         * @brief Removes the entity with the specified entityId from the pool.
         * 
-        * This method removes the entity with the specified entityId from the pool and updates the index-entity maps accordingly.
-        * If the entityId does not exist in the pool, no action is taken.
+        * The last element is moved into the removed slot to keep the array packed.
+        * The entity must exist in the pool.
         *
         * @param entityId The id of the entity to remove from the pool.
         */
         void Remove(int entityId)
         {
-			// Copy the last element to the deleted position to keep the array packed
-			int indexOfRemoved = entityIdToIndex[entityId];
-			int indexOfLast = size - 1;
-			data[indexOfRemoved] = data[indexOfLast];
+			int& indexOfRemoved = SparseSlot(entityId);
+			const int indexOfLast = static_cast<int>(data.size()) - 1;
+			const int entityIdOfLastElement = indexToEntityId[indexOfLast];
 
-			// Update the index-entity maps to point to the correct elements
-			int entityIdOfLastElement = indexToEntityId[indexOfLast];
-			entityIdToIndex[entityIdOfLastElement] = indexOfRemoved;
-			indexToEntityId[indexOfRemoved] = entityIdOfLastElement;
-
-			entityIdToIndex.erase(entityId);
-			indexToEntityId.erase(indexOfLast);
+			// Move the last element to the deleted position to keep the array packed
+			if (indexOfRemoved != indexOfLast)
+			{
+				data[indexOfRemoved] = std::move(data[indexOfLast]);
+				indexToEntityId[indexOfRemoved] = entityIdOfLastElement;
+				SparseSlot(entityIdOfLastElement) = indexOfRemoved;
+			}
+			indexOfRemoved = INVALID_INDEX;
 
-			--size;
+			data.pop_back();
+			indexToEntityId.pop_back();
         }
 
         /**
         * @brief Removes the entity with the specified entityId from the pool.
         * 
-        * This method removes the entity with the specified entityId from the pool and updates the index-entity maps accordingly.
+        * This method removes the entity with the specified entityId from the pool and updates the sparse set accordingly.
         * If the entityId does not exist in the pool, no action is taken.
         *
         * @param entityId The id of the entity to remove from the pool.
         */
         void RemoveEntityFromPool(int entityId) override
         {
-			if (entityIdToIndex.find(entityId) != entityIdToIndex.end())
+			if (Has(entityId))
 			{
 				Remove(entityId);
 			}
@@ -432,12 +583,12 @@ namespace Popplio
         */
         T& Get(int entityId)
         {
-            auto it = entityIdToIndex.find(entityId);
-            if (it == entityIdToIndex.end())
+            const int index = GetIndex(entityId);
+            if (index == INVALID_INDEX)
             {
                 throw std::out_of_range("Trying to get non-existent component");
             }
-            return data[it->second];
+            return data[index];
         }
 
         /**
@@ -451,20 +602,364 @@ namespace Popplio
 			return data[index];
         }
 
+        /**
+        * @brief Gets the id of the entity owning the object at the specified index in the pool.
+        * 
+        * @param index The index of the object in the pool.
+        * @return int The id of the owning entity.
+        */
+        int GetEntityId(unsigned int index) const
+        {
+			return indexToEntityId[index];
+        }
+
+        /**
+        * @brief Gets the packed component objects for contiguous iteration.
+        * 
+        * @return std::vector<T>& The packed component objects, parallel to GetEntityIds().
+        */
+        std::vector<T>& GetData()
+        {
+			return data;
+        }
+
+        /**
+        * @brief Gets the packed entity ids for contiguous iteration.
+        * 
+        * @return const std::vector<int>& The entity ids, parallel to GetData().
+        */
+        const std::vector<int>& GetEntityIds() const
+        {
+			return indexToEntityId;
+        }
+
 	private:
-		// Keep track of the vector of component objects and their current size
+        /**
+        * @brief Gets the packed index of the specified entity, or INVALID_INDEX if it has no object.
+        */
+        int GetIndex(int entityId) const
+        {
+			const size_t page = static_cast<size_t>(entityId) / PAGE_SIZE;
+			if (entityId < 0 || page >= sparsePages.size() || !sparsePages[page])
+			{
+				return INVALID_INDEX;
+			}
+			return sparsePages[page][entityId % PAGE_SIZE];
+        }
+
+        /**
+        * @brief Gets the sparse slot of the specified entity, allocating its page if necessary.
+        */
+        int& SparseSlot(int entityId)
+        {
+			const size_t page = static_cast<size_t>(entityId) / PAGE_SIZE;
+			if (page >= sparsePages.size())
+			{
+				sparsePages.resize(page + 1);
+			}
+			if (!sparsePages[page])
+			{
+				sparsePages[page] = std::make_unique<int[]>(PAGE_SIZE);
+				std::fill_n(sparsePages[page].get(), PAGE_SIZE, INVALID_INDEX);
+			}
+			return sparsePages[page][entityId % PAGE_SIZE];
+        }
+
+		// Packed component objects and the entity id owning each of them (dense arrays)
 		std::vector<T> data;
-		int size;
+		std::vector<int> indexToEntityId;
 
-		// Maps to keep track of entity ids per index so that the vector is always packed
-		std::unordered_map<int, int> entityIdToIndex;
-		std::unordered_map<int, int> indexToEntityId;
+		// Pages of entity id -> dense index, allocated on demand (sparse array)
+		std::vector<std::unique_ptr<int[]>> sparsePages;
 	};
 
 	
+    /**
+    * @brief Iterates every entity owning all of the TComponents.
+    * 
+    * In sparse set storage, the view walks the packed entity ids of the smallest pool and probes
+    * the other pools, yielding references to the components directly without copying entity lists.
+    * In archetype storage, the view walks the chunks of every matching archetype, where the
+    * components of each type are contiguous.
+    * Iteration runs from the back of the packed arrays so that removing the current entity's
+    * components during iteration does not skip any entity.
+    * A view made for a system only yields the entities the system tracks, so entities waiting to be
+    * created or stashed out of the systems are skipped like GetSystemEntities() skips them.
+    * 
+    * @tparam TComponents The component types that entities must have.
+    */
+    template <typename ...TComponents>
+    class ComponentView
+    {
+        using ColumnIndices = std::array<int, sizeof...(TComponents)>;
+
+    public:
+        /**
+        * @brief Iterator yielding a tuple of the entity and references to its components.
+        */
+        class Iterator
+        {
+        public:
+            Iterator(ComponentView const* view, int archetypeIndex, int index)
+                : view(view), archetypeIndex(archetypeIndex), index(index)
+            {
+                SkipInvalid();
+            }
+
+            std::tuple<Entity, TComponents&...> operator*() const
+            {
+                if (view->driverIds)
+                {
+                    const int entityId = (*view->driverIds)[index];
+                    return std::tuple<Entity, TComponents&...>(view->MakeEntity(entityId), view->template Get<TComponents>(entityId)...);
+                }
+                return view->GetRow(archetypeIndex, index, std::index_sequence_for<TComponents...>{});
+            }
+
+            Iterator& operator++()
+            {
+                --index;
+                SkipInvalid();
+                return *this;
+            }
+
+            bool operator!=(Iterator const& other) const
+            {
+                return archetypeIndex != other.archetypeIndex || index != other.index;
+            }
+
+        private:
+            // Skip entities missing one of the other components, or stale indices after removals
+            void SkipInvalid()
+            {
+                if (view->driverIds)
+                {
+                    while (index >= 0 && (index >= static_cast<int>(view->driverIds->size()) ||
+                        !view->Contains((*view->driverIds)[index])))
+                    {
+                        --index;
+                    }
+                    return;
+                }
+
+                // Move on to the previous archetype once the rows of this one are exhausted
+                while (archetypeIndex >= 0)
+                {
+                    Archetype const* archetype = view->archetypes[archetypeIndex];
+                    const int size = archetype->Size();
+                    if (index >= size) index = size - 1;
+                    while (index >= 0 && !view->IsMember(archetype->GetEntityId(index))) --index;
+                    if (index >= 0) return;
+
+                    if (--archetypeIndex >= 0) index = view->archetypes[archetypeIndex]->Size() - 1;
+                }
+                index = -1;
+            }
+
+            ComponentView const* view;
+            int archetypeIndex;
+            int index;
+        };
+
+        /**
+        * @brief Constructs a view over the given pools.
+        * 
+        * If any pool does not exist yet, the view is empty.
+        * 
+        * @param registry The registry owning the pools.
+        * @param system The system whose entities are yielded, or nullptr for every entity.
+        * @param pools The pools of each component type.
+        */
+        ComponentView(class Registry* registry, System const* system, Pool<TComponents>*... pools)
+            : registry(registry), system(system), pools(pools...), driverIds(nullptr)
+        {
+            if (((pools == nullptr) || ...)) return;
+
+            // Drive the iteration with the smallest pool
+            auto consider = [this](auto* pool)
+            {
+                if (!driverIds || pool->GetEntityIds().size() < driverIds->size())
+                {
+                    driverIds = &pool->GetEntityIds();
+                }
+            };
+            (consider(pools), ...);
+        }
+
+        /**
+        * @brief Constructs a view over the given archetypes.
+        * 
+        * @param registry The registry owning the archetypes.
+        * @param system The system whose entities are yielded, or nullptr for every entity.
+        * @param archetypes The archetypes containing all of the TComponents.
+        */
+        ComponentView(class Registry* registry, System const* system, std::vector<Archetype*> matching)
+            : registry(registry), system(system), pools(), driverIds(nullptr), archetypes(std::move(matching))
+        {
+            columns.reserve(archetypes.size());
+            for (Archetype* archetype : archetypes)
+            {
+                columns.push_back(ColumnIndices{ archetype->ColumnOf(Component<TComponents>::GetId())... });
+            }
+        }
+
+        /**
+        * @brief Calls func for every entity owning all of the TComponents.
+        * 
+        * func may take (Entity, TComponents&...) or (TComponents&...).
+        * 
+        * @param func The function to call.
+        */
+        template <typename TFunc>
+        void Each(TFunc&& func) const
+        {
+            if (!driverIds)
+            {
+                for (int a = static_cast<int>(archetypes.size()) - 1; a >= 0; --a)
+                {
+                    EachInArchetype(a, func, std::index_sequence_for<TComponents...>{});
+                }
+                return;
+            }
+
+            for (int index = static_cast<int>(driverIds->size()) - 1; index >= 0; --index)
+            {
+                // Packed arrays may shrink if func removes components
+                if (index >= static_cast<int>(driverIds->size())) continue;
+
+                const int entityId = (*driverIds)[index];
+                if (!Contains(entityId)) continue;
+
+                if constexpr (std::is_invocable_v<TFunc, Entity, TComponents&...>)
+                {
+                    func(MakeEntity(entityId), Get<TComponents>(entityId)...);
+                }
+                else
+                {
+                    func(Get<TComponents>(entityId)...);
+                }
+            }
+        }
+
+        Iterator begin() const
+        {
+            if (driverIds) return Iterator(this, 0, static_cast<int>(driverIds->size()) - 1);
+            if (archetypes.empty()) return end();
+
+            const int last = static_cast<int>(archetypes.size()) - 1;
+            return Iterator(this, last, archetypes[last]->Size() - 1);
+        }
+
+        Iterator end() const
+        {
+            return Iterator(this, driverIds ? 0 : -1, -1);
+        }
+
+        /**
+        * @brief Gets the upper bound of entities in the view.
+        * 
+        * @return size_t The number of entities in the smallest pool, or in the matching archetypes.
+        */
+        size_t SizeHint() const
+        {
+            if (driverIds) return driverIds->size();
+
+            size_t size = 0;
+            for (Archetype* archetype : archetypes) size += static_cast<size_t>(archetype->Size());
+            return size;
+        }
+
+    private:
+        bool IsMember(int entityId) const
+        {
+            return !system || system->HasEntity(Entity(entityId));
+        }
+
+        bool Contains(int entityId) const
+        {
+            return (std::get<Pool<TComponents>*>(pools)->Has(entityId) && ...) && IsMember(entityId);
+        }
+
+        template <typename TComponent>
+        TComponent& Get(int entityId) const
+        {
+            return std::get<Pool<TComponent>*>(pools)->Get(entityId);
+        }
+
+        template <size_t ...I>
+        std::tuple<Entity, TComponents&...> GetRow(int archetypeIndex, int row, std::index_sequence<I...>) const
+        {
+            Archetype* archetype = archetypes[archetypeIndex];
+            ColumnIndices const& cols = columns[archetypeIndex];
+            return std::tuple<Entity, TComponents&...>(MakeEntity(archetype->GetEntityId(row)),
+                *static_cast<TComponents*>(archetype->GetComponent(cols[I], row))...);
+        }
+
+        template <typename TFunc, size_t ...I>
+        void EachInArchetype(int archetypeIndex, TFunc& func, std::index_sequence<I...>) const
+        {
+            Archetype* archetype = archetypes[archetypeIndex];
+            ColumnIndices const& cols = columns[archetypeIndex];
+            const int capacity = archetype->ChunkCapacity();
+
+            for (int chunk = archetype->ChunkCount() - 1; chunk >= 0; --chunk)
+            {
+                // Chunks are never freed, so the column bases stay valid while func runs
+                std::tuple<TComponents*...> bases(archetype->template ColumnData<TComponents>(chunk, cols[I])...);
+
+                for (int i = archetype->ChunkSize(chunk) - 1; i >= 0; --i)
+                {
+                    // Rows may move out if func adds / removes components
+                    if (i >= archetype->ChunkSize(chunk)) continue;
+                    if (!IsMember(archetype->GetEntityId(chunk * capacity + i))) continue;
+
+                    if constexpr (std::is_invocable_v<TFunc, Entity, TComponents&...>)
+                    {
+                        func(MakeEntity(archetype->GetEntityId(chunk * capacity + i)), std::get<I>(bases)[i]...);
+                    }
+                    else
+                    {
+                        func(std::get<I>(bases)[i]...);
+                    }
+                }
+            }
+        }
+
+        Entity MakeEntity(int entityId) const;
+
+        class Registry* registry;
+        System const* system; /**< Only the entities of this system are yielded, if set. */
+        std::tuple<Pool<TComponents>*...> pools;
+        const std::vector<int>* driverIds; /**< Packed entity ids of the smallest pool. */
+
+        std::vector<Archetype*> archetypes; /**< Matching archetypes (archetype storage only). */
+        std::vector<ColumnIndices> columns; /**< Column of each of the TComponents per archetype. */
+    };
+
 	class Registry
 	{
 	public:
+        /**
+        * @brief The layout used to store components.
+        */
+        enum class StorageMode
+        {
+            SPARSE_SET, /**< One pool per component type (default). */
+            ARCHETYPE /**< Entities grouped by signature into chunks, one array per component type. */
+        };
+
+        /**
+        * @brief Structural changes applied by the registry during one frame.
+        */
+        struct StructuralChangeStats
+        {
+            unsigned int entitiesCreated = 0; /**< Entities added to their systems. */
+            unsigned int entitiesDestroyed = 0; /**< Entities killed and removed from storage. */
+            unsigned int componentsAdded = 0; /**< Components added, immediately or deferred. */
+            unsigned int componentsRemoved = 0; /**< Components removed, immediately or deferred. */
+            unsigned int deferredCommands = 0; /**< Commands applied from the command buffer. */
+        };
+
 		int GetNumEntities() const;
 
         void ResetNumEntities();
@@ -477,6 +972,8 @@ namespace Popplio
         * 
         * This method updates the ECS registry by processing any pending entity additions or removals.
         * It is responsible for adding new entities to their respective systems and removing killed entities from the systems.
+        * Deferred component commands are applied first, grouped per entity so that each entity's
+        * systems are updated once for its final signature.
         */
         void Update();
 
@@ -503,7 +1000,7 @@ namespace Popplio
 
         void KillEntityFirstPass(Entity entity);
 
-        std::set<Entity>& KillEntitySecondPass(Entity entity, std::set<Entity>& killedEntities);
+        void KillEntitySecondPass(Entity entity, std::vector<Entity>& killedEntities);
 
         void KillEntityRuntime(Entity entity);
 
@@ -527,6 +1024,30 @@ namespace Popplio
         */
         bool EntityExists(int entityId) const;
 
+        /**
+        * @brief Checks if the entity referred to by a handle is alive, in O(1).
+        * 
+        * @param handle The generational handle of the entity.
+        * @return bool True if the id is in use and its generation matches the handle.
+        */
+        bool IsAlive(EntityHandle handle) const;
+
+        /**
+        * @brief Gets the current generation of an entity id.
+        * 
+        * @param entityId The id of the entity.
+        * @return std::uint32_t The generation, bumped every time an entity with this id is killed.
+        */
+        std::uint32_t GetEntityGeneration(int entityId) const;
+
+        /**
+        * @brief Gets the entity referred to by a handle.
+        * 
+        * @param handle The generational handle of the entity.
+        * @return Entity The entity, or Entity(-1) if it is no longer alive.
+        */
+        Entity GetEntityByHandle(EntityHandle handle);
+
         /**
         * @brief Gets the entity with the specified id from the ECS registry.
         * 
@@ -649,6 +1170,9 @@ namespace Popplio
         /**
         * @brief Adds a component of type TComponent to the entity.
         *
+        * In archetype storage the entity moves to another archetype, invalidating references to its
+        * components and to the components of the entity moved into its old row.
+        *
         * @tparam TComponent The type of the component to add.
         * @tparam TArgs The types of the arguments to forward to the component's constructor.
         * @param entity The entity to add the component to.
@@ -660,12 +1184,38 @@ namespace Popplio
         /**
         * @brief Removes the component of type TComponent from the entity.
         *
+        * In archetype storage the entity moves to another archetype, invalidating references to its
+        * components and to the components of the entity moved into its old row.
+        *
         * @tparam TComponent The type of the component to remove.
         * @param entity The entity to remove the component from.
         */
         template <typename TComponent>
         void RemoveComponent(Entity entity);
 
+        /**
+        * @brief Records adding a component of type TComponent to the entity, applied on the next Update().
+        *
+        * Use this instead of AddComponent when spawning or changing many entities in a frame:
+        * the entity's systems are updated once per Update() instead of once per component.
+        *
+        * @tparam TComponent The type of the component to add.
+        * @tparam TArgs The types of the arguments to forward to the component's constructor.
+        * @param entity The entity to add the component to.
+        * @param args The arguments to forward to the component's constructor.
+        */
+        template <typename TComponent, typename ...TArgs>
+        void DeferAddComponent(Entity entity, TArgs&& ...args);
+
+        /**
+        * @brief Records removing the component of type TComponent from the entity, applied on the next Update().
+        *
+        * @tparam TComponent The type of the component to remove.
+        * @param entity The entity to remove the component from.
+        */
+        template <typename TComponent>
+        void DeferRemoveComponent(Entity entity);
+
         /**
         * @brief Checks if the entity has a component of type TComponent.
         *
@@ -686,6 +1236,88 @@ namespace Popplio
         template <typename TComponent>
         TComponent& GetComponent(Entity entity) const;
 
+        /**
+        * @brief Gets the component of type TComponent from the entity if it has one.
+        *
+        * @tparam TComponent The type of the component to get.
+        * @param entity The entity to get the component from.
+        * @return TComponent* The pointer to the component, or nullptr if the entity does not have it.
+        */
+        template <typename TComponent>
+        TComponent* TryGetComponent(Entity entity) const;
+
+        /**
+        * @brief Gets a view over all entities that have every one of the TComponents.
+        *
+        * Systems can iterate the view (or call Each on it) to get references to the
+        * components directly instead of calling HasComponent/GetComponent per entity.
+        *
+        * @tparam TComponents The component types that entities must have.
+        * @return ComponentView<TComponents...> The view over the matching entities.
+        */
+        template <typename ...TComponents>
+        ComponentView<TComponents...> View();
+
+        /**
+        * @brief Gets a view over the entities of a system that have every one of the TComponents.
+        *
+        * Systems iterate this view instead of View() so that entities waiting to be created or stashed
+        * out of the systems (persistent entities during a scene change) are left alone.
+        *
+        * @tparam TComponents The component types that entities must have.
+        * @param system The system whose entities are yielded.
+        * @return ComponentView<TComponents...> The view over the matching entities of the system.
+        */
+        template <typename ...TComponents>
+        ComponentView<TComponents...> View(System const& system);
+
+        /**
+        * @brief Gets the pool of components of type TComponent.
+        *
+        * @tparam TComponent The component type.
+        * @return Pool<TComponent>* The pool, or nullptr if no component of this type was ever added
+        *                           or the registry uses archetype storage.
+        */
+        template <typename TComponent>
+        Pool<TComponent>* GetPool() const;
+
+        /**
+        * @brief Gets a counter that changes whenever components are added to or removed from any pool.
+        *
+        * Pointers to pooled components stay valid only while this value is unchanged.
+        *
+        * @return unsigned int The current component version.
+        */
+        unsigned int GetComponentVersion() const;
+
+        /**
+        * @brief Sets the layout used to store components.
+        *
+        * The storage mode can only be changed while the registry has no entities.
+        *
+        * @param mode The storage mode to use.
+        */
+        void SetStorageMode(StorageMode mode);
+
+        /**
+        * @brief Gets the layout used to store components.
+        *
+        * @return StorageMode The current storage mode.
+        */
+        StorageMode GetStorageMode() const;
+
+        /**
+        * @brief Starts counting the structural changes of a new frame.
+        */
+        void BeginFrame();
+
+        /**
+        * @brief Gets the structural changes applied during the previous frame.
+        *
+        * @return const StructuralChangeStats& The counters of the previous frame.
+        */
+        const StructuralChangeStats& GetStructuralChangeStats() const;
+
         /**
         * @brief Adds a system of type TSystem to the ECS registry.
         *
@@ -755,10 +1387,13 @@ namespace Popplio
         * It takes the entity and its new signature as parameters.
         * The system uses this method to update the component signature of the entity in the system.
         * 
+        * Only the systems requiring the changed component are checked.
+        * 
         * @param entity The entity whose signature has changed.
         * @param entitySignature The new signature of the entity.
+        * @param changedComponentId The id of the component that was added or removed.
         */
-        void EntitySignatureChanged(Entity entity, const Signature& entitySignature);
+        void EntitySignatureChanged(Entity entity, const Signature& entitySignature, int changedComponentId);
 
         /**
         * @brief Clears instanced entities
@@ -809,10 +1444,74 @@ namespace Popplio
 			index = system typeId]
 		*/
 		std::unordered_map<std::type_index, std::shared_ptr<System>> systems;
+
+		/*
+			Systems requiring or watching each component type, so signature changes only touch affected systems
+			[vector index = componentId]
+		*/
+		std::vector<std::vector<System*>> systemsPerComponent = std::vector<std::vector<System*>>(MAX_COMPONENTS);
 	
-		// Set of entities that are flagged to be added or removed in the next registry Update()
-		std::set<Entity> entitiesToBeAdded;
-		std::set<Entity> entitiesToBeKilled;
+		// Entities that are flagged to be added or removed in the next registry Update()
+		std::vector<Entity> entitiesToBeAdded;
+		std::vector<Entity> entitiesToBeKilled;
+
+		enum PendingFlag : std::uint8_t
+		{
+			PENDING_CREATE = 1 << 0,
+			PENDING_KILL = 1 << 1,
+			KILLED = 1 << 2 /**< Set while Update() removes the entity from the entities vector. */
+		};
+
+		/*
+			Pending structural changes per entity, so queueing twice is detected in O(1)
+			[vector index = entityId]
+		*/
+		std::vector<std::uint8_t> pendingFlags;
+
+		/*
+			Deferred component command buffer
+			Added components are stored by value in a typed array per component type
+		*/
+		struct ComponentCommand
+		{
+			Entity entity;
+			int componentId;
+			bool add;
+			std::uint32_t payload; /**< Index of the component in its typed array (add only). */
+		};
+
+		struct IDeferredComponents
+		{
+			virtual ~IDeferredComponents() = default;
+			virtual void Apply(Registry& registry, int entityId, int componentId, std::uint32_t index) = 0;
+			virtual void Clear() = 0;
+		};
+
+		template <typename TComponent>
+		struct DeferredComponents : public IDeferredComponents
+		{
+			std::vector<TComponent> values;
+
+			void Apply(Registry& registry, int entityId, int componentId, std::uint32_t index) override
+			{
+				registry.SetComponentData<TComponent>(entityId, componentId, std::move(values[index]));
+			}
+
+			void Clear() override
+			{
+				values.clear();
+			}
+		};
+
+		std::vector<ComponentCommand> componentCommands;
+		std::vector<std::unique_ptr<IDeferredComponents>> deferredComponents; /**< [vector index = componentId] */
+
+		// Structural change counters of the current and previous frame
+		StructuralChangeStats frameStats{};
+		StructuralChangeStats lastFrameStats{};
+
+		// Systems visited while reconciling one entity (reused to avoid allocations)
+		std::vector<System*> touchedSystems;
 
 		// Entity tags (one tag name per entity)
 		std::unordered_map<std::string, Entity> entityPerTag;
@@ -825,6 +1524,12 @@ namespace Popplio
 		// List of free entity ids that were previously removed
 		std::deque<int> freeIds;
 
+		/*
+			Generation of each entity id, bumped whenever the entity using the id is killed
+			[vector index = entityId]
+		*/
+		std::vector<std::uint32_t> entityGenerations;
+
         // Entity cloned from ids
         std::unordered_map<int, int> clonedFromIds; // Key: entity id, Value: original entity id
 
@@ -832,6 +1537,14 @@ namespace Popplio
         std::deque<int> cacheFreeIds{};
         int cacheNumEntities = 0;
 
+        // Bumped on every pool insertion / removal
+        unsigned int componentVersion = 0;
+
+        StorageMode storageMode = StorageMode::SPARSE_SET;
+
+        // Component storage when storageMode is ARCHETYPE (componentPools stay empty)
+        ArchetypeStorage archetypeStorage;
+
 
         /**
         * @brief Behaviour on entity creation
@@ -849,6 +1562,46 @@ namespace Popplio
         * @param entity The entity destroyed.
         */
         void OnEntityDestroy(Entity entity);
+
+        /**
+        * @brief Rebuilds the systems required by each component type after a system is added or removed.
+        */
+        void RebuildSystemIndex();
+
+        /**
+        * @brief Stores a component and sets its signature bit, without notifying systems.
+        */
+        template <typename TComponent, typename ...TArgs>
+        void SetComponentData(int entityId, int componentId, TArgs&& ...args);
+
+        /**
+        * @brief Removes a component and clears its signature bit, without notifying systems.
+        */
+        void RemoveComponentData(int entityId, int componentId);
+
+        /**
+        * @brief Adds / removes the entity from the systems affected by a signature change.
+        *
+        * @param entity The entity whose signature changed.
+        * @param before The signature before the change.
+        * @param after The signature after the change.
+        */
+        void ReconcileSystems(Entity entity, const Signature& before, const Signature& after);
+
+        /**
+        * @brief Applies the deferred component commands, grouped per entity.
+        */
+        void ApplyComponentCommands();
+
+        /**
+        * @brief Adds the entities waiting to be created to their systems and removes the killed entities.
+        */
+        void ProcessPendingEntities();
+
+        /**
+        * @brief Gets the pending flags of an entity, growing the flag array if needed.
+        */
+        std::uint8_t& PendingFlags(int entityId);
 	};
 	
     /**
@@ -913,11 +1666,18 @@ namespace Popplio
 		componentSignature.set(componentId);
 	}
 
+	template <typename TComponent>
+	void System::WatchComponent()
+	{
+		watchedSignature.set(Component<TComponent>::GetId());
+	}
+
 	template <typename TSystem, typename ...TArgs>
 	void Registry::AddSystem(TArgs&& ...args)
 	{
 		std::shared_ptr<TSystem> newSystem = std::make_shared<TSystem>(std::forward<TArgs>(args)...);
 		systems.insert(std::make_pair(std::type_index(typeid(TSystem)), newSystem));
+        RebuildSystemIndex();
 	}
 
 	template <typename TSystem>
@@ -927,6 +1687,7 @@ namespace Popplio
         if (system != systems.end())
         {
             systems.erase(system);
+            RebuildSystemIndex();
         }
 	}
 
@@ -947,41 +1708,57 @@ namespace Popplio
 		return *(std::static_pointer_cast<TSystem>(system->second));
 	}
 
+	template <typename TComponent, typename ...TArgs>
+	void Registry::SetComponentData(int entityId, int componentId, TArgs&& ...args)
+	{
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            // Moves the entity to the archetype of its new signature
+            archetypeStorage.Set<TComponent>(entityId, componentId, std::forward<TArgs>(args)...);
+        }
+        else
+        {
+		    // If the component id is greater than the current size of the componentPools, then resize the vector
+		    if (componentId >= componentPools.size())
+		    {
+			    componentPools.resize(componentId + 1, nullptr);
+		    }
+
+		    // If we still don't have a Pool for that component type
+		    if (!componentPools[componentId])
+		    {
+			    std::shared_ptr<Pool<TComponent>> newComponentPool = std::make_shared<Pool<TComponent>>();
+			    componentPools[componentId] = newComponentPool;
+		    }
+
+		    // Get the pool of component values for that component type
+		    auto componentPool = static_cast<Pool<TComponent>*>(componentPools[componentId].get());
+
+		    // Create a new Component object of the type T, and forward the various parameters to the constructors
+		    TComponent newComponent(std::forward<TArgs>(args)...);
+
+		    // Add the component to the component pool list, using the entity Id as index
+		    componentPool->Set(entityId, std::move(newComponent));
+        }
+		++componentVersion;
+        ++frameStats.componentsAdded;
+
+		// Finally, change the component signature of the entity and set the component id on the bitset to 1
+		entityComponentSignatures[entityId].set(componentId);
+	}
+
 	template <typename TComponent, typename ...TArgs>
 	void Registry::AddComponent(Entity entity, TArgs&& ...args)
 	{
 		const auto componentId = Component<TComponent>::GetId();
 		const auto entityId = entity.GetId();
 
-		// If the component id is greater than the current size of the componentPools, then resize the vector
-		if (componentId >= componentPools.size())
-		{
-			componentPools.resize(componentId + 1, nullptr);
-		}
-
-		// If we still don't have a Pool for that component type
-		if (!componentPools[componentId])
-		{
-			std::shared_ptr<Pool<TComponent>> newComponentPool = std::make_shared<Pool<TComponent>>();
-			componentPools[componentId] = newComponentPool;
-		}
-
-		// Get the pool of component values for that component type
-		std::shared_ptr<Pool<TComponent>> componentPool = std::static_pointer_cast<Pool<TComponent>>(componentPools[componentId]);
-
-		// Create a new Component object of the type T, and forward the various parameters to the constructors
-		TComponent newComponent(std::forward<TArgs>(args)...);
-
-		// Add the component to the component pool list, using the entity Id as index
-		componentPool->Set(entityId, std::move(newComponent));
-
-		// Finally, change the component signature of the entity and set the component id on the bitset to 1
-		entityComponentSignatures[entityId].set(componentId);
+        SetComponentData<TComponent>(entityId, componentId, std::forward<TArgs>(args)...);
 
         // Notify systems that an entity's components have changed
-        EntitySignatureChanged(entity, entityComponentSignatures[entityId]);
+        EntitySignatureChanged(entity, entityComponentSignatures[entityId], componentId);
 
-		Logger::Debug("Component added to Entity ID: " + std::to_string(entity.GetId()) +
+		POPPLIO_LOG_DEBUG("Component added to Entity ID: " + std::to_string(entity.GetId()) +
 			", Component Type: " + typeid(TComponent).name());
 	}
 
@@ -997,19 +1774,40 @@ namespace Popplio
             return;
         }
 
-		// Remove the component from the component pool for that entity
-		std::shared_ptr<Pool<TComponent>> componentPool = std::static_pointer_cast<Pool<TComponent>>(componentPools[componentId]);
-		componentPool->Remove(entityId);
-
-		// Set the component signature for that entity to false
-		entityComponentSignatures[entityId].set(componentId, false);
+        RemoveComponentData(entityId, componentId);
 
-        EntitySignatureChanged(entity, entityComponentSignatures[entityId]);
+        EntitySignatureChanged(entity, entityComponentSignatures[entityId], componentId);
 
-        Logger::Debug("Component removed from Entity ID: " + std::to_string(entity.GetId()) +
+        POPPLIO_LOG_DEBUG("Component removed from Entity ID: " + std::to_string(entity.GetId()) +
             ", Component Type: " + typeid(TComponent).name());
 	}
 
+	template <typename TComponent, typename ...TArgs>
+	void Registry::DeferAddComponent(Entity entity, TArgs&& ...args)
+	{
+		const auto componentId = Component<TComponent>::GetId();
+
+        if (componentId >= static_cast<int>(deferredComponents.size()))
+        {
+            deferredComponents.resize(componentId + 1);
+        }
+        if (!deferredComponents[componentId])
+        {
+            deferredComponents[componentId] = std::make_unique<DeferredComponents<TComponent>>();
+        }
+
+        auto& values = static_cast<DeferredComponents<TComponent>*>(deferredComponents[componentId].get())->values;
+        values.emplace_back(std::forward<TArgs>(args)...);
+
+        componentCommands.push_back({ entity, componentId, true, static_cast<std::uint32_t>(values.size() - 1) });
+	}
+
+	template <typename TComponent>
+	void Registry::DeferRemoveComponent(Entity entity)
+	{
+        componentCommands.push_back({ entity, Component<TComponent>::GetId(), false, 0 });
+	}
+
 	template <typename TComponent>
 	bool Registry::HasComponent(Entity entity) const
 	{
@@ -1023,15 +1821,83 @@ namespace Popplio
 	{
 		const auto componentId = Component<TComponent>::GetId();
 		const auto entityId = entity.GetId();
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            TComponent* component = archetypeStorage.Get<TComponent>(entityId, componentId);
+            if (!component)
+            {
+                Logger::Error("Attempt to get non-existent component from Entity ID: " + std::to_string(entityId));
+                throw std::runtime_error("Component not found");
+            }
+            return *component;
+        }
         if (componentId >= componentPools.size() || !componentPools[componentId])
         {
             Logger::Error("Attempt to get non-existent component from Entity ID: " + std::to_string(entityId));
             throw std::runtime_error("Component not found");
         }
-		auto componentPool = std::static_pointer_cast<Pool<TComponent>>(componentPools[componentId]);
+		// Raw pointer cast avoids touching the shared_ptr ref count on every lookup
+		auto componentPool = static_cast<Pool<TComponent>*>(componentPools[componentId].get());
 		return componentPool->Get(entityId);
 	}
 
+	template <typename TComponent>
+	TComponent* Registry::TryGetComponent(Entity entity) const
+	{
+		const auto componentId = Component<TComponent>::GetId();
+		const auto entityId = entity.GetId();
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            return archetypeStorage.Get<TComponent>(entityId, componentId);
+        }
+        Pool<TComponent>* componentPool = GetPool<TComponent>();
+        if (!componentPool || !componentPool->Has(entityId)) return nullptr;
+		return &componentPool->Get(entityId);
+	}
+
+	template <typename ...TComponents>
+	Entity ComponentView<TComponents...>::MakeEntity(int entityId) const
+	{
+		Entity entity(entityId, registry ? registry->GetEntityGeneration(entityId) : 0);
+		entity.registry = registry;
+		return entity;
+	}
+
+	template <typename ...TComponents>
+	ComponentView<TComponents...> Registry::View()
+	{
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            Signature required;
+            (required.set(Component<TComponents>::GetId()), ...);
+            return ComponentView<TComponents...>(this, nullptr, archetypeStorage.GetMatchingArchetypes(required));
+        }
+		return ComponentView<TComponents...>(this, nullptr, GetPool<TComponents>()...);
+	}
+
+	template <typename ...TComponents>
+	ComponentView<TComponents...> Registry::View(System const& system)
+	{
+        if (storageMode == StorageMode::ARCHETYPE)
+        {
+            Signature required;
+            (required.set(Component<TComponents>::GetId()), ...);
+            return ComponentView<TComponents...>(this, &system, archetypeStorage.GetMatchingArchetypes(required));
+        }
+		return ComponentView<TComponents...>(this, &system, GetPool<TComponents>()...);
+	}
+
+	template <typename TComponent>
+	Pool<TComponent>* Registry::GetPool() const
+	{
+		const auto componentId = Component<TComponent>::GetId();
+		if (storageMode == StorageMode::ARCHETYPE || componentId >= componentPools.size())
+		{
+			return nullptr;
+		}
+		return static_cast<Pool<TComponent>*>(componentPools[componentId].get());
+	}
+
 	template <typename TComponent, typename ...TArgs>
 	void Entity::AddComponent(TArgs&& ...args)
 	{
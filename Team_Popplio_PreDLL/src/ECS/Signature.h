@@ -0,0 +1,256 @@
+/******************************************************************************/
+/*!
+\file   Signature.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for the component signature of the
+        Entity Component System of the engine
+
+        The signature is a fixed-size bit set stored as aligned 64-bit words
+        so that matching can be done a whole SIMD register at a time
+        Define POPPLIO_MAX_COMPONENTS (multiple of 64) to change its width
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POPPLIO_SIGNATURE_AVX2
+#define POPPLIO_SIGNATURE_LANE_WORDS 4
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POPPLIO_SIGNATURE_SSE2
+#define POPPLIO_SIGNATURE_LANE_WORDS 2
+#else
+#define POPPLIO_SIGNATURE_LANE_WORDS 1
+#endif
+
+#ifndef POPPLIO_MAX_COMPONENTS
+#define POPPLIO_MAX_COMPONENTS 128
+#endif
+
+namespace Popplio
+{
+	static const unsigned int MAX_COMPONENTS = POPPLIO_MAX_COMPONENTS;
+
+	static_assert(MAX_COMPONENTS >= 64 && MAX_COMPONENTS % 64 == 0,
+		"POPPLIO_MAX_COMPONENTS must be a non-zero multiple of 64");
+
+	/**
+	* @brief The set of component types of an entity or required by a system.
+	*
+	* Bit i is set if the component with id i is present / required.
+	* Provides the subset of the std::bitset interface used by the ECS.
+	*/
+	class alignas(32) Signature
+	{
+	public:
+		static const unsigned int WORD_BITS = 64;
+		static const unsigned int WORD_COUNT = MAX_COMPONENTS / WORD_BITS;
+
+		// Words actually stored, padded with zero words to fill whole SIMD registers
+		static const unsigned int STORAGE_WORDS =
+			(WORD_COUNT + POPPLIO_SIGNATURE_LANE_WORDS - 1) / POPPLIO_SIGNATURE_LANE_WORDS * POPPLIO_SIGNATURE_LANE_WORDS;
+
+		Signature() : words{} {}
+
+		/**
+		* @brief Sets the bit of a component id.
+		*
+		* @param pos The component id.
+		* @param value The value of the bit.
+		* @return Signature& This signature.
+		*/
+		Signature& set(size_t pos, bool value = true)
+		{
+			const std::uint64_t mask = std::uint64_t{ 1 } << (pos % WORD_BITS);
+			if (value) words[pos / WORD_BITS] |= mask;
+			else words[pos / WORD_BITS] &= ~mask;
+			return *this;
+		}
+
+		/**
+		* @brief Clears the bit of a component id.
+		*/
+		Signature& reset(size_t pos)
+		{
+			return set(pos, false);
+		}
+
+		/**
+		* @brief Clears every bit.
+		*/
+		Signature& reset()
+		{
+			for (std::uint64_t& word : words) word = 0;
+			return *this;
+		}
+
+		/**
+		* @brief Checks the bit of a component id.
+		*/
+		bool test(size_t pos) const
+		{
+			return (words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1u;
+		}
+
+		/**
+		* @brief Checks if no bit is set.
+		*/
+		bool none() const
+		{
+			std::uint64_t any = 0;
+			for (std::uint64_t word : words) any |= word;
+			return any == 0;
+		}
+
+		/**
+		* @brief Checks if any bit is set.
+		*/
+		bool any() const
+		{
+			return !none();
+		}
+
+		/**
+		* @brief Gets the number of bits of the signature.
+		*/
+		static constexpr size_t size()
+		{
+			return MAX_COMPONENTS;
+		}
+
+		/**
+		* @brief Gets a 64-bit word of the signature.
+		*
+		* @param index The word index, bit i of the signature is bit (i % 64) of word (i / 64).
+		* @return std::uint64_t The word.
+		*/
+		std::uint64_t GetWord(size_t index) const
+		{
+			return words[index];
+		}
+
+		/**
+		* @brief Checks if every bit set in required is also set in this signature.
+		*
+		* Equivalent to (*this & required) == required, without building a temporary.
+		*
+		* @param required The required bits (e.g. the signature of a system).
+		* @return bool True if this signature contains all of required.
+		*/
+		bool Contains(Signature const& required) const
+		{
+#if defined(POPPLIO_SIGNATURE_AVX2)
+			__m256i missing = _mm256_setzero_si256();
+			for (unsigned int i = 0; i < STORAGE_WORDS; i += 4)
+			{
+				const __m256i have = _mm256_load_si256(reinterpret_cast<__m256i const*>(words + i));
+				const __m256i need = _mm256_load_si256(reinterpret_cast<__m256i const*>(required.words + i));
+				missing = _mm256_or_si256(missing, _mm256_andnot_si256(have, need));
+			}
+			return _mm256_testz_si256(missing, missing) != 0;
+#elif defined(POPPLIO_SIGNATURE_SSE2)
+			__m128i missing = _mm_setzero_si128();
+			for (unsigned int i = 0; i < STORAGE_WORDS; i += 2)
+			{
+				const __m128i have = _mm_load_si128(reinterpret_cast<__m128i const*>(words + i));
+				const __m128i need = _mm_load_si128(reinterpret_cast<__m128i const*>(required.words + i));
+				missing = _mm_or_si128(missing, _mm_andnot_si128(have, need));
+			}
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xFFFF;
+#else
+			std::uint64_t missing = 0;
+			for (unsigned int i = 0; i < WORD_COUNT; ++i) missing |= required.words[i] & ~words[i];
+			return missing == 0;
+#endif
+		}
+
+		Signature& operator&=(Signature const& rhs)
+		{
+			for (unsigned int i = 0; i < WORD_COUNT; ++i) words[i] &= rhs.words[i];
+			return *this;
+		}
+
+		Signature& operator|=(Signature const& rhs)
+		{
+			for (unsigned int i = 0; i < WORD_COUNT; ++i) words[i] |= rhs.words[i];
+			return *this;
+		}
+
+		Signature& operator^=(Signature const& rhs)
+		{
+			for (unsigned int i = 0; i < WORD_COUNT; ++i) words[i] ^= rhs.words[i];
+			return *this;
+		}
+
+		// Operands are taken by reference, 32-byte aligned parameters cannot be passed by value on x86
+		friend Signature operator&(Signature const& lhs, Signature const& rhs)
+		{
+			Signature result = lhs;
+			return result &= rhs;
+		}
+
+		friend Signature operator|(Signature const& lhs, Signature const& rhs)
+		{
+			Signature result = lhs;
+			return result |= rhs;
+		}
+
+		friend Signature operator^(Signature const& lhs, Signature const& rhs)
+		{
+			Signature result = lhs;
+			return result ^= rhs;
+		}
+
+		friend bool operator==(Signature const& lhs, Signature const& rhs)
+		{
+			std::uint64_t diff = 0;
+			for (unsigned int i = 0; i < WORD_COUNT; ++i) diff |= lhs.words[i] ^ rhs.words[i];
+			return diff == 0;
+		}
+
+		friend bool operator!=(Signature const& lhs, Signature const& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+	private:
+		alignas(32) std::uint64_t words[STORAGE_WORDS];
+	};
+}
+
+namespace std
+{
+	/**
+	* @brief Hash of a Signature, so it can key unordered containers (e.g. the archetype map).
+	*/
+	template <>
+	struct hash<Popplio::Signature>
+	{
+		size_t operator()(Popplio::Signature const& signature) const noexcept
+		{
+			std::uint64_t h = 1469598103934665603ull;
+			for (unsigned int i = 0; i < Popplio::Signature::WORD_COUNT; ++i)
+			{
+				h = (h ^ signature.GetWord(i)) * 1099511628211ull;
+			}
+			return static_cast<size_t>(h);
+		}
+	};
+}
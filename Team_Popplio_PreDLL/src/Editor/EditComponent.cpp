@@ -29,10 +29,11 @@ Technology is prohibited.
 #include "../UI/FunctionRegistry.h"  
 #include "../UI/UISystem.h"
 #include "../Particles/ParticleSystem.h"
+#include "../Graphic/RenderSystem.h"
 
 #include "../Mono/MonoUtilities.h"
 
-#include "../PerformanceViewer/PerformanceViewer.h"
+#include "../PerformanceViewer/Profiler.h"
 
 #include <mono/metadata/attrdefs.h>
 
@@ -476,6 +477,7 @@ namespace Popplio
         {
             if (!isChanged) oldState = render;
             render.meshType = static_cast<MeshType>(currentMeshType);
+            reg.GetSystem<RenderSystem>().ReclassifyForCulling(*selectedEntity);
             if (!isChanged) isChanged = true;
         }
 
@@ -1127,6 +1129,7 @@ namespace Popplio
             {
                 if (!isChanged) { oldState = ui; isChanged = true; }
                 ui.type = static_cast<UIType>(currentType);
+                reg.GetSystem<RenderSystem>().ReclassifyForCulling(*selectedEntity);
             }
 
             // Enable or Disable Hover Effect
@@ -3237,9 +3240,8 @@ namespace Popplio
         if (isPlaying)
         {
             // Animation update
-            PerformanceViewer::GetInstance()->start("animation");
+            POPPLIO_PROFILE_ZONE("animation");
             reg.GetSystem<AnimationSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-            PerformanceViewer::GetInstance()->end("animation");
         }
 
         if (ImGui::BeginCombo("Animation", animation.currentAnimation.c_str()))
@@ -3958,9 +3960,8 @@ namespace Popplio
             }
 
             // Audio update
-            PerformanceViewer::GetInstance()->start("audio");
+            POPPLIO_PROFILE_ZONE("audio");
             reg.GetSystem<AudioSystem>().Update();
-            PerformanceViewer::GetInstance()->end("audio");
         }
 
         // Track slider
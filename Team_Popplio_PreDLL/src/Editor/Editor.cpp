@@ -27,11 +27,21 @@ Technology is prohibited.
 
 #include "../Cloning/CloneEntityEvent.h"
 #include "../Graphic/RenderSystem.h"
-#include "../PerformanceViewer/PerformanceViewer.h"
+#include "../PerformanceViewer/Profiler.h"
 #include "../Input/InputSystem.h"
 #include "../Utilities/QueueSystem.h"
 #include"../UI/UISystem.h"
 #include "../Hierarchy/HierarchySystem.h"
+#include "../Script/LogicSystem.h"
+
+#include "../../tests/TestECS.h"
+#include "../../tests/TestCollision.h"
+#include "../../tests/TestRender.h"
+#include "../../tests/TestEvent.h"
+#include "../../tests/TestLogging.h"
+#include "../../tests/TestProfiler.h"
+#include "../../tests/TestScripts.h"
+#include "../../tests/TestAssets.h"
 
 #include <ImGuizmo/ImGuizmo.h>
 
@@ -259,9 +269,10 @@ namespace Popplio
 		// ImGui //
 
 		// process editor's queued events
-		PerformanceViewer::GetInstance()->start("editor queue");
-		if (!reg.GetSystem<QueueSystem>().IsProcessingEditor()) reg.GetSystem<QueueSystem>().ProcessEditor();
-		PerformanceViewer::GetInstance()->end("editor queue");
+		{
+			POPPLIO_PROFILE_ZONE("editor queue");
+			if (!reg.GetSystem<QueueSystem>().IsProcessingEditor()) reg.GetSystem<QueueSystem>().ProcessEditor();
+		}
 
 		// Go to run start / end if killqueue is still not empty
 		if (isStarting)
@@ -293,31 +304,33 @@ namespace Popplio
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 			glViewport(0, 0, Engine::Config::windowWidth, Engine::Config::windowHeight);
 
-			PerformanceViewer::GetInstance()->start("rendering");
-			reg.GetSystem<RenderSystem>().Update();
-			PerformanceViewer::GetInstance()->end("rendering");
+			{
+				POPPLIO_PROFILE_ZONE("rendering");
+				reg.GetSystem<RenderSystem>().Update();
+			}
 
-			PerformanceViewer::GetInstance()->start("ui");
-			reg.GetSystem<UISystem>().Update();
-			PerformanceViewer::GetInstance()->end("ui");
+			{
+				POPPLIO_PROFILE_ZONE("ui");
+				reg.GetSystem<UISystem>().Update();
+			}
 			return;
 		}
 
-		PerformanceViewer::GetInstance()->start("rendering");
-		reg.GetSystem<RenderSystem>().Update();
-		PerformanceViewer::GetInstance()->end("rendering");
+		{
+			POPPLIO_PROFILE_ZONE("rendering");
+			reg.GetSystem<RenderSystem>().Update();
+		}
 
 		if (editorState != State::EDITING)
 		{
-			PerformanceViewer::GetInstance()->start("runtime render");
+			POPPLIO_PROFILE_ZONE("runtime render");
 			RunRender();
 			//HandleButtonInput();
-            PerformanceViewer::GetInstance()->end("runtime render");
 		}
 
 		// Code here for engine gui render //
 
-		Popplio::PerformanceViewer::GetInstance()->start("graphical user interface + imgui");
+		POPPLIO_PROFILE_ZONE("graphical user interface + imgui");
 		// ImGui Dock Windows
 
 		if (showSimulationControls) RenderSimulationControls();
@@ -353,7 +366,6 @@ namespace Popplio
 			ImGui::RenderPlatformWindowsDefault();
 			glfwMakeContextCurrent(backup_current_context);
 		}
-		Popplio::PerformanceViewer::GetInstance()->end("graphical user interface + imgui");
 
 		//std::cout << "InputSys: " << InputSystem::GetMouse().x << "," << InputSystem::GetMouse().y << std::endl;
 		//std::cout << "ImGui: " << ImGui::GetMousePos().x << "," << ImGui::GetMousePos().y << std::endl;
@@ -932,6 +944,124 @@ namespace Popplio
 			reg.ClearInstancedEntities();
 		}
 
+		ImGui::SeparatorText("ECS Benchmarks");
+
+		if (ImGui::Button("Pool GetComponent"))
+		{
+			PopplioTest::BenchmarkPoolGetComponent();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Sparse Set vs Archetype"))
+		{
+			PopplioTest::BenchmarkStorageModes();
+		}
+
+		if (ImGui::Button("Immediate vs Deferred Spawn"))
+		{
+			PopplioTest::BenchmarkStructuralChanges();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("100k Entity Churn"))
+		{
+			PopplioTest::StressTestEntityChurn();
+		}
+
+		ImGui::SeparatorText("Collision Benchmarks");
+
+		if (ImGui::Button("Broad Phase 100 / 1k / 10k"))
+		{
+			PopplioTest::BenchmarkBroadPhase();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Layer Filtering 1M Pairs"))
+		{
+			PopplioTest::BenchmarkLayerFiltering();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Contact Pairs 10k"))
+		{
+			PopplioTest::BenchmarkContactPairs();
+		}
+
+		ImGui::SeparatorText("Render Benchmarks");
+
+		if (ImGui::Button("Render Queue 100k"))
+		{
+			PopplioTest::BenchmarkRenderQueue();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Sprite Batching 100k"))
+		{
+			PopplioTest::BenchmarkSpriteBatching();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Atlas Packing 2k"))
+		{
+			PopplioTest::BenchmarkAtlasPacking();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Text Layout 10k"))
+		{
+			PopplioTest::BenchmarkTextLayout();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Culling 22k"))
+		{
+			PopplioTest::BenchmarkCulling();
+		}
+
+		ImGui::SeparatorText("Event Benchmarks");
+
+		if (ImGui::Button("Event Bus 1M Emits"))
+		{
+			PopplioTest::BenchmarkEventBus();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Queued Events 10k"))
+		{
+			PopplioTest::BenchmarkQueuedEvents();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Logger 100k"))
+		{
+			PopplioTest::BenchmarkLogger();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Profiler 1M Zones"))
+		{
+			PopplioTest::BenchmarkProfiler();
+		}
+
+		ImGui::SeparatorText("Script Benchmarks");
+
+		if (ImGui::Button("Script Dispatch 1k"))
+		{
+			PopplioTest::BenchmarkScriptDispatch(reg.GetSystem<LogicSystem>().monoAPI);
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Component Access 1k"))
+		{
+			PopplioTest::BenchmarkComponentAccess(reg.GetSystem<LogicSystem>().monoAPI, reg);
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Assembly Reload"))
+		{
+			PopplioTest::BenchmarkAssemblyReload(reg.GetSystem<LogicSystem>().monoAPI);
+		}
+
+		ImGui::SeparatorText("Asset Benchmarks");
+
+		if (ImGui::Button("Asset Loading 1/4/8 Workers"))
+		{
+			PopplioTest::BenchmarkAssetLoading(reg.GetSystem<AudioSystem>(), reg.GetSystem<LogicSystem>());
+		}
+
 		ImGui::End();
 	}
 
@@ -275,6 +275,7 @@ namespace Popplio
 		void RenderChartEditor();
 		void RenderScriptDirectoryGUI();
 		void RenderLayerMatrix();
+		void RenderCollisionSettings();
 
 		// Logger
 		void LogClearOnRun();
@@ -41,6 +41,7 @@ Technology is prohibited.
 #include "../Serialization/Serialization.h"
 
 #include "../PerformanceViewer/PerformanceViewer.h"
+#include "../PerformanceViewer/Profiler.h"
 
 #include "../Utilities/OnAppQuit.h"
 
@@ -89,47 +90,60 @@ namespace Popplio
 	void Editor::RunUpdate()
 	{
 		// Fixed Logic updates
-		PerformanceViewer::GetInstance()->start("fixed logic");
-		reg.GetSystem<LogicSystem>().FixedUpdate();
-		PerformanceViewer::GetInstance()->end("fixed logic");
+		{
+			POPPLIO_PROFILE_ZONE("fixed logic");
+			reg.GetSystem<LogicSystem>().FixedUpdate();
+		}
 
 		// Logic updates
-		PerformanceViewer::GetInstance()->start("logic");
-		reg.GetSystem<LogicSystem>().Update();
-		PerformanceViewer::GetInstance()->end("logic");
+		{
+			POPPLIO_PROFILE_ZONE("logic");
+			reg.GetSystem<LogicSystem>().Update();
+		}
 
 		// Particle updates
-		PerformanceViewer::GetInstance()->start("particles");
-		reg.GetSystem<ParticleSystem>().Update(Engine::timer.GetFixedDeltaTime());
-		PerformanceViewer::GetInstance()->end("particles");
+		{
+			POPPLIO_PROFILE_ZONE("particles");
+			reg.GetSystem<ParticleSystem>().Update(Engine::timer.GetFixedDeltaTime());
+		}
 
 		// Transform updates
-		Popplio::PerformanceViewer::GetInstance()->start("transformation");
-		reg.GetSystem<TransformationSystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("transformation");
+		{
+			POPPLIO_PROFILE_ZONE("transformation");
+			reg.GetSystem<TransformationSystem>().Update();
+		}
 
-		Popplio::PerformanceViewer::GetInstance()->start("hierarchy");
-		reg.GetSystem<HierarchySystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("hierarchy");
+		{
+			POPPLIO_PROFILE_ZONE("hierarchy");
+			reg.GetSystem<HierarchySystem>().Update();
+		}
 
 		// Physics updates
-		PerformanceViewer::GetInstance()->start("gravity");
-		reg.GetSystem<GravitySystem>().Update();
-		PerformanceViewer::GetInstance()->end("gravity");
+		{
+			POPPLIO_PROFILE_ZONE("gravity");
+			reg.GetSystem<GravitySystem>().Update();
+		}
 
-		PerformanceViewer::GetInstance()->start("Movement");
-		reg.GetSystem<MovementSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("Movement");
+		{
+			POPPLIO_PROFILE_ZONE("Movement");
+			reg.GetSystem<MovementSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
+		}
 
 		// Collision updates
-		PerformanceViewer::GetInstance()->start("collision");
-		reg.GetSystem<CollisionSystem>().Update(reg, static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("collision");
+		{
+			POPPLIO_PROFILE_ZONE("collision");
+			reg.GetSystem<CollisionSystem>().Update(reg, static_cast<float>(Engine::timer.GetFixedDeltaTime()));
+		}
+
+		// Queued events (collisions / triggers), delivered after physics so handlers do not run mid-iteration
+		{
+			POPPLIO_PROFILE_ZONE("events");
+			PerformanceViewer::GetInstance()->SetCounter("Queued events", eventBus.DeliverQueuedEvents());
+		}
 
 		// resolve queue
-		PerformanceViewer::GetInstance()->start("queue");
+		POPPLIO_PROFILE_ZONE("queue");
 		if (!reg.GetSystem<QueueSystem>().IsProcessing()) reg.GetSystem<QueueSystem>().Process();
-		PerformanceViewer::GetInstance()->end("queue");
 
 		// Animation update
 		//PerformanceViewer::GetInstance()->start("animation");
@@ -142,24 +156,26 @@ namespace Popplio
 	void Editor::RunRender()
 	{
 		// Animation update
-		PerformanceViewer::GetInstance()->start("animation");
-		reg.GetSystem<AnimationSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("animation");
+		{
+			POPPLIO_PROFILE_ZONE("animation");
+			reg.GetSystem<AnimationSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
+		}
 
 		// Particle update
-		PerformanceViewer::GetInstance()->start("particles");
-		reg.GetSystem<ParticleSystem>().Update(Engine::timer.GetFixedDeltaTime());
-		PerformanceViewer::GetInstance()->end("particles");
+		{
+			POPPLIO_PROFILE_ZONE("particles");
+			reg.GetSystem<ParticleSystem>().Update(Engine::timer.GetFixedDeltaTime());
+		}
 
 		// UI
-		PerformanceViewer::GetInstance()->start("ui");
-		reg.GetSystem<UISystem>().Update();
-		PerformanceViewer::GetInstance()->end("ui");
+		{
+			POPPLIO_PROFILE_ZONE("ui");
+			reg.GetSystem<UISystem>().Update();
+		}
 
 		// Audio update
-		PerformanceViewer::GetInstance()->start("audio");
+		POPPLIO_PROFILE_ZONE("audio");
 		reg.GetSystem<AudioSystem>().Update();
-		PerformanceViewer::GetInstance()->end("audio");
 	}
 
 	void Editor::RunEnd()
@@ -178,31 +194,40 @@ namespace Popplio
 	{
 
 		// Transform updates
-		Popplio::PerformanceViewer::GetInstance()->start("fixed transformation");
-		reg.GetSystem<TransformationSystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("fixed transformation");
+		{
+			POPPLIO_PROFILE_ZONE("fixed transformation");
+			reg.GetSystem<TransformationSystem>().Update();
+		}
 
-		Popplio::PerformanceViewer::GetInstance()->start("fixed hierarchy");
-		reg.GetSystem<HierarchySystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("fixed hierarchy");
+		{
+			POPPLIO_PROFILE_ZONE("fixed hierarchy");
+			reg.GetSystem<HierarchySystem>().Update();
+		}
 
 		// Physics updates
-		PerformanceViewer::GetInstance()->start("fixed gravity");
-		reg.GetSystem<GravitySystem>().Update();
-		PerformanceViewer::GetInstance()->end("fixed gravity");
+		{
+			POPPLIO_PROFILE_ZONE("fixed gravity");
+			reg.GetSystem<GravitySystem>().Update();
+		}
 
-		PerformanceViewer::GetInstance()->start("fixed Movement");
-		reg.GetSystem<MovementSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("fixed Movement");
+		{
+			POPPLIO_PROFILE_ZONE("fixed Movement");
+			reg.GetSystem<MovementSystem>().Update(static_cast<float>(Engine::timer.GetFixedDeltaTime()));
+		}
 
 		// Collision updates
-		PerformanceViewer::GetInstance()->start("fixed collision");
-		reg.GetSystem<CollisionSystem>().Update(reg, static_cast<float>(Engine::timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("fixed collision");
+		{
+			POPPLIO_PROFILE_ZONE("fixed collision");
+			reg.GetSystem<CollisionSystem>().Update(reg, static_cast<float>(Engine::timer.GetFixedDeltaTime()));
+		}
+
+		{
+			POPPLIO_PROFILE_ZONE("fixed events");
+			eventBus.DeliverQueuedEvents();
+		}
 
-		PerformanceViewer::GetInstance()->start("queue");
+		POPPLIO_PROFILE_ZONE("queue");
 		if (!reg.GetSystem<QueueSystem>().IsProcessing()) reg.GetSystem<QueueSystem>().Process();
-		PerformanceViewer::GetInstance()->end("queue");
 	}
 
 	void Editor::StartScene() // start scene
@@ -20,6 +20,7 @@ Technology is prohibited.
 /******************************************************************************/
 #include <pch.h>
 #include "Editor.h"
+#include "../Collision/CollisionSystem.h"
 
 namespace Popplio
 {
@@ -51,6 +52,12 @@ namespace Popplio
 				ImGui::EndTabItem();
 			}
 
+			if (ImGui::BeginTabItem("Collision"))
+			{
+				RenderCollisionSettings();
+				ImGui::EndTabItem();
+			}
+
 			ImGui::EndTabBar();
 		}
 
@@ -218,6 +225,40 @@ namespace Popplio
 		ImGui::End();
 	}
 
+	void Editor::RenderCollisionSettings()
+	{
+		// Saved with the scene
+		auto& collisionSystem = reg.GetSystem<CollisionSystem>();
+
+		static const BroadPhaseType types[] =
+			{ BroadPhaseType::BRUTE_FORCE, BroadPhaseType::SPATIAL_HASH, BroadPhaseType::SORT_AND_SWEEP };
+
+		BroadPhaseType current = collisionSystem.GetBroadPhaseType();
+		float cellSize = collisionSystem.GetCellSize();
+
+		if (ImGui::BeginCombo("Broad Phase", BroadPhaseTypeToString(current).c_str()))
+		{
+			for (BroadPhaseType type : types)
+			{
+				if (ImGui::Selectable(BroadPhaseTypeToString(type).c_str(), type == current))
+				{
+					collisionSystem.SetBroadPhase(type, cellSize);
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		if (current == BroadPhaseType::SPATIAL_HASH)
+		{
+			if (ImGui::InputFloat("Cell Size", &cellSize, 8.f, 64.f, "%.0f", ImGuiInputTextFlags_EnterReturnsTrue))
+			{
+				collisionSystem.SetBroadPhase(current, cellSize);
+			}
+		}
+
+		ImGui::Text("Pairs tested last step: %zu", collisionSystem.GetPairsTested());
+	}
+
 	void Editor::RenderLayerMatrix()
 	{
 		auto sortedLayers = layerManager.GetSortedLayers();
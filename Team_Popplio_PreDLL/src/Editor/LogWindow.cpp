@@ -111,8 +111,9 @@ namespace Popplio
             }
 
             const auto& logBuffer = Logger::GetLogBuffer();
-            for (const auto& entry : logBuffer)
+            for (size_t i{}; i < logBuffer.Size(); ++i)
             {
+                const LogEntry& entry = logBuffer[i];
                 ImGui::PushStyleColor(ImGuiCol_Text, entry.color);
                 ImGui::TextUnformatted(entry.message.data(), entry.message.data() + entry.message.size());
                 ImGui::PopStyleColor();
@@ -20,6 +20,8 @@ Technology is prohibited.
 #include <pch.h>
 #include "Editor.h"
 #include "../PerformanceViewer/PerformanceViewer.h"
+#include "../PerformanceViewer/Profiler.h"
+#include "../Graphic/RenderSystem.h"
 
 namespace Popplio
 {
@@ -68,73 +70,108 @@ namespace Popplio
 			}
 			else
 			{
-				if (ImGui::BeginTable("Performance Table", 3, flags))
+				// Profiler zones, nested under the zones they ran in, times over the last frames
+				std::vector<ProfileZoneStats> const& zoneStats = Profiler::GetZoneStats();
+				double frameMs = 0.0;
+				for (ProfileZoneStats const& zone : zoneStats)
 				{
-					ImGui::TableSetupColumn("Name");
-					ImGui::TableSetupColumn("Time (Microseconds | us)");
-					ImGui::TableSetupColumn("Time %");
+					if (zone.depth == 0 && PerformanceViewer::_MainEngine == zone.name) frameMs = zone.lastMs;
+				}
+
+				if (ImGui::BeginTable("Performance Table", 8, flags))
+				{
+					ImGui::TableSetupColumn("Zone");
+					ImGui::TableSetupColumn("Last (ms)");
+					ImGui::TableSetupColumn("Min");
+					ImGui::TableSetupColumn("Avg");
+					ImGui::TableSetupColumn("P95");
+					ImGui::TableSetupColumn("Max");
+					ImGui::TableSetupColumn("Calls");
+					ImGui::TableSetupColumn("Frame %");
 					ImGui::TableHeadersRow();
 
-					std::vector<std::string> sysNameVec{};
-					for (auto& it : pvInstance->GetAllSystemTimeMap())
+					for (ProfileZoneStats const& zone : zoneStats)
 					{
-						sysNameVec.push_back(it.first);
+						ImGui::TableNextRow();
+						ImGui::TableSetColumnIndex(0);
+						if (zone.depth == 0 && zone.threadIndex != 0) ImGui::Text("[Thread %u] %s", zone.threadIndex, zone.name);
+						else ImGui::Text("%*s%s", static_cast<int>(zone.depth * 2), "", zone.name);
+						ImGui::TableSetColumnIndex(1);
+						ImGui::Text("%.3f", zone.lastMs);
+						ImGui::TableSetColumnIndex(2);
+						ImGui::Text("%.3f", zone.minMs);
+						ImGui::TableSetColumnIndex(3);
+						ImGui::Text("%.3f", zone.avgMs);
+						ImGui::TableSetColumnIndex(4);
+						ImGui::Text("%.3f", zone.p95Ms);
+						ImGui::TableSetColumnIndex(5);
+						ImGui::Text("%.3f", zone.maxMs);
+						ImGui::TableSetColumnIndex(6);
+						ImGui::Text("%u", zone.calls);
+						ImGui::TableSetColumnIndex(7);
+						ImGui::Text("%.1f%%", frameMs > 0.0 ? zone.lastMs / frameMs * 100.0 : 0.0);
 					}
+					ImGui::EndTable();
+				}
+			}
 
-					//make Engine the first ROW
-					ImGui::TableNextRow();
-					for (int col = 0; col < 3; ++col)
-					{
-						ImGui::TableSetColumnIndex(col);
-						std::string buf{};
-						switch (col)
-						{
-						case 0:
-							//sprintf_s(buf, "Hi %s", (std::string)(sysNameVec[row]));
-							buf = PerformanceViewer::_MainEngine;
-							break;
-						case 1:
-							//sprintf_s(buf, "Hello %ld", pvInstance->GetSystemTime(sysNameVec[row]).count());
-							buf = std::to_string(pvInstance->GetSystemTime(PerformanceViewer::_MainEngine).count()) + " us";
-							break;
-						case 2:
-							//sprintf_s(buf, "%d", pvInstance->GetSystemTimePercentage(sysNameVec[row]));
-							buf = std::to_string(pvInstance->GetSystemTimePercentage(PerformanceViewer::_MainEngine)) + "%";
-							break;
-						}
-						ImGui::TextUnformatted(buf.c_str());
-					}
+			// Chrome trace of the frames between start and stop, open in chrome://tracing or Perfetto
+			if (!Profiler::IsCapturing())
+			{
+				if (ImGui::Button("Start Trace Capture")) Profiler::StartCapture();
+			}
+			else
+			{
+				if (ImGui::Button("Stop and Save Trace"))
+				{
+					std::time_t now = std::time(nullptr);
+					std::tm localTime{};
+					localtime_s(&localTime, &now);
+					std::stringstream path{};
+					path << "Profiles/trace_" << std::put_time(&localTime, "%Y%m%d_%H%M%S") << ".json";
+
+					std::filesystem::create_directories("Profiles");
+					Profiler::StopCapture(path.str());
+				}
+				ImGui::SameLine();
+				ImGui::Text("%zu zones captured", Profiler::GetCaptureEventCount());
+			}
+			if (Profiler::GetDroppedEventCount() > 0)
+				ImGui::Text("Zones dropped (thread buffers full): %zu", Profiler::GetDroppedEventCount());
 
+			// Counters reported by the systems
+			if (!pvInstance->GetAllCounters().empty())
+			{
+				ImGui::SeparatorText("Counters");
+				for (auto const& [name, value] : pvInstance->GetAllCounters())
+				{
+					ImGui::Text("%s: %zu", name.c_str(), value);
+				}
+			}
 
-					for (int row = 0; row < pvInstance->GetNumSystemsRegistered(); ++row)
-					{
-						// skip the engine category
-						if (sysNameVec[row] == PerformanceViewer::_MainEngine) continue;
+			// Structural changes applied by the registry last frame
+			Registry::StructuralChangeStats const& stats = reg.GetStructuralChangeStats();
+			ImGui::SeparatorText("ECS Structural Changes");
+			ImGui::Text("Entities created: %u  destroyed: %u", stats.entitiesCreated, stats.entitiesDestroyed);
+			ImGui::Text("Components added: %u  removed: %u", stats.componentsAdded, stats.componentsRemoved);
+			ImGui::Text("Deferred commands: %u", stats.deferredCommands);
 
-						ImGui::TableNextRow();
-						for (int col = 0; col < 3; ++col)
-						{
-							ImGui::TableSetColumnIndex(col);
-							std::string buf{};
-							switch (col)
-							{
-							case 0:
-								//sprintf_s(buf, "Hi %s", (std::string)(sysNameVec[row]));
-								buf = sysNameVec[row];
-								break;
-							case 1:
-								//sprintf_s(buf, "Hello %ld", pvInstance->GetSystemTime(sysNameVec[row]).count());
-								buf = std::to_string(pvInstance->GetSystemTime(sysNameVec[row]).count()) + " us";
-								break;
-							case 2:
-								//sprintf_s(buf, "%d", pvInstance->GetSystemTimePercentage(sysNameVec[row]));
-								buf = std::to_string(pvInstance->GetSystemTimePercentage(sysNameVec[row])) + "%";
-								break;
-							}
-							ImGui::TextUnformatted(buf.c_str());
-						}
-					}
-					ImGui::EndTable();
+			// Render queue counters of the last render pass
+			if (reg.HasSystem<RenderSystem>())
+			{
+				RenderStats const& renderStats = reg.GetSystem<RenderSystem>().GetRenderStats();
+				ImGui::SeparatorText("Rendering");
+				ImGui::Text("Commands: %u  Draw calls: %u", renderStats.commands, renderStats.drawCalls);
+				ImGui::Text("Shader switches: %u  Texture binds: %u", renderStats.shaderSwitches, renderStats.textureBinds);
+				ImGui::Text("Batched sprites: %u  Batched glyphs: %u  Instances: %u",
+					renderStats.batchedSprites, renderStats.batchedGlyphs, renderStats.instances);
+
+				// OpenGL calls of the last render pass, by kind
+				ImGui::Text("GL calls: %u", GLCallCounter::GetTotal());
+				for (std::uint8_t call = 0; call < GLCallCounter::COUNT; ++call)
+				{
+					const auto kind = static_cast<GLCallCounter::Call>(call);
+					ImGui::BulletText("%s: %u", GLCallCounter::GetName(kind), GLCallCounter::Get(kind));
 				}
 			}
 		}
@@ -29,6 +29,8 @@ Technology is prohibited.
 
 #include "../Cloning/CloneSystem.h"
 
+#include "../Graphic/RenderSystem.h"
+
 #include "EntitySelectionEvents.h"
 
 namespace Popplio
@@ -66,6 +68,10 @@ namespace Popplio
                     // update for audio components
                     if (std::is_same_v<T, AudioComponent>) 
                         latestChange.entities[i].GetComponent<AudioComponent>().Update(reg.GetSystem<AudioSystem>());
+
+                    // the mesh or UI type decides culling
+                    if (std::is_same_v<T, RenderComponent> || std::is_same_v<T, UIComponent>)
+                        reg.GetSystem<RenderSystem>().ReclassifyForCulling(latestChange.entities[i]);
                     break;
                 }
                 case ChangeAction::REMOVE_COMPONENT:
@@ -105,6 +111,10 @@ namespace Popplio
                     // update for audio components
                     if (std::is_same_v<T, AudioComponent>) 
                         latestUndo.entities[i].GetComponent<AudioComponent>().Update(reg.GetSystem<AudioSystem>());
+
+                    // the mesh or UI type decides culling
+                    if (std::is_same_v<T, RenderComponent> || std::is_same_v<T, UIComponent>)
+                        reg.GetSystem<RenderSystem>().ReclassifyForCulling(latestUndo.entities[i]);
                     break;
                 }
                 case ChangeAction::REMOVE_COMPONENT:
@@ -26,6 +26,7 @@ Technology is prohibited.
 
 //Debug
 #include "../PerformanceViewer/PerformanceViewer.h"
+#include "../PerformanceViewer/Profiler.h"
 
 //ECS
 #include "../ECS/ECS.h"
@@ -97,6 +98,7 @@ namespace Popplio
 	int Engine::Config::windowWidth;
 	int Engine::Config::windowHeight;
 	bool Engine::Config::vSync;
+	bool Engine::Config::archetypeStorage;
 
 	bool Engine::Config::safeMode;
     std::string Engine::Config::lastScene;
@@ -322,8 +324,13 @@ namespace Popplio
             Config::lastScene = serializer->GetConfiguration().lastScene;
 			Config::verbose = serializer->GetConfiguration().verbose;
             Config::startScene = serializer->GetConfiguration().startScene;
+			Config::archetypeStorage = serializer->GetConfiguration().archetypeStorage;
 		}
 
+		// No entities exist yet, so the component storage can still be switched
+		registry->SetStorageMode(Config::archetypeStorage ?
+			Registry::StorageMode::ARCHETYPE : Registry::StorageMode::SPARSE_SET);
+
 		window = glfwCreateWindow(Config::windowWidth, Config::windowHeight, "Team Popplio Engine", nullptr, nullptr);
 		if (!window)
 		{
@@ -490,9 +497,9 @@ namespace Popplio
 		registry->AddSystem<GravitySystem>();
 		registry->AddSystem<CloneSystem>(*registry, *layerManager);
 		registry->AddSystem<PrefabSyncSystem>(*registry, *prefabManager);
-		registry->AddSystem<AnimationSystem>();
-		registry->AddSystem<TransformationSystem>();
-		registry->AddSystem<RenderSystem>(window, *layerManager, *cameraManager);
+		registry->AddSystem<AnimationSystem>(*registry);
+		registry->AddSystem<TransformationSystem>(*registry);
+		registry->AddSystem<RenderSystem>(*registry, window, *layerManager, *cameraManager);
 		registry->AddSystem<ParticleSystem>(*registry);
 		registry->AddSystem<HierarchySystem>();
 		registry->AddSystem<RuntimeSystem>(*registry, *eventBus, *monoAPI);
@@ -517,6 +524,7 @@ namespace Popplio
 		editor.Init();
 		editor.LoadScene(Config::lastScene);
 		registry->GetSystem<AnimationSystem>().StopAll();
+		monoAPI->StartObserving(); // hot reload C# scripts rebuilt while the editor runs
 #else
 		serializer->LoadSceneFromFile(Config::startScene, *cameraManager);
 		monoAPI->ReloadAssembly();
@@ -539,23 +547,36 @@ namespace Popplio
 	void Engine::Run()
 	{
 		Logger::Info("Engine loop started", LogDestination::WINDOWS_CONSOLE);
+		Profiler::SetThreadName("Main");
 
 		while (!glfwWindowShouldClose(window))
 		{
-			//if (isPaused) continue;
-			// update delta time and fps
-			Popplio::PerformanceViewer::GetInstance()->start(PerformanceViewer::_MainEngine);
-			timer.Update(framesPerSecond, 1.f);
-			Popplio::PerformanceViewer::GetInstance()->start("total input");
-			ProcessInput();
-			Popplio::PerformanceViewer::GetInstance()->end("total input");
-			Popplio::PerformanceViewer::GetInstance()->start("total update");
-			Update();
-			Popplio::PerformanceViewer::GetInstance()->end("total update");
-			Popplio::PerformanceViewer::GetInstance()->start("total render");
-			Render();
-			Popplio::PerformanceViewer::GetInstance()->end("total render");
-			Popplio::PerformanceViewer::GetInstance()->end(PerformanceViewer::_MainEngine);
+			{
+				//if (isPaused) continue;
+				// update delta time and fps
+				POPPLIO_PROFILE_ZONE("engine");
+				timer.Update(framesPerSecond, 1.f);
+				registry->BeginFrame();
+#ifndef IMGUI_DISABLE
+				// frame boundary, swap in a hot reloaded C# assembly while no scripts run
+				if (registry->GetSystem<Editor>().editorState == Editor::State::EDITING) monoAPI->ApplyPreparedAssembly();
+#endif
+				{
+					POPPLIO_PROFILE_ZONE("total input");
+					ProcessInput();
+				}
+				{
+					POPPLIO_PROFILE_ZONE("total update");
+					Update();
+				}
+				{
+					POPPLIO_PROFILE_ZONE("total render");
+					Render();
+				}
+			}
+
+			// collect the zones of the frame once the engine zone closed
+			Profiler::EndFrame();
 		}
 
 //#ifndef IMGUI_DISABLE
@@ -654,7 +675,7 @@ namespace Popplio
 
 	void Engine::ProcessInput()
 	{
-		Popplio::PerformanceViewer::GetInstance()->start("input");
+		POPPLIO_PROFILE_ZONE("input");
 		glfwPollEvents();
 
 		// Toggle fullscreen/windowed mode
@@ -674,15 +695,15 @@ namespace Popplio
 
 		// Editor toggle input handling
 #ifndef IMGUI_DISABLE
-		Popplio::PerformanceViewer::GetInstance()->start("editor input");
-        registry->GetSystem<Editor>().ProcessInput();
-		Popplio::PerformanceViewer::GetInstance()->end("editor input");
+		{
+			POPPLIO_PROFILE_ZONE("editor input");
+			registry->GetSystem<Editor>().ProcessInput();
+		}
 
 #endif
 		registry->GetSystem<UISystem>().ProcessInput();
 
 		InputSystem::Update();
-		Popplio::PerformanceViewer::GetInstance()->end("input");
 	}
 
 	void Engine::Update()
@@ -746,14 +767,16 @@ namespace Popplio
 		
 		
 		// Update the registry to process the entites that are waiting to be created/deleted
-		Popplio::PerformanceViewer::GetInstance()->start("registry");
-		registry->Update();
-		Popplio::PerformanceViewer::GetInstance()->end("registry");
+		{
+			POPPLIO_PROFILE_ZONE("registry");
+			registry->Update();
+		}
 
 		// Game systems update
-		Popplio::PerformanceViewer::GetInstance()->start("prefabs sync");
-		registry->GetSystem<PrefabSyncSystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("prefabs sync");
+		{
+			POPPLIO_PROFILE_ZONE("prefabs sync");
+			registry->GetSystem<PrefabSyncSystem>().Update();
+		}
 
 #ifndef IMGUI_DISABLE
 		auto& editor = registry->GetSystem<Editor>();
@@ -767,33 +790,32 @@ namespace Popplio
 		//	editor.Update();
 		//}
 
-		Popplio::PerformanceViewer::GetInstance()->start("editor");
-		editor.Update();
-		Popplio::PerformanceViewer::GetInstance()->end("editor");
+		{
+			POPPLIO_PROFILE_ZONE("editor");
+			editor.Update();
+		}
 
 		// Only update game logic if playing
         if (isPlaying)
         {
-			Popplio::PerformanceViewer::GetInstance()->start("editor runtime");
+			POPPLIO_PROFILE_ZONE("editor runtime");
             editor.RunUpdate();
-            Popplio::PerformanceViewer::GetInstance()->end("editor runtime");
         }
 		else
 		{
-			Popplio::PerformanceViewer::GetInstance()->start("transformation");
-			registry->GetSystem<TransformationSystem>().Update();
-			Popplio::PerformanceViewer::GetInstance()->end("transformation");
+			{
+				POPPLIO_PROFILE_ZONE("transformation");
+				registry->GetSystem<TransformationSystem>().Update();
+			}
 
-			Popplio::PerformanceViewer::GetInstance()->start("hierarchy");
+			POPPLIO_PROFILE_ZONE("hierarchy");
 			registry->GetSystem<HierarchySystem>().Update();
-			Popplio::PerformanceViewer::GetInstance()->end("hierarchy");
 		}
 #else
 		if (!isSceneChanging)
 		{
-			Popplio::PerformanceViewer::GetInstance()->start("runtime");
+			POPPLIO_PROFILE_ZONE("runtime");
 			GameUpdate();
-            Popplio::PerformanceViewer::GetInstance()->end("runtime");
 		}
 		else
 		{
@@ -831,9 +853,10 @@ namespace Popplio
 		glfwSetWindowTitle(window, title.str().c_str());
 
 		// Game-only mode rendering - render directly to screen
-		Popplio::PerformanceViewer::GetInstance()->start("runtime render");
-		GameRender();
-        Popplio::PerformanceViewer::GetInstance()->end("runtime render");
+		{
+			POPPLIO_PROFILE_ZONE("runtime render");
+			GameRender();
+		}
 #endif
 
 		// Swap buffers
@@ -883,52 +906,65 @@ namespace Popplio
 	void Engine::GameUpdate() 
 	{
 		// Fixed Logic updates
-		PerformanceViewer::GetInstance()->start("fixed logic");
-		registry->GetSystem<LogicSystem>().FixedUpdate();
-		PerformanceViewer::GetInstance()->end("fixed logic");
+		{
+			POPPLIO_PROFILE_ZONE("fixed logic");
+			registry->GetSystem<LogicSystem>().FixedUpdate();
+		}
 
 		// Logic updates
-		PerformanceViewer::GetInstance()->start("logic");
-		registry->GetSystem<LogicSystem>().Update();
-		PerformanceViewer::GetInstance()->end("logic");
+		{
+			POPPLIO_PROFILE_ZONE("logic");
+			registry->GetSystem<LogicSystem>().Update();
+		}
 
 		// Particle updates
-        PerformanceViewer::GetInstance()->start("particles");
-        registry->GetSystem<ParticleSystem>().Update(timer.GetFixedDeltaTime());
-        PerformanceViewer::GetInstance()->end("particles");
+		{
+			POPPLIO_PROFILE_ZONE("particles");
+			registry->GetSystem<ParticleSystem>().Update(timer.GetFixedDeltaTime());
+		}
 
         // Transform updates
-		Popplio::PerformanceViewer::GetInstance()->start("transformation");
-		registry->GetSystem<TransformationSystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("transformation");
+		{
+			POPPLIO_PROFILE_ZONE("transformation");
+			registry->GetSystem<TransformationSystem>().Update();
+		}
 
-		Popplio::PerformanceViewer::GetInstance()->start("hierarchy");
-		registry->GetSystem<HierarchySystem>().Update();
-		Popplio::PerformanceViewer::GetInstance()->end("hierarchy");
+		{
+			POPPLIO_PROFILE_ZONE("hierarchy");
+			registry->GetSystem<HierarchySystem>().Update();
+		}
 
 		// Physics updates
 		//PerformanceViewer::GetInstance()->start("gravity");
 		//registry->GetSystem<GravitySystem>().Update();
 		//PerformanceViewer::GetInstance()->end("gravity");
 
-		PerformanceViewer::GetInstance()->start("Movement");
-		registry->GetSystem<MovementSystem>().Update(static_cast<float>(timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("Movement");
+		{
+			POPPLIO_PROFILE_ZONE("Movement");
+			registry->GetSystem<MovementSystem>().Update(static_cast<float>(timer.GetFixedDeltaTime()));
+		}
 
 		// Collision updates
-		PerformanceViewer::GetInstance()->start("collision");
-		registry->GetSystem<CollisionSystem>().Update(*registry, static_cast<float>(timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("collision");
+		{
+			POPPLIO_PROFILE_ZONE("collision");
+			registry->GetSystem<CollisionSystem>().Update(*registry, static_cast<float>(timer.GetFixedDeltaTime()));
+		}
+
+		// Queued events (collisions / triggers), delivered after physics so handlers do not run mid-iteration
+		{
+			POPPLIO_PROFILE_ZONE("events");
+			PerformanceViewer::GetInstance()->SetCounter("Queued events", eventBus->DeliverQueuedEvents());
+		}
 
 		// resolve queue
-		PerformanceViewer::GetInstance()->start("queue");
-		if (!(registry->GetSystem<QueueSystem>().IsProcessing())) registry->GetSystem<QueueSystem>().Process();
-		PerformanceViewer::GetInstance()->end("queue");
+		{
+			POPPLIO_PROFILE_ZONE("queue");
+			if (!(registry->GetSystem<QueueSystem>().IsProcessing())) registry->GetSystem<QueueSystem>().Process();
+		}
 
 		// UI
-		PerformanceViewer::GetInstance()->start("ui");
+		POPPLIO_PROFILE_ZONE("ui");
 		registry->GetSystem<UISystem>().Update();
-		PerformanceViewer::GetInstance()->end("ui");
 	}
 
 	//void Engine::GameFixedUpdate() // todo: implement
@@ -973,24 +1009,26 @@ namespace Popplio
 		glViewport(0, 0, Config::windowWidth, Config::windowHeight);
 
 		// Update render system
-		PerformanceViewer::GetInstance()->start("rendering");
-		registry->GetSystem<RenderSystem>().Update();
-		PerformanceViewer::GetInstance()->end("rendering");
+		{
+			POPPLIO_PROFILE_ZONE("rendering");
+			registry->GetSystem<RenderSystem>().Update();
+		}
 
 		// Animation update
-		PerformanceViewer::GetInstance()->start("animation");
-		registry->GetSystem<AnimationSystem>().Update(static_cast<float>(timer.GetFixedDeltaTime()));
-		PerformanceViewer::GetInstance()->end("animation");
+		{
+			POPPLIO_PROFILE_ZONE("animation");
+			registry->GetSystem<AnimationSystem>().Update(static_cast<float>(timer.GetFixedDeltaTime()));
+		}
 
 		// Particle update
-		PerformanceViewer::GetInstance()->start("particles");
-		registry->GetSystem<ParticleSystem>().Update(timer.GetFixedDeltaTime());
-		PerformanceViewer::GetInstance()->end("particles");
+		{
+			POPPLIO_PROFILE_ZONE("particles");
+			registry->GetSystem<ParticleSystem>().Update(timer.GetFixedDeltaTime());
+		}
 
         // Audio update
-		PerformanceViewer::GetInstance()->start("audio");
+		POPPLIO_PROFILE_ZONE("audio");
 		registry->GetSystem<AudioSystem>().Update();
-		PerformanceViewer::GetInstance()->end("audio");
 	}
 
 	void Engine::GameEnd()
@@ -1053,5 +1091,6 @@ namespace Popplio
 		UnhookWindowsHookEx(keyboardHook);
 		glfwDestroyWindow(window);
 		glfwTerminate();
+		Logger::Shutdown();
 	}
 }
\ No newline at end of file
@@ -181,6 +181,11 @@ namespace Popplio
              */
             static bool vSync;
 
+            /**
+             * @brief Flag indicating whether the ECS stores components in archetype chunks instead of sparse sets.
+             */
+            static bool archetypeStorage;
+
             // Editor // ========================
 
             /**
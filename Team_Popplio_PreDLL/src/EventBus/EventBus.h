@@ -19,10 +19,11 @@ Technology is prohibited.
 #pragma once
 #include "Event.h"
 #include "../Logging/Logger.h"
-#include <map>
-#include <typeindex>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <list>
+#include <span>
+#include <vector>
 #include <functional>
 
 namespace Popplio
@@ -74,6 +75,17 @@ namespace Popplio
         MemberFunctionEventCallback(TOwner* owner, CallbackFunction callback)
             : ownerInstance(owner), callbackFunction(callback) {}
 
+        /**
+         * @brief Whether this callback calls the member function on the owner instance.
+         *
+         * @param owner The owner instance.
+         * @param callback The member function callback.
+         */
+        bool IsFor(TOwner* owner, CallbackFunction callback) const
+        {
+            return ownerInstance == owner && callbackFunction == callback;
+        }
+
         /**
          * @brief Call the member function callback.
          * 
@@ -124,6 +136,80 @@ namespace Popplio
         std::function<void(TEvent&)> callbackFunction; /**< The function callback. */
     };
 
+    using EventTypeId = std::uint32_t;
+
+    /**
+     * @brief Gives every event type a small index into the handler lists of the event bus.
+     *
+     * The id of a type is taken the first time the type is used and stays the same
+     * for the rest of the run.
+     */
+    class EventType
+    {
+    public:
+        /**
+         * @brief Gets the id of an event type.
+         *
+         * @tparam TEvent The event type.
+         */
+        template <typename TEvent>
+        static EventTypeId Id()
+        {
+            static const EventTypeId id = nextId.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+
+    private:
+        inline static std::atomic<EventTypeId> nextId{ 0 }; /**< The id of the next event type. */
+    };
+
+    /**
+     * @brief Handle of a subscription, returned by EventBus::SubscribeToEvent.
+     *
+     * A default constructed handle does not refer to any subscription.
+     */
+    struct SubscriptionHandle
+    {
+        EventTypeId type = 0; /**< The event type of the subscription. */
+        std::uint32_t id = 0; /**< The id of the subscription, 0 if none. */
+
+        /**
+         * @brief Whether the handle refers to a subscription.
+         */
+        bool IsValid() const { return id != 0; }
+    };
+
+    /**
+     * @brief The events of one type queued since the last delivery, see EventBus::QueueEvent.
+     *
+     * Subscribe to EventBatch<TEvent> to receive all queued events of a type in one call.
+     * The events are only valid during the call.
+     *
+     * @tparam TEvent The event type.
+     */
+    template <typename TEvent>
+    class EventBatch : public Event
+    {
+    public:
+        std::span<const TEvent> events; /**< The queued events, in the order they were queued. */
+
+        EventBatch(std::span<const TEvent> e) : events(e) {}
+    };
+
+    /**
+     * @brief Dispatches events to the handlers subscribed to their type.
+     *
+     * The handlers of each event type are kept in one contiguous array, indexed by
+     * the event type id, so emitting an event does not look up or allocate anything.
+     * Handlers may subscribe and unsubscribe while an event is being dispatched:
+     * handlers subscribed during an emit are called from the next emit, and handlers
+     * unsubscribed during an emit are not called again. Unsubscribed handlers are
+     * removed from the array once the outermost emit of their event type returns.
+     *
+     * Events can also be queued, then delivered together at a defined point of the
+     * frame by DeliverQueuedEvents, to the handlers of the event type and of its
+     * EventBatch.
+     */
     class EventBus
     {
     public:
@@ -132,7 +218,26 @@ namespace Popplio
          */
         void Reset()
         {
-            subscribers.clear();
+            for (auto& channel : channels)
+            {
+                if (channel) channel->ClearQueued();
+            }
+            queuedChannels.clear();
+
+            for (HandlerList& list : handlerLists)
+            {
+                if (list.dispatchDepth > 0)
+                {
+                    // the list is being iterated, only mark the handlers
+                    for (Handler& handler : list.handlers) handler.removed = true;
+                    list.removedCount = list.handlers.size();
+                }
+                else
+                {
+                    list.handlers.clear();
+                    list.removedCount = 0;
+                }
+            }
         }
 
         /**
@@ -142,14 +247,13 @@ namespace Popplio
          * @tparam TOwner The owner class type.
          * @param ownerInstance The owner instance.
          * @param callbackFunction The member function callback.
+         * @return The handle to unsubscribe with.
          */
         template <typename TEvent, typename TOwner>
-        void SubscribeToEvent(TOwner* ownerInstance, void (TOwner::* callbackFunction)(TEvent&))
+        SubscriptionHandle SubscribeToEvent(TOwner* ownerInstance, void (TOwner::* callbackFunction)(TEvent&))
         {
-            subscribers[typeid(TEvent)].push_back(
-                std::make_shared<MemberFunctionEventCallback<TOwner, TEvent>>
-                (ownerInstance, callbackFunction)
-            );
+            return AddHandler(EventType::Id<TEvent>(),
+                std::make_unique<MemberFunctionEventCallback<TOwner, TEvent>>(ownerInstance, callbackFunction));
         }
 
         /**
@@ -157,18 +261,20 @@ namespace Popplio
          * 
          * @tparam TEvent The event type.
          * @param callback The function callback.
+         * @return The handle to unsubscribe with.
          */
         template <typename TEvent>
-        void SubscribeToEvent(std::function<void(TEvent&)> callback)
+        SubscriptionHandle SubscribeToEvent(std::function<void(TEvent&)> callback)
         {
-            subscribers[typeid(TEvent)].push_back(
-                std::make_shared<FunctionEventCallback<TEvent>>(callback)
-            );
+            return AddHandler(EventType::Id<TEvent>(),
+                std::make_unique<FunctionEventCallback<TEvent>>(std::move(callback)));
         }
 
         /**
          * @brief Emits an event by invoking all subscribed event handlers.
          * 
+         * The event is only constructed if the event type has handlers.
+         * 
          * @tparam TEvent The event type.
          * @tparam TArgs The argument types.
          * @param args The arguments to construct the event object.
@@ -176,14 +282,88 @@ namespace Popplio
         template <typename TEvent, typename ...TArgs>
         void EmitEvent(TArgs&& ...args)
         {
-            auto handlers = subscribers[typeid(TEvent)];
-            if (!handlers.empty())
+            const EventTypeId type = EventType::Id<TEvent>();
+            if (!HasHandlers(type)) return;
+
+            TEvent event(std::forward<TArgs>(args)...);
+            Dispatch(type, event);
+        }
+
+        /**
+         * @brief Queues an event to be delivered by the next DeliverQueuedEvents.
+         *
+         * The events of each type are kept in a buffer that is reused every frame.
+         * Like EmitEvent, the event is dropped if neither the event type nor its
+         * EventBatch has handlers.
+         *
+         * @tparam TEvent The event type.
+         * @tparam TArgs The argument types.
+         * @param args The arguments to construct the event object.
+         */
+        template <typename TEvent, typename ...TArgs>
+        void QueueEvent(TArgs&& ...args)
+        {
+            const EventTypeId type = EventType::Id<TEvent>();
+            if (!HasHandlers(type) && !HasHandlers(EventType::Id<EventBatch<TEvent>>())) return;
+
+            if (type >= channels.size()) channels.resize(static_cast<size_t>(type) + 1);
+            if (!channels[type]) channels[type] = std::make_unique<EventChannel<TEvent>>();
+
+            auto& channel = static_cast<EventChannel<TEvent>&>(*channels[type]);
+            if (channel.queued.empty()) queuedChannels.push_back(type);
+            channel.queued.emplace_back(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * @brief Delivers the queued events, type by type.
+         *
+         * For each event type, the handlers of the event type are called once per event,
+         * then the handlers of its EventBatch once with all the events.
+         * Events queued by the handlers are delivered by the next call.
+         *
+         * @return The number of events delivered.
+         */
+        size_t DeliverQueuedEvents()
+        {
+            if (delivering) return 0;
+            delivering = true;
+
+            size_t count{};
+            deliveringChannels.swap(queuedChannels);
+            for (EventTypeId type : deliveringChannels) count += channels[type]->Deliver(*this);
+            deliveringChannels.clear();
+
+            delivering = false;
+            return count;
+        }
+
+        /**
+         * @brief Gets the number of events waiting for DeliverQueuedEvents.
+         */
+        size_t GetQueuedEventCount() const
+        {
+            size_t count{};
+            for (EventTypeId type : queuedChannels) count += channels[type]->GetQueuedCount();
+            return count;
+        }
+
+        /**
+         * @brief Unsubscribes the subscription of a handle.
+         *
+         * Does nothing if the subscription was already removed.
+         *
+         * @param handle The handle returned when subscribing.
+         */
+        void UnsubscribeToEvent(SubscriptionHandle handle)
+        {
+            if (!handle.IsValid() || handle.type >= handlerLists.size()) return;
+
+            HandlerList& list = handlerLists[handle.type];
+            for (size_t i{}; i < list.handlers.size(); ++i)
             {
-                TEvent event(std::forward<TArgs>(args)...);
-                for (auto& handler : handlers)
-                {
-                    handler->Call(event);
-                }
+                if (list.handlers[i].id != handle.id) continue;
+                RemoveHandler(list, i);
+                return;
             }
         }
 
@@ -196,29 +376,163 @@ namespace Popplio
          * @param callbackFunction The member function callback.
          */
         template <typename TEvent, typename TOwner>
-        void UnsubscribeToEvent(TOwner* ownerInstance, void (TOwner::* callbackFunction)(TEvent&)) // TODO IMPLEMENT
+        void UnsubscribeToEvent(TOwner* ownerInstance, void (TOwner::* callbackFunction)(TEvent&))
         {
-            //subscribers[typeid(TEvent)].erase(
-            //    MemberFunctionEventCallback<TOwner, TEvent>
-            //    (ownerInstance, callbackFunction)
-            //);
+            const EventTypeId type = EventType::Id<TEvent>();
+            if (type >= handlerLists.size()) return;
+
+            HandlerList& list = handlerLists[type];
+            for (size_t i{}; i < list.handlers.size(); ++i)
+            {
+                auto* callback = dynamic_cast<MemberFunctionEventCallback<TOwner, TEvent>*>(list.handlers[i].callback.get());
+                if (list.handlers[i].removed || !callback || !callback->IsFor(ownerInstance, callbackFunction)) continue;
+                RemoveHandler(list, i);
+                return;
+            }
         }
 
         /**
-         * @brief Unsubscribes a function callback to an event.
+         * @brief Gets the number of handlers subscribed to an event.
          *
          * @tparam TEvent The event type.
-         * @param callback The function callback.
          */
         template <typename TEvent>
-        void UnsubscribeToEvent(std::function<void(TEvent&)> callback) // TODO IMPLEMENT
+        size_t GetHandlerCount() const
         {
-            //subscribers[typeid(TEvent)].erase(
-            //    FunctionEventCallback<TEvent>(callback)
-            //);
+            const EventTypeId type = EventType::Id<TEvent>();
+            if (type >= handlerLists.size()) return 0;
+            return handlerLists[type].handlers.size() - handlerLists[type].removedCount;
         }
 
     private:
-        std::map<std::type_index, std::list<std::shared_ptr<IEventCallback>>> subscribers; /**< The map of event subscribers. */
+        /**
+         * @brief Interface of the queued events of one event type.
+         */
+        class IEventChannel
+        {
+        public:
+            virtual ~IEventChannel() = default;
+            virtual size_t Deliver(EventBus& bus) = 0;
+            virtual void ClearQueued() = 0;
+            virtual size_t GetQueuedCount() const = 0;
+        };
+
+        /**
+         * @brief The queued events of one event type.
+         *
+         * Events queued while delivering go to the other buffer, so handlers may queue
+         * events of the type they handle.
+         */
+        template <typename TEvent>
+        class EventChannel : public IEventChannel
+        {
+        public:
+            std::vector<TEvent> queued{}; /**< The events waiting for delivery. */
+
+            size_t Deliver(EventBus& bus) override
+            {
+                delivering.swap(queued);
+
+                const EventTypeId type = EventType::Id<TEvent>();
+                for (TEvent& event : delivering)
+                {
+                    if (!bus.HasHandlers(type)) break;
+                    bus.Dispatch(type, event);
+                }
+
+                const EventTypeId batchType = EventType::Id<EventBatch<TEvent>>();
+                if (bus.HasHandlers(batchType))
+                {
+                    EventBatch<TEvent> batch(std::span<const TEvent>(delivering.data(), delivering.size()));
+                    bus.Dispatch(batchType, batch);
+                }
+
+                const size_t count = delivering.size();
+                delivering.clear(); // keeps the capacity for the next frame
+                return count;
+            }
+
+            void ClearQueued() override { queued.clear(); }
+            size_t GetQueuedCount() const override { return queued.size(); }
+
+        private:
+            std::vector<TEvent> delivering{}; /**< The events being delivered. */
+        };
+
+        struct Handler
+        {
+            std::uint32_t id; /**< The id of the subscription. */
+            bool removed; /**< Whether the handler was unsubscribed during a dispatch. */
+            std::unique_ptr<IEventCallback> callback; /**< The callback to invoke. */
+        };
+
+        struct HandlerList
+        {
+            std::vector<Handler> handlers{}; /**< The handlers, in the order they subscribed. */
+            size_t removedCount = 0; /**< The handlers unsubscribed but not yet erased. */
+            int dispatchDepth = 0; /**< The emits of the event type in progress. */
+        };
+
+        std::vector<HandlerList> handlerLists{}; /**< The handler lists, indexed by event type id. */
+        std::uint32_t nextHandlerId = 1; /**< The id of the next subscription, 0 is never used. */
+
+        std::vector<std::unique_ptr<IEventChannel>> channels{}; /**< The queued events, indexed by event type id. */
+        std::vector<EventTypeId> queuedChannels{}; /**< The event types with queued events. */
+        std::vector<EventTypeId> deliveringChannels{}; /**< The event types being delivered. */
+        bool delivering = false; /**< Whether DeliverQueuedEvents is running. */
+
+        bool HasHandlers(EventTypeId type) const
+        {
+            return type < handlerLists.size() && handlerLists[type].handlers.size() > handlerLists[type].removedCount;
+        }
+
+        SubscriptionHandle AddHandler(EventTypeId type, std::unique_ptr<IEventCallback> callback)
+        {
+            if (type >= handlerLists.size()) handlerLists.resize(static_cast<size_t>(type) + 1);
+
+            const std::uint32_t id = nextHandlerId++;
+            handlerLists[type].handlers.push_back({ id, false, std::move(callback) });
+            return { type, id };
+        }
+
+        void RemoveHandler(HandlerList& list, size_t index)
+        {
+            if (list.handlers[index].removed) return;
+
+            if (list.dispatchDepth > 0)
+            {
+                // the list is being iterated, erased after the outermost dispatch
+                list.handlers[index].removed = true;
+                ++list.removedCount;
+            }
+            else list.handlers.erase(list.handlers.begin() + index);
+        }
+
+        void Dispatch(EventTypeId type, Event& event)
+        {
+            // keeps the depth right if a handler throws
+            struct DispatchScope
+            {
+                EventBus& bus;
+                EventTypeId type;
+
+                DispatchScope(EventBus& b, EventTypeId t) : bus(b), type(t) { ++bus.handlerLists[type].dispatchDepth; }
+                ~DispatchScope()
+                {
+                    HandlerList& list = bus.handlerLists[type];
+                    if (--list.dispatchDepth > 0 || list.removedCount == 0) return;
+                    std::erase_if(list.handlers, [](Handler const& handler) { return handler.removed; });
+                    list.removedCount = 0;
+                }
+            } scope(*this, type);
+
+            // handlers subscribed during the dispatch are past count, the lists can grow so they are indexed again every call
+            const size_t count = handlerLists[type].handlers.size();
+            for (size_t i{}; i < count; ++i)
+            {
+                Handler& handler = handlerLists[type].handlers[i];
+                if (!handler.removed) handler.callback->Call(event);
+            }
+        }
     };
 }
\ No newline at end of file
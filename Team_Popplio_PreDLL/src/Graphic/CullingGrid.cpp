@@ -0,0 +1,238 @@
+/******************************************************************************/
+/*!
+\file   CullingGrid.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the CullingGrid class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "CullingGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Popplio
+{
+	namespace
+	{
+		// cell coordinates stay well inside int so that looping up to the last cell cannot overflow
+		const float MAX_CELL_COORDINATE = 1073741824.0f; // 2^30
+
+		bool IsFinite(const CullBounds& bounds)
+		{
+			return std::isfinite(bounds.minX) && std::isfinite(bounds.minY) &&
+				std::isfinite(bounds.maxX) && std::isfinite(bounds.maxY);
+		}
+	}
+
+	CullBounds CullBounds::FromModelMatrix(const glm::mat3& model)
+	{
+		// Half extents of the transformed unit square, rotation included
+		const float halfX = 0.5f * (std::abs(model[0][0]) + std::abs(model[1][0]));
+		const float halfY = 0.5f * (std::abs(model[0][1]) + std::abs(model[1][1]));
+		return { model[2][0] - halfX, model[2][1] - halfY, model[2][0] + halfX, model[2][1] + halfY };
+	}
+
+	CullingGrid::CullingGrid(float size)
+		: cellSize(size > 0.0f ? size : DEFAULT_CELL_SIZE), inverseCellSize(1.0f / cellSize)
+	{
+	}
+
+	void CullingGrid::Update(int entity, const CullBounds& bounds)
+	{
+		if (entity < 0) return;
+		if (static_cast<size_t>(entity) >= entries.size()) entries.resize(static_cast<size_t>(entity) + 1);
+
+		Entry& entry = entries[entity];
+		if (entry.liveIndex >= 0 && entry.bounds == bounds) return;
+
+		entry.bounds = bounds;
+		if (entry.liveIndex < 0)
+		{
+			entry.liveIndex = static_cast<int>(live.size());
+			live.push_back(entity);
+			Bin(entity);
+			++cellMoves;
+			return;
+		}
+
+		// Only rebinned when the bounds leave the cells
+		int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+		if (!CellRange(bounds, x0, y0, x1, y1) || x0 != entry.x0 || x1 != entry.x1 || y0 != entry.y0 || y1 != entry.y1)
+		{
+			Unbin(entity);
+			Bin(entity);
+			++cellMoves;
+		}
+	}
+
+	void CullingGrid::Remove(int entity)
+	{
+		if (!Contains(entity)) return;
+
+		Entry& entry = entries[entity];
+		Unbin(entity);
+
+		const int index = entry.liveIndex;
+		entry.liveIndex = -1;
+		live[index] = live.back();
+		entries[live[index]].liveIndex = index;
+		live.pop_back();
+	}
+
+	void CullingGrid::Clear()
+	{
+		for (int entity : live) entries[entity].liveIndex = -1;
+		live.clear();
+		cells.clear();
+		oversized.clear();
+		visible.clear();
+	}
+
+	void CullingGrid::Query(const CullBounds& view)
+	{
+		++query;
+		cellMoves = 0;
+		visible.clear();
+
+		auto visit = [this, &view](int entity)
+		{
+			Entry& entry = entries[entity];
+			if (entry.visible == query || !entry.bounds.Overlaps(view)) return;
+			entry.visible = query;
+			visible.push_back(entity);
+		};
+
+		int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+		const bool finite = CellRange(view, x0, y0, x1, y1);
+		const long long viewCells = (static_cast<long long>(x1) - x0 + 1) * (static_cast<long long>(y1) - y0 + 1);
+
+		if (finite && viewCells <= static_cast<long long>(cells.size()))
+		{
+			for (int x = x0; x <= x1; ++x)
+			{
+				for (int y = y0; y <= y1; ++y)
+				{
+					auto it = cells.find(CellKey(x, y));
+					if (it == cells.end()) continue;
+					for (int entity : it->second) visit(entity);
+				}
+			}
+		}
+		else
+		{
+			// Zoomed far out (or a broken view), the occupied cells are fewer than the cells in view
+			for (auto& [key, cellEntities] : cells)
+			{
+				for (int entity : cellEntities) visit(entity);
+			}
+		}
+
+		for (int entity : oversized) visit(entity);
+	}
+
+	bool CullingGrid::IsCulled(int entity) const
+	{
+		if (entity < 0 || static_cast<size_t>(entity) >= entries.size()) return false;
+		const Entry& entry = entries[entity];
+		return entry.liveIndex >= 0 && entry.visible != query;
+	}
+
+	int CullingGrid::CellCoordinate(float position) const
+	{
+		// Far away positions are clamped to the outermost cells
+		return static_cast<int>(std::clamp(std::floor(position * inverseCellSize), -MAX_CELL_COORDINATE, MAX_CELL_COORDINATE));
+	}
+
+	bool CullingGrid::CellRange(const CullBounds& bounds, int& x0, int& y0, int& x1, int& y1) const
+	{
+		// NaN / infinite bounds have no cells
+		if (!IsFinite(bounds)) return false;
+
+		x0 = CellCoordinate(bounds.minX);
+		x1 = CellCoordinate(bounds.maxX);
+		y0 = CellCoordinate(bounds.minY);
+		y1 = CellCoordinate(bounds.maxY);
+		return true;
+	}
+
+	std::uint64_t CullingGrid::CellKey(int x, int y)
+	{
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+	}
+
+	void CullingGrid::Bin(int entity)
+	{
+		Entry& entry = entries[entity];
+		if (CellRange(entry.bounds, entry.x0, entry.y0, entry.x1, entry.y1))
+		{
+			const long long cellCount = (static_cast<long long>(entry.x1) - entry.x0 + 1) * (static_cast<long long>(entry.y1) - entry.y0 + 1);
+			entry.oversized = cellCount > MAX_CELLS_PER_ENTITY;
+		}
+		else
+		{
+			entry.x0 = entry.y0 = 0;
+			entry.x1 = entry.y1 = -1;
+			entry.oversized = true;
+		}
+
+		if (entry.oversized)
+		{
+			oversized.push_back(entity);
+			return;
+		}
+
+		for (int x = entry.x0; x <= entry.x1; ++x)
+		{
+			for (int y = entry.y0; y <= entry.y1; ++y)
+			{
+				cells[CellKey(x, y)].push_back(entity);
+			}
+		}
+	}
+
+	void CullingGrid::Unbin(int entity)
+	{
+		// Order within a cell does not matter, swap with the last and pop
+		auto erase = [entity](std::vector<int>& list)
+		{
+			for (size_t i = 0; i < list.size(); ++i)
+			{
+				if (list[i] != entity) continue;
+				list[i] = list.back();
+				list.pop_back();
+				return;
+			}
+		};
+
+		Entry& entry = entries[entity];
+		if (entry.oversized)
+		{
+			erase(oversized);
+			return;
+		}
+
+		for (int x = entry.x0; x <= entry.x1; ++x)
+		{
+			for (int y = entry.y0; y <= entry.y1; ++y)
+			{
+				auto it = cells.find(CellKey(x, y));
+				if (it == cells.end()) continue;
+				erase(it->second);
+				if (it->second.empty()) cells.erase(it);
+			}
+		}
+	}
+}
@@ -0,0 +1,152 @@
+/******************************************************************************/
+/*!
+\file   CullingGrid.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the CullingGrid class, a uniform grid of the
+		world bounds of the rendered entities, used to find the entities inside
+		the camera view before they are queued for drawing.
+
+		Entities stay in the grid until removed, only the entities that moved
+		are updated, and they only move between cells when their bounds leave
+		their cells. The grid does not touch OpenGL or the ECS.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	Axis-aligned bounds in world space.
+
+	*******************************************************************************/
+	struct CullBounds
+	{
+		float minX = 0.0f;
+		float minY = 0.0f;
+		float maxX = 0.0f;
+		float maxY = 0.0f;
+
+		bool Overlaps(const CullBounds& other) const
+		{
+			return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+		}
+
+		bool operator==(const CullBounds& other) const = default;
+
+		/*!*****************************************************************************
+		\brief
+		Gets the bounds of a mesh spanning -0.5 to 0.5 transformed by a model
+		matrix.
+
+		*******************************************************************************/
+		static CullBounds FromModelMatrix(const glm::mat3& model);
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Uniform grid of entity bounds, keyed by entity id.
+
+	Every frame: Update the entities that moved, Remove the ones that can no
+	longer be culled, then Query the view. Entities with NaN or infinite
+	bounds are tested on every query like large entities.
+
+	*******************************************************************************/
+	class CullingGrid
+	{
+	public:
+		static constexpr float DEFAULT_CELL_SIZE = 256.0f;
+		static constexpr int MAX_CELLS_PER_ENTITY = 64; // larger entities are tested on every query
+
+		explicit CullingGrid(float cellSize = DEFAULT_CELL_SIZE);
+
+		/*!*****************************************************************************
+		\brief
+		Adds an entity or sets its bounds, moving it to other cells only if its
+		bounds left the cells it is in.
+
+		*******************************************************************************/
+		void Update(int entity, const CullBounds& bounds);
+
+		/*!*****************************************************************************
+		\brief
+		Removes an entity from the grid, if it is in it.
+
+		*******************************************************************************/
+		void Remove(int entity);
+
+		/*!*****************************************************************************
+		\brief
+		Removes every entity from the grid.
+
+		*******************************************************************************/
+		void Clear();
+
+		/*!*****************************************************************************
+		\brief
+		Finds the entities whose bounds overlap the view, see GetVisible.
+
+		*******************************************************************************/
+		void Query(const CullBounds& view);
+
+		/*!*****************************************************************************
+		\brief
+		Whether the entity is in the grid and outside the last queried view.
+
+		*******************************************************************************/
+		bool IsCulled(int entity) const;
+
+		bool Contains(int entity) const
+		{
+			return entity >= 0 && static_cast<size_t>(entity) < entries.size() && entries[entity].liveIndex >= 0;
+		}
+
+		const std::vector<int>& GetVisible() const { return visible; } // entities in the last queried view, unordered
+		size_t GetEntityCount() const { return live.size(); }
+		size_t GetVisibleCount() const { return visible.size(); }
+		size_t GetCellMoves() const { return cellMoves; } // entities that changed cells since the last Query
+
+	private:
+		struct Entry
+		{
+			CullBounds bounds{};
+			int x0 = 0, y0 = 0, x1 = -1, y1 = -1; // cell range, empty if not binned
+			std::uint32_t visible = 0; // last Query that saw it
+			int liveIndex = -1; // index in live, -1 if not in the grid
+			bool oversized = false;
+		};
+
+		float cellSize;
+		float inverseCellSize;
+		std::uint32_t query = 0; // number of Query calls
+		std::vector<Entry> entries{}; // by entity id
+		std::vector<int> live{}; // entities in the grid
+		std::unordered_map<std::uint64_t, std::vector<int>> cells{};
+		std::vector<int> oversized{};
+		std::vector<int> visible{};
+		size_t cellMoves = 0;
+
+		int CellCoordinate(float position) const;
+		bool CellRange(const CullBounds& bounds, int& x0, int& y0, int& x1, int& y1) const;
+		static std::uint64_t CellKey(int x, int y);
+		void Bin(int entity);
+		void Unbin(int entity);
+	};
+}
@@ -24,6 +24,10 @@ Technology is prohibited.
 namespace Popplio
 {
     // Initialize static members
+    namespace
+    {
+        std::uint32_t nextGlyphSetId = 0; // ids of the loaded sizes, 0 is never used
+    }
 
 	Font::Font(const std::string& path) : VAO(0), VBO(0), fontPath(path)
 	{
@@ -41,37 +45,50 @@ namespace Popplio
 
 	Font::~Font()
 	{
-		// Clean up textures
-		for (auto& sizeMap : sizedCharacters) {
-			for (auto& charPair : sizeMap.second) {
-				glDeleteTextures(1, &charPair.second.TextureID);
-			}
+		// Clean up the glyph atlases
+		for (auto& sizePair : sizedGlyphs) {
+			glDeleteTextures(1, &sizePair.second.texture);
 		}
+		glDeleteBuffers(1, &VBO);
+		glDeleteVertexArrays(1, &VAO);
 	}
 
 	void Font::LoadSize(unsigned int fontSize)
 	{
-        if (sizedCharacters.find(fontSize) != sizedCharacters.end())
+        if (sizedGlyphs.find(fontSize) != sizedGlyphs.end())
             return; // Already loaded
 
+        GlyphBitmaps glyphBitmaps{};
+        if (!RasterizeSize(fontPath, fontSize, glyphBitmaps)) return;
+        UploadSize(glyphBitmaps);
+	}
+
+    bool Font::RasterizeSize(const std::string& path, unsigned int fontSize, GlyphBitmaps& glyphs)
+    {
+        // Every call has its own library, FreeType libraries are not shared between threads
         FT_Library ft;
         if (FT_Init_FreeType(&ft)) // all functions return a value different than 0 whenever an error occurred
         {
             Logger::Critical("FREETYPE: Could not init FreeType Library");
+            return false;
         }
 
         // load font as face
         FT_Face face;
-        if (FT_New_Face(ft, fontPath.c_str(), 0, &face))
+        if (FT_New_Face(ft, path.c_str(), 0, &face))
         {
             Logger::Error("FREETYPE: Failed to load font");
+            FT_Done_FreeType(ft);
+            return false;
         }
 
         FT_Set_Pixel_Sizes(face, 0, fontSize);
-        std::map<char, Character>& characters = sizedCharacters[fontSize];
-        // Disable byte-alignment restriction
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        // Load first 128 ASCII characters
+        glyphs.fontSize = fontSize;
+        glyphs.characters.clear();
+
+        // Load first 128 ASCII characters, their bitmaps are kept until the atlas is built
+        std::vector<std::vector<unsigned char>> bitmaps(128);
+        std::vector<AtlasImage> images{};
         for (unsigned char c = 0; c < 128; c++)
         {
             if (FT_Load_Char(face, c, FT_LOAD_RENDER))
@@ -80,60 +97,117 @@ namespace Popplio
                 continue;
             }
 
-            // Generate texture
-            unsigned int texture;
-            glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D
-            (
-                GL_TEXTURE_2D,
-                0,
-                GL_RED,
-                face->glyph->bitmap.width,
-                face->glyph->bitmap.rows,
-                0,
-                GL_RED,
-                GL_UNSIGNED_BYTE,
-                face->glyph->bitmap.buffer
-            );
-
-            // Set texture parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // Store character
-            Character character = 
+            const FT_Bitmap& bitmap = face->glyph->bitmap;
+            const int width = static_cast<int>(bitmap.width);
+            const int rows = static_cast<int>(bitmap.rows);
+            const int pitch = std::abs(bitmap.pitch);
+            bitmaps[c].resize(static_cast<size_t>(width) * rows);
+            for (int row = 0; row < rows; ++row)
             {
-                texture,
-                glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+                std::memcpy(bitmaps[c].data() + static_cast<size_t>(row) * width, bitmap.buffer + static_cast<size_t>(row) * pitch, width);
+            }
+            if (width > 0 && rows > 0) images.push_back({ std::to_string(c), width, rows });
+
+            // Store character, placed in the atlas below
+            Character character =
+            {
+                0,
+                glm::ivec2(width, rows),
                 glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                static_cast<unsigned int>(face->glyph->advance.x)
+                static_cast<unsigned int>(face->glyph->advance.x),
+                glm::vec4(0.0f)
             };
-            characters.insert(std::pair<char, Character>(c, character));
+            glyphs.characters.insert(std::pair<char, Character>(c, character));
         }
 
         // destroy FreeType once we're finished
         FT_Done_Face(face);
         FT_Done_FreeType(ft);
+
+        // Copy the glyphs into one page, rows top to bottom like the bitmaps
+        AtlasManifest manifest = PackGlyphAtlas(images);
+        const int pageSize = std::max(manifest.pageSize, 1);
+        if (manifest.pageCount > 1 || manifest.regions.size() != images.size())
+        {
+            Logger::Warning("Font size " + std::to_string(fontSize) + " does not fit a glyph atlas, some glyphs are not drawn");
+        }
+
+        glyphs.pageSize = pageSize;
+        std::vector<unsigned char>& pixels = glyphs.pixels;
+        pixels.assign(static_cast<size_t>(pageSize) * pageSize, 0);
+        for (auto& [c, character] : glyphs.characters)
+        {
+            auto regionIt = manifest.regions.find(std::to_string(static_cast<unsigned char>(c)));
+            if (regionIt == manifest.regions.end() || regionIt->second.page != 0) continue;
+
+            const AtlasRegion& region = regionIt->second;
+            const std::vector<unsigned char>& bitmap = bitmaps[static_cast<unsigned char>(c)];
+            for (int row = 0; row < region.height; ++row)
+            {
+                std::memcpy(pixels.data() + static_cast<size_t>(region.y + row) * pageSize + region.x,
+                    bitmap.data() + static_cast<size_t>(row) * region.width, region.width);
+            }
+
+            // The first bitmap row is the top of the glyph
+            glm::vec4 uv = manifest.GetUVRect(region);
+            character.uvRect = glm::vec4(uv.x, uv.w, uv.z, uv.y);
+        }
+
+        return true;
+    }
+
+    void Font::UploadSize(const GlyphBitmaps& glyphBitmaps)
+    {
+        if (sizedGlyphs.find(glyphBitmaps.fontSize) != sizedGlyphs.end())
+            return; // Already loaded
+
+        GlyphSet& glyphs = sizedGlyphs[glyphBitmaps.fontSize];
+        glyphs.id = ++nextGlyphSetId;
+        glyphs.characters = glyphBitmaps.characters;
+
+        // Disable byte-alignment restriction
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glGenTextures(1, &glyphs.texture);
+        glBindTexture(GL_TEXTURE_2D, glyphs.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, glyphBitmaps.pageSize, glyphBitmaps.pageSize, 0, GL_RED, GL_UNSIGNED_BYTE, glyphBitmaps.pixels.data());
+
+        // Set texture parameters
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // Sampled as (1, 1, 1, coverage), so any shader multiplying the texture by a color draws the text
+        const GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        for (auto& charPair : glyphs.characters) {
+            charPair.second.TextureID = glyphs.texture;
+        }
 	}
 
     bool Font::IsSizeLoaded(unsigned int fontSize) const
     {
-        return sizedCharacters.find(fontSize) != sizedCharacters.end();
+        return sizedGlyphs.find(fontSize) != sizedGlyphs.end();
     }
 
 	const Character& Font::GetCharacter(char c, unsigned int fontSize) const
 	{
-        auto sizeIt = sizedCharacters.find(fontSize);
-        if (sizeIt == sizedCharacters.end())
+        auto sizeIt = sizedGlyphs.find(fontSize);
+        if (sizeIt == sizedGlyphs.end())
             throw std::runtime_error("Font size not loaded: " + std::to_string(fontSize));
 
-        auto charIt = sizeIt->second.find(c);
-        if (charIt == sizeIt->second.end())
+        auto charIt = sizeIt->second.characters.find(c);
+        if (charIt == sizeIt->second.characters.end())
             throw std::runtime_error("Character not found: " + std::string(1, c));
 
         return charIt->second;
 	}
+
+    const GlyphSet* Font::GetGlyphSet(unsigned int fontSize) const
+    {
+        auto sizeIt = sizedGlyphs.find(fontSize);
+        return sizeIt == sizedGlyphs.end() ? nullptr : &sizeIt->second;
+    }
 }
@@ -10,7 +10,7 @@
 		This is the header file for the Font class, which is part of the main
 		graphics system. It declares the Font class and its member functions
 		used for loading and rendering fonts using the FreeType library and
-		OpenGL.
+		OpenGL. The glyphs of each loaded size share one atlas texture.
 
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
@@ -29,14 +29,17 @@ Technology is prohibited.
 #include "../Shader/Shader.h"
 #include "../Camera/CameraManager.h"
 #include "../Texture/Texture.h"
+#include "TextLayout.h"
 
 namespace Popplio
 {;
-	struct Character {
-		unsigned int TextureID;  // OpenGL texture ID
-		glm::ivec2   Size;      // Size of glyph
-		glm::ivec2   Bearing;   // Offset from baseline to left/top of glyph
-		unsigned int Advance;    // Offset to advance to next glyph
+	// Glyphs of one size rasterized into an atlas page on the CPU, waiting for Font::UploadSize
+	struct GlyphBitmaps
+	{
+		unsigned int fontSize = 0;
+		std::map<char, Character> characters{};
+		std::vector<unsigned char> pixels{}; // one channel, pageSize * pageSize, rows top to bottom
+		int pageSize = 0;
 	};
 
 	class Font
@@ -48,14 +51,17 @@ namespace Popplio
 		~Font();
 
 		void LoadSize(unsigned int fontSize);
+		static bool RasterizeSize(const std::string& path, unsigned int fontSize, GlyphBitmaps& glyphBitmaps); // no GL, any thread
+		void UploadSize(const GlyphBitmaps& glyphBitmaps);
 		bool IsSizeLoaded(unsigned int fontSize) const;
 		const Character& GetCharacter(char c, unsigned int fontSize) const;
+		const GlyphSet* GetGlyphSet(unsigned int fontSize) const;
 
 		unsigned int GetVAO() const { return VAO; }
 		unsigned int GetVBO() const { return VBO; }
 	private:
 		std::string fontPath;
-		std::map<unsigned int, std::map<char, Character>> sizedCharacters;
+		std::map<unsigned int, GlyphSet> sizedGlyphs;
 		unsigned int VAO, VBO;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*!
+\file   TextLayout.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the TextLayout class and the glyph atlas
+		packing of a font size.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "TextLayout.h"
+
+namespace Popplio
+{
+	AtlasManifest PackGlyphAtlas(const std::vector<AtlasImage>& glyphs)
+	{
+		AtlasManifest manifest{};
+		for (int pageSize = 128; pageSize <= MAX_GLYPH_ATLAS_SIZE; pageSize *= 2)
+		{
+			// Glyphs are surrounded by empty texels, the padding keeps neighbours out of linear filtering
+			manifest = AtlasPacker::Pack(glyphs, pageSize, AtlasPacker::DEFAULT_PADDING);
+			if (manifest.pageCount <= 1) break;
+		}
+		return manifest;
+	}
+
+	bool TextLayout::IsBuiltFor(const std::string& str, const GlyphSet& glyphs) const
+	{
+		return glyphSet == glyphs.id && text == str;
+	}
+
+	void TextLayout::Build(const std::string& str, const GlyphSet& glyphs)
+	{
+		text = str;
+		++version;
+		glyphSet = glyphs.id;
+		texture = glyphs.texture;
+		quads.clear();
+		width = ascent = descent = 0.0f;
+
+		// First pass: extents, for centering
+		for (char c : text)
+		{
+			auto it = glyphs.characters.find(c);
+			if (it == glyphs.characters.end()) continue;
+			const Character& ch = it->second;
+
+			width += static_cast<float>(ch.Advance >> 6); // Advance is in 1/64th pixels
+			ascent = std::max(ascent, static_cast<float>(ch.Bearing.y));
+			descent = std::max(descent, static_cast<float>(ch.Size.y) - static_cast<float>(ch.Bearing.y));
+		}
+
+		// The text is centered horizontally, and between its ascent and descent vertically
+		float x = -width / 2.0f;
+		const float baseline = (ascent - descent) / 2.0f;
+
+		for (char c : text)
+		{
+			auto it = glyphs.characters.find(c);
+			if (it == glyphs.characters.end()) continue;
+			const Character& ch = it->second;
+
+			// Empty glyphs (spaces) only advance the cursor
+			if (ch.Size.x > 0 && ch.Size.y > 0)
+			{
+				const float xpos = x + static_cast<float>(ch.Bearing.x);
+				const float ypos = baseline - static_cast<float>(ch.Size.y) + static_cast<float>(ch.Bearing.y);
+				quads.push_back({ glm::vec4(xpos, ypos, static_cast<float>(ch.Size.x), static_cast<float>(ch.Size.y)), ch.uvRect });
+			}
+
+			x += static_cast<float>(ch.Advance >> 6);
+		}
+	}
+
+	void TextLayout::Clear()
+	{
+		if (!quads.empty()) ++version;
+		text.clear();
+		glyphSet = 0;
+		texture = 0;
+		quads.clear();
+		width = ascent = descent = 0.0f;
+	}
+}
@@ -0,0 +1,127 @@
+/******************************************************************************/
+/*!
+\file   TextLayout.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the glyph data of a loaded font size and the
+		TextLayout class, which places the glyphs of a string once and keeps
+		the quads until the string or the font size changes.
+
+		Layouts only build CPU-side data and do not touch OpenGL or FreeType.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Texture/TextureAtlas.h"
+
+namespace Popplio
+{
+	struct Character {
+		unsigned int TextureID;  // OpenGL texture ID (glyph atlas of the size)
+		glm::ivec2   Size;      // Size of glyph
+		glm::ivec2   Bearing;   // Offset from baseline to left/top of glyph
+		unsigned int Advance;    // Offset to advance to next glyph
+		glm::vec4    uvRect;    // UVs of the bottom-left and top-right corners in the atlas
+	};
+
+	/*!*****************************************************************************
+	\brief
+	The glyphs of one loaded font size, all in one atlas texture.
+
+	*******************************************************************************/
+	struct GlyphSet
+	{
+		std::map<char, Character> characters{};
+		unsigned int texture = 0;
+		std::uint32_t id = 0; // unique per loaded size, layouts built from another set are rebuilt
+	};
+
+	/*!*****************************************************************************
+	\brief
+	A glyph placed by a layout.
+
+	*******************************************************************************/
+	struct GlyphQuad
+	{
+		glm::vec4 rect; // bottom-left corner relative to the text position, width, height
+		glm::vec4 uvRect;
+	};
+
+	static constexpr int MAX_GLYPH_ATLAS_SIZE = 4096;
+
+	/*!*****************************************************************************
+	\brief
+	Packs the glyphs of a font size into the smallest square page that fits
+	them all, up to MAX_GLYPH_ATLAS_SIZE.
+
+	\return
+	The manifest, with more than one page if the glyphs do not fit the largest
+	page.
+
+	*******************************************************************************/
+	AtlasManifest PackGlyphAtlas(const std::vector<AtlasImage>& glyphs);
+
+	/*!*****************************************************************************
+	\brief
+	Glyph quads and extents of a string, centered on the text position like
+	the text has always been drawn.
+
+	*******************************************************************************/
+	class TextLayout
+	{
+	public:
+		/*!*****************************************************************************
+		\brief
+		Whether the layout was built for this string with these glyphs.
+
+		*******************************************************************************/
+		bool IsBuiltFor(const std::string& str, const GlyphSet& glyphs) const;
+
+		/*!*****************************************************************************
+		\brief
+		Places the glyphs of the string. Characters without a glyph are skipped.
+
+		*******************************************************************************/
+		void Build(const std::string& str, const GlyphSet& glyphs);
+
+		/*!*****************************************************************************
+		\brief
+		Removes the quads, the next Build always rebuilds.
+
+		*******************************************************************************/
+		void Clear();
+
+		const std::vector<GlyphQuad>& GetQuads() const { return quads; }
+		unsigned int GetTexture() const { return texture; }
+		float GetWidth() const { return width; }
+		float GetHeight() const { return ascent + descent; }
+		std::uint32_t GetVersion() const { return version; } // changes whenever the quads change
+
+	private:
+		std::string text{};
+		std::uint32_t version = 0;
+		std::uint32_t glyphSet = 0;
+		unsigned int texture = 0;
+		std::vector<GlyphQuad> quads{};
+		float width = 0.0f;
+		float ascent = 0.0f;
+		float descent = 0.0f;
+	};
+}
@@ -0,0 +1,52 @@
+/******************************************************************************/
+/*!
+\file   GLCallCounter.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the GLCallCounter class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "GLCallCounter.h"
+
+namespace Popplio
+{
+	std::array<unsigned int, GLCallCounter::COUNT> GLCallCounter::calls{};
+
+	unsigned int GLCallCounter::GetTotal()
+	{
+		unsigned int total = 0;
+		for (unsigned int count : calls) total += count;
+		return total;
+	}
+
+	const char* GLCallCounter::GetName(Call call)
+	{
+		switch (call)
+		{
+		case PROGRAM: return "Programs";
+		case UNIFORM: return "Uniforms";
+		case UNIFORM_QUERY: return "Uniform queries";
+		case TEXTURE: return "Texture binds";
+		case BUFFER: return "Buffer uploads";
+		case DRAW: return "Draws";
+		default: return "";
+		}
+	}
+
+	void GLCallCounter::Reset()
+	{
+		calls.fill(0);
+	}
+}
@@ -0,0 +1,70 @@
+/******************************************************************************/
+/*!
+\file   GLCallCounter.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the GLCallCounter class, which counts the
+		OpenGL calls made by the shaders and the render system, by kind, so
+		redundant calls show up in the performance viewer.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	Counts the OpenGL calls of the current render pass. Reset by the render
+	system at the start of each Update.
+
+	*******************************************************************************/
+	class GLCallCounter
+	{
+	public:
+		enum Call : std::uint8_t
+		{
+			PROGRAM, // glUseProgram
+			UNIFORM, // glUniform*
+			UNIFORM_QUERY, // glGetUniformLocation, glGetActiveUniform
+			TEXTURE, // glBindTexture
+			BUFFER, // glBufferData, glBufferSubData
+			DRAW, // glDraw*
+			COUNT
+		};
+
+		static void Add(Call call, unsigned int count = 1) { calls[call] += count; }
+		static unsigned int Get(Call call) { return calls[call]; }
+
+		/*!*****************************************************************************
+		\brief
+		Gets the calls of every kind added up.
+
+		*******************************************************************************/
+		static unsigned int GetTotal();
+
+		/*!*****************************************************************************
+		\brief
+		Gets the display name of a kind of call.
+
+		*******************************************************************************/
+		static const char* GetName(Call call);
+
+		static void Reset();
+
+	private:
+		static std::array<unsigned int, COUNT> calls;
+	};
+}
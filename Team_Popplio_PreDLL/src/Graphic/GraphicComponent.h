@@ -23,6 +23,8 @@ Technology is prohibited.
 #include <glm/glm.hpp>
 #include <string>
 
+#include "Font/TextLayout.h"
+
 namespace Popplio
 {
 	/*!*****************************************************************************
@@ -141,5 +143,16 @@ namespace Popplio
 
 		float GetWidth() const;
 		float GetHeight() const;
+
+		/*!*****************************************************************************
+		\brief
+		Gets the glyph quads of the text, rebuilt only when the text, font or
+		font size changed since the last call.
+
+		*******************************************************************************/
+		const TextLayout& GetLayout() const;
+
+	private:
+		mutable TextLayout layout{}; // not serialized
 	};
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+/******************************************************************************/
+/*!
+\file   InstanceRingBuffer.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the InstanceRingBuffer class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "InstanceRingBuffer.h"
+
+#include <cstring>
+
+namespace Popplio
+{
+	bool InstanceRingBuffer::Reserve(size_t instancesPerRegion)
+	{
+		if (buffer && instancesPerRegion <= capacity) return false;
+
+		size_t newCapacity = capacity ? capacity : 1;
+		while (newCapacity < instancesPerRegion) newCapacity *= 2;
+
+		Destroy();
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const GLsizeiptr size = static_cast<GLsizeiptr>(sizeof(InstanceData) * newCapacity * REGION_COUNT);
+
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+		mapped = static_cast<InstanceData*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		if (!mapped)
+		{
+			Logger::Error("InstanceRingBuffer: Failed to map instance buffer");
+		}
+
+		capacity = newCapacity;
+		region = 0;
+		return true;
+	}
+
+	GLuint InstanceRingBuffer::Upload(const std::vector<InstanceData>& instances)
+	{
+		WaitRegion(region);
+
+		const size_t first = region * capacity;
+		if (mapped && !instances.empty())
+		{
+			std::memcpy(mapped + first, instances.data(), sizeof(InstanceData) * std::min(instances.size(), capacity));
+		}
+		return static_cast<GLuint>(first);
+	}
+
+	void InstanceRingBuffer::Fence()
+	{
+		fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		region = (region + 1) % REGION_COUNT;
+	}
+
+	void InstanceRingBuffer::Destroy()
+	{
+		for (size_t i = 0; i < REGION_COUNT; ++i) WaitRegion(i);
+
+		if (buffer)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glDeleteBuffers(1, &buffer);
+		}
+		buffer = 0;
+		mapped = nullptr;
+	}
+
+	GLuint InstanceRingBuffer::GetBuffer() const
+	{
+		return buffer;
+	}
+
+	size_t InstanceRingBuffer::GetCapacity() const
+	{
+		return capacity;
+	}
+
+	void InstanceRingBuffer::WaitRegion(size_t index)
+	{
+		GLsync& fence = fences[index];
+		if (!fence) return;
+
+		// The first wait flushes, so the fence is sure to signal
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		while (true)
+		{
+			const GLenum result = glClientWaitSync(fence, waitFlags, 1000000); // 1 ms
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) break;
+			if (result == GL_WAIT_FAILED)
+			{
+				Logger::Error("InstanceRingBuffer: Failed to wait for instance buffer fence");
+				break;
+			}
+			waitFlags = 0;
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
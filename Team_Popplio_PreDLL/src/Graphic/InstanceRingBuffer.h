@@ -0,0 +1,93 @@
+/******************************************************************************/
+/*!
+\file   InstanceRingBuffer.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the InstanceRingBuffer class, a persistently
+		mapped instance buffer split into three regions. Each frame writes its
+		instances into the next region, and a fence per region keeps the CPU
+		from overwriting instances the GPU is still reading.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <vector>
+
+#include "SpriteBatcher.h"
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	Triple-buffered, persistently mapped buffer of InstanceData.
+
+	*******************************************************************************/
+	class InstanceRingBuffer
+	{
+	public:
+		static constexpr size_t REGION_COUNT = 3;
+
+		/*!*****************************************************************************
+		\brief
+		Makes sure each region holds at least the given number of instances,
+		recreating the buffer if it is too small.
+
+		\return
+		True if the buffer was (re)created, vertex arrays reading from it must be
+		attached to the new buffer.
+
+		*******************************************************************************/
+		bool Reserve(size_t instancesPerRegion);
+
+		/*!*****************************************************************************
+		\brief
+		Copies the instances into the current region, waiting for the GPU to be
+		done with it first. The instances must fit in a region (see Reserve).
+
+		\return
+		The base instance of the region, to add to the first instance of draws.
+
+		*******************************************************************************/
+		GLuint Upload(const std::vector<InstanceData>& instances);
+
+		/*!*****************************************************************************
+		\brief
+		Fences the draws of the current region and moves to the next one.
+		Called after the last draw reading the uploaded instances.
+
+		*******************************************************************************/
+		void Fence();
+
+		/*!*****************************************************************************
+		\brief
+		Waits for every region and deletes the buffer. Needs the GL context.
+
+		*******************************************************************************/
+		void Destroy();
+
+		GLuint GetBuffer() const;
+		size_t GetCapacity() const;
+
+	private:
+		void WaitRegion(size_t index);
+
+		GLuint buffer = 0;
+		InstanceData* mapped = nullptr;
+		size_t capacity = 0; // instances per region
+		size_t region = 0;
+		std::array<GLsync, REGION_COUNT> fences{};
+	};
+}
@@ -26,22 +26,14 @@ Technology is prohibited.
 
 namespace Popplio
 {
-	void Mesh::SetupInstancing()
+	void Mesh::SetupInstancing(GLuint instanceBuffer)
 	{
-		glGenBuffers(1, &instanceVBO);
+		instanceVBO = instanceBuffer;
 		glBindVertexArray(VAO);
 		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
 
-		// Allocate buffer space
-		glBufferData(GL_ARRAY_BUFFER,
-			sizeof(InstanceData) * MAX_INSTANCES, // Define MAX_INSTANCES as needed
-			nullptr,
-			GL_DYNAMIC_DRAW);
-
 		// Set up matrix attributes (locations 3,4,5)
 		size_t vec3Size = sizeof(glm::vec3);
-		size_t matrixSize = sizeof(glm::mat3);
-		size_t floatSize = sizeof(float);       
 
 		// Matrix columns
 		glEnableVertexAttribArray(3);
@@ -57,22 +49,30 @@ namespace Popplio
 		// Color attribute (location 6)
 		glEnableVertexAttribArray(6);
 		glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
-			reinterpret_cast<void*>(matrixSize));
+			reinterpret_cast<void*>(offsetof(InstanceData, color)));
 
 		// Instance alpha (location 7)
 		glEnableVertexAttribArray(7);
-		glVertexAttribPointer(7, 1, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(sizeof(glm::mat3) + vec3Size));
+		glVertexAttribPointer(7, 1, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, alpha));
 
 		// Instance UV rect (location 8)
 		glEnableVertexAttribArray(8);
-		glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(sizeof(glm::mat3) + vec3Size + floatSize));
-
-		glVertexAttribDivisor(3, 1);
-		glVertexAttribDivisor(4, 1);
-		glVertexAttribDivisor(5, 1);
-		glVertexAttribDivisor(6, 1);
-		glVertexAttribDivisor(7, 1);
-		glVertexAttribDivisor(8, 1);
+		glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, uvRect));
+
+		// Nine-slice borders, sprite size, texture size and flags (locations 9,10,11,12)
+		glEnableVertexAttribArray(9);
+		glVertexAttribPointer(9, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, borderSize));
+		glEnableVertexAttribArray(10);
+		glVertexAttribPointer(10, 2, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, spriteSize));
+		glEnableVertexAttribArray(11);
+		glVertexAttribPointer(11, 2, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, textureSize));
+		glEnableVertexAttribArray(12);
+		glVertexAttribPointer(12, 2, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, flags));
+
+		for (GLuint location = 3; location <= 12; ++location)
+		{
+			glVertexAttribDivisor(location, 1);
+		}
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 		glBindVertexArray(0);
@@ -53,12 +53,18 @@ namespace Popplio
 		std::vector<unsigned int> indices;
 
 		// Fields for instancing
-		GLuint instanceVBO;
-		static const size_t MAX_INSTANCES = 10000; // Adjust as needed
+		GLuint instanceVBO; // instance buffer the instance attributes read from (not owned)
+		static const size_t MAX_INSTANCES = 10000; // Initial instances per frame, the buffer grows as needed
 
 		Mesh() : VAO(0), VBO(0), EBO(0), instanceVBO(0) {}
 
-		void SetupInstancing();
+		/*!*****************************************************************************
+		\brief
+		Attaches the per-instance attributes (locations 3 to 12) of the mesh to an
+		instance buffer of InstanceData.
+
+		*******************************************************************************/
+		void SetupInstancing(GLuint instanceBuffer);
 	};
 
 	/*!*****************************************************************************
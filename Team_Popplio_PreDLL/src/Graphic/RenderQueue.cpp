@@ -0,0 +1,121 @@
+/******************************************************************************/
+/*!
+\file   RenderQueue.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the RenderQueue class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "RenderQueue.h"
+
+#include <array>
+
+namespace Popplio
+{
+	namespace
+	{
+		constexpr int DEPTH_SHIFT = 0;
+		constexpr int MESH_SHIFT = DEPTH_SHIFT + RenderQueue::DEPTH_BITS;
+		constexpr int TEXTURE_SHIFT = MESH_SHIFT + RenderQueue::MESH_BITS;
+		constexpr int SHADER_SHIFT = TEXTURE_SHIFT + RenderQueue::TEXTURE_BITS;
+		constexpr int PASS_SHIFT = SHADER_SHIFT + RenderQueue::SHADER_BITS;
+		constexpr int LAYER_SHIFT = PASS_SHIFT + RenderQueue::PASS_BITS;
+		static_assert(LAYER_SHIFT + RenderQueue::LAYER_BITS == 64, "Render key fields must fill 64 bits");
+
+		std::uint64_t Field(std::uint32_t value, int bits, int shift)
+		{
+			return (static_cast<std::uint64_t>(value) & ((std::uint64_t(1) << bits) - 1)) << shift;
+		}
+
+		std::uint32_t Extract(std::uint64_t key, int bits, int shift)
+		{
+			return static_cast<std::uint32_t>((key >> shift) & ((std::uint64_t(1) << bits) - 1));
+		}
+	}
+
+	std::uint64_t RenderQueue::MakeKey(std::uint32_t layer, std::uint32_t pass, std::uint32_t shader,
+		std::uint32_t texture, std::uint32_t mesh, std::uint32_t depth)
+	{
+		return Field(layer, LAYER_BITS, LAYER_SHIFT) | Field(pass, PASS_BITS, PASS_SHIFT) |
+			Field(shader, SHADER_BITS, SHADER_SHIFT) | Field(texture, TEXTURE_BITS, TEXTURE_SHIFT) |
+			Field(mesh, MESH_BITS, MESH_SHIFT) | Field(depth, DEPTH_BITS, DEPTH_SHIFT);
+	}
+
+	std::uint32_t RenderQueue::GetLayer(std::uint64_t key) { return Extract(key, LAYER_BITS, LAYER_SHIFT); }
+	std::uint32_t RenderQueue::GetPass(std::uint64_t key) { return Extract(key, PASS_BITS, PASS_SHIFT); }
+	std::uint32_t RenderQueue::GetShader(std::uint64_t key) { return Extract(key, SHADER_BITS, SHADER_SHIFT); }
+	std::uint32_t RenderQueue::GetTexture(std::uint64_t key) { return Extract(key, TEXTURE_BITS, TEXTURE_SHIFT); }
+	std::uint32_t RenderQueue::GetMesh(std::uint64_t key) { return Extract(key, MESH_BITS, MESH_SHIFT); }
+	std::uint32_t RenderQueue::GetDepth(std::uint64_t key) { return Extract(key, DEPTH_BITS, DEPTH_SHIFT); }
+
+	void RenderQueue::Clear()
+	{
+		commands.clear();
+	}
+
+	void RenderQueue::Push(std::uint64_t key, std::uint32_t payload)
+	{
+		commands.push_back({ key, payload });
+	}
+
+	void RenderQueue::Sort()
+	{
+		const size_t count = commands.size();
+		if (count < 2) return;
+
+		// Histogram of every byte of the keys in one pass
+		std::array<std::array<size_t, 256>, 8> histograms{};
+		for (const RenderCommand& command : commands)
+		{
+			for (int byte = 0; byte < 8; ++byte)
+			{
+				++histograms[byte][(command.key >> (byte * 8)) & 0xFF];
+			}
+		}
+
+		scratch.resize(count);
+		for (int byte = 0; byte < 8; ++byte)
+		{
+			std::array<size_t, 256>& histogram = histograms[byte];
+
+			// Every key has the same value in this byte, the pass would not move anything
+			if (histogram[(commands[0].key >> (byte * 8)) & 0xFF] == count) continue;
+
+			size_t offset = 0;
+			for (size_t& bucket : histogram)
+			{
+				const size_t size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+
+			for (const RenderCommand& command : commands)
+			{
+				scratch[histogram[(command.key >> (byte * 8)) & 0xFF]++] = command;
+			}
+			commands.swap(scratch);
+		}
+	}
+
+	const std::vector<RenderCommand>& RenderQueue::GetCommands() const
+	{
+		return commands;
+	}
+
+	size_t RenderQueue::Size() const
+	{
+		return commands.size();
+	}
+}
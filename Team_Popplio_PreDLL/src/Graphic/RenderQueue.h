@@ -0,0 +1,144 @@
+/******************************************************************************/
+/*!
+\file   RenderQueue.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the RenderQueue class, which collects the
+		draw commands of a frame as 64-bit sort keys with a payload index and
+		radix sorts them, so commands sharing a shader / texture / mesh are
+		submitted together.
+
+		The queue does not touch OpenGL and can be used headlessly.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	One draw command: the sort key and the index of the data to draw, which is
+	owned by the system that queued the command.
+
+	*******************************************************************************/
+	struct RenderCommand
+	{
+		std::uint64_t key;
+		std::uint32_t payload;
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Per-frame rendering counters.
+
+	*******************************************************************************/
+	struct RenderStats
+	{
+		unsigned int commands = 0;
+		unsigned int drawCalls = 0;
+		unsigned int shaderSwitches = 0;
+		unsigned int textureBinds = 0;
+		unsigned int batchedSprites = 0; // sprites drawn in sprite batches
+		unsigned int instances = 0; // instances uploaded to the instance buffer
+		unsigned int batchedGlyphs = 0; // text glyphs drawn in sprite batches
+		unsigned int visibleEntities = 0; // cullable entities inside the camera view
+		unsigned int culledEntities = 0; // cullable entities outside, not queued
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Queue of draw commands sorted by key.
+
+	Key layout, most significant first:
+	layer (8) | pass (2) | shader (12) | texture (16) | mesh (4) | depth (22)
+	Layers keep their draw order, and within a layer the passes keep theirs;
+	commands in a pass are grouped by state, depth only breaks ties.
+	Fields wider than their bits are truncated, which only affects grouping.
+
+	*******************************************************************************/
+	class RenderQueue
+	{
+	public:
+		/*!*****************************************************************************
+		\brief
+		Draw passes within a layer, in draw order.
+
+		*******************************************************************************/
+		enum Pass : std::uint32_t
+		{
+			PASS_SPRITE,
+			PASS_INSTANCED,
+			PASS_TEXT
+		};
+
+		static constexpr int DEPTH_BITS = 22;
+		static constexpr int MESH_BITS = 4;
+		static constexpr int TEXTURE_BITS = 16;
+		static constexpr int SHADER_BITS = 12;
+		static constexpr int PASS_BITS = 2;
+		static constexpr int LAYER_BITS = 8;
+
+		/*!*****************************************************************************
+		\brief
+		Packs the fields of a command into a sort key.
+
+		*******************************************************************************/
+		static std::uint64_t MakeKey(std::uint32_t layer, std::uint32_t pass, std::uint32_t shader,
+			std::uint32_t texture, std::uint32_t mesh, std::uint32_t depth);
+
+		static std::uint32_t GetLayer(std::uint64_t key);
+		static std::uint32_t GetPass(std::uint64_t key);
+		static std::uint32_t GetShader(std::uint64_t key);
+		static std::uint32_t GetTexture(std::uint64_t key);
+		static std::uint32_t GetMesh(std::uint64_t key);
+		static std::uint32_t GetDepth(std::uint64_t key);
+
+		/*!*****************************************************************************
+		\brief
+		Removes every command, keeping the memory for the next frame.
+
+		*******************************************************************************/
+		void Clear();
+
+		/*!*****************************************************************************
+		\brief
+		Queues a command.
+
+		*******************************************************************************/
+		void Push(std::uint64_t key, std::uint32_t payload);
+
+		/*!*****************************************************************************
+		\brief
+		Sorts the commands by key (LSD radix sort, stable). Byte positions where
+		every key is equal are skipped.
+
+		*******************************************************************************/
+		void Sort();
+
+		/*!*****************************************************************************
+		\brief
+		Gets the queued commands, in key order after Sort.
+
+		*******************************************************************************/
+		const std::vector<RenderCommand>& GetCommands() const;
+
+		size_t Size() const;
+
+	private:
+		std::vector<RenderCommand> commands{};
+		std::vector<RenderCommand> scratch{}; // radix sort buffer
+	};
+}
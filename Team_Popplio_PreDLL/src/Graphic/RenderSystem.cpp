@@ -27,14 +27,58 @@ Technology is prohibited.
 #include <pch.h>
 #include "RenderSystem.h"
 #include "../Engine/Engine.h"
+#include "../PerformanceViewer/PerformanceViewer.h"
 
 namespace Popplio
 {
+	namespace
+	{
+		// Uniforms set per draw, hashed at compile time
+		constexpr UniformHandle MODEL_UNIFORM{ "model" };
+		constexpr UniformHandle COLOR_UNIFORM{ "uColor" };
+		constexpr UniformHandle ALPHA_UNIFORM{ "uAlpha" };
+		constexpr UniformHandle TEXTURE_UNIFORM{ "ourTexture" };
+		constexpr UniformHandle USE_TEXTURE_UNIFORM{ "useTexture" };
+		constexpr UniformHandle NINE_SLICE_UNIFORM{ "useNineSlice" };
+		constexpr UniformHandle SPRITE_SIZE_UNIFORM{ "spriteSize" };
+		constexpr UniformHandle TEXTURE_SIZE_UNIFORM{ "textureSize" };
+		constexpr UniformHandle BORDER_SIZE_UNIFORM{ "borderSize" };
+		constexpr UniformHandle UV_COORDS_UNIFORM{ "u_TextureCoords" };
+		constexpr UniformHandle TEXT_COLOR_UNIFORM{ "textColor" };
+	}
 
-	RenderSystem::RenderSystem(GLFWwindow* window, LayerManager& layerMgr, CameraManager& cameraMgr)
-		: window(window), layerManager(layerMgr), cameraManager(cameraMgr)
+	RenderSystem::RenderSystem(Registry& reg, GLFWwindow* window, LayerManager& layerMgr, CameraManager& cameraMgr)
+		: reg(reg), window(window), layerManager(layerMgr), cameraManager(cameraMgr)
 	{
 		RequireComponent<TransformComponent>();
+
+		// These decide whether and how an entity is culled
+		WatchComponent<RenderComponent>();
+		WatchComponent<TextComponent>();
+		WatchComponent<ParticleComponent>();
+		WatchComponent<UIComponent>();
+	}
+
+	void RenderSystem::AddEntityToSystem(Entity entity)
+	{
+		System::AddEntityToSystem(entity);
+		cullingChanges.push_back(entity);
+	}
+
+	void RenderSystem::RemoveEntityFromSystem(Entity entity)
+	{
+		System::RemoveEntityFromSystem(entity);
+		SetCullClass(entity, CullClass::NONE);
+	}
+
+	void RenderSystem::OnWatchedComponentChanged(Entity entity)
+	{
+		cullingChanges.push_back(entity);
+	}
+
+	void RenderSystem::ReclassifyForCulling(const Entity& entity)
+	{
+		if (HasEntity(entity)) cullingChanges.push_back(entity);
 	}
 
 	void RenderSystem::ToggleDebugDrawing()
@@ -50,10 +94,15 @@ namespace Popplio
 		AssetStore::StoreMeshAsset(Quad, CreateQuadMesh());
 		AssetStore::StoreMeshAsset(Circle, CreateCircleMesh());
 
-		// Set up instancing for meshes that will be instanced
-		AssetStore::GetMesh(Quad).SetupInstancing();
-		AssetStore::GetMesh(Triangle).SetupInstancing();
-		AssetStore::GetMesh(Circle).SetupInstancing();
+		// Set up instancing for meshes that will be instanced, all reading from the instance ring buffer
+		instanceRing.Reserve(Mesh::MAX_INSTANCES);
+		AssetStore::GetMesh(Quad).SetupInstancing(instanceRing.GetBuffer());
+		AssetStore::GetMesh(Triangle).SetupInstancing(instanceRing.GetBuffer());
+		AssetStore::GetMesh(Circle).SetupInstancing(instanceRing.GetBuffer());
+
+		// View and projection of every shader, as two std140 mat3 (three vec4 columns each)
+		glCreateBuffers(1, &cameraBuffer);
+		glNamedBufferStorage(cameraBuffer, sizeof(glm::vec4) * 6, nullptr, GL_DYNAMIC_STORAGE_BIT);
 	}
 
 	void RenderSystem::Update()
@@ -61,27 +110,94 @@ namespace Popplio
 		glClearColor(0.7f, 0.7f, 0.7f, 1.f);
 		glClear(GL_COLOR_BUFFER_BIT);
 
+		renderStats = RenderStats{};
+		GLCallCounter::Reset();
+		boundShader = nullptr;
+		boundTexture = 0;
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		GLCallCounter::Add(GLCallCounter::TEXTURE);
+
+		// The camera does not change during an Update, so it is uploaded once for every shader
+		UploadCamera();
+
+		// Queue every draw, sort by layer / pass / state, then draw in that order
+		QueueEntities();
+		renderQueue.Sort();
+		SubmitRenderQueue();
+
+		// Render debug colliders if needed
+		if (debugDrawing)
+		{
+			RenderDebugColliders();
+		}
+
+		if (boundShader) boundShader->UnUse();
+		boundShader = nullptr;
+		BindTexture(0);
+
+		GLCallCounter::Add(GLCallCounter::DRAW, renderStats.drawCalls);
+	}
+
+	void RenderSystem::UploadCamera()
+	{
+		const glm::mat3 view = cameraManager.GetViewMatrix().ToGLM();
+		const glm::mat3 projection = cameraManager.GetProjectionMatrix().ToGLM();
+
+		// std140 pads every mat3 column to a vec4
+		const glm::vec4 camera[6] = {
+			glm::vec4(view[0], 0.0f), glm::vec4(view[1], 0.0f), glm::vec4(view[2], 0.0f),
+			glm::vec4(projection[0], 0.0f), glm::vec4(projection[1], 0.0f), glm::vec4(projection[2], 0.0f)
+		};
+		glNamedBufferSubData(cameraBuffer, 0, sizeof(camera), camera);
+		glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, cameraBuffer);
+		GLCallCounter::Add(GLCallCounter::BUFFER);
+	}
+
+	const RenderStats& RenderSystem::GetRenderStats() const
+	{
+		return renderStats;
+	}
+
+	void RenderSystem::QueueEntities()
+	{
+		renderQueue.Clear();
+		queuedEntities.clear();
+		queuedSpriteShaders.clear();
+		for (size_t i = 0; i < instancedBatchCount; ++i) instancedBatches[i].entities.clear();
+		instancedBatchCount = 0;
+
+		UpdateCulling();
+
+		// Quad sprites are drawn in batches if the batch shader is loaded
+		spriteBatchShader = AssetStore::GetShader("sprite_batch_shader");
+
 		// Get all layers in order
 		auto sortedLayers = layerManager.GetSortedLayers();
 
-		// Render entities in each layer
-		for (const auto& layer : sortedLayers)
+		// Only the entities in view and the ones never culled are visited
+		GatherDrawCandidates(sortedLayers);
+		size_t candidate = 0;
+
+		// Queue entities in each layer
+		for (std::uint32_t layerIndex = 0; layerIndex < static_cast<std::uint32_t>(sortedLayers.size()); ++layerIndex)
 		{
+			const auto& layer = sortedLayers[layerIndex];
 			if (!layer.active)
 			{
 				continue;
 			}
 
-			// Get entities in this layer
-			auto layerEntities = layerManager.GetEntitiesInLayer(layer.name);
+			// Instanced entities of this layer are batched per mesh
+			int batchOfMesh[MeshType::FullscreenQuad + 1] = { -1, -1, -1, -1 };
 
-			// Separate entities by rendering method
-			std::vector<Entity> nonInstancedEntities;
-			std::vector<Entity> textEntities;
-			std::unordered_map<MeshType, std::vector<Entity>> instancedEntities;
+			// Order of the entity within the layer, breaks ties between commands with the same state
+			std::uint32_t depth = 0;
 
-			for (const auto& entity : layerEntities)
+			for (; candidate < drawCandidates.size() && drawCandidates[candidate].layer == layerIndex; ++candidate)
 			{
+				const Entity& entity = drawCandidates[candidate].entity;
+				++depth;
 				if (entity.HasComponent<ActiveComponent>() == false)
 				{
 					Logger::Debug("Why does Entity not have ActiveComponent???");
@@ -92,194 +208,500 @@ namespace Popplio
 				{
 					if (!entity.GetComponent<RenderComponent>().isActive) continue;
 					const auto& renderComp = entity.GetComponent<RenderComponent>();
-					if (renderComp.useInstancing)
+
+					Shader* shader = AssetStore::GetShader(renderComp.shaderName);
+					if (!shader) continue;
+					const unsigned int textureID = renderComp.textureName.empty() ? 0 : AssetStore::GetTexture(renderComp.textureName);
+
+					SpriteShader spriteShader = spriteBatchShader ? SpriteBatcher::GetSpriteShader(renderComp) : SpriteShader::NONE;
+					// Particles are drawn per particle by the instanced / sprite paths
+					if (entity.HasComponent<ParticleComponent>() &&
+						(renderComp.useInstancing || entity.GetComponent<ParticleComponent>().isActive))
+					{
+						spriteShader = SpriteShader::NONE;
+					}
+
+					if (spriteShader != SpriteShader::NONE)
+					{
+						// Batched sprites share the batch shader, so they are grouped by texture (atlas page)
+						const unsigned int pageID = renderComp.textureName.empty() ? 0 : AssetStore::GetTextureRegion(renderComp.textureName).texture;
+						renderQueue.Push(RenderQueue::MakeKey(layerIndex, RenderQueue::PASS_SPRITE,
+							spriteBatchShader->GetID(), pageID, renderComp.meshType, depth), static_cast<std::uint32_t>(queuedEntities.size()));
+						queuedEntities.push_back(entity);
+						queuedSpriteShaders.push_back(spriteShader);
+					}
+					else if (renderComp.useInstancing)
 					{
-						instancedEntities[renderComp.meshType].push_back(entity);
+						int& batch = batchOfMesh[renderComp.meshType];
+						if (batch < 0)
+						{
+							// The first entity of the batch decides its shader and texture
+							batch = static_cast<int>(instancedBatchCount++);
+							if (instancedBatches.size() < instancedBatchCount) instancedBatches.emplace_back();
+							instancedBatches[batch].mesh = renderComp.meshType;
+
+							renderQueue.Push(RenderQueue::MakeKey(layerIndex, RenderQueue::PASS_INSTANCED,
+								shader->GetID(), textureID, renderComp.meshType, depth), static_cast<std::uint32_t>(batch));
+						}
+						instancedBatches[batch].entities.push_back(entity);
 					}
 					else
 					{
-						nonInstancedEntities.push_back(entity);
+						renderQueue.Push(RenderQueue::MakeKey(layerIndex, RenderQueue::PASS_SPRITE,
+							shader->GetID(), textureID, renderComp.meshType, depth), static_cast<std::uint32_t>(queuedEntities.size()));
+						queuedEntities.push_back(entity);
+						queuedSpriteShaders.push_back(SpriteShader::NONE);
 					}
 				}
 				else if (entity.HasComponent<TextComponent>())
 				{
-					if (!entity.GetComponent<TextComponent>().isActive) continue;
-					textEntities.push_back(entity);
+					const auto& textComp = entity.GetComponent<TextComponent>();
+					if (!textComp.isActive) continue;
+
+					// Only rebuilt if the text, font or size changed
+					const TextLayout& layout = textComp.GetLayout();
+					if (layout.GetQuads().empty()) continue;
+
+					// Glyphs are drawn in sprite batches, grouped by the glyph atlas of their font size
+					const bool batched = spriteBatchShader != nullptr;
+					renderQueue.Push(RenderQueue::MakeKey(layerIndex, RenderQueue::PASS_TEXT,
+						batched ? spriteBatchShader->GetID() : 0, layout.GetTexture(), 0, depth),
+						static_cast<std::uint32_t>(queuedEntities.size()));
+					queuedEntities.push_back(entity);
+					queuedSpriteShaders.push_back(batched ? SpriteShader::TEXT : SpriteShader::NONE);
 				}
 			}
+		}
+
+		renderStats.commands = static_cast<unsigned int>(renderQueue.Size());
+	}
+
+	void RenderSystem::UpdateCulling()
+	{
+		TransformationSystem* transformation = reg.HasSystem<TransformationSystem>() ? &reg.GetSystem<TransformationSystem>() : nullptr;
+		if (transformation) transformation->TakeMovedEntities(movedEntities);
+
+		// Entities added, with changed components or types are sorted again, the rest keep their place
+		for (const Entity& entity : cullingChanges)
+		{
+			if (HasEntity(entity)) SetCullClass(entity, GetCullClass(entity));
+		}
+		cullingChanges.clear();
+
+		if (transformation)
+		{
+			for (int id : movedEntities)
+			{
+				if (cullingGrid.Contains(id)) UpdateCullBounds(reg.GetEntityById(id));
+			}
+		}
+		else
+		{
+			// Nothing reports the moved entities
+			for (const Entity& entity : GetSystemEntities())
+			{
+				if (cullingGrid.Contains(entity.GetId())) UpdateCullBounds(entity);
+			}
+		}
+
+		// Text can change without moving
+		for (const Entity& entity : textEntities)
+		{
+			if (entity.GetComponent<TextComponent>().GetLayout().GetVersion() != textLayoutVersions[entity.GetId()])
+			{
+				UpdateCullBounds(entity);
+			}
+		}
 
-			// Render non-instanced entities
-			RenderNonInstancedEntities(nonInstancedEntities);
+		const glm::vec4 view = cameraManager.GetViewBounds();
+		cullingGrid.Query(CullBounds{ view.x, view.y, view.z, view.w });
 
-			// Render non-instanced entities
-			for (const auto& [meshType, entitiesList] : instancedEntities)
+		renderStats.visibleEntities = static_cast<unsigned int>(cullingGrid.GetVisibleCount());
+		renderStats.culledEntities = static_cast<unsigned int>(cullingGrid.GetEntityCount() - cullingGrid.GetVisibleCount());
+		PerformanceViewer::GetInstance()->SetCounter("Visible entities", renderStats.visibleEntities);
+		PerformanceViewer::GetInstance()->SetCounter("Culled entities", renderStats.culledEntities);
+	}
+
+	RenderSystem::CullClass RenderSystem::GetCullClass(const Entity& entity) const
+	{
+		if (entity.HasComponent<RenderComponent>())
+		{
+			// Full screen quads, particles and slider handles are drawn away from their transform
+			if (entity.GetComponent<RenderComponent>().meshType == MeshType::FullscreenQuad ||
+				entity.HasComponent<ParticleComponent>() ||
+				(entity.HasComponent<UIComponent>() && entity.GetComponent<UIComponent>().type == UIType::SLIDER_HANDLE))
 			{
-				RenderInstanced(meshType, entitiesList);
+				return CullClass::UNCULLABLE;
 			}
+			return CullClass::SPRITE;
+		}
+		return entity.HasComponent<TextComponent>() ? CullClass::TEXT : CullClass::NONE;
+	}
 
-			// Render text entities
-			RenderTextEntities(textEntities);
+	void RenderSystem::SetCullClass(const Entity& entity, CullClass cullClass)
+	{
+		const int id = entity.GetId();
+		if (static_cast<size_t>(id) >= cullClasses.size())
+		{
+			if (cullClass == CullClass::NONE) return;
+			cullClasses.resize(id + 1, CullClass::NONE);
+			textLayoutVersions.resize(id + 1, 0);
 		}
 
-		// Render debug colliders if needed
-		if (debugDrawing)
+		const CullClass previous = cullClasses[id];
+		if (previous == cullClass) return;
+
+		auto erase = [id](std::vector<Entity>& entities)
 		{
-			RenderDebugColliders();
+			auto it = std::find_if(entities.begin(), entities.end(), [id](const Entity& e) { return e.GetId() == id; });
+			if (it == entities.end()) return;
+			*it = entities.back();
+			entities.pop_back();
+		};
+		if (previous == CullClass::SPRITE || previous == CullClass::TEXT) cullingGrid.Remove(id);
+		if (previous == CullClass::TEXT) erase(textEntities);
+		if (previous == CullClass::UNCULLABLE) erase(uncullableEntities);
+
+		cullClasses[id] = cullClass;
+		switch (cullClass)
+		{
+		case CullClass::SPRITE:
+			UpdateCullBounds(entity);
+			break;
+		case CullClass::TEXT:
+			textEntities.push_back(entity);
+			UpdateCullBounds(entity);
+			break;
+		case CullClass::UNCULLABLE:
+			uncullableEntities.push_back(entity);
+			break;
+		default:
+			break;
 		}
 	}
-	void RenderSystem::RenderNonInstancedEntities(const std::vector<Entity>& entitiesList)
+
+	void RenderSystem::UpdateCullBounds(const Entity& entity)
 	{
-		for (const auto& entity : entitiesList)
+		const auto& transform = entity.GetComponent<TransformComponent>();
+		if (entity.HasComponent<RenderComponent>())
 		{
-			if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-			if (!entity.GetComponent<RenderComponent>().isActive) continue;
+			// Every mesh fits in the unit square before its model matrix
+			cullingGrid.Update(entity.GetId(), CullBounds::FromModelMatrix(transform.modelMatrix.ToGLM()));
+			return;
+		}
 
-			const auto& transform = entity.GetComponent<TransformComponent>();
-			const auto& renderComp = entity.GetComponent<RenderComponent>();
+		// Text ignores the model matrix, its glyphs are placed around the position
+		const TextLayout& layout = entity.GetComponent<TextComponent>().GetLayout();
+		textLayoutVersions[entity.GetId()] = layout.GetVersion();
+		CullBounds bounds{ transform.position.x, transform.position.y, transform.position.x, transform.position.y };
+		for (const GlyphQuad& glyph : layout.GetQuads())
+		{
+			bounds.minX = std::min(bounds.minX, transform.position.x + glyph.rect.x);
+			bounds.minY = std::min(bounds.minY, transform.position.y + glyph.rect.y);
+			bounds.maxX = std::max(bounds.maxX, transform.position.x + glyph.rect.x + glyph.rect.z);
+			bounds.maxY = std::max(bounds.maxY, transform.position.y + glyph.rect.y + glyph.rect.w);
+		}
+		cullingGrid.Update(entity.GetId(), bounds);
+	}
 
-			Shader* shader = AssetStore::GetShader(renderComp.shaderName);
-			shader->Use();
+	void RenderSystem::GatherDrawCandidates(const std::vector<Layer>& sortedLayers)
+	{
+		// Sorted index of each layer id, -1 for inactive layers and entities without a layer
+		std::array<int, LayerManager::MAX_LAYERS + 1> layerIndexOfId{};
+		layerIndexOfId.fill(-1);
+		for (size_t i = 0; i < sortedLayers.size(); ++i)
+		{
+			if (!sortedLayers[i].active) continue;
+			const int id = layerManager.GetLayerId(sortedLayers[i].name);
+			if (id != LayerManager::NO_LAYER) layerIndexOfId[id] = static_cast<int>(i);
+		}
+
+		drawCandidates.clear();
+		auto add = [this, &layerIndexOfId](const Entity& entity)
+		{
+			const int layer = layerIndexOfId[layerManager.GetEntityLayerId(entity.GetId())];
+			if (layer >= 0) drawCandidates.push_back({ static_cast<std::uint32_t>(layer), entity });
+		};
+		for (int id : cullingGrid.GetVisible()) add(reg.GetEntityById(id));
+		for (const Entity& entity : uncullableEntities) add(entity);
+
+		std::sort(drawCandidates.begin(), drawCandidates.end(), [](const DrawCandidate& a, const DrawCandidate& b)
+			{ return a.layer < b.layer || (a.layer == b.layer && a.entity.GetId() < b.entity.GetId()); });
+	}
+
+	void RenderSystem::SubmitRenderQueue()
+	{
+		BuildDrawSteps();
+
+		// Upload every instance of the frame at once
+		const std::vector<InstanceData>& instances = spriteBatcher.GetInstances();
+		if (instanceRing.Reserve(instances.size()))
+		{
+			// The buffer grew, attach the meshes to the new one
+			AssetStore::GetMesh(Quad).SetupInstancing(instanceRing.GetBuffer());
+			AssetStore::GetMesh(Triangle).SetupInstancing(instanceRing.GetBuffer());
+			AssetStore::GetMesh(Circle).SetupInstancing(instanceRing.GetBuffer());
+		}
+		baseInstance = instanceRing.Upload(instances);
+		renderStats.instances = static_cast<unsigned int>(instances.size());
 
-			// Set model, view, and projection matrices if not background mesh type
-			if (renderComp.meshType != MeshType::FullscreenQuad)
+		const std::vector<RenderCommand>& commands = renderQueue.GetCommands();
+		for (const SpriteDrawStep& step : spriteBatcher.GetSteps())
+		{
+			if (step.spriteBatch)
 			{
-				shader->SetMatrix3("model", transform.modelMatrix.ToGLM());
-				shader->SetMatrix3("view", cameraManager.GetViewMatrix().ToGLM());
-				shader->SetMatrix3("projection", cameraManager.GetProjectionMatrix().ToGLM());
-				shader->SetVector3f("uColor", renderComp.color);
-				//std::cout << std::to_string(static_cast<int>(transform.anchor)) <<std::endl;
+				RenderSpriteBatch(step);
+				continue;
 			}
 
-			if (renderComp.shaderName != "debug_shader")
+			const RenderCommand& command = commands[step.command];
+			switch (RenderQueue::GetPass(command.key))
 			{
-				shader->setFloat("uAlpha", renderComp.alpha);
+			case RenderQueue::PASS_SPRITE:
+				RenderSprite(queuedEntities[command.payload]);
+				break;
+			case RenderQueue::PASS_INSTANCED:
+				RenderInstanced(instancedBatches[command.payload], step);
+				break;
+			case RenderQueue::PASS_TEXT:
+			{
+				const Entity& entity = queuedEntities[command.payload];
+				RenderText(entity.GetComponent<TextComponent>(), entity.GetComponent<TransformComponent>());
+				break;
 			}
+			default:
+				break;
+			}
+		}
+
+		// The region can be written again once the GPU is done with these draws
+		instanceRing.Fence();
+	}
+
+	void RenderSystem::BuildDrawSteps()
+	{
+		spriteBatcher.Begin();
 
-            // Handle particles
-			bool particlesActive = 
-				entity.HasComponent<ParticleComponent>() && entity.GetComponent<ParticleComponent>().isActive;
-			if (particlesActive)
+		const std::vector<RenderCommand>& commands = renderQueue.GetCommands();
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(commands.size()); ++i)
+		{
+			const RenderCommand& command = commands[i];
+			switch (RenderQueue::GetPass(command.key))
 			{
-                std::optional<RenderComponent> renderCompOpt = 
-					entity.HasComponent<RenderComponent>() ? 
-					std::make_optional(entity.GetComponent<RenderComponent>()) : std::nullopt;
-                std::optional<AnimationComponent> animCompOpt = 
-					entity.HasComponent<AnimationComponent>() ? 
-					std::make_optional(entity.GetComponent<AnimationComponent>()) : std::nullopt;
-				HandleParticles(entity.GetComponent<ParticleComponent>(), renderCompOpt, animCompOpt, shader);
-			}
-			else // if entity does not have a particle system
+			case RenderQueue::PASS_SPRITE:
 			{
-				// Handle textures
-				if (!renderComp.textureName.empty()) HandleTexture(renderComp, shader);
+				const SpriteShader spriteShader = queuedSpriteShaders[command.payload];
+				if (spriteShader == SpriteShader::NONE)
+				{
+					spriteBatcher.AddCommand(i);
+					break;
+				}
 
-				// Handle animations
-				if (entity.HasComponent<AnimationComponent>() && entity.GetComponent<AnimationComponent>().isActive)
-					HandleAnimation(renderComp, entity.GetComponent<AnimationComponent>(), shader);
+				const Entity& entity = queuedEntities[command.payload];
+				const auto& renderComp = entity.GetComponent<RenderComponent>();
+				const AnimationComponent* animComp =
+					entity.HasComponent<AnimationComponent>() ? &entity.GetComponent<AnimationComponent>() : nullptr;
+				const UIComponent* uiComp =
+					entity.HasComponent<UIComponent>() ? &entity.GetComponent<UIComponent>() : nullptr;
+
+				const TextureRegion region = renderComp.textureName.empty() ? TextureRegion{} : AssetStore::GetTextureRegion(renderComp.textureName);
+				spriteBatcher.AddSprite(i, region.texture, SpriteBatcher::MakeSpriteInstance(spriteShader,
+					entity.GetComponent<TransformComponent>(), renderComp, animComp, uiComp, GetSliderTrack(entity), region));
+				++renderStats.batchedSprites;
+				break;
 			}
-
-			// Apply 9-Slice Scaling (only default shader supports this)
-			if (!renderComp.textureName.empty() && renderComp.enableNineSlice && (renderComp.shaderName == "default_shader"))
+			case RenderQueue::PASS_INSTANCED:
+				spriteBatcher.AddCommand(i);
+				BuildInstances(instancedBatches[command.payload].entities);
+				break;
+			case RenderQueue::PASS_TEXT:
 			{
-				shader->setBool("useNineSlice", true);
-				shader->SetUniform("spriteSize", glm::vec2(transform.scale.x, transform.scale.y));
-				shader->SetUniform("textureSize", glm::vec2(renderComp.textureWidth, renderComp.textureHeight));
-
-				glm::vec4 bSize(
-							renderComp.borderLeft,
-							renderComp.borderRight,
-							renderComp.borderBottom,
-							renderComp.borderTop
-						);
-				shader->SetUniform("borderSize", bSize);
+				if (queuedSpriteShaders[command.payload] != SpriteShader::TEXT)
+				{
+					spriteBatcher.AddCommand(i);
+					break;
+				}
 
+				// Consecutive texts with the same glyph atlas end up in the same batch
+				const Entity& entity = queuedEntities[command.payload];
+				const auto& textComp = entity.GetComponent<TextComponent>();
+				const auto& transform = entity.GetComponent<TransformComponent>();
+				const TextLayout& layout = textComp.GetLayout();
+				for (const GlyphQuad& glyph : layout.GetQuads())
+				{
+					spriteBatcher.AddSprite(i, layout.GetTexture(), SpriteBatcher::MakeGlyphInstance(glyph, transform, textComp));
+				}
+				renderStats.batchedGlyphs += static_cast<unsigned int>(layout.GetQuads().size());
+				break;
 			}
-			else
-			{
-				shader->setBool("useNineSlice", false);
+			default:
+				spriteBatcher.AddCommand(i);
+				break;
 			}
+		}
+	}
 
+	const TransformComponent* RenderSystem::GetSliderTrack(const Entity& entity) const
+	{
+		if (!entity.HasComponent<UIComponent>()) return nullptr;
 
-			if (entity.HasComponent<UIComponent>() && entity.GetComponent<UIComponent>().isActive)
-			{
-				auto& uiComp = entity.GetComponent<UIComponent>();
+		const auto& uiComp = entity.GetComponent<UIComponent>();
+		if (uiComp.type != UIType::SLIDER_HANDLE || uiComp.linkedEntityId < 0) return nullptr;
 
-				if (uiComp.type == UIType::SLIDER_TRACK)
-				{
-					//shader->SetVector3f("uColor", glm::vec3(uiComp.sliderValue, renderComp.color.g, renderComp.color.b));
-				}
-				else if (uiComp.type == UIType::SLIDER_HANDLE)
-				{
-					// Ensure the handle renders in the correct position
-					if (uiComp.linkedEntityId >= 0)
-					{
-						Entity trackEntity(uiComp.linkedEntityId);
-						trackEntity.registry = entity.registry;
-						if (trackEntity.HasComponent<TransformComponent>())
-						{
-							auto& trackTransform = trackEntity.GetComponent<TransformComponent>();
+		Entity trackEntity(uiComp.linkedEntityId);
+		trackEntity.registry = entity.registry;
+		if (!trackEntity.HasComponent<TransformComponent>()) return nullptr;
+		return &trackEntity.GetComponent<TransformComponent>();
+	}
 
-							float trackLeft = trackTransform.position.x - (trackTransform.scale.x * 0.5f);
-							float offset = uiComp.sliderValue * trackTransform.scale.x;
+	void RenderSystem::RenderSpriteBatch(const SpriteDrawStep& step)
+	{
+		UseShader(spriteBatchShader);
+		BindTexture(step.texture);
+		spriteBatchShader->setInt(TEXTURE_UNIFORM, 0);
 
-							glm::mat3 modelMatrix = transform.modelMatrix.ToGLM();
-							modelMatrix[2][0] = trackLeft + offset;
+		const Mesh& mesh = AssetStore::GetMesh(MeshType::Quad);
+		glBindVertexArray(mesh.VAO);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES,
+			static_cast<GLsizei>(mesh.indices.size()),
+			GL_UNSIGNED_INT, 0,
+			static_cast<GLsizei>(step.instanceCount),
+			baseInstance + step.firstInstance);
+		++renderStats.drawCalls;
+		glBindVertexArray(0);
+	}
 
-							shader->SetMatrix3("model", modelMatrix);
-						}
-					}
-				}
-				else if (uiComp.type == UIType::CHECKBOX)
-				{
-					shader->SetVector3f("uColor", uiComp.checked ? glm::vec3(0.0f, 0.7f, 0.0f) : renderComp.color);
-				}
-				else if (uiComp.type == UIType::BUTTON && uiComp.hasHoverEffect)
-				{
-					glm::vec4 uvCoords = uiComp.GetCurrentUV();
-					shader->SetUniform("u_TextureCoords", uvCoords);
-				}
-			}
+	void RenderSystem::UseShader(Shader* shader)
+	{
+		if (shader == boundShader) return;
 
-			if (!particlesActive) RenderMesh(renderComp.meshType);
+		shader->Use();
+		boundShader = shader;
+		++renderStats.shaderSwitches;
+	}
 
-			glBindTexture(GL_TEXTURE_2D, 0);
+	void RenderSystem::BindTexture(unsigned int textureID)
+	{
+		if (textureID == boundTexture) return;
 
-			shader->UnUse();
-		}
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		boundTexture = textureID;
+		++renderStats.textureBinds;
+		GLCallCounter::Add(GLCallCounter::TEXTURE);
 	}
 
-	void RenderSystem::RenderTextEntities(const std::vector<Entity>& entitiesList)
+	void RenderSystem::RenderSprite(const Entity& entity)
 	{
-		for (const auto& entity : entitiesList)
+		const auto& transform = entity.GetComponent<TransformComponent>();
+		const auto& renderComp = entity.GetComponent<RenderComponent>();
+
+		Shader* shader = AssetStore::GetShader(renderComp.shaderName);
+
+		// Set model, view, and projection matrices if not background mesh type
+		UseShader(shader);
+		if (renderComp.meshType != MeshType::FullscreenQuad)
 		{
-			if (!entity.GetComponent<TextComponent>().isActive) continue;
+			shader->SetMatrix3(MODEL_UNIFORM, transform.modelMatrix.ToGLM());
+			shader->SetVector3f(COLOR_UNIFORM, renderComp.color);
+			//std::cout << std::to_string(static_cast<int>(transform.anchor)) <<std::endl;
+		}
 
-			const auto& textComp = entity.GetComponent<TextComponent>();
-			const auto& transComp = entity.GetComponent<TransformComponent>();
-			RenderText(textComp, transComp);
+		if (renderComp.shaderName != "debug_shader")
+		{
+			shader->setFloat(ALPHA_UNIFORM, renderComp.alpha);
 		}
-	}
 
-	void RenderSystem::RenderInstanced(MeshType meshType, const std::vector<Entity>& entitiesList)
-	{
-		if (entitiesList.empty())
+        // Handle particles
+		bool particlesActive = 
+			entity.HasComponent<ParticleComponent>() && entity.GetComponent<ParticleComponent>().isActive;
+		if (particlesActive)
 		{
-			return;
+            std::optional<RenderComponent> renderCompOpt = 
+				entity.HasComponent<RenderComponent>() ? 
+				std::make_optional(entity.GetComponent<RenderComponent>()) : std::nullopt;
+            std::optional<AnimationComponent> animCompOpt = 
+				entity.HasComponent<AnimationComponent>() ? 
+				std::make_optional(entity.GetComponent<AnimationComponent>()) : std::nullopt;
+			HandleParticles(entity.GetComponent<ParticleComponent>(), renderCompOpt, animCompOpt, shader);
 		}
+		else // if entity does not have a particle system
+		{
+			// Handle textures, untextured sprites sample no texture
+			if (!renderComp.textureName.empty()) HandleTexture(renderComp, shader);
+			else BindTexture(0);
 
-		const auto& firstEntity = entitiesList[0];
-		const auto& firstrenderComp = firstEntity.GetComponent<RenderComponent>();
+			// Handle animations
+			if (entity.HasComponent<AnimationComponent>() && entity.GetComponent<AnimationComponent>().isActive)
+				HandleAnimation(renderComp, entity.GetComponent<AnimationComponent>(), shader);
+		}
 
-		Shader* shader = AssetStore::GetShader(firstrenderComp.shaderName);
-		shader->Use();
+		// Apply 9-Slice Scaling (only default shader supports this)
+		if (!renderComp.textureName.empty() && renderComp.enableNineSlice && (renderComp.shaderName == "default_shader"))
+		{
+			shader->setBool(NINE_SLICE_UNIFORM, true);
+			shader->SetUniform(SPRITE_SIZE_UNIFORM, glm::vec2(transform.scale.x, transform.scale.y));
+			shader->SetUniform(TEXTURE_SIZE_UNIFORM, glm::vec2(renderComp.textureWidth, renderComp.textureHeight));
+
+			glm::vec4 bSize(
+						renderComp.borderLeft,
+						renderComp.borderRight,
+						renderComp.borderBottom,
+						renderComp.borderTop
+					);
+			shader->SetUniform(BORDER_SIZE_UNIFORM, bSize);
+
+		}
+		else
+		{
+			shader->setBool(NINE_SLICE_UNIFORM, false);
+		}
+
+
+		if (entity.HasComponent<UIComponent>() && entity.GetComponent<UIComponent>().isActive)
+		{
+			auto& uiComp = entity.GetComponent<UIComponent>();
+
+			if (uiComp.type == UIType::SLIDER_TRACK)
+			{
+				//shader->SetVector3f("uColor", glm::vec3(uiComp.sliderValue, renderComp.color.g, renderComp.color.b));
+			}
+			else if (uiComp.type == UIType::SLIDER_HANDLE)
+			{
+				// Ensure the handle renders in the correct position
+				if (uiComp.linkedEntityId >= 0)
+				{
+					Entity trackEntity(uiComp.linkedEntityId);
+					trackEntity.registry = entity.registry;
+					if (trackEntity.HasComponent<TransformComponent>())
+					{
+						auto& trackTransform = trackEntity.GetComponent<TransformComponent>();
 
-		Mesh& mesh = AssetStore::GetMesh(meshType);
+						float trackLeft = trackTransform.position.x - (trackTransform.scale.x * 0.5f);
+						float offset = uiComp.sliderValue * trackTransform.scale.x;
 
-		// Prepare instance data
-		std::vector<InstanceData> instanceData;
-		instanceData.reserve(entitiesList.size() * 4);
+						glm::mat3 modelMatrix = transform.modelMatrix.ToGLM();
+						modelMatrix[2][0] = trackLeft + offset;
 
+						shader->SetMatrix3(MODEL_UNIFORM, modelMatrix);
+					}
+				}
+			}
+			else if (uiComp.type == UIType::CHECKBOX)
+			{
+				shader->SetVector3f(COLOR_UNIFORM, uiComp.checked ? glm::vec3(0.0f, 0.7f, 0.0f) : renderComp.color);
+			}
+			else if (uiComp.type == UIType::BUTTON && uiComp.hasHoverEffect)
+			{
+				glm::vec4 uvCoords = uiComp.GetCurrentUV();
+				shader->SetUniform(UV_COORDS_UNIFORM, uvCoords);
+			}
+		}
+
+		if (!particlesActive) RenderMesh(renderComp.meshType);
+	}
 
+	void RenderSystem::BuildInstances(const std::vector<Entity>& entitiesList)
+	{
 		for (const auto& entity : entitiesList)
 		{
 			if (!entity.GetComponent<ActiveComponent>().isActive) continue;
@@ -328,7 +750,7 @@ namespace Popplio
 						uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 					}
 
-					instanceData.push_back({ modelMatrix, instColor, instAlpha, uvRect });
+					spriteBatcher.AddInstance({ modelMatrix, instColor, instAlpha, uvRect });
 				}
 			}
 			else  // Normal instanced entity
@@ -345,7 +767,7 @@ namespace Popplio
 					uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // Full texture if no animation.
 				}
 
-				instanceData.push_back({
+				spriteBatcher.AddInstance({
 					transform.modelMatrix.ToGLM(),
 					glm::vec3(renderComp.color.x, renderComp.color.y, renderComp.color.z),
 					renderComp.alpha,
@@ -353,54 +775,43 @@ namespace Popplio
 					});
 			}
 		}
+	}
 
-		//// Apply 9-Slice Scaling to Instanced Entities with Textures
-		//if (!renderComp.textureName.empty() && renderComp.enableNineSlice)
-		//{
-		//	shader->setBool("useNineSlice", true);
-		//	shader->SetUniform("borderSize", glm::vec4(
-		//		renderComp.borderLeft / renderComp.textureWidth,
-		//		renderComp.borderRight / renderComp.textureWidth,
-		//		renderComp.borderTop / renderComp.textureHeight,
-		//		renderComp.borderBottom / renderComp.textureHeight
-		//	));
-		//}
-		//else
-		//{
-		//	shader->setBool("useNineSlice", false);
-		//}
+	void RenderSystem::RenderInstanced(const InstancedBatch& batch, const SpriteDrawStep& step)
+	{
+		if (step.instanceCount == 0)
+		{
+			return;
+		}
 
-		// Update instance buffer
-		glBindBuffer(GL_ARRAY_BUFFER, mesh.instanceVBO);
-		glBufferData(GL_ARRAY_BUFFER,
-			instanceData.size() * sizeof(InstanceData),
-			instanceData.data(),
-			GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		const auto& firstEntity = batch.entities[0];
+		const auto& firstrenderComp = firstEntity.GetComponent<RenderComponent>();
 
-		// Set uniforms
-		shader->SetMatrix3("view", cameraManager.GetViewMatrix().ToGLM());
-		shader->SetMatrix3("projection", cameraManager.GetProjectionMatrix().ToGLM());
+		Shader* shader = AssetStore::GetShader(firstrenderComp.shaderName);
+		UseShader(shader);
+
+		const Mesh& mesh = AssetStore::GetMesh(batch.mesh);
 
 		if (!firstrenderComp.textureName.empty())
 		{
 			unsigned int textureID = AssetStore::GetTexture(firstrenderComp.textureName);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, textureID);
-			shader->setInt("ourTexture", 0);
-			shader->setBool("useTexture", true);
+			BindTexture(textureID);
+			shader->setInt(TEXTURE_UNIFORM, 0);
+			shader->setBool(USE_TEXTURE_UNIFORM, true);
 		}
 		else
 		{
-			shader->setBool("useTexture", false);
+			shader->setBool(USE_TEXTURE_UNIFORM, false);
 		}
 
 		// Bind the mesh's VAO before drawing
 		glBindVertexArray(mesh.VAO);
-		glDrawElementsInstanced(GL_TRIANGLES,
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES,
 			static_cast<GLsizei>(mesh.indices.size()),
 			GL_UNSIGNED_INT, 0,
-			static_cast<GLsizei>(instanceData.size()));
+			static_cast<GLsizei>(step.instanceCount),
+			baseInstance + step.firstInstance);
+		++renderStats.drawCalls;
 
 		/*GLenum error = glGetError();
 		if (error != GL_NO_ERROR)
@@ -409,8 +820,6 @@ namespace Popplio
 		}*/
 
 		glBindVertexArray(0);
-
-		shader->UnUse();
 	}
 
 	void RenderSystem::RenderDebugColliders()
@@ -430,35 +839,29 @@ namespace Popplio
 		const auto& meshData = AssetStore::GetMesh(mesh);
 		glBindVertexArray(meshData.VAO);
 		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(meshData.indices.size()), GL_UNSIGNED_INT, 0);
+		++renderStats.drawCalls;
 		glBindVertexArray(0);
 	}
 
 	void RenderSystem::DrawBoxCollider(const BoxColliderComponent& boxCollider)
 	{
 		Shader* debugShader = AssetStore::GetShader("debug_shader");
-		debugShader->Use();
+		UseShader(debugShader);
 
 		// Use the pre-calculated collider matrix
-		debugShader->SetMatrix3("model", boxCollider.colliderMatrix.ToGLM());
-		debugShader->SetMatrix3("view", cameraManager.GetViewMatrix().ToGLM());
-		debugShader->SetMatrix3("projection", cameraManager.GetProjectionMatrix().ToGLM());
+		debugShader->SetMatrix3(MODEL_UNIFORM, boxCollider.colliderMatrix.ToGLM());
 		debugShader->SetVector3f("color", glm::vec3(1.0f, 0.0f, 0.0f)); // Red color for colliders
 
 		// Draw the collider
 		const Mesh& quadMesh = AssetStore::GetMesh(MeshType::Quad);
 		glBindVertexArray(quadMesh.VAO);
 		glDrawElements(GL_LINE_LOOP, static_cast<GLsizei>(quadMesh.indices.size()), GL_UNSIGNED_INT, 0);
+		++renderStats.drawCalls;
 		glBindVertexArray(0);
-
-		debugShader->UnUse();
 	}
 
 	void RenderSystem::RenderText(const TextComponent& textComp, const TransformComponent& transform)
 	{
-		if (textComp.text.empty())
-			return;
-		// Fetch the latest text and update
-		std::string updatedText = textComp.text;
 		Font* font = AssetStore::GetFont(textComp.fontName);
 		if (!font)
 		{
@@ -466,11 +869,10 @@ namespace Popplio
 			return;
 		}
 
-		// Ensure font size is loaded
-		if (!font->IsSizeLoaded(textComp.fontSize))
-		{
-			font->LoadSize(textComp.fontSize);
-		}
+		// Also loads the font size if needed
+		const TextLayout& layout = textComp.GetLayout();
+		if (layout.GetQuads().empty())
+			return;
 
 		Shader* textShader = AssetStore::GetShader("font_shader");
 		if (!textShader)
@@ -479,105 +881,51 @@ namespace Popplio
 			return;
 		}
 
-		textShader->Use();
-
-		glActiveTexture(GL_TEXTURE0);
-
 		// Set up matrices
-		textShader->SetMatrix3("view", cameraManager.GetViewMatrix().ToGLM());
-		textShader->SetMatrix3("projection", cameraManager.GetProjectionMatrix().ToGLM());
-		textShader->SetVector3f("textColor", glm::vec3(textComp.color));
-		textShader->setFloat("uAlpha", textComp.alpha);
-
-		glBindVertexArray(font->GetVAO());
-
-		// Calculate text metrics for centering
-		float totalWidth = 0.0f;
-		float maxAscent = 0.0f;
-		float maxDescent = 0.0f;
+		UseShader(textShader);
+		textShader->SetVector3f(TEXT_COLOR_UNIFORM, glm::vec3(textComp.color));
+		textShader->setFloat(ALPHA_UNIFORM, textComp.alpha);
 
-		// First pass: calculate metrics
-		for (char c : textComp.text)
+		// Two triangles per glyph, position and atlas UVs
+		textVertices.clear();
+		for (const GlyphQuad& glyph : layout.GetQuads())
 		{
-			const Character& ch = font->GetCharacter(c, textComp.fontSize);
-			totalWidth += static_cast<float>(ch.Advance >> 6);
-
-			// Calculate maximum ascent (height above baseline)
-			maxAscent = std::max(maxAscent, static_cast<float>(ch.Bearing.y));
-
-			// Calculate maximum descent (height below baseline)
-			float descent = static_cast<float>(ch.Size.y) - static_cast<float>(ch.Bearing.y);
-			maxDescent = std::max(maxDescent, descent);
+			const float xpos = transform.position.x + glyph.rect.x;
+			const float ypos = transform.position.y + glyph.rect.y;
+			const float w = glyph.rect.z;
+			const float h = glyph.rect.w;
+			const glm::vec4& uv = glyph.uvRect; // bottom-left, top-right
+
+			textVertices.insert(textVertices.end(), {
+				xpos,     ypos,         uv.x, uv.y,     // bottom-left
+				xpos + w, ypos + h,     uv.z, uv.w,     // top-right
+				xpos,     ypos + h,     uv.x, uv.w,     // top-left
+
+				xpos,     ypos,         uv.x, uv.y,     // bottom-left
+				xpos + w, ypos,         uv.z, uv.y,     // bottom-right
+				xpos + w, ypos + h,     uv.z, uv.w      // top-right
+			});
 		}
 
-		//float totalHeight = maxAscent + maxDescent;
+		BindTexture(layout.GetTexture());
 
-		// Calculate starting positions
-		float x = transform.position.x - totalWidth / 2.0f;
-		
-		// For vertical positioning:
-		// Position is the center of the text
-		float y = transform.position.y;
-		
-		// Calculate vertical offset to center the text
-		// Make midpoint between the ascent and descent to be at y
-		float verticalOffset = (maxAscent - maxDescent) / 2.0f;
-		
-		// The baseline position is offset from the center
-		float baseline = y + verticalOffset;
-
-		// Render each character
-		for (char c : textComp.text)
-		{
-			const Character& ch = font->GetCharacter(c, textComp.fontSize);
-
-			// Position horizontally - add bearing X (horizontal offset)
-			float xpos = x + static_cast<float>(ch.Bearing.x);
-			
-			// Position vertically - FreeType expects:
-			// 1. Start at baseline
-			// 2. Subtract full glyph height
-			// 3. Add bearing Y (which is distance from baseline to top of glyph)
-			float ypos = baseline - static_cast<float>(ch.Size.y) + static_cast<float>(ch.Bearing.y);
-
-			float w = static_cast<float>(ch.Size.x);
-			float h = static_cast<float>(ch.Size.y);
-
-			// Update VBO
-			float vertices[6][4] = {
-				{ xpos,     ypos,           0.0f, 1.0f },     // bottom-left
-				{ xpos + w, ypos + h,       1.0f, 0.0f },     // top-right
-				{ xpos,     ypos + h,       0.0f, 0.0f },     // top-left
-				
-				{ xpos,     ypos,           0.0f, 1.0f },     // bottom-left
-				{ xpos + w, ypos,           1.0f, 1.0f },     // bottom-right
-				{ xpos + w, ypos + h,       1.0f, 0.0f }      // top-right
-			};
-
-			glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-			// Update content of VBO memory
-			glBindBuffer(GL_ARRAY_BUFFER, font->GetVBO());
-			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-			// Render quad
-			glDrawArrays(GL_TRIANGLES, 0, 6);
+		// Every glyph shares the atlas, so the whole text is one draw
+		glBindVertexArray(font->GetVAO());
+		glBindBuffer(GL_ARRAY_BUFFER, font->GetVBO());
+		glBufferData(GL_ARRAY_BUFFER, textVertices.size() * sizeof(float), textVertices.data(), GL_DYNAMIC_DRAW);
+		GLCallCounter::Add(GLCallCounter::BUFFER);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-			// Advance cursor for next glyph
-			x += (ch.Advance >> 6); // Advance is in 1/64th pixels
-		}
+		glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(textVertices.size() / 4));
+		++renderStats.drawCalls;
 
 		glBindVertexArray(0);
-		glBindTexture(GL_TEXTURE_2D, 0);
-		textShader->UnUse();
 	}
 
 	void RenderSystem::HandleTexture(const RenderComponent& renderComp, Shader* shader)
 	{
 		unsigned int textureID = AssetStore::GetTexture(renderComp.textureName);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, textureID);
+		BindTexture(textureID);
 		shader->setInt(renderComp.meshType == MeshType::FullscreenQuad ?
 			"backgroundTexture" : "ourTexture", 0);
 
@@ -601,11 +949,10 @@ namespace Popplio
 	{
 		//auto& animComp = entity.GetComponent<AnimationComponent>();
 		unsigned int textureID = AssetStore::GetTexture(renderComp.textureName);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		shader->setInt("ourTexture", 0);
+		BindTexture(textureID);
+		shader->setInt(TEXTURE_UNIFORM, 0);
 		glm::vec4 uvCoords = animComp.GetUVCoords();
-		shader->SetUniform("u_TextureCoords", uvCoords);
+		shader->SetUniform(UV_COORDS_UNIFORM, uvCoords);
 	}
 
 	void RenderSystem::HandleParticles(const ParticleComponent& particles, const std::optional<RenderComponent>& renderComp,
@@ -640,10 +987,10 @@ namespace Popplio
 			// Compute final transformation matrix
 			transform = translateMat * rotateMat * scaleMat;
 
-			shader->SetMatrix3("model", transform.ToGLM());
+			shader->SetMatrix3(MODEL_UNIFORM, transform.ToGLM());
 
-			shader->SetVector3f("uColor", glm::vec3(particle.col.r, particle.col.g, particle.col.b));
-			shader->setFloat("uAlpha", particle.col.a);
+			shader->SetVector3f(COLOR_UNIFORM, glm::vec3(particle.col.r, particle.col.g, particle.col.b));
+			shader->setFloat(ALPHA_UNIFORM, particle.col.a);
 
 			// For animated particles, compute unique UV coordinates per particle
 			if (particles.renderOption == 1 && animComp.has_value())
@@ -655,7 +1002,7 @@ namespace Popplio
 				float u2 = ((particle.frameX + 1) * currentAnim.frameWidth) / animComp->sheetWidth;
 				float v2 = ((particle.frameY + 1) * currentAnim.frameHeight) / animComp->sheetHeight;
 				glm::vec4 uvCoords(u1, v1, u2, v2);
-				shader->SetUniform("u_TextureCoords", uvCoords);
+				shader->SetUniform(UV_COORDS_UNIFORM, uvCoords);
 			}
 			RenderMesh(renderComp->meshType);
 		}
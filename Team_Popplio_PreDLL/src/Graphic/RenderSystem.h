@@ -48,20 +48,17 @@ Technology is prohibited.
 #include "../Camera/CameraManager.h"
 #include "../Layering/LayerManager.h"
 #include "../Editor/EntitySelectionEvents.h"
+#include "RenderQueue.h"
+#include "SpriteBatcher.h"
+#include "InstanceRingBuffer.h"
+#include "CullingGrid.h"
+#include "../Transformation/TransformationSystem.h"
 
 #include <vector>
 #include <unordered_map>
 
 namespace Popplio
 {
-	struct InstanceData
-	{
-		glm::mat3 modelMatrix;
-		glm::vec3 color;
-		float alpha;       
-		glm::vec4 uvRect;
-	};
-
 	/*!*****************************************************************************
     \brief
     Class representing the graphics system. It is responsible for initializing
@@ -78,11 +75,14 @@ namespace Popplio
 		\brief
 		Constructor for the GraphicSystem class.
 
+		\param[in] reg
+		[Registry&] The registry, to find the entities the transformation system moved.
+
 		\param[in] window
 		[GLFWwindow*] Pointer to the GLFW window.
 
 		*******************************************************************************/
-		RenderSystem(GLFWwindow* window, LayerManager& layerMgr, CameraManager& cameraMgr);
+		RenderSystem(Registry& reg, GLFWwindow* window, LayerManager& layerMgr, CameraManager& cameraMgr);
 
 		
 
@@ -112,42 +112,236 @@ namespace Popplio
 		*******************************************************************************/
 		void ToggleDebugDrawing();
 
+		/*!*****************************************************************************
+		\brief
+			Gets the draw calls, shader switches and texture binds of the last Update.
+
+		*******************************************************************************/
+		const RenderStats& GetRenderStats() const;
+
+		/*!*****************************************************************************
+		\brief
+			Adds an entity to the system, it is sorted for culling on the next
+			Update.
+
+		*******************************************************************************/
+		void AddEntityToSystem(Entity entity) override;
+
+		/*!*****************************************************************************
+		\brief
+			Removes an entity from the system and from the culling grid.
+
+		*******************************************************************************/
+		void RemoveEntityFromSystem(Entity entity) override;
+
+		/*!*****************************************************************************
+		\brief
+			Sorts the entity for culling again on the next Update, after a render,
+			text, particle or UI component was added or removed.
+
+		*******************************************************************************/
+		void OnWatchedComponentChanged(Entity entity) override;
+
+		/*!*****************************************************************************
+		\brief
+			Sorts the entity for culling again on the next Update, after its mesh
+			type or UI type changed.
+
+		*******************************************************************************/
+		void ReclassifyForCulling(const Entity& entity);
+
 	private:
+		Registry& reg;
 		GLFWwindow* window;
 		LayerManager& layerManager;
 		CameraManager& cameraManager;
 		bool debugDrawing = false;
 
+		// Entities of one layer drawn with one instanced draw call
+		struct InstancedBatch
+		{
+			MeshType mesh;
+			std::vector<Entity> entities;
+		};
+
+		RenderQueue renderQueue{};
+		std::vector<Entity> queuedEntities{}; // payload of sprite and text commands
+		std::vector<SpriteShader> queuedSpriteShaders{}; // per queued entity, NONE if not batched
+		std::vector<InstancedBatch> instancedBatches{}; // payload of instanced commands, reused between frames
+		size_t instancedBatchCount = 0;
+		RenderStats renderStats{};
+
+		// Instances of the frame, built on the CPU then uploaded once
+		SpriteBatcher spriteBatcher{};
+		InstanceRingBuffer instanceRing{};
+		GLuint baseInstance = 0; // first instance of the current ring region
+		std::vector<float> textVertices{}; // glyph quads of the text drawn without the batch shader
+		CullingGrid cullingGrid{}; // world bounds of the entities that can be culled
+
+		// Where an entity is kept for culling
+		enum class CullClass : std::uint8_t
+		{
+			NONE, // nothing to draw
+			SPRITE, // in the grid, bounds follow the model matrix
+			TEXT, // in the grid, bounds follow the layout
+			UNCULLABLE // drawn away from its transform, never culled
+		};
+		std::vector<CullClass> cullClasses{}; // by entity id
+		std::vector<std::uint32_t> textLayoutVersions{}; // by entity id, layout version of the text bounds in the grid
+		std::vector<Entity> cullingChanges{}; // entities to sort again on the next Update
+		std::vector<int> movedEntities{}; // taken from the transformation system every frame
+		std::vector<Entity> textEntities{}; // text bounds follow their layout, updated when it is rebuilt
+		std::vector<Entity> uncullableEntities{}; // full screen quads, particle emitters and slider handles
+
+		// An entity to queue, in view or never culled
+		struct DrawCandidate
+		{
+			std::uint32_t layer; // index in the sorted layers
+			Entity entity;
+		};
+		std::vector<DrawCandidate> drawCandidates{}; // sorted by layer then entity, like the layer entity sets
+		Shader* spriteBatchShader = nullptr; // nullptr if the batch shader is not loaded
+
+		// GL state of the current Update, to skip redundant changes
+		Shader* boundShader = nullptr;
+		unsigned int boundTexture = 0;
+		GLuint cameraBuffer = 0; // camera uniform block, at CAMERA_UNIFORM_BINDING
+
 		/*!*****************************************************************************
 		\brief
-			Renders non-instanced entities using their mesh and transform components.
+			Sorts the changed entities into the grid or the entities that are never
+			culled (full screen quads, particle emitters and slider handles), updates
+			the bounds of the entities the transformation system moved and of the
+			text whose layout was rebuilt, then finds the ones inside the camera view.
 
-		\param[in] entities
-			A list of entities to be rendered using standard non-instanced rendering.
+		*******************************************************************************/
+		void UpdateCulling();
+
+		/*!*****************************************************************************
+		\brief
+			Gets where an entity is kept for culling from its components.
 
 		*******************************************************************************/
-		void RenderNonInstancedEntities(const std::vector<Entity>& entities);
+		CullClass GetCullClass(const Entity& entity) const;
 
 		/*!*****************************************************************************
 		\brief
-		Renders instanced triangles using the specified shader and projection matrix.
+			Moves an entity to the grid or the entities never culled, removing it
+			from where it was.
 
-		This function binds the vertex array object (VAO) of the mesh and renders multiple
-		instances of the mesh using instanced rendering. It sets the projection matrix uniform
-		in the shader and draws the instances.
+		*******************************************************************************/
+		void SetCullClass(const Entity& entity, CullClass cullClass);
+
+		/*!*****************************************************************************
+		\brief
+			Sets the bounds of a sprite or text entity in the culling grid.
+
+		*******************************************************************************/
+		void UpdateCullBounds(const Entity& entity);
+
+		/*!*****************************************************************************
+		\brief
+			Gathers the entities of the active layers that are in view or never
+			culled into drawCandidates.
 
 		*******************************************************************************/
-		void RenderInstanced(MeshType mesh, const std::vector<Entity>& entities);
+		void GatherDrawCandidates(const std::vector<Layer>& sortedLayers);
 
 		/*!*****************************************************************************
 		\brief
-			Renders all entities that have text components.
+			Queues the draw commands of every active entity in the active layers
+			that is not culled.
 
-		\param[in] entities
-			A list of entities containing text components to be rendered on screen.
+		*******************************************************************************/
+		void QueueEntities();
+
+		/*!*****************************************************************************
+		\brief
+			Draws the sorted commands of the render queue: builds the draw steps
+			and instances of the frame, uploads the instances to the ring buffer,
+			then draws the steps.
+
+		*******************************************************************************/
+		void SubmitRenderQueue();
+
+		/*!*****************************************************************************
+		\brief
+			Adds the sorted commands to the sprite batcher, merging consecutive
+			batchable sprites with the same texture.
+
+		*******************************************************************************/
+		void BuildDrawSteps();
+
+		/*!*****************************************************************************
+		\brief
+			Gets the transform of the track a slider handle is linked to.
+
+		\return
+			nullptr if the entity is not a linked slider handle.
+
+		*******************************************************************************/
+		const TransformComponent* GetSliderTrack(const Entity& entity) const;
+
+		/*!*****************************************************************************
+		\brief
+			Draws a batch of sprites with one instanced draw call.
+
+		*******************************************************************************/
+		void RenderSpriteBatch(const SpriteDrawStep& step);
+
+		/*!*****************************************************************************
+		\brief
+			Makes the shader current if it is not.
+
+		\param[in] shader
+			The shader to use.
+
+		*******************************************************************************/
+		void UseShader(Shader* shader);
+
+		/*!*****************************************************************************
+		\brief
+			Uploads the view and projection of the current camera to the camera
+			uniform buffer, and binds it for every shader.
+
+		*******************************************************************************/
+		void UploadCamera();
+
+		/*!*****************************************************************************
+		\brief
+			Binds a texture to texture unit 0 if it is not bound already.
+
+		*******************************************************************************/
+		void BindTexture(unsigned int textureID);
+
+		/*!*****************************************************************************
+		\brief
+			Renders a non-instanced entity using its mesh and transform components.
+
+		\param[in] entity
+			The entity to be rendered using standard non-instanced rendering.
+
+		*******************************************************************************/
+		void RenderSprite(const Entity& entity);
+
+		/*!*****************************************************************************
+		\brief
+		Adds the instance data of a batch of instanced entities (and of their
+		particles) to the sprite batcher.
+
+		*******************************************************************************/
+		void BuildInstances(const std::vector<Entity>& entities);
+
+		/*!*****************************************************************************
+		\brief
+		Renders instanced triangles using the specified shader and projection matrix.
+
+		This function binds the vertex array object (VAO) of the mesh and renders multiple
+		instances of the mesh using instanced rendering. It sets the projection matrix uniform
+		in the shader and draws the instances uploaded for the step.
 
 		*******************************************************************************/
-		void RenderTextEntities(const std::vector<Entity>& entities);
+		void RenderInstanced(const InstancedBatch& batch, const SpriteDrawStep& step);
 
 		/*!*****************************************************************************
 		\brief
@@ -181,7 +375,9 @@ namespace Popplio
 
 		/*!*****************************************************************************
 		\brief
-			Renders a text string using the provided TextComponent and its world transform.
+			Renders a text string using the provided TextComponent and its world transform,
+			all its glyphs in one draw. Used when the text cannot be batched with the
+			sprite batch shader.
 
 		\param[in] textComp
 			The text component containing the string and styling information.
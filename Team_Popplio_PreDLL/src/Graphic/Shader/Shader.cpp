@@ -20,6 +20,7 @@ Technology is prohibited.
 #include <pch.h>
 #include "Shader.h"
 
+#include <cassert>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -100,6 +101,7 @@ namespace Popplio
         glAttachShader(ID, fragment);
         glLinkProgram(ID);
         checkCompileErrors(ID, "PROGRAM");
+        ReflectUniforms();
         // delete the shaders as they're linked into our program now and no longer necessary
         glDeleteShader(vertex);
         glDeleteShader(fragment);
@@ -113,6 +115,7 @@ namespace Popplio
     void Shader::Use() const
     {
         glUseProgram(ID);
+        GLCallCounter::Add(GLCallCounter::PROGRAM);
     }
 
     /*!*****************************************************************************
@@ -123,6 +126,86 @@ namespace Popplio
     void Shader::UnUse()
     {
         glUseProgram(0);
+        GLCallCounter::Add(GLCallCounter::PROGRAM);
+    }
+
+    /*!*****************************************************************************
+    \brief
+    Gets the location of an active uniform from the reflected table.
+
+    \param[in] name
+    [UniformHandle] Name of the uniform.
+
+    \return
+    [GLint] Location of the uniform, -1 if the shader has no such active uniform.
+
+    *******************************************************************************/
+    GLint Shader::GetUniformLocation(UniformHandle name) const
+    {
+        auto it = std::lower_bound(uniformLocations.begin(), uniformLocations.end(), name.hash,
+            [](const UniformEntry& uniform, std::uint32_t hash) { return uniform.hash < hash; });
+        if (it == uniformLocations.end() || it->hash != name.hash) return -1;
+
+        // Another name with the same hash would silently set this uniform
+        assert(it->name == name.name && "Uniform name hash collision");
+        return it->location;
+    }
+
+    /*!*****************************************************************************
+    \brief
+    Fills the uniform table with the active uniforms of the linked program,
+    and binds its camera uniform block to CAMERA_UNIFORM_BINDING.
+
+    *******************************************************************************/
+    void Shader::ReflectUniforms()
+    {
+        uniformLocations.clear();
+
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        GLCallCounter::Add(GLCallCounter::UNIFORM_QUERY, 2);
+
+        std::vector<GLchar> nameBuffer(static_cast<size_t>(std::max(maxLength, 1)));
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &size, &type, nameBuffer.data());
+            GLint location = glGetUniformLocation(ID, nameBuffer.data());
+            GLCallCounter::Add(GLCallCounter::UNIFORM_QUERY, 2);
+
+            // Members of uniform blocks have no location
+            if (location < 0) continue;
+
+            // Arrays are reported as "name[0]", and set by their name
+            std::string_view uniformName(nameBuffer.data(), static_cast<size_t>(length));
+            if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]")
+            {
+                uniformName.remove_suffix(3);
+            }
+            uniformLocations.push_back({ HashUniformName(uniformName), location, std::string(uniformName) });
+        }
+
+        std::sort(uniformLocations.begin(), uniformLocations.end(),
+            [](const UniformEntry& a, const UniformEntry& b) { return a.hash < b.hash; });
+        for (size_t i = 1; i < uniformLocations.size(); ++i)
+        {
+            if (uniformLocations[i].hash == uniformLocations[i - 1].hash)
+            {
+                Logger::Error("Shader " + std::to_string(ID) + " uniforms " + uniformLocations[i - 1].name + " and " +
+                    uniformLocations[i].name + " have the same name hash, rename one of them");
+            }
+        }
+
+        // Every shader reads the camera from the same buffer
+        GLuint cameraBlock = glGetUniformBlockIndex(ID, "Camera");
+        if (cameraBlock != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(ID, cameraBlock, CAMERA_UNIFORM_BINDING);
+        }
     }
 
     /*!*****************************************************************************
@@ -130,15 +213,20 @@ namespace Popplio
     Sets a boolean uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [bool] Value to set.
 
     *******************************************************************************/
-    void Shader::setBool(const std::string& name, bool value) const
+    void Shader::setBool(UniformHandle name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform1i(loc, (int)value);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
     
     /*!*****************************************************************************
@@ -146,15 +234,20 @@ namespace Popplio
     Sets an integer uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [int] Value to set.
 
     *******************************************************************************/
-    void Shader::setInt(const std::string& name, int value) const
+    void Shader::setInt(UniformHandle name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform1i(loc, value);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
     
     /*!*****************************************************************************
@@ -162,15 +255,20 @@ namespace Popplio
     Sets a float uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [float] Value to set.
 
     *******************************************************************************/
-    void Shader::setFloat(const std::string& name, float value) const
+    void Shader::setFloat(UniformHandle name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform1f(loc, value);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
 
     /*!*****************************************************************************
@@ -178,21 +276,22 @@ namespace Popplio
     Sets a mat3 uniform in the shader for model transformation.
 
     \param[in] name
-    [const char*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [glm::mat3 const&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(const char* name, glm::mat3 const& val) const
+    void Shader::SetUniform(UniformHandle name, glm::mat3 const& val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0) {
             glUniformMatrix3fv(loc, 1, GL_FALSE, &val[0][0]);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
@@ -202,21 +301,22 @@ namespace Popplio
     Sets an integer uniform in the shader for texture.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [GLint] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(GLchar const* name, GLint val) const
+    void Shader::SetUniform(UniformHandle name, GLint val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0) {
             glUniform1i(loc, val);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
@@ -226,22 +326,22 @@ namespace Popplio
     Sets a mat4 uniform in the shader for TRS.
 
     \param[in] name
-    [const char*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [glm::mat4 const&] Value to set.
 
     *******************************************************************************/
-    //void Shader::SetUniform(GLchar const* name, glm::mat4 const& val)
+    //void Shader::SetUniform(UniformHandle name, glm::mat4 const& val)
     //{
-    //    GLint loc = glGetUniformLocation(ID, name);
+    //    GLint loc = GetUniformLocation(name);
     //    if (loc >= 0) {
     //        glUniformMatrix4fv(loc, 1, GL_FALSE, &val[0][0]);
     //    }
     //    else 
     //    {
     //        std::ostringstream error;
-    //        error << "Uniform variable " << name << " doesn't exist" << std::endl;
+    //        error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
     //        Logger::Error(error.str());
     //    }
     //}
@@ -251,15 +351,20 @@ namespace Popplio
     Sets a boolean uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [bool] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(const std::string& name, bool value) const
+    void Shader::SetUniform(UniformHandle name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform1i(loc, (int)value);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
 
     /*!*****************************************************************************
@@ -267,15 +372,20 @@ namespace Popplio
     Sets a float uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [float] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(const std::string& name, float value) const
+    void Shader::SetUniform(UniformHandle name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform1f(loc, value);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
 
     /*!*****************************************************************************
@@ -283,24 +393,25 @@ namespace Popplio
     Sets a vec2 uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [const glm::vec2&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(GLchar const* name, const glm::vec2& value) const
+    void Shader::SetUniform(UniformHandle name, const glm::vec2& value) const
     {
         // Get the uniform location
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniform2f(loc, value.x, value.y);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
@@ -310,15 +421,20 @@ namespace Popplio
     Sets a vec3 uniform in the shader.
 
     \param[in] name
-    [const std::string&] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [const glm::vec3&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetUniform(const std::string& name, const glm::vec3& value) const
+    void Shader::SetUniform(UniformHandle name, const glm::vec3& value) const
     {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        GLint loc = GetUniformLocation(name);
+        if (loc >= 0)
+        {
+            glUniform3fv(loc, 1, &value[0]);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
+        }
     }
 
     /*!*****************************************************************************
@@ -326,24 +442,25 @@ namespace Popplio
    Sets a vec4 uniform in the shader.
 
    \param[in] name
-   [const std::string&] Name of the uniform.
+   [UniformHandle] Name of the uniform.
 
    \param[in] value
    [const glm::vec3&] Value to set.
 
    *******************************************************************************/
-    void Shader::SetUniform(GLchar const* name, const glm::vec4& value) const
+    void Shader::SetUniform(UniformHandle name, const glm::vec4& value) const
     {
         // Get the uniform location
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniform4f(loc, value.x, value.g, value.b, value.a);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
 
@@ -354,23 +471,24 @@ namespace Popplio
     Sets an integer uniform in the shader.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] value
     [GLint] Value to set.
 
     *******************************************************************************/
-    void Shader::SetInteger(GLchar const* name, GLint val) const
+    void Shader::SetInteger(UniformHandle name, GLint val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniform1i(loc, val);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
 
@@ -381,7 +499,7 @@ namespace Popplio
     Sets a vec3 uniform in the shader.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] x
     [GLfloat] X value to set.
@@ -393,18 +511,19 @@ namespace Popplio
     [GLfloat] Z value to set.
 
     *******************************************************************************/
-    void Shader::SetVector3f(GLchar const* name, GLfloat x, GLfloat y, GLfloat z)  const
+    void Shader::SetVector3f(UniformHandle name, GLfloat x, GLfloat y, GLfloat z)  const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
 
         if (loc >= 0)
         {
             glUniform3f(loc, x, y, z);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
 
@@ -415,23 +534,24 @@ namespace Popplio
     Sets a vec3 uniform in the shader.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [glm::vec3 const&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetVector3f(GLchar const* name, glm::vec3 const& val) const
+    void Shader::SetVector3f(UniformHandle name, glm::vec3 const& val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniform3f(loc, val.x, val.y, val.z);
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
@@ -441,24 +561,25 @@ namespace Popplio
     Sets a mat3 uniform in the shader.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [glm::mat3 const&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetMatrix3(GLchar const* name, glm::mat3 const& val) const
+    void Shader::SetMatrix3(UniformHandle name, glm::mat3 const& val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniformMatrix3fv(loc, 1, false, glm::value_ptr(val));
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
 
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
@@ -468,24 +589,25 @@ namespace Popplio
     Sets a mat4 uniform in the shader.
 
     \param[in] name
-    [GLchar const*] Name of the uniform.
+    [UniformHandle] Name of the uniform.
 
     \param[in] val
     [glm::mat4 const&] Value to set.
 
     *******************************************************************************/
-    void Shader::SetMatrix4(GLchar const* name, glm::mat4 const& val) const
+    void Shader::SetMatrix4(UniformHandle name, glm::mat4 const& val) const
     {
-        GLint loc = glGetUniformLocation(ID, name);
+        GLint loc = GetUniformLocation(name);
         if (loc >= 0)
         {
             glUniformMatrix4fv(loc, 1, false, glm::value_ptr(val));
+            GLCallCounter::Add(GLCallCounter::UNIFORM);
 
         }
         else
         {
             std::ostringstream error;
-            error << "Uniform variable " << name << " doesn't exist" << std::endl;
+            error << "Uniform variable " << name.c_str() << " doesn't exist" << std::endl;
             Logger::Error(error.str());
         }
     }
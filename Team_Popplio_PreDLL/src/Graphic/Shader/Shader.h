@@ -11,6 +11,9 @@
         shader programs in OpenGL. It includes functions for creating, using,
         and setting uniforms for shaders.
 
+        The active uniforms are reflected once after linking into a table
+        sorted by name hash, so setting a uniform does not query OpenGL.
+
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
 without the prior written consent of DigiPen Institute of
@@ -20,8 +23,57 @@ Technology is prohibited.
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../GLCallCounter.h"
+
 namespace Popplio
 {
+    /*!*****************************************************************************
+    \brief
+    Binding point of the camera uniform block (view and projection), shared by
+    every shader and filled once per render pass by the render system.
+
+    *******************************************************************************/
+    static constexpr unsigned int CAMERA_UNIFORM_BINDING = 0;
+
+    /*!*****************************************************************************
+    \brief
+    FNV-1a hash of a uniform name.
+
+    *******************************************************************************/
+    constexpr std::uint32_t HashUniformName(std::string_view name)
+    {
+        std::uint32_t hash = 2166136261u;
+        for (char c : name)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /*!*****************************************************************************
+    \brief
+    Name of a uniform with its hash. Made from a string literal it can be
+    constexpr, so the hash is computed at compile time.
+
+    *******************************************************************************/
+    struct UniformHandle
+    {
+        std::uint32_t hash;
+        const char* name;
+
+        constexpr UniformHandle(const char* uniformName) : hash(HashUniformName(uniformName)), name(uniformName) {}
+        UniformHandle(const std::string& uniformName) : hash(HashUniformName(uniformName)), name(uniformName.c_str()) {}
+
+        const char* c_str() const { return name; }
+    };
+
     /*!*****************************************************************************
     \brief
     Class representing a shader program in OpenGL. It includes functions for
@@ -67,163 +119,163 @@ namespace Popplio
         Sets a boolean uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [bool] Value to set.
 
         *******************************************************************************/
-        void setBool(const std::string& name, bool value) const;
+        void setBool(UniformHandle name, bool value) const;
 
         /*!*****************************************************************************
         \brief
         Sets an integer uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [int] Value to set.
 
         *******************************************************************************/
-        void setInt(const std::string& name, int value) const;
+        void setInt(UniformHandle name, int value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a float uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [float] Value to set.
 
         *******************************************************************************/
-        void setFloat(const std::string& name, float value) const;
+        void setFloat(UniformHandle name, float value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a mat3 uniform in the shader for model transformation.
 
         \param[in] name
-        [const char*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [glm::mat3 const&] Value to set.
 
         *******************************************************************************/
-        void SetUniform(const char* name, glm::mat3 const& val) const;
+        void SetUniform(UniformHandle name, glm::mat3 const& val) const;
 
         /*!*****************************************************************************
         \brief
         Sets an integer uniform in the shader for texture.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [GLint] Value to set.
 
         *******************************************************************************/
-        void SetUniform(GLchar const* name, GLint val) const;
+        void SetUniform(UniformHandle name, GLint val) const;
 
         /*!*****************************************************************************
         \brief
         Sets a mat4 uniform in the shader for TRS.
 
         \param[in] name
-        [const char*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [glm::mat4 const&] Value to set.
 
         *******************************************************************************/
-        //void SetUniform(const char* name, glm::mat4 const& val);
+        //void SetUniform(UniformHandle name, glm::mat4 const& val);
 
         /*!*****************************************************************************
         \brief
         Sets a boolean uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [bool] Value to set.
 
         *******************************************************************************/
-        void SetUniform(const std::string& name, bool value) const;
+        void SetUniform(UniformHandle name, bool value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a float uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [float] Value to set.
 
         *******************************************************************************/
-        void SetUniform(const std::string& name, float value) const;
+        void SetUniform(UniformHandle name, float value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a vec2 uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [const glm::vec2&] Value to set.
 
         *******************************************************************************/
-        void SetUniform(GLchar const* name, const glm::vec2& value) const;
+        void SetUniform(UniformHandle name, const glm::vec2& value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a vec3 uniform in the shader.
 
         \param[in] name
-        [const std::string&] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [const glm::vec3&] Value to set.
 
         *******************************************************************************/
-        void SetUniform(const std::string& name, const glm::vec3& value) const;
+        void SetUniform(UniformHandle name, const glm::vec3& value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a vec4 uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [const glm::vec4] Value to set.
 
         *******************************************************************************/
-        void SetUniform(GLchar const* name, const glm::vec4& value) const;
+        void SetUniform(UniformHandle name, const glm::vec4& value) const;
 
         /*!*****************************************************************************
         \brief
         Sets an integer uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] value
         [GLint] Value to set.
 
         *******************************************************************************/
-        void SetInteger(GLchar const* name, GLint value) const;
+        void SetInteger(UniformHandle name, GLint value) const;
 
         /*!*****************************************************************************
         \brief
         Sets a vec3 uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] x
         [GLfloat] X value to set.
@@ -235,51 +287,77 @@ namespace Popplio
         [GLfloat] Z value to set.
 
         *******************************************************************************/
-        void SetVector3f(GLchar const* name, GLfloat x, GLfloat y, GLfloat z) const;
+        void SetVector3f(UniformHandle name, GLfloat x, GLfloat y, GLfloat z) const;
 
         /*!*****************************************************************************
         \brief
         Sets a vec3 uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [glm::vec3 const&] Value to set.
 
         *******************************************************************************/
-        void SetVector3f(GLchar const* name, glm::vec3 const& val) const;
+        void SetVector3f(UniformHandle name, glm::vec3 const& val) const;
 
         /*!*****************************************************************************
         \brief
         Sets a mat3 uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [glm::mat3 const&] Value to set.
 
         *******************************************************************************/
-        void SetMatrix3(GLchar const* name, glm::mat3 const& val) const;
+        void SetMatrix3(UniformHandle name, glm::mat3 const& val) const;
 
         /*!*****************************************************************************
         \brief
         Sets a mat4 uniform in the shader.
 
         \param[in] name
-        [GLchar const*] Name of the uniform.
+        [UniformHandle] Name of the uniform.
 
         \param[in] val
         [glm::mat4 const&] Value to set.
 
         *******************************************************************************/
-        void SetMatrix4(GLchar const* name, glm::mat4 const& val) const;
+        void SetMatrix4(UniformHandle name, glm::mat4 const& val) const;
 
         unsigned int GetID() const { return ID; };
 
+        /*!*****************************************************************************
+        \brief
+        Gets the location of an active uniform from the reflected table.
+
+        \return
+        -1 if the shader has no such active uniform. Asserts in debug builds
+        if the uniform with the same hash has a different name.
+
+        *******************************************************************************/
+        GLint GetUniformLocation(UniformHandle name) const;
+
     private:
         unsigned int ID;
+        struct UniformEntry
+        {
+            std::uint32_t hash;
+            GLint location;
+            std::string name; // checked against the looked up name in debug builds
+        };
+        std::vector<UniformEntry> uniformLocations{}; // sorted by hash
+
+        /*!*****************************************************************************
+        \brief
+        Fills the uniform table with the active uniforms of the linked program,
+        and binds its camera uniform block to CAMERA_UNIFORM_BINDING.
+
+        *******************************************************************************/
+        void ReflectUniforms();
 
         /*!*****************************************************************************
         \brief
@@ -0,0 +1,150 @@
+/******************************************************************************/
+/*!
+\file   SpriteBatcher.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the SpriteBatcher class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "SpriteBatcher.h"
+
+namespace Popplio
+{
+	SpriteShader SpriteBatcher::GetSpriteShader(const RenderComponent& render)
+	{
+		if (render.meshType != MeshType::Quad) return SpriteShader::NONE;
+
+		if (render.useInstancing) return render.shaderName == "instanced_shader" ? SpriteShader::INSTANCED : SpriteShader::NONE;
+		if (render.shaderName == "default_shader") return SpriteShader::DEFAULT;
+		if (render.shaderName == "animation_shader") return SpriteShader::ANIMATION;
+		return SpriteShader::NONE;
+	}
+
+	InstanceData SpriteBatcher::MakeSpriteInstance(SpriteShader shader, const TransformComponent& transform,
+		const RenderComponent& render, const AnimationComponent* animation, const UIComponent* ui,
+		const TransformComponent* sliderTrack, const TextureRegion& region)
+	{
+		InstanceData instance{};
+		instance.modelMatrix = transform.modelMatrix.ToGLM();
+		instance.color = render.color;
+		instance.alpha = render.alpha;
+		instance.uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		instance.flags = glm::vec2(1.0f, 0.0f);
+
+		if (shader == SpriteShader::INSTANCED)
+		{
+			// Same as the instanced path: animation UVs, untextured sprites use the color only
+			if (animation) instance.uvRect = animation->GetUVCoords();
+			instance.flags.x = render.textureName.empty() ? 0.0f : 1.0f;
+			instance.uvRect = region.Remap(instance.uvRect);
+			return instance;
+		}
+
+		// The default shader multiplies uAlpha into the color and the vertex color
+		if (shader == SpriteShader::DEFAULT) instance.alpha = render.alpha * render.alpha;
+
+		if (shader == SpriteShader::ANIMATION && animation && animation->isActive)
+		{
+			instance.uvRect = animation->GetUVCoords();
+		}
+
+		// Apply 9-Slice Scaling (only default shader supports this)
+		if (shader == SpriteShader::DEFAULT && !render.textureName.empty() && render.enableNineSlice)
+		{
+			instance.flags.y = 1.0f;
+			instance.spriteSize = glm::vec2(transform.scale.x, transform.scale.y);
+			instance.textureSize = glm::vec2(render.textureWidth, render.textureHeight);
+			instance.borderSize = glm::vec4(render.borderLeft, render.borderRight, render.borderBottom, render.borderTop);
+		}
+
+		if (ui && ui->isActive)
+		{
+			if (ui->type == UIType::SLIDER_HANDLE && sliderTrack)
+			{
+				// Ensure the handle renders in the correct position
+				float trackLeft = sliderTrack->position.x - (sliderTrack->scale.x * 0.5f);
+				instance.modelMatrix[2][0] = trackLeft + ui->sliderValue * sliderTrack->scale.x;
+			}
+			else if (ui->type == UIType::CHECKBOX)
+			{
+				instance.color = ui->checked ? glm::vec3(0.0f, 0.7f, 0.0f) : render.color;
+			}
+			else if (ui->type == UIType::BUTTON && ui->hasHoverEffect && shader == SpriteShader::ANIMATION)
+			{
+				// Only the animation shader reads the texture coordinates
+				instance.uvRect = ui->GetCurrentUV();
+			}
+		}
+
+		// Into atlas space, nine-slicing happens before in the batch shader
+		instance.uvRect = region.Remap(instance.uvRect);
+		return instance;
+	}
+
+	InstanceData SpriteBatcher::MakeGlyphInstance(const GlyphQuad& glyph, const TransformComponent& transform,
+		const TextComponent& text)
+	{
+		// The quad mesh spans -0.5 to 0.5, scaled to the glyph and moved to its center
+		InstanceData instance{};
+		instance.modelMatrix = glm::mat3(1.0f);
+		instance.modelMatrix[0][0] = glyph.rect.z;
+		instance.modelMatrix[1][1] = glyph.rect.w;
+		instance.modelMatrix[2][0] = transform.position.x + glyph.rect.x + glyph.rect.z * 0.5f;
+		instance.modelMatrix[2][1] = transform.position.y + glyph.rect.y + glyph.rect.w * 0.5f;
+		instance.color = text.color;
+		instance.alpha = text.alpha;
+		instance.uvRect = glyph.uvRect;
+		instance.flags = glm::vec2(1.0f, 0.0f);
+		return instance;
+	}
+
+	void SpriteBatcher::Begin()
+	{
+		instances.clear();
+		steps.clear();
+	}
+
+	void SpriteBatcher::AddSprite(std::uint32_t command, std::uint32_t texture, const InstanceData& instance)
+	{
+		if (steps.empty() || !steps.back().spriteBatch || steps.back().texture != texture)
+		{
+			steps.push_back({ command, texture, static_cast<std::uint32_t>(instances.size()), 0, true });
+		}
+
+		instances.push_back(instance);
+		++steps.back().instanceCount;
+	}
+
+	void SpriteBatcher::AddCommand(std::uint32_t command)
+	{
+		steps.push_back({ command, 0, static_cast<std::uint32_t>(instances.size()), 0, false });
+	}
+
+	void SpriteBatcher::AddInstance(const InstanceData& instance)
+	{
+		instances.push_back(instance);
+		++steps.back().instanceCount;
+	}
+
+	const std::vector<InstanceData>& SpriteBatcher::GetInstances() const
+	{
+		return instances;
+	}
+
+	const std::vector<SpriteDrawStep>& SpriteBatcher::GetSteps() const
+	{
+		return steps;
+	}
+}
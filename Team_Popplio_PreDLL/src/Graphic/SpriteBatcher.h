@@ -0,0 +1,171 @@
+/******************************************************************************/
+/*!
+\file   SpriteBatcher.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the SpriteBatcher class, which turns the
+		sorted draw commands of a frame into per-instance data and draw steps.
+		Consecutive quad sprites sharing a texture are merged into one
+		instanced draw, whichever shader (default, animation, instanced) they
+		were set to use. The glyphs of text entities are batched the same way,
+		sampling the glyph atlas of their font size.
+
+		The batcher only builds CPU-side data and does not touch OpenGL.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Transformation/TransformComponent.h"
+#include "../Graphic/GraphicComponent.h"
+#include "../Animation/AnimationComponent.h"
+#include "../UI/UIComponent.h"
+#include "../Graphic/Texture/TextureAtlas.h"
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	Per-instance vertex data, the layout of the instance buffer (attribute
+	locations 3 to 12).
+
+	*******************************************************************************/
+	struct InstanceData
+	{
+		glm::mat3 modelMatrix;
+		glm::vec3 color;
+		float alpha;
+		glm::vec4 uvRect;
+		glm::vec4 borderSize;   // nine-slice borders in pixels (left, right, bottom, top)
+		glm::vec2 spriteSize;   // nine-slice sprite size
+		glm::vec2 textureSize;  // nine-slice texture size
+		glm::vec2 flags;        // x: sample the texture, y: nine-slice
+	};
+
+	/*!*****************************************************************************
+	\brief
+	The shader a batched sprite was set to use, which decides how its instance
+	data is filled so the batch shader draws it the same way.
+
+	*******************************************************************************/
+	enum class SpriteShader : std::uint8_t
+	{
+		NONE, // not batchable
+		DEFAULT, // default_shader: nine-slice, alpha applied twice
+		ANIMATION, // animation_shader: animation / hover UVs
+		INSTANCED, // instanced_shader: animation UVs, texture optional
+		TEXT // glyphs of a TextComponent, from the glyph atlas of its font size
+	};
+
+	/*!*****************************************************************************
+	\brief
+	One draw of the frame: either a batch of merged sprites, or a command drawn
+	by its own path (with the instances it added, if any).
+
+	*******************************************************************************/
+	struct SpriteDrawStep
+	{
+		std::uint32_t command; // index of the (first) render command of the step
+		std::uint32_t texture; // texture of the batch
+		std::uint32_t firstInstance;
+		std::uint32_t instanceCount;
+		bool spriteBatch; // true if drawn with the batch shader
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Builds the instance data and draw steps of a frame.
+
+	*******************************************************************************/
+	class SpriteBatcher
+	{
+	public:
+		/*!*****************************************************************************
+		\brief
+		Gets which batchable shader a sprite uses.
+
+		\return
+		SpriteShader::NONE if the sprite cannot be batched (mesh is not a quad,
+		or a shader the batch shader does not reproduce).
+
+		*******************************************************************************/
+		static SpriteShader GetSpriteShader(const RenderComponent& render);
+
+		/*!*****************************************************************************
+		\brief
+		Fills the instance data of a sprite with the state the non-instanced path
+		sets as uniforms: color, alpha, animation and hover UVs, nine-slice,
+		checkbox color and slider handle position.
+
+		\param[in] sliderTrack
+		Transform of the track of a slider handle, nullptr if none.
+
+		\param[in] region
+		Where the sprite's texture is sampled from, the UVs are remapped into it.
+
+		*******************************************************************************/
+		static InstanceData MakeSpriteInstance(SpriteShader shader, const TransformComponent& transform,
+			const RenderComponent& render, const AnimationComponent* animation, const UIComponent* ui,
+			const TransformComponent* sliderTrack, const TextureRegion& region = TextureRegion{});
+
+		/*!*****************************************************************************
+		\brief
+		Fills the instance data of a glyph placed by a text layout, drawn at the
+		text position with the text color and alpha.
+
+		*******************************************************************************/
+		static InstanceData MakeGlyphInstance(const GlyphQuad& glyph, const TransformComponent& transform,
+			const TextComponent& text);
+
+		/*!*****************************************************************************
+		\brief
+		Removes the instances and steps of the previous frame.
+
+		*******************************************************************************/
+		void Begin();
+
+		/*!*****************************************************************************
+		\brief
+		Adds a sprite, merged into the previous step if that is a sprite batch
+		with the same texture.
+
+		*******************************************************************************/
+		void AddSprite(std::uint32_t command, std::uint32_t texture, const InstanceData& instance);
+
+		/*!*****************************************************************************
+		\brief
+		Adds a command drawn by its own path, which ends the current sprite batch.
+
+		*******************************************************************************/
+		void AddCommand(std::uint32_t command);
+
+		/*!*****************************************************************************
+		\brief
+		Adds an instance to the last command added with AddCommand.
+
+		*******************************************************************************/
+		void AddInstance(const InstanceData& instance);
+
+		const std::vector<InstanceData>& GetInstances() const;
+		const std::vector<SpriteDrawStep>& GetSteps() const;
+
+	private:
+		std::vector<InstanceData> instances{};
+		std::vector<SpriteDrawStep> steps{};
+	};
+}
@@ -17,6 +17,9 @@
     character dimensions for width and height metrics, and supports alpha and
     color properties used for text rendering.
 
+    The glyph layout of the text is cached, so the metrics and the quads are
+    only recomputed when the text, font or font size changes.
+
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
 without the prior written consent of DigiPen Institute of
@@ -42,34 +45,22 @@ namespace Popplio
 
     float TextComponent::GetWidth() const
     {
-        Font* font = AssetStore::GetFont(fontName);
-        if (!font)
-        {
-            Logger::Warning("Font not found: " + fontName);
-            return 0.0f;
-        }
-
-        if (!font->IsSizeLoaded(fontSize))
-        {
-            font->LoadSize(fontSize);
-        }
-
-        float totalWidth = 0.0f;
-        for (char c : text)
-        {
-            const Character& ch = font->GetCharacter(c, fontSize);
-            totalWidth += static_cast<float>(ch.Advance >> 6);
-        }
-        return totalWidth;
+        return GetLayout().GetWidth();
     }
 
     float TextComponent::GetHeight() const
+    {
+        return GetLayout().GetHeight();
+    }
+
+    const TextLayout& TextComponent::GetLayout() const
     {
         Font* font = AssetStore::GetFont(fontName);
         if (!font)
         {
             Logger::Warning("Font not found: " + fontName);
-            return 0.0f;
+            layout.Clear();
+            return layout;
         }
 
         if (!font->IsSizeLoaded(fontSize))
@@ -77,18 +68,17 @@ namespace Popplio
             font->LoadSize(fontSize);
         }
 
-        float maxAscent = 0.0f;
-        float maxDescent = 0.0f;
-
-        for (char c : text)
+        const GlyphSet* glyphs = font->GetGlyphSet(fontSize);
+        if (!glyphs)
         {
-            const Character& ch = font->GetCharacter(c, fontSize);
-            maxAscent = std::max(maxAscent, static_cast<float>(ch.Bearing.y));
-            float descent = static_cast<float>(ch.Size.y) - static_cast<float>(ch.Bearing.y);
-            maxDescent = std::max(maxDescent, descent);
+            layout.Clear();
+            return layout;
         }
 
-        return maxAscent + maxDescent;
+        if (!layout.IsBuiltFor(text, *glyphs))
+        {
+            layout.Build(text, *glyphs);
+        }
+        return layout;
     }
-
 }
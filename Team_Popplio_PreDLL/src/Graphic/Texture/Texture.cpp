@@ -46,10 +46,20 @@ namespace Popplio
 	[std::string] Path to the texture file.
 
 	*******************************************************************************/
-	Texture::Texture(const std::string& texturePath)
+	Texture::Texture(const std::string& texturePath) : Texture(Decode(texturePath))
 	{
-		const char* path = texturePath.c_str();
+	}
+
+	/*!*****************************************************************************
+	\brief
+	Constructor that uploads an image decoded by Decode.
 
+	\param[in] image
+	[TextureImage] The decoded image.
+
+	*******************************************************************************/
+	Texture::Texture(const TextureImage& image) : width(image.width), height(image.height)
+	{
 		unsigned int texture;
 		glGenTextures(1, &texture);
 		glBindTexture(GL_TEXTURE_2D, texture);
@@ -58,30 +68,47 @@ namespace Popplio
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		// load and generate the texture
-		int nrChannels;
-		stbi_set_flip_vertically_on_load(true); //flip loaded texture's on the y-axis
-		unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-		if (data)
+		// generate the texture, Decode always gives 4 channels
+		if (image.pixels)
 		{
-			// to use .png, set to GL_RGBA
-			// to use .jpg, set to GL_RGB
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.get());
 			glGenerateMipmap(GL_TEXTURE_2D);
+		}
 
-			if (Popplio::Engine::Config::verbose)
-				Logger::Info("Successfully loaded texture: " + static_cast<std::string>(path));
+		textureID = texture;
+	}
+
+	/*!*****************************************************************************
+	\brief
+	Decodes an image file to RGBA8 without touching OpenGL.
 
+	\param[in] texturePath
+	[std::string] Path to the texture file.
+
+	\return
+	[TextureImage] The decoded image, without pixels if the file failed to load.
+
+	*******************************************************************************/
+	TextureImage Texture::Decode(const std::string& texturePath)
+	{
+		TextureImage image{};
+
+		int nrChannels;
+		stbi_set_flip_vertically_on_load_thread(true); //flip loaded texture's on the y-axis, per thread so workers can decode
+		image.pixels.reset(stbi_load(texturePath.c_str(), &image.width, &image.height, &nrChannels, STBI_rgb_alpha));
+		if (image.pixels)
+		{
+			if (Popplio::Engine::Config::verbose)
+				Logger::Info("Successfully loaded texture: " + texturePath);
 		}
 		else
 		{
-			Logger::Error("Failed to load texture");
-			width = 0;
-			height = 0;
+			Logger::Error("Failed to load texture: " + texturePath);
+			image.width = 0;
+			image.height = 0;
 		}
-		stbi_image_free(data);
 
-		textureID = texture;
+		return image;
 	}
 
 	/*!*****************************************************************************
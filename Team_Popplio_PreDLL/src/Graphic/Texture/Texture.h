@@ -24,10 +24,29 @@ Technology is prohibited.
 #include <stb/stb_image.h>
 #include <string>
 #include <iostream>
+#include <memory>
 
 
 namespace Popplio
 {
+	/*!*****************************************************************************
+	\brief
+	RGBA8 pixels of an image file decoded on the CPU, rows from the bottom,
+	waiting to be uploaded by the thread that owns the GL context.
+
+	*******************************************************************************/
+	struct TextureImage
+	{
+		struct PixelDeleter
+		{
+			void operator()(unsigned char* data) const { stbi_image_free(data); }
+		};
+
+		std::unique_ptr<unsigned char, PixelDeleter> pixels{};
+		int width = 0;
+		int height = 0;
+	};
+
 	class Texture
 	{
 	public:
@@ -49,6 +68,31 @@ namespace Popplio
 		*******************************************************************************/
 		Texture(const std::string& texturePath);
 
+		/*!*****************************************************************************
+		\brief
+		Constructor that uploads an image decoded by Decode.
+		An image that failed to decode gives an empty texture.
+
+		\param[in] image
+		[TextureImage] The decoded image.
+
+		*******************************************************************************/
+		explicit Texture(const TextureImage& image);
+
+		/*!*****************************************************************************
+		\brief
+		Decodes an image file to RGBA8 without touching OpenGL, safe to call
+		from any thread.
+
+		\param[in] texturePath
+		[std::string] Path to the texture file.
+
+		\return
+		[TextureImage] The decoded image, without pixels if the file failed to load.
+
+		*******************************************************************************/
+		static TextureImage Decode(const std::string& texturePath);
+
 		GLuint GetTextureID();
 
 		/*!*****************************************************************************
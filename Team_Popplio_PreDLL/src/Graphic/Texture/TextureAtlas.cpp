@@ -0,0 +1,325 @@
+/******************************************************************************/
+/*!
+\file   TextureAtlas.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the texture atlas packer and manifest.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "TextureAtlas.h"
+#include "../../Serialization/Serialization.h"
+
+#include <stb/stb_image.h>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <climits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Popplio
+{
+	namespace
+	{
+		/*!*****************************************************************************
+		\brief
+		One page being packed. The skyline is the top edge of the packed
+		rectangles, as horizontal segments from left to right covering the page.
+
+		*******************************************************************************/
+		class SkylinePage
+		{
+		public:
+			explicit SkylinePage(int size) : size(size), nodes{ { 0, 0, size } } {}
+
+			// Places a rectangle as low as possible, then on the narrowest segment
+			bool Insert(int width, int height, int& outX, int& outY)
+			{
+				int bestTop = INT_MAX, bestWidth = INT_MAX;
+				size_t bestIndex = nodes.size();
+				for (size_t i = 0; i < nodes.size(); ++i)
+				{
+					int y = 0;
+					if (!Fits(i, width, height, y)) continue;
+					if (y + height < bestTop || (y + height == bestTop && nodes[i].width < bestWidth))
+					{
+						bestTop = y + height;
+						bestWidth = nodes[i].width;
+						bestIndex = i;
+						outX = nodes[i].x;
+						outY = y;
+					}
+				}
+				if (bestIndex == nodes.size()) return false;
+
+				AddSegment(bestIndex, outX, outY + height, width);
+				return true;
+			}
+
+		private:
+			struct Segment
+			{
+				int x;
+				int y;
+				int width;
+			};
+
+			// Whether the rectangle fits with its left edge at the segment, and at which height
+			bool Fits(size_t index, int width, int height, int& y) const
+			{
+				if (nodes[index].x + width > size) return false;
+
+				y = 0;
+				int widthLeft = width;
+				for (size_t i = index; widthLeft > 0; ++i)
+				{
+					y = std::max(y, nodes[i].y);
+					if (y + height > size) return false;
+					widthLeft -= nodes[i].width;
+				}
+				return true;
+			}
+
+			void AddSegment(size_t index, int x, int y, int width)
+			{
+				nodes.insert(nodes.begin() + index, Segment{ x, y, width });
+
+				// Cut the segments now under the new one
+				for (size_t i = index + 1; i < nodes.size();)
+				{
+					const int previousEnd = nodes[i - 1].x + nodes[i - 1].width;
+					if (nodes[i].x >= previousEnd) break;
+
+					const int shrink = previousEnd - nodes[i].x;
+					if (nodes[i].width <= shrink)
+					{
+						nodes.erase(nodes.begin() + i);
+						continue;
+					}
+					nodes[i].x += shrink;
+					nodes[i].width -= shrink;
+					break;
+				}
+
+				// Merge neighbours at the same height
+				for (size_t i = 0; i + 1 < nodes.size();)
+				{
+					if (nodes[i].y == nodes[i + 1].y)
+					{
+						nodes[i].width += nodes[i + 1].width;
+						nodes.erase(nodes.begin() + i + 1);
+					}
+					else ++i;
+				}
+			}
+
+			int size;
+			std::vector<Segment> nodes;
+		};
+
+		bool ReadInt(const rapidjson::Value& object, const char* name, int& out)
+		{
+			if (!object.HasMember(name) || !object[name].IsInt()) return false;
+			out = object[name].GetInt();
+			return true;
+		}
+	}
+
+	glm::vec4 TextureRegion::Remap(const glm::vec4& uv) const
+	{
+		const glm::vec2 origin(uvRect.x, uvRect.y);
+		const glm::vec2 size(uvRect.z - uvRect.x, uvRect.w - uvRect.y);
+		return glm::vec4(origin + glm::vec2(uv.x, uv.y) * size, origin + glm::vec2(uv.z, uv.w) * size);
+	}
+
+	glm::vec4 AtlasManifest::GetUVRect(const AtlasRegion& region) const
+	{
+		const float size = static_cast<float>(pageSize);
+		return glm::vec4(region.x / size, region.y / size,
+			(region.x + region.width) / size, (region.y + region.height) / size);
+	}
+
+	bool AtlasManifest::Save(const std::filesystem::path& path) const
+	{
+		rapidjson::Document document;
+		document.SetObject();
+		auto& allocator = document.GetAllocator();
+
+		document.AddMember("pageSize", pageSize, allocator);
+		document.AddMember("padding", padding, allocator);
+		document.AddMember("pageCount", pageCount, allocator);
+
+		rapidjson::Value regionArray{ rapidjson::kArrayType };
+		for (const auto& [name, region] : regions)
+		{
+			rapidjson::Value regionVal{ rapidjson::kObjectType };
+			regionVal.AddMember("name", rapidjson::Value(name.c_str(), allocator), allocator);
+			regionVal.AddMember("page", region.page, allocator);
+			regionVal.AddMember("x", region.x, allocator);
+			regionVal.AddMember("y", region.y, allocator);
+			regionVal.AddMember("width", region.width, allocator);
+			regionVal.AddMember("height", region.height, allocator);
+			regionArray.PushBack(regionVal, allocator);
+		}
+		document.AddMember("regions", regionArray, allocator);
+
+		rapidjson::StringBuffer buffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+		document.Accept(writer);
+
+		std::ofstream ofs(path);
+		if (!ofs.is_open()) return false;
+		ofs << buffer.GetString();
+		return ofs.good();
+	}
+
+	bool AtlasManifest::Load(const std::filesystem::path& path)
+	{
+		*this = AtlasManifest{};
+
+		std::ifstream ifs(path);
+		if (!ifs.is_open()) return false;
+
+		rapidjson::Document document;
+		rapidjson::IStreamWrapper isw(ifs);
+		document.ParseStream(isw);
+
+		AtlasManifest manifest{};
+		if (document.HasParseError() || !document.IsObject() ||
+			!ReadInt(document, "pageSize", manifest.pageSize) || !ReadInt(document, "padding", manifest.padding) ||
+			!ReadInt(document, "pageCount", manifest.pageCount) ||
+			!document.HasMember("regions") || !document["regions"].IsArray())
+		{
+			return false;
+		}
+
+		for (const rapidjson::Value& regionVal : document["regions"].GetArray())
+		{
+			AtlasRegion region{};
+			if (!regionVal.IsObject() || !regionVal.HasMember("name") || !regionVal["name"].IsString() ||
+				!ReadInt(regionVal, "page", region.page) || !ReadInt(regionVal, "x", region.x) ||
+				!ReadInt(regionVal, "y", region.y) || !ReadInt(regionVal, "width", region.width) ||
+				!ReadInt(regionVal, "height", region.height) ||
+				region.page < 0 || region.page >= manifest.pageCount)
+			{
+				return false;
+			}
+			manifest.regions[regionVal["name"].GetString()] = region;
+		}
+
+		*this = std::move(manifest);
+		return true;
+	}
+
+	bool AtlasPacker::IsPackable(int width, int height)
+	{
+		return width > 0 && height > 0 && width <= MAX_IMAGE_SIZE && height <= MAX_IMAGE_SIZE;
+	}
+
+	AtlasManifest AtlasPacker::Pack(std::vector<AtlasImage> images, int pageSize, int padding)
+	{
+		AtlasManifest manifest{};
+		manifest.pageSize = pageSize;
+		manifest.padding = padding;
+
+		// Only the first texture of each name is packed, like the asset store keeps it
+		std::unordered_set<std::string> seen{};
+		images.erase(std::remove_if(images.begin(), images.end(), [&seen](const AtlasImage& image)
+		{
+			return !IsPackable(image.width, image.height) || !seen.insert(image.name).second;
+		}), images.end());
+
+		// Tallest first keeps the skyline flat
+		std::sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b)
+		{
+			if (a.height != b.height) return a.height > b.height;
+			if (a.width != b.width) return a.width > b.width;
+			return a.name < b.name;
+		});
+
+		std::vector<SkylinePage> pages{};
+		for (const AtlasImage& image : images)
+		{
+			// The padding is split around the texture, its edges are extruded into it
+			const int cellWidth = image.width + padding;
+			const int cellHeight = image.height + padding;
+			if (cellWidth > pageSize || cellHeight > pageSize) continue;
+
+			int x = 0, y = 0;
+			size_t page = 0;
+			while (page < pages.size() && !pages[page].Insert(cellWidth, cellHeight, x, y)) ++page;
+			if (page == pages.size())
+			{
+				pages.emplace_back(pageSize);
+				pages.back().Insert(cellWidth, cellHeight, x, y);
+			}
+
+			manifest.regions[image.name] = AtlasRegion{ static_cast<int>(page),
+				x + padding / 2, y + padding / 2, image.width, image.height };
+		}
+
+		manifest.pageCount = static_cast<int>(pages.size());
+		return manifest;
+	}
+
+	std::vector<AtlasImage> AtlasPacker::ScanImages(const std::filesystem::path& directory)
+	{
+		std::vector<std::filesystem::path> files{};
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".png") files.push_back(entry.path());
+		}
+		std::sort(files.begin(), files.end());
+
+		std::vector<AtlasImage> images{};
+		for (const std::filesystem::path& file : files)
+		{
+			int width = 0, height = 0, channels = 0;
+			if (!stbi_info(file.string().c_str(), &width, &height, &channels)) continue;
+			if (IsPackable(width, height))
+			{
+				images.push_back({ Serializer::GenerateAssetName(file.filename().string()), width, height });
+			}
+		}
+		return images;
+	}
+
+	bool AtlasPacker::IsUpToDate(const AtlasManifest& manifest, const std::vector<AtlasImage>& images,
+		int pageSize, int padding)
+	{
+		if (manifest.pageSize != pageSize || manifest.padding != padding) return false;
+
+		// First texture of each name, like Pack
+		std::unordered_map<std::string, const AtlasImage*> packable{};
+		for (const AtlasImage& image : images)
+		{
+			if (IsPackable(image.width, image.height)) packable.emplace(image.name, &image);
+		}
+		if (packable.size() != manifest.regions.size()) return false;
+
+		for (const auto& [name, image] : packable)
+		{
+			auto it = manifest.regions.find(name);
+			if (it == manifest.regions.end() ||
+				it->second.width != image->width || it->second.height != image->height)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,169 @@
+/******************************************************************************/
+/*!
+\file   TextureAtlas.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the texture atlas packer and manifest.
+		Small textures are packed into a few large pages (skyline bottom-left)
+		so sprites using different textures can be drawn in one batch. The
+		manifest records where each texture is on which page.
+
+		Packing, scanning and the manifest do not touch OpenGL, so atlases can
+		be built headlessly; the pages are composed when the assets are loaded.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Popplio
+{
+	/*!*****************************************************************************
+	\brief
+	A texture as it is sampled: the GL texture (atlas page or the texture
+	itself) and the UV rectangle of the texture in it.
+
+	*******************************************************************************/
+	struct TextureRegion
+	{
+		unsigned int texture = 0;
+		glm::vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+
+		/*!*****************************************************************************
+		\brief
+		Maps a UV rectangle in texture space (e.g. an animation frame) into the
+		space of the region's GL texture.
+
+		*******************************************************************************/
+		glm::vec4 Remap(const glm::vec4& uv) const;
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Placement of a packed texture, in pixels of its page.
+
+	*******************************************************************************/
+	struct AtlasRegion
+	{
+		int page = 0;
+		int x = 0;
+		int y = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	/*!*****************************************************************************
+	\brief
+	A texture to pack.
+
+	*******************************************************************************/
+	struct AtlasImage
+	{
+		std::string name;
+		int width = 0;
+		int height = 0;
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Result of packing: page size and count, and the region of every packed
+	texture by asset name.
+
+	*******************************************************************************/
+	struct AtlasManifest
+	{
+		int pageSize = 0;
+		int padding = 0;
+		int pageCount = 0;
+		std::map<std::string, AtlasRegion> regions{};
+
+		/*!*****************************************************************************
+		\brief
+		Gets the UV rectangle of a region in its page.
+
+		*******************************************************************************/
+		glm::vec4 GetUVRect(const AtlasRegion& region) const;
+
+		/*!*****************************************************************************
+		\brief
+		Writes the manifest as JSON.
+
+		\return
+		False if the file could not be written.
+
+		*******************************************************************************/
+		bool Save(const std::filesystem::path& path) const;
+
+		/*!*****************************************************************************
+		\brief
+		Reads a manifest written by Save.
+
+		\return
+		False if the file is missing or invalid, the manifest is left empty.
+
+		*******************************************************************************/
+		bool Load(const std::filesystem::path& path);
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Packs textures into atlas pages.
+
+	*******************************************************************************/
+	class AtlasPacker
+	{
+	public:
+		static constexpr int DEFAULT_PAGE_SIZE = 2048;
+		static constexpr int DEFAULT_PADDING = 2; // pixels between textures, filled by extruding their edges
+		static constexpr int MAX_IMAGE_SIZE = 512; // larger textures keep their own GL texture
+
+		/*!*****************************************************************************
+		\brief
+		Whether a texture of the given size is packed.
+
+		*******************************************************************************/
+		static bool IsPackable(int width, int height);
+
+		/*!*****************************************************************************
+		\brief
+		Packs the textures, tallest first, into as few pages as fit them.
+		Textures that are not packable, or named like an earlier texture, are
+		skipped.
+
+		*******************************************************************************/
+		static AtlasManifest Pack(std::vector<AtlasImage> images,
+			int pageSize = DEFAULT_PAGE_SIZE, int padding = DEFAULT_PADDING);
+
+		/*!*****************************************************************************
+		\brief
+		Lists the packable PNGs under a directory, reading only their headers.
+		Names come from Serializer::GenerateAssetName, like the loaded textures.
+
+		*******************************************************************************/
+		static std::vector<AtlasImage> ScanImages(const std::filesystem::path& directory);
+
+		/*!*****************************************************************************
+		\brief
+		Whether the manifest packs exactly the packable textures given, with the
+		same sizes and settings, so it does not need repacking.
+
+		*******************************************************************************/
+		static bool IsUpToDate(const AtlasManifest& manifest, const std::vector<AtlasImage>& images,
+			int pageSize = DEFAULT_PAGE_SIZE, int padding = DEFAULT_PADDING);
+	};
+}
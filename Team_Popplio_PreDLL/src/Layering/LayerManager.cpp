@@ -27,6 +27,11 @@ Technology is prohibited.
 
 namespace Popplio
 {
+	LayerManager::LayerManager()
+	{
+		interactionMasks.fill(~std::uint64_t(0));
+	}
+
 	void LayerManager::AddLayer(const std::string& name, bool active)
 	{
 		if (name.empty())
@@ -41,6 +46,17 @@ namespace Popplio
 			return;
 		}
 
+		// Take the lowest free layer id
+		auto freeId = std::find_if(layerNames.begin(), layerNames.end(), [](const std::string& n) { return n.empty(); });
+		if (freeId == layerNames.end())
+		{
+			Logger::Error("Cannot add layer '" + name + "', the maximum of " + std::to_string(MAX_LAYERS) +
+				" layers is reached", LogDestination::IMGUI_CONSOLE);
+			return;
+		}
+		*freeId = name;
+		layerIds[name] = static_cast<int>(freeId - layerNames.begin());
+
 		// Calculate the order of the new layer
 		int order = 0;
 		if (!layers.empty())
@@ -72,15 +88,21 @@ namespace Popplio
 		auto& entities = layerEntities[name];
 		for (const Entity& entity : entities)
 		{
-			entityLayerMap.erase(entity.GetId());
+			entityLayerIds[entity.GetId()] = NO_LAYER;
 		}
 
+		// Remove layer interactions (before the layer itself, which they are looked up by)
+		ClearLayerInteractions(name);
+
 		// Remove layer entries
 		layers.erase(layerIt);
 		layerEntities.erase(name);
 
-		// Remove layer interactions
-		ClearLayerInteractions(name);
+		// Free the layer id
+		auto idIt = layerIds.find(name);
+		layerNames[idIt->second].clear();
+		interactionMasks[idIt->second] = ~std::uint64_t(0);
+		layerIds.erase(idIt);
 
 		// Reorder remaining layers to maintain consecutive ordering
 		ReorderLayers();
@@ -102,7 +124,11 @@ namespace Popplio
 		RemoveEntityFromCurrentLayer(entity);
 
 		// Add to new layer
-		entityLayerMap[entity.GetId()] = layerName;
+		if (entity.GetId() >= static_cast<int>(entityLayerIds.size()))
+		{
+			entityLayerIds.resize(entity.GetId() + 1, NO_LAYER);
+		}
+		entityLayerIds[entity.GetId()] = layerIds.at(layerName);
 		layerEntities[layerName].insert(entity);
 
 		Logger::Debug("Added Entity " + std::to_string(entity.GetId()) +
@@ -111,12 +137,12 @@ namespace Popplio
 
 	void LayerManager::RemoveEntityFromCurrentLayer(Entity entity)
 	{
-		auto it = entityLayerMap.find(entity.GetId());
-		if (it != entityLayerMap.end())
+		const int layerId = GetEntityLayerId(entity.GetId());
+		if (layerId != NO_LAYER)
 		{
-			std::string currentLayer = it->second;
+			std::string currentLayer = layerNames[layerId];
 			layerEntities[currentLayer].erase(entity);
-			entityLayerMap.erase(it);
+			entityLayerIds[entity.GetId()] = NO_LAYER;
 
 			Logger::Debug("Removed Entity " + std::to_string(entity.GetId()) +
 				" from layer '" + currentLayer + "'", LogDestination::IMGUI_CONSOLE);
@@ -125,8 +151,14 @@ namespace Popplio
 
 	std::string LayerManager::GetEntityLayer(Entity entity) const
 	{
-		auto it = entityLayerMap.find(entity.GetId());
-		return it != entityLayerMap.end() ? it->second : "";
+		const int layerId = GetEntityLayerId(entity.GetId());
+		return layerId != NO_LAYER ? layerNames[layerId] : "";
+	}
+
+	int LayerManager::GetLayerId(const std::string& name) const
+	{
+		auto it = layerIds.find(name);
+		return it != layerIds.end() ? it->second : NO_LAYER;
 	}
 
 	std::vector<Entity> LayerManager::GetEntitiesInLayer(const std::string& layerName) const
@@ -142,7 +174,7 @@ namespace Popplio
 	std::vector<Entity> LayerManager::GetAllEntitiesSortedByLayer() const
 	{
 		std::vector<Entity> sortedEntities;
-		sortedEntities.reserve(entityLayerMap.size());  // Reserve space for efficiency
+		sortedEntities.reserve(entityLayerIds.size());  // Reserve space for efficiency
 
 		// Get sorted layers
 		auto sortedLayers = GetSortedLayers();
@@ -290,9 +322,12 @@ namespace Popplio
 
 		// Clear all internal data structures
 		layers.clear();
-		entityLayerMap.clear();
+		entityLayerIds.clear();
 		layerEntities.clear();
 		layerInteractions.clear();
+		layerIds.clear();
+		for (std::string& layerName : layerNames) layerName.clear();
+		interactionMasks.fill(~std::uint64_t(0));
 
   //      if (persistentEntities.empty()) // Clear all layers and entities
 		//{
@@ -403,6 +438,19 @@ namespace Popplio
 		}
 		layerInteractions[layer1][layer2] = interacts;
 		layerInteractions[layer2][layer1] = interacts;
+
+		const std::uint64_t bit1 = std::uint64_t(1) << layerIds[layer1];
+		const std::uint64_t bit2 = std::uint64_t(1) << layerIds[layer2];
+		if (interacts)
+		{
+			interactionMasks[layerIds[layer1]] |= bit2;
+			interactionMasks[layerIds[layer2]] |= bit1;
+		}
+		else
+		{
+			interactionMasks[layerIds[layer1]] &= ~bit2;
+			interactionMasks[layerIds[layer2]] &= ~bit1;
+		}
 		Logger::Debug("Set interaction between layers '" + layer1 + "' and '" + layer2 +
 			"' to " + (interacts ? "true" : "false"), LogDestination::IMGUI_CONSOLE);
 	}
@@ -441,6 +489,7 @@ namespace Popplio
 				layerInteractions[name][layerName] = true;
 			}
 		}
+		RebuildInteractionMasks();
 		Logger::Debug("Initialized interactions for layer '" + layerName + "'", LogDestination::IMGUI_CONSOLE);
 	}
 
@@ -456,6 +505,7 @@ namespace Popplio
 		{
 			interactions.erase(layerName);
 		}
+		RebuildInteractionMasks();
 		Logger::Debug("Cleared interactions for layer '" + layerName + "'", LogDestination::IMGUI_CONSOLE);
 	}
 
@@ -467,6 +517,26 @@ namespace Popplio
 	void LayerManager::LoadInteractions(const std::unordered_map<std::string, std::unordered_map<std::string, bool>>& interactions)
 	{
 		layerInteractions = interactions;
+		RebuildInteractionMasks();
 		Logger::Debug("Loaded layer interactions", LogDestination::IMGUI_CONSOLE);
 	}
+
+	void LayerManager::RebuildInteractionMasks()
+	{
+		// Unset interactions default to true, and NO_LAYER interacts with everything
+		interactionMasks.fill(~std::uint64_t(0));
+		for (const auto& [layer1, interactions] : layerInteractions)
+		{
+			auto id1 = layerIds.find(layer1);
+			if (id1 == layerIds.end()) continue;
+
+			for (const auto& [layer2, interacts] : interactions)
+			{
+				auto id2 = layerIds.find(layer2);
+				if (id2 == layerIds.end() || interacts) continue;
+
+				interactionMasks[id1->second] &= ~(std::uint64_t(1) << id2->second);
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ Technology is prohibited.
 /******************************************************************************/
 
 #pragma once
+#include <array>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -50,8 +52,14 @@ namespace Popplio
 	class LayerManager
 	{
 	public:
+        static constexpr int MAX_LAYERS = 63; //!< The maximum number of layers, one bit each in an interaction mask.
+        static constexpr int NO_LAYER = MAX_LAYERS; //!< The layer id of entities without a layer, interacts with every layer.
+
+        LayerManager();
+
         /**
         * \brief Adds a layer to the LayerManager.
+        * Fails if MAX_LAYERS layers already exist.
         * \param name The name of the layer to add.
         * \param active Indicates whether the layer is active or not. Default is true.
         */
@@ -111,6 +119,35 @@ namespace Popplio
         */
         std::string GetEntityLayer(Entity entity) const;
 
+        /**
+        * \brief Gets the layer id of an entity, for use on hot paths (no string lookups).
+        * \param entityId The id of the entity.
+        * \return The id of the layer the entity belongs to, or NO_LAYER.
+        */
+        int GetEntityLayerId(int entityId) const
+        {
+            return entityId >= 0 && entityId < static_cast<int>(entityLayerIds.size()) ? entityLayerIds[entityId] : NO_LAYER;
+        }
+
+        /**
+        * \brief Gets the id of a layer.
+        * \param name The name of the layer.
+        * \return The id of the layer, or NO_LAYER if the layer does not exist.
+        */
+        int GetLayerId(const std::string& name) const;
+
+        /**
+        * \brief Checks if two layers interact using the precomputed interaction masks.
+        * Same result as ShouldLayersInteract on the names of the layers; NO_LAYER interacts with every layer.
+        * \param layerId1 The id of the first layer.
+        * \param layerId2 The id of the second layer.
+        * \return True if the layers interact.
+        */
+        bool ShouldLayerIdsInteract(int layerId1, int layerId2) const
+        {
+            return (interactionMasks[layerId1] & (std::uint64_t(1) << layerId2)) != 0;
+        }
+
         /**
         * \brief Gets all entities in a specific layer.
         * \param layerName The name of the layer to get the entities from.
@@ -161,11 +198,15 @@ namespace Popplio
         void LoadInteractions(const std::unordered_map<std::string, std::unordered_map<std::string, bool>>& interactions);
     private:
 		std::unordered_map<std::string, Layer> layers; //!< The map of layer names to Layer objects.
-		std::unordered_map<int, std::string> entityLayerMap; //!< The map of entity IDs to layer names.
+		std::vector<int> entityLayerIds; //!< Layer id of each entity, indexed by entity id (NO_LAYER if none).
+		std::unordered_map<std::string, int> layerIds; //!< The map of layer names to layer ids.
+		std::array<std::string, MAX_LAYERS> layerNames; //!< The name of each layer id, empty if the id is free.
+		std::array<std::uint64_t, MAX_LAYERS + 1> interactionMasks; //!< Bit j of mask i is set if layers i and j interact.
 		std::unordered_map<std::string, std::set<Entity>> layerEntities; //!< The map of layer names to sets of entities.
 		std::unordered_map<std::string, std::unordered_map<std::string, bool>> layerInteractions; //!< The map of layer names to maps of layer interaction toggles.
 
 		// Helper methods
 		void ReorderLayers(); //!< Ensures layer orders remain sequential.
+		void RebuildInteractionMasks(); //!< Recomputes the interaction masks from the interaction map.
 	};
 }
\ No newline at end of file
@@ -277,8 +277,6 @@ namespace Popplio
         glfwSwapBuffers(window);
     }
 
-    const unsigned int loadCycle = 16; // 16ms = ~60 FPS
-
     void LoadingScreen::LoadAssets(const std::function<void(std::function<void(float)>)>& assetLoadingFunction)
     {
         // Set loading state
@@ -291,11 +289,8 @@ namespace Popplio
             this->Render();
 
             // Process events to keep UI responsive
+            // No delay here, the asset loader paces the updates by its upload budget
             glfwPollEvents();
-
-            // Small delay to avoid maxing CPU and allow UI updates
-            std::this_thread::sleep_for(std::chrono::milliseconds(loadCycle)); 
-            //std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
         };
 
         // Initial update at 0%
@@ -0,0 +1,259 @@
+/******************************************************************************/
+/*!
+\file   LogQueue.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+    This header file defines the LogQueue class, a fixed-capacity lock-free
+    queue of log records with many producers (any thread that logs) and one
+    consumer (the log writer thread), and the LogRing class, the fixed-capacity
+    circular buffer of the entries shown in the ImGui console.
+
+    Records keep the level, time, destination and message inline, the writer
+    formats them, so logging only costs copying the message into a queue slot.
+    Messages longer than the slot are moved to the writer as an owned string.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Popplio
+{
+    enum class LogLevel
+    {
+        DEBUG_LOG,
+        INFO_LOG,
+        WARNING_LOG,
+        ERROR_LOG,
+        CRITICAL_LOG
+    };
+
+    enum class LogDestination
+    {
+        WINDOWS_CONSOLE = 1,
+        IMGUI_CONSOLE = 2,
+        ALL = WINDOWS_CONSOLE | IMGUI_CONSOLE
+    };
+
+    /**
+    * @struct LogRecord
+    * @brief A message waiting to be formatted and written by the log writer.
+    *
+    * Short messages are stored inline so that queueing them does not allocate,
+    * longer ones are kept whole in an owned string.
+    */
+    struct LogRecord
+    {
+        static constexpr size_t MESSAGE_CAPACITY = 256; // characters kept inline
+
+        std::chrono::system_clock::time_point time{};
+        LogLevel level = LogLevel::INFO_LOG;
+        LogDestination destination = LogDestination::ALL;
+        bool isEngine = true;
+        std::uint16_t length = 0;
+        char message[MESSAGE_CAPACITY]; // first length characters are the message, not null terminated
+        std::string longMessage{}; // the message if it does not fit inline, empty otherwise
+
+        /**
+            * Copies the message inline, or into longMessage if it does not fit.
+            * @param text The message.
+            */
+        void SetText(std::string_view text)
+        {
+            if (text.size() <= MESSAGE_CAPACITY)
+            {
+                length = static_cast<std::uint16_t>(text.size());
+                std::memcpy(message, text.data(), text.size());
+                longMessage.clear();
+                return;
+            }
+
+            length = 0;
+            longMessage.assign(text);
+        }
+
+        std::string_view Text() const
+        {
+            return longMessage.empty() ? std::string_view(message, length) : std::string_view(longMessage);
+        }
+    };
+
+    /**
+    * @class LogQueue
+    * @brief Bounded lock-free queue of log records, many producers and one consumer.
+    *
+    * Every slot has a sequence number telling whether it is free for the producer
+    * at that position or filled for the consumer, so producers only contend on the
+    * enqueue position.
+    */
+    class LogQueue
+    {
+    public:
+        /**
+            * Creates the queue.
+            * @param capacity The number of slots, rounded up to a power of two.
+            */
+        explicit LogQueue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity) size *= 2;
+
+            mask = size - 1;
+            slots = std::make_unique<Slot[]>(size);
+            for (size_t i{}; i < size; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /**
+            * Adds a record, moving it into the slot.
+            * Safe to call from any thread.
+            * @param record The record to add, left untouched if the queue is full.
+            * @return False if the queue is full.
+            */
+        bool TryPush(LogRecord&& record)
+        {
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;)
+            {
+                slot = &slots[position & mask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (difference == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                }
+                else if (difference < 0) return false; // the consumer has not freed the slot yet
+                else position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+
+            slot->record = std::move(record);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+            * Takes the oldest record.
+            * Only one thread may call this.
+            * @param record Receives the record.
+            * @return False if the queue is empty.
+            */
+        bool TryPop(LogRecord& record)
+        {
+            Slot& slot = slots[dequeuePosition & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(dequeuePosition + 1) < 0) return false;
+
+            record = std::move(slot.record);
+            slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+            ++dequeuePosition;
+            return true;
+        }
+
+        /**
+            * Whether every pushed record was popped.
+            * Exact only on the consumer thread, an estimate elsewhere.
+            */
+        bool IsEmpty() const
+        {
+            return enqueuePosition.load(std::memory_order_acquire) == popped.load(std::memory_order_acquire);
+        }
+
+        /**
+            * Marks the records popped so far as written, for IsEmpty.
+            * Called by the consumer once it is done with the records.
+            */
+        void MarkWritten()
+        {
+            popped.store(dequeuePosition, std::memory_order_release);
+        }
+
+        size_t GetCapacity() const { return mask + 1; }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence{ 0 };
+            LogRecord record{};
+        };
+
+        std::unique_ptr<Slot[]> slots{};
+        size_t mask = 0;
+
+        alignas(64) std::atomic<size_t> enqueuePosition{ 0 }; // producers
+        alignas(64) size_t dequeuePosition = 0; // consumer only
+        std::atomic<size_t> popped{ 0 }; // records popped and written by the consumer
+    };
+
+    /**
+    * @class LogRing
+    * @brief Fixed-capacity circular buffer, the oldest entry is overwritten when full.
+    * @tparam T The entry type.
+    */
+    template <typename T>
+    class LogRing
+    {
+    public:
+        explicit LogRing(size_t cap) : capacity(cap) { entries.reserve(capacity); }
+
+        /**
+            * Adds an entry, replacing the oldest one if the buffer is full.
+            * @param entry The entry to add.
+            */
+        void Push(T&& entry)
+        {
+            if (entries.size() < capacity)
+            {
+                entries.push_back(std::move(entry));
+                return;
+            }
+
+            entries[head] = std::move(entry);
+            head = (head + 1) % capacity;
+        }
+
+        /**
+            * Removes every entry.
+            */
+        void Clear()
+        {
+            entries.clear();
+            head = 0;
+        }
+
+        size_t Size() const { return entries.size(); }
+        size_t GetCapacity() const { return capacity; }
+
+        /**
+            * Gets an entry, 0 being the oldest.
+            * @param index The index of the entry.
+            */
+        const T& operator[](size_t index) const
+        {
+            return entries[(head + index) % entries.size()];
+        }
+
+    private:
+        std::vector<T> entries{};
+        size_t capacity;
+        size_t head = 0; // oldest entry once full
+    };
+}
@@ -14,6 +14,10 @@
 	levels to various destinations, such as the Windows console and ImGui console. 
 	It supports different log levels, including debug, info, warning, error, and critical.
 
+	Logged messages go into a lock-free queue, a writer thread formats them and
+	writes them to the console and the ImGui log buffer. Errors and critical
+	messages are written by the logging thread itself once the queue is drained.
+
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
 without the prior written consent of DigiPen Institute of
@@ -23,25 +27,104 @@ Technology is prohibited.
 #include <pch.h>
 #include <Windows.h>
 
+#include <condition_variable>
+#include <thread>
+
 namespace Popplio
 {
+	namespace
+	{
+		// State of the writer thread, created on first use so logging during static initialization works
+		struct LogBackend
+		{
+			LogQueue queue{ Logger::LOG_QUEUE_CAPACITY };
+			std::thread writer{};
+			std::atomic<bool> running{ false };
+			std::atomic<bool> sleeping{ false };
+			std::mutex wakeMutex{};
+			std::condition_variable wake{};
+			std::mutex writeMutex{}; // one thread formats and writes at a time
+			std::mutex initMutex{};
+
+#ifndef IMGUI_DISABLE
+			std::mutex imguiMutex{};
+			LogRing<LogEntry> pendingImGui{ Logger::LOG_BUFFER_CAPACITY }; // written, not yet taken by GetLogBuffer
+#endif
+
+			~LogBackend()
+			{
+				// Shutdown was not called, joining here could deadlock while the module unloads
+				if (writer.joinable()) writer.detach();
+			}
+		};
+
+		LogBackend& GetBackend()
+		{
+			static LogBackend backend{};
+			return backend;
+		}
+
+		void WakeWriter(LogBackend& backend)
+		{
+			if (backend.sleeping.load(std::memory_order_acquire)) backend.wake.notify_one();
+		}
+	}
+
 	// Initialize static members
 	bool Logger::showEngine = true;
 	bool Logger::showUser = true;
 
-	LogLevel Logger::currentLevel = LogLevel::INFO_LOG;
-	bool Logger::isInitialized = false;
-	std::vector<LogEntry> Logger::logBuffer;
+	std::atomic<LogLevel> Logger::currentLevel{ LogLevel::INFO_LOG };
+	std::atomic<bool> Logger::isInitialized{ false };
+	LogRing<LogEntry> Logger::logBuffer{ Logger::LOG_BUFFER_CAPACITY };
 
 	void Logger::Initialize(LogLevel level)
 	{
+		LogBackend& backend = GetBackend();
+		std::lock_guard<std::mutex> lock(backend.initMutex);
 		if (!isInitialized)
 		{
 			currentLevel = level;
+			backend.running = true;
+			backend.writer = std::thread(&Logger::WriterLoop);
 			isInitialized = true;
 		}
 	}
 
+	void Logger::Flush()
+	{
+		LogBackend& backend = GetBackend();
+		if (!backend.running || std::this_thread::get_id() == backend.writer.get_id()) return;
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+		while (!backend.queue.IsEmpty() && std::chrono::steady_clock::now() < deadline)
+		{
+			WakeWriter(backend);
+			std::this_thread::yield();
+		}
+	}
+
+	void Logger::Shutdown()
+	{
+		LogBackend& backend = GetBackend();
+		{
+			std::lock_guard<std::mutex> lock(backend.initMutex);
+			if (!backend.running) return;
+			backend.running = false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(backend.wakeMutex);
+			backend.wake.notify_one();
+		}
+		if (backend.writer.joinable()) backend.writer.join();
+
+		// Messages pushed while the writer was stopping
+		std::lock_guard<std::mutex> lock(backend.writeMutex);
+		WriteQueued();
+		std::cout.flush();
+	}
+
 	void Logger::SetLogLevel(LogLevel level)
 	{
 		currentLevel = level;
@@ -84,20 +167,91 @@ namespace Popplio
 			Initialize(); // Initialize with default values if not done explicitly
 		}
 
-		if (level < currentLevel)
+		if (!IsEnabled(level, isEngine)) return;
+
+		LogRecord record;
+		record.time = std::chrono::system_clock::now();
+		record.level = level;
+		record.destination = dest;
+		record.isEngine = isEngine;
+		LogBackend& backend = GetBackend();
+
+		// Errors are written before returning, in case the program is about to crash
+		if (level >= LogLevel::ERROR_LOG)
 		{
+			std::lock_guard<std::mutex> lock(backend.writeMutex);
+			WriteQueued();
+			Write(record, message);
+			std::cout.flush();
 			return;
 		}
 
-        if (!isEngine && !showUser) return;
-        if (isEngine && !showEngine) return;
+		record.SetText(message);
+
+		// Queue full: the writer is behind, wait for it to free a slot
+		while (backend.running.load(std::memory_order_acquire))
+		{
+			if (backend.queue.TryPush(std::move(record))) // only moved once a slot is claimed
+			{
+				WakeWriter(backend);
+				return;
+			}
+			WakeWriter(backend);
+			std::this_thread::yield();
+		}
+
+		// Writer not running (shut down), write on this thread
+		std::lock_guard<std::mutex> lock(backend.writeMutex);
+		Write(record, message);
+		std::cout.flush();
+	}
+
+	void Logger::WriteQueued()
+	{
+		LogBackend& backend = GetBackend();
+		LogRecord record;
+		while (backend.queue.TryPop(record)) Write(record, record.Text());
+		backend.queue.MarkWritten();
+	}
+
+	void Logger::WriterLoop()
+	{
+		LogBackend& backend = GetBackend();
+		LogRecord record;
+
+		for (;;)
+		{
+			{
+				std::lock_guard<std::mutex> lock(backend.writeMutex);
+				bool wrote = false;
+				while (backend.queue.TryPop(record))
+				{
+					Write(record, record.Text());
+					wrote = true;
+				}
+				if (wrote) std::cout.flush(); // once per batch instead of once per line
+				backend.queue.MarkWritten();
+			}
+
+			if (!backend.running.load(std::memory_order_acquire)) return;
 
-		std::string timestamp = GetCurrentTimestamp();
-		std::string levelStr = LogLevelToString(level);
+			// The timeout covers a message pushed between the check and the wait
+			std::unique_lock<std::mutex> lock(backend.wakeMutex);
+			backend.sleeping = true;
+			backend.wake.wait_for(lock, std::chrono::milliseconds(10),
+				[&backend]() { return !backend.queue.IsEmpty() || !backend.running.load(std::memory_order_acquire); });
+			backend.sleeping = false;
+		}
+	}
 
-        std::string origin = isEngine ? "ENGINE | " : "USER | ";
+	void Logger::Write(LogRecord const& record, std::string_view message)
+	{
+        const char* origin = record.isEngine ? "ENGINE | " : "USER | ";
 
-		std::string logMessage = origin + timestamp + " " + "[" + levelStr + "]" + " " + message;
+		std::string logMessage{};
+		logMessage.reserve(message.size() + 48);
+		logMessage.append(origin).append(FormatTimestamp(record.time))
+			.append(" [").append(LogLevelToString(record.level)).append("] ").append(message);
 
 		// Windows console colors
 		WORD consoleColor = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
@@ -105,7 +259,7 @@ namespace Popplio
 #ifndef IMGUI_DISABLE
 		ImVec4 imguiColor;
 #endif
-		switch (level)
+		switch (record.level)
 		{
 		case LogLevel::DEBUG_LOG:
 			consoleColor = FOREGROUND_INTENSITY | FOREGROUND_BLUE | FOREGROUND_GREEN; // Cyan
@@ -140,63 +294,79 @@ namespace Popplio
 		}
 
 		// Log to Windows console if specified
-		if (dest & LogDestination::WINDOWS_CONSOLE)
+		if (record.destination & LogDestination::WINDOWS_CONSOLE)
 		{
 			LogToWindowsConsole(logMessage, consoleColor);
 		}
 
 #ifndef IMGUI_DISABLE
 		// Log to ImGui if specified
-		if (dest & LogDestination::IMGUI_CONSOLE) {
-			LogToImGui(logMessage, imguiColor, dest);
+		if (record.destination & LogDestination::IMGUI_CONSOLE) {
+			LogToImGui(logMessage, imguiColor, record.destination);
 		}
 #endif // !#ifndef IMGUI_DISABLE
-
-
 	}
 
 	void Logger::LogToWindowsConsole(const std::string& message, unsigned short color)
 	{
 		HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 		SetConsoleTextAttribute(hConsole, color);
-		std::cout << message << std::endl;
+		std::cout << message << '\n';
 		SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE); // Reset color
 	}
 
 #ifndef IMGUI_DISABLE
 	void Logger::LogToImGui(const std::string& message, const ImVec4& color, LogDestination dest)
 	{
-		logBuffer.emplace_back(message, color, dest);
-		if (logBuffer.size() > 1000)
-		{
-			logBuffer.erase(logBuffer.begin());
-		}
+		// Taken into the log buffer by the main thread in GetLogBuffer
+		LogBackend& backend = GetBackend();
+		std::lock_guard<std::mutex> lock(backend.imguiMutex);
+		backend.pendingImGui.Push(LogEntry(message, color, dest));
 	}
 #endif
 
-	const std::vector<LogEntry>& Logger::GetLogBuffer()
+	const LogRing<LogEntry>& Logger::GetLogBuffer()
 	{
+#ifndef IMGUI_DISABLE
+		LogBackend& backend = GetBackend();
+		std::lock_guard<std::mutex> lock(backend.imguiMutex);
+		for (size_t i{}; i < backend.pendingImGui.Size(); ++i) logBuffer.Push(LogEntry(backend.pendingImGui[i]));
+		backend.pendingImGui.Clear();
+#endif
 		return logBuffer;
 	}
 
 	void Logger::ClearLogBuffer()
 	{
-		logBuffer.clear();
+#ifndef IMGUI_DISABLE
+		LogBackend& backend = GetBackend();
+		std::lock_guard<std::mutex> lock(backend.imguiMutex);
+		backend.pendingImGui.Clear();
+#endif
+		logBuffer.Clear();
 	}
 
-	std::string Logger::GetCurrentTimestamp()
+	const std::string& Logger::FormatTimestamp(std::chrono::system_clock::time_point time)
 	{
-		std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+		// Only called with writeMutex held
+		static std::time_t cachedSecond = -1;
+		static std::string cachedText{};
+
+		const std::time_t now = std::chrono::system_clock::to_time_t(time);
+		if (now == cachedSecond) return cachedText;
+
 		char buffer[32];
 
 		struct tm timeinfo;
 		localtime_s(&timeinfo, &now);
 
 		std::strftime(buffer, sizeof(buffer), "%d-%b-%Y %H:%M:%S", &timeinfo);
-		return std::string(buffer);
+		cachedSecond = now;
+		cachedText = buffer;
+		return cachedText;
 	}
 
-	std::string Logger::LogLevelToString(LogLevel level)
+	const char* Logger::LogLevelToString(LogLevel level)
 	{
 		switch (level)
 		{
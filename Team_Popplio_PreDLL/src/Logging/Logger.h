@@ -15,6 +15,12 @@
     ImGui console, with options for different severity levels such as debug, 
     info, warning, error, and critical.
 
+    Messages are queued and written by a background writer thread, so logging
+    does not wait on the console. Errors and critical messages are written on
+    the logging thread right away, after the queued messages, so a crash does
+    not lose them. Use the POPPLIO_LOG_* macros on hot paths,
+    they skip building the message when its level is filtered out.
+
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents
 without the prior written consent of DigiPen Institute of
@@ -31,25 +37,24 @@ Technology is prohibited.
 #include <iomanip>
 #include <mutex>
 #include <vector>
+#include <atomic>
 #include <imgui/imgui.h>
 
+#include "LogQueue.h"
+
+/**
+    * Logs an engine message only if its level is enabled, the message
+    * expression is not evaluated otherwise.
+    * Takes the same arguments as the matching Logger function.
+    */
+#define POPPLIO_LOG_DEBUG(...) do { if (::Popplio::Logger::IsEnabled(::Popplio::LogLevel::DEBUG_LOG)) ::Popplio::Logger::Debug(__VA_ARGS__); } while (false)
+#define POPPLIO_LOG_INFO(...) do { if (::Popplio::Logger::IsEnabled(::Popplio::LogLevel::INFO_LOG)) ::Popplio::Logger::Info(__VA_ARGS__); } while (false)
+#define POPPLIO_LOG_WARNING(...) do { if (::Popplio::Logger::IsEnabled(::Popplio::LogLevel::WARNING_LOG)) ::Popplio::Logger::Warning(__VA_ARGS__); } while (false)
+#define POPPLIO_LOG_ERROR(...) do { if (::Popplio::Logger::IsEnabled(::Popplio::LogLevel::ERROR_LOG)) ::Popplio::Logger::Error(__VA_ARGS__); } while (false)
+#define POPPLIO_LOG_CRITICAL(...) do { if (::Popplio::Logger::IsEnabled(::Popplio::LogLevel::CRITICAL_LOG)) ::Popplio::Logger::Critical(__VA_ARGS__); } while (false)
+
 namespace Popplio
 {
-    enum class LogLevel
-    {
-        DEBUG_LOG,
-        INFO_LOG,
-        WARNING_LOG,
-        ERROR_LOG,
-        CRITICAL_LOG
-    };
-
-    enum class LogDestination
-    {
-        WINDOWS_CONSOLE = 1,
-        IMGUI_CONSOLE = 2,
-        ALL = WINDOWS_CONSOLE | IMGUI_CONSOLE
-    };
 
     struct LogEntry
     {
@@ -83,17 +88,40 @@ namespace Popplio
     class Logger
     {
     public:
+        static constexpr size_t LOG_BUFFER_CAPACITY = 1000; // entries kept for the ImGui console
+        static constexpr size_t LOG_QUEUE_CAPACITY = 8192; // messages waiting for the writer thread
 
         static bool showEngine;
         static bool showUser;
 
         /**
-            * Initializes the Logger with the specified log level
+            * Initializes the Logger with the specified log level and starts the writer thread
             * @param level The log level to set. Default is LogLevel::INFO.
-            * @param useColor Determines whether to use color in the log output. Default is true.
             */
         static void Initialize(LogLevel level = LogLevel::INFO_LOG);
 
+        /**
+            * Waits for the writer thread to write the queued messages, at most half a second.
+            */
+        static void Flush();
+
+        /**
+            * Stops the writer thread after it writes the queued messages.
+            * Messages logged after are written on the calling thread.
+            */
+        static void Shutdown();
+
+        /**
+            * Whether a message of this level would be logged.
+            * @param level The log level of the message.
+            * @param isEngine Whether the message comes from the engine or user scripts.
+            * @return True if the message would be logged.
+            */
+        static bool IsEnabled(LogLevel level, bool isEngine = true)
+        {
+            return level >= currentLevel.load(std::memory_order_relaxed) && (isEngine ? showEngine : showUser);
+        }
+
         /**
             * Sets the log level for the Logger.
             * @param level The log level to set.
@@ -126,21 +154,25 @@ namespace Popplio
 
         /**
             * Logs an error message.
+            * Written on the calling thread after the queued messages, so it is not lost if the program
+            * crashes right after.
             * @param message The message to log.
             */
         static void Error(const std::string& message, LogDestination dest = LogDestination::ALL, bool isEngine = true);
 
         /**
             * Logs a critical message.
+            * Written on the calling thread after the queued messages, like Error.
             * @param message The message to log.
             */
         static void Critical(const std::string& message, LogDestination dest = LogDestination::ALL, bool isEngine = true);
 
         /**
-            * Retrieves the log buffer containing all the logged entries.
+            * Retrieves the log buffer containing the last logged entries, oldest first.
+            * Takes the entries written since the last call, call from the main thread only.
             * @return A constant reference to the log buffer.
             */
-        static const std::vector<LogEntry>& GetLogBuffer();
+        static const LogRing<LogEntry>& GetLogBuffer();
 
         /**
             * Clears the log buffer, removing all logged entries.
@@ -155,6 +187,24 @@ namespace Popplio
             */
         static void Log(LogLevel level, const std::string& message, LogDestination dest, bool isEngine = true);
 
+        /**
+            * Formats a message and writes it to its destinations.
+            * Called by the writer thread, or the logging thread for errors and when the writer is not running.
+            * @param record The message to write.
+            * @param message The text of the message, longer than the record holds for errors.
+            */
+        static void Write(LogRecord const& record, std::string_view message);
+
+        /**
+            * Writes the queued messages on the calling thread, writeMutex must be held.
+            */
+        static void WriteQueued();
+
+        /**
+            * Writes the queued messages until the logger shuts down.
+            */
+        static void WriterLoop();
+
         /**
         * Logs the message to the Windows console with the specified color.
         * @param message The message to log.
@@ -172,21 +222,23 @@ namespace Popplio
         static void LogToImGui(const std::string& message, const ImVec4& color, LogDestination dest);
 #endif
         /**
-            * Gets the current timestamp in the format "YYYY-MM-DD HH:MM:SS".
-            * @return The current timestamp.
+            * Formats a time in the format "DD-Mon-YYYY HH:MM:SS".
+            * The text is reused while the time stays in the same second.
+            * @param time The time to format.
+            * @return The formatted time.
             */
-        static std::string GetCurrentTimestamp();
+        static const std::string& FormatTimestamp(std::chrono::system_clock::time_point time);
 
         /**
             * Converts a log level enum value to its string representation.
             * @param level The log level to convert.
             * @return The string representation of the log level.
             */
-        static std::string LogLevelToString(LogLevel level);
+        static const char* LogLevelToString(LogLevel level);
 
-        static LogLevel currentLevel;
-        static bool isInitialized;
-        static std::vector<LogEntry> logBuffer;
+        static std::atomic<LogLevel> currentLevel;
+        static std::atomic<bool> isInitialized;
+        static LogRing<LogEntry> logBuffer;
     };
 
     /**
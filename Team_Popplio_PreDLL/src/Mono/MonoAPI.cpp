@@ -234,33 +234,52 @@ namespace PopplioScriptAPI
 
         //PrintMemoryStats();
 
-        appDomain = mono_domain_create_appdomain(appDomainName, nullptr);
-
-        mono_domain_set(appDomain, true);
-
-        //PrintMemoryStats();
-
-        assembly = LoadCSAssembly(POPPLIO_ASSEMBLY_PATH); // load ass path here
-
-        if (assembly == nullptr)
+        PreparedAssembly prepared{};
+        if (!PrepareAssembly(POPPLIO_ASSEMBLY_PATH, prepared)) // load ass path here
         {
             std::stringstream ss;
             ss << "PopplioScriptAPI::MonoAPI | Failed to initialize Mono assembly";
 
             Popplio::Logger::Error(ss.str()); // print to logger
+
+            // keep the empty app domain current, it is unloaded with the next reload
+            appDomain = prepared.appDomain;
+            mono_domain_set(appDomain, true);
             //std::filesystem::current_path(currPath);
             return;
         }
 
-        image = mono_assembly_get_image(assembly);
+        AdoptAssembly(prepared);
 
-        // init utilities
-        MonoUtilInit(this);
+        //std::filesystem::current_path(currPath);
+    }
+
+    bool MonoAPI::PrepareAssembly(std::string const& path, PreparedAssembly& prepared)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        MonoDomain* previous = mono_domain_get();
+
+        prepared.appDomain = mono_domain_create_appdomain(appDomainName, nullptr);
+
+        mono_domain_set(prepared.appDomain, false);
+
+        //PrintMemoryStats();
+
+        prepared.assembly = LoadCSAssembly(path);
+
+        if (prepared.assembly == nullptr)
+        {
+            mono_domain_set(previous, false);
+            return false;
+        }
+
+        prepared.image = mono_assembly_get_image(prepared.assembly);
 
         //mono_jit_exec(domain, assembly, 0, nullptr);
 
         // get loaded classes //
-        MonoTableInfo const* typeTable = mono_image_get_table_info(&GetImage(), MONO_TABLE_TYPEDEF); // get table of types
+        MonoTableInfo const* typeTable = mono_image_get_table_info(prepared.image, MONO_TABLE_TYPEDEF); // get table of types
         int rows = mono_table_info_get_rows(typeTable); // get num of rows
 
         std::string name{ "" };
@@ -269,9 +288,12 @@ namespace PopplioScriptAPI
         {
             uint32_t cols[MONO_TYPEDEF_SIZE]; // get cols
             mono_metadata_decode_row(typeTable, i, cols, MONO_TYPEDEF_SIZE); // decode row
-            char const* typeNamespace = mono_metadata_string_heap(&GetImage(), cols[MONO_TYPEDEF_NAMESPACE]); // get namespace
-            char const* typeName = mono_metadata_string_heap(&GetImage(), cols[MONO_TYPEDEF_NAME]); // get name
-            MonoClass* classObj{ GetAssClass(typeNamespace, typeName) }; // get class
+            char const* typeNamespace = mono_metadata_string_heap(prepared.image, cols[MONO_TYPEDEF_NAMESPACE]); // get namespace
+            char const* typeName = mono_metadata_string_heap(prepared.image, cols[MONO_TYPEDEF_NAME]); // get name
+            MonoClass* classObj{ mono_class_from_name(prepared.image, typeNamespace, typeName) }; // get class
+
+            // load the fields and methods now instead of on first use
+            if (classObj != nullptr) mono_class_init(classObj);
 
             name = typeNamespace;
 
@@ -279,20 +301,47 @@ namespace PopplioScriptAPI
 
             if (name == POPPLIO_PROJECT_NAMESPACE)
             {
-                loadedUserClasses.push_back(classObj);
-                loadedUserClassNames.push_back({ typeNamespace, typeName });
+                prepared.userClasses.push_back(classObj);
+                prepared.userClassNames.push_back({ typeNamespace, typeName });
             }
             else if (name == POPPLIO_CORE)
             {
-                loadedEngineClasses.push_back(classObj);
-                loadedEngineClassNames.push_back({ typeNamespace, typeName });
+                prepared.engineClasses.push_back(classObj);
+                prepared.engineClassNames.push_back({ typeNamespace, typeName });
             }
 
-            loadedClasses.push_back(classObj);
-            loadedClassNames.push_back({ typeNamespace, typeName });
+            prepared.classes.push_back(classObj);
+            prepared.classNames.push_back({ typeNamespace, typeName });
         }
         // get loaded classes //
 
+        mono_domain_set(previous, false);
+
+        prepared.prepareMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    void MonoAPI::AdoptAssembly(PreparedAssembly& prepared)
+    {
+        appDomain = prepared.appDomain;
+
+        mono_domain_set(appDomain, true);
+
+        assembly = prepared.assembly;
+        image = prepared.image;
+        ++assemblyGeneration; // cached classes / methods / thunks are now stale
+
+        // init utilities
+        MonoUtilInit(this);
+
+        loadedClasses = std::move(prepared.classes);
+        loadedEngineClasses = std::move(prepared.engineClasses);
+        loadedUserClasses = std::move(prepared.userClasses);
+
+        loadedClassNames = std::move(prepared.classNames);
+        loadedEngineClassNames = std::move(prepared.engineClassNames);
+        loadedUserClassNames = std::move(prepared.userClassNames);
+
         // Load Native Library
         //MonoObject* obj{ InstLifeClass("Team_Popplio", "PopplioNativeInterop") };
         //CallMethod(obj, "Init");
@@ -331,6 +380,8 @@ namespace PopplioScriptAPI
     {
         if (!domain) return;
 
+        StopObserving();
+
         loadedUserClasses.clear();
         loadedEngineClasses.clear();
         loadedClasses.clear();
@@ -477,6 +528,12 @@ namespace PopplioScriptAPI
         uint32_t fSize = 0;
         char* fData = GetFileAsBytes(path, &fSize); // read bytes into buffer
 
+        if (fData == nullptr) // missing, empty or locked by the build
+        {
+            Popplio::Logger::Error("PopplioScriptAPI::MonoAPI | Failed to read assembly: " + path);
+            return nullptr;
+        }
+
         MonoImageOpenStatus status;
         MonoImage* loadImage = mono_image_open_from_data_full(fData, fSize, 1, &status, 0); // load ass
         // return nullptr if failed, otherwise returns valid pointer to an image    
@@ -663,6 +720,31 @@ namespace PopplioScriptAPI
         }
     }
 
+    MonoMethod* MonoAPI::GetOverride(MonoClass* derived, MonoClass* base, char const* methodName, int paramCount)
+    {
+        if (!base || !derived) return nullptr;
+
+        // searches derived then its parents, so this is the method derived runs
+        MonoMethod* method = mono_class_get_method_from_name(derived, methodName, paramCount);
+
+        if (method == nullptr || mono_method_get_class(method) == base) return nullptr;
+
+        return method;
+    }
+
+    void MonoAPI::LogThunkException(MonoMethod* method, MonoException* except)
+    {
+        MonoClass* classObj{ mono_method_get_class(method) };
+
+        std::stringstream ss{ "" };
+
+        ss << "PopplioScriptAPI::MonoAPI | Method returned exception: " <<
+            mono_class_get_namespace(classObj) << "::" << mono_class_get_name(classObj) << "." << 
+            mono_method_get_name(method) << " | " << GetExceptionMessage(reinterpret_cast<MonoObject*>(except));
+
+        Popplio::Logger::Error(ss.str());
+    }
+
     void MonoAPI::CallMethod(MonoObject* obj, char const* methodName) // invoke c# method
     {
         if (!IsObjValid(obj)) // check if obj is valid
@@ -41,9 +41,13 @@ Technology is prohibited.
 #include "../Utilities/Constants.h"
 #include "MonoUtilities.h"
 
+#include <atomic>
 #include <cstdarg>
 #include <type_traits>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // +++++++++++++++++++++++++++++++++++++ //
 
@@ -66,11 +70,28 @@ Technology is prohibited.
 #define POPPLIO_UTIL_NAMESPACE      "PopplioUtil"               // engine util namespace
 
 #define POPPLIO_ASSEMBLY_RELOAD_INTERVAL 10                     // hot reload interval in seconds
+#define POPPLIO_ASSEMBLY_RELOAD_DEBOUNCE 500                    // hot reload quiet time after the last change in ms
 
 // +++++++++++++++++++++++++++++++++++++ //
 
 namespace PopplioScriptAPI
 {
+    /*
+    *   C# method resolved once with its unmanaged thunk, called directly without boxing arguments
+    *   Args are the C# parameters, preceded by the MonoObject* for instance methods
+    *   invalid once the assembly it came from is unloaded (see MonoAPI::GetAssemblyGeneration)
+    */
+    template <typename... Args>
+    struct MonoThunk
+    {
+        using Function = void(*)(Args..., MonoException**);
+
+        MonoMethod* method{ nullptr };
+        Function function{ nullptr };
+
+        explicit operator bool() const { return function != nullptr; }
+    };
+
     class MonoAPI
     {
         // data //
@@ -84,6 +105,8 @@ namespace PopplioScriptAPI
         MonoAssembly* assembly;
         MonoImage* image;
 
+        unsigned assemblyGeneration{}; // incremented each time the assembly is loaded
+
         // +++++++++ //
 
         // garbage collection
@@ -114,6 +137,60 @@ namespace PopplioScriptAPI
         // registry
         Popplio::Registry& registry;
 
+        // +++++++++ //
+
+        // hot reload
+
+        // app domain with the assembly loaded and its classes initialized, waiting to be swapped in
+        struct PreparedAssembly
+        {
+            MonoDomain* appDomain{ nullptr };
+            MonoAssembly* assembly{ nullptr };
+            MonoImage* image{ nullptr };
+
+            std::vector<MonoClass*> classes{};
+            std::vector<MonoClass*> engineClasses{};
+            std::vector<MonoClass*> userClasses{};
+
+            std::vector<std::pair<std::string, std::string>> classNames{};
+            std::vector<std::pair<std::string, std::string>> engineClassNames{};
+            std::vector<std::pair<std::string, std::string>> userClassNames{};
+
+            double prepareMs{};
+        };
+
+        std::thread observerThread{};
+        std::atomic<bool> observing{ false };
+        std::atomic<bool> prepareRequested{ false };
+
+        std::mutex reloadMutex{}; // guards preparedAssembly and domainsToUnload
+        std::unique_ptr<PreparedAssembly> preparedAssembly{};
+        std::vector<MonoDomain*> domainsToUnload{}; // swapped out, unloaded by the observer thread
+
+        double lastPrepareMs{};
+        double lastSwapMs{};
+
+        /*
+        *   creates an app domain, loads the assembly into it and lists / initializes its classes
+        *   can run on any thread attached to mono, the calling thread's domain is left unchanged
+        */
+        bool PrepareAssembly(std::string const& path, PreparedAssembly& prepared);
+
+        /*
+        *   makes a prepared domain the current app domain, main thread only
+        */
+        void AdoptAssembly(PreparedAssembly& prepared);
+
+        /*
+        *   observer thread loop, waits for changes to the assembly directory
+        */
+        void ObserveAssembly(std::filesystem::path path);
+
+        /*
+        *   unloads the swapped out domains and the prepared domain if discard is set
+        */
+        void UnloadStaleDomains(bool discardPrepared);
+
         // +++++++++++++++++++++++++++++++++++++ //
 
         public:
@@ -199,6 +276,10 @@ namespace PopplioScriptAPI
         MonoDomain& GetAppDomain() { return *appDomain; }
         MonoAssembly& GetAssembly() { return *assembly; }
         MonoImage& GetImage() { return *image; }
+        /*
+        *   assembly load count, classes / methods / thunks from an older generation are invalid
+        */
+        unsigned GetAssemblyGeneration() const { return assemblyGeneration; }
         std::vector<MonoClass*> const& GetLoadedClasses() const { return loadedClasses; }
         std::vector<MonoClass*> const& GetLoadedUserClasses() const { return loadedUserClasses; }
         std::vector<MonoClass*> const& GetLoadedEngineClasses() const { return loadedEngineClasses; }
@@ -363,6 +444,29 @@ namespace PopplioScriptAPI
         */
         template <typename T>
         T CallThunk(MonoClass* classObj, char const* methodName, char const* signature);
+
+        /*
+        *   get thunk of a resolved method, empty if method is nullptr
+        */
+        template <typename... Args>
+        MonoThunk<Args...> GetMethodThunk(MonoMethod* method);
+
+        /*
+        *   get method of class overriding a virtual method of base, nullptr if class does not override it
+        */
+        MonoMethod* GetOverride(MonoClass* derived, MonoClass* base, char const* methodName, int paramCount);
+
+        /*
+        *   call thunk, logs the exception if the method threw
+        *   returns false if thunk is empty or the method threw
+        */
+        template <typename... Args, typename... Params>
+        bool CallThunk(MonoThunk<Args...> const& thunk, Params&&... params);
+
+        /*
+        *   log exception returned by a thunk
+        */
+        void LogThunkException(MonoMethod* method, MonoException* except);
         
         // ++++++++++ //
 
@@ -656,13 +760,43 @@ namespace PopplioScriptAPI
 
         /*
         *   reload the mono assembly
+        *   swaps in the assembly prepared by hot reload instead if one is waiting
         */
         void ReloadAssembly();
 
         /*
-        *   starts observing for changes in C# script code
+        *   starts observing for changes in C# script code on a thread
+        *   a change is debounced, then the new app domain is prepared on that thread for ApplyPreparedAssembly
         */
         void StartObserving();
+
+        /*
+        *   stops observing, unloading a prepared domain that was not applied
+        */
+        void StopObserving();
+
+        /*
+        *   asks the observer thread to prepare the assembly without waiting for a change
+        */
+        void RequestPrepare();
+
+        /*
+        *   whether an assembly is prepared and waiting for ApplyPreparedAssembly
+        */
+        bool IsAssemblyPrepared();
+
+        /*
+        *   swaps the prepared assembly in, call from the main thread between frames while no scripts run
+        *   the swapped out domain is unloaded by the observer thread
+        *   returns whether an assembly was swapped in
+        */
+        bool ApplyPreparedAssembly();
+
+        /*
+        *   time taken by the last preparation (observer thread) and swap (main thread) in ms
+        */
+        double GetLastPrepareMs() const { return lastPrepareMs; }
+        double GetLastSwapMs() const { return lastSwapMs; }
     };
 }
 
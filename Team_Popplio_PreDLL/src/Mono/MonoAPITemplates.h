@@ -183,6 +183,33 @@ namespace PopplioScriptAPI
         }
     }
 
+    template <typename... Args>
+    MonoThunk<Args...> MonoAPI::GetMethodThunk(MonoMethod* method)
+    {
+        MonoThunk<Args...> thunk{};
+        if (method == nullptr) return thunk;
+
+        thunk.method = method;
+        thunk.function = reinterpret_cast<typename MonoThunk<Args...>::Function>(mono_method_get_unmanaged_thunk(method));
+
+        return thunk;
+    }
+
+    template <typename... Args, typename... Params>
+    bool MonoAPI::CallThunk(MonoThunk<Args...> const& thunk, Params&&... params)
+    {
+        if (!thunk) return false;
+
+        MonoException* except{ nullptr }; // exception
+
+        thunk.function(std::forward<Params>(params)..., &except);
+
+        if (except == nullptr) return true;
+
+        LogThunkException(thunk.method, except);
+        return false;
+    }
+
     // +++++++++++++++++++++++++++++++++++++ //
 
     // Method
@@ -12,6 +12,10 @@
 
         Enables hot reload compile for C# scripts in the engine with mono
 
+        An observer thread waits for changes to the assembly, prepares a new
+        app domain with it once the writes stop and the main thread swaps it
+        in between frames
+
         Extension of MonoAPI in PopplioScriptAPI
 
 Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
@@ -26,12 +30,16 @@ Technology is prohibited.
 #include "MonoAPI.h"
 
 #include "../Logging/Logger.h"
+#include "../PerformanceViewer/Profiler.h"
 
 #include <mono/metadata/debug-helpers.h>
+#include <mono/metadata/threads.h>
 #include <filesystem>
 #include <thread>
 #include <chrono>
 
+#include <Windows.h>
+
 namespace PopplioScriptAPI
 {
     void MonoAPI::UnloadAssembly()
@@ -64,6 +72,9 @@ namespace PopplioScriptAPI
     {
         try
         {
+            // the observer thread already prepared the new domain, only the swap is left
+            if (ApplyPreparedAssembly()) return;
+
             Popplio::Logger::Info("PopplioScriptAPI::MonoAPI | Reloading Mono...");
 
             UnloadAssembly();
@@ -85,26 +96,165 @@ namespace PopplioScriptAPI
 
     void MonoAPI::StartObserving()
     {
-        std::thread observerThread
-        ([&]()
+        if (!hotReloadEnabled || observing) return;
+
+        observing = true;
+        observerThread = std::thread(&MonoAPI::ObserveAssembly, this, std::filesystem::absolute(assemblyPath));
+    }
+
+    void MonoAPI::StopObserving()
+    {
+        observing = false;
+        if (observerThread.joinable()) observerThread.join();
+
+        UnloadStaleDomains(true);
+    }
+
+    void MonoAPI::RequestPrepare()
+    {
+        prepareRequested = true;
+    }
+
+    bool MonoAPI::IsAssemblyPrepared()
+    {
+        std::lock_guard<std::mutex> lock(reloadMutex);
+        return preparedAssembly != nullptr;
+    }
+
+    bool MonoAPI::ApplyPreparedAssembly()
+    {
+        std::unique_ptr<PreparedAssembly> prepared{};
+        {
+            std::lock_guard<std::mutex> lock(reloadMutex);
+            prepared = std::move(preparedAssembly);
+        }
+        if (!prepared) return false;
+
+        POPPLIO_PROFILE_ZONE("mono hot reload swap");
+        auto start = std::chrono::steady_clock::now();
+
+        // script objects of the old domain
+        ClearAllGC();
+
+        MonoDomain* previous = appDomain;
+        AdoptAssembly(*prepared);
+
+        {
+            std::lock_guard<std::mutex> lock(reloadMutex);
+            domainsToUnload.push_back(previous);
+        }
+        if (!observing) UnloadStaleDomains(false); // no observer thread to unload it
+
+        lastPrepareMs = prepared->prepareMs;
+        lastSwapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::stringstream ss{ "" };
+        ss << std::fixed << std::setprecision(3) << "PopplioScriptAPI::MonoAPI | Hot reloaded assembly, prepared in "
+            << lastPrepareMs << " ms off the main thread, swapped in " << lastSwapMs << " ms";
+        Popplio::Logger::Info(ss.str());
+
+        return true;
+    }
+
+    void MonoAPI::ObserveAssembly(std::filesystem::path path)
+    {
+        Popplio::Profiler::SetThreadName("Mono Hot Reload");
+        mono_thread_attach(mono_get_root_domain());
+
+        // signalled on writes / renames in the assembly directory
+        HANDLE change = FindFirstChangeNotificationW(path.parent_path().wstring().c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+        if (change == INVALID_HANDLE_VALUE)
+            Popplio::Logger::Error("PopplioScriptAPI::MonoAPI | Failed to observe " + path.parent_path().string() + " for hot reload");
+
+        bool changed = false;
+        int retries{};
+        auto lastChange = std::chrono::steady_clock::now();
+
+        while (observing)
+        {
+            // wakes on a change or every 100 ms to check the flags
+            if (change == INVALID_HANDLE_VALUE) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            else if (WaitForSingleObject(change, 100) == WAIT_OBJECT_0)
             {
-                while (hotReloadEnabled)
-                {
-                    Popplio::Logger::Debug("PopplioScriptAPI::MonoAPI | Observing assembly for hot reload");
-                    auto currModified = std::filesystem::last_write_time(assemblyPath); // get current modified time
+                changed = true;
+                lastChange = std::chrono::steady_clock::now();
+                FindNextChangeNotification(change);
+            }
+
+            UnloadStaleDomains(false);
+
+            if (!prepareRequested.exchange(false))
+            {
+                // a build writes the assembly several times, wait until the writes stop
+                if (!changed || std::chrono::steady_clock::now() - lastChange <
+                    std::chrono::milliseconds(POPPLIO_ASSEMBLY_RELOAD_DEBOUNCE)) continue;
+                changed = false;
+
+                std::error_code error{};
+                auto currModified = std::filesystem::last_write_time(path, error); // get current modified time
+                if (error || currModified == lastModified) continue; // another file in the directory changed
+                lastModified = currModified; // set new modified time
+            }
+
+            auto prepared = std::make_unique<PreparedAssembly>();
+            bool success{};
+            {
+                POPPLIO_PROFILE_ZONE("mono hot reload prepare");
+                success = PrepareAssembly(path.string(), *prepared);
+            }
 
-                    if (currModified != lastModified) // modified
-                    {
-                        ReloadAssembly(); // reload assembly
-                        lastModified = currModified; // set new modified time
-                    }
+            if (!success)
+            {
+                std::lock_guard<std::mutex> lock(reloadMutex);
+                domainsToUnload.push_back(prepared->appDomain);
 
-                    std::this_thread::sleep_for(std::chrono::seconds(observeInterval)); // sleep for ___ seconds
+                // the assembly may still be locked by the build, try again after the debounce
+                if (retries++ < 3)
+                {
+                    changed = true;
+                    lastChange = std::chrono::steady_clock::now();
+                    lastModified = std::filesystem::file_time_type{};
                 }
+                else Popplio::Logger::Error("PopplioScriptAPI::MonoAPI | Failed to prepare assembly for hot reload");
+                continue;
             }
-        );
+            retries = 0;
 
-        observerThread.detach(); // detach thread
+            std::stringstream ss{ "" };
+            ss << std::fixed << std::setprecision(3) << "PopplioScriptAPI::MonoAPI | Prepared assembly for hot reload in "
+                << prepared->prepareMs << " ms";
+            Popplio::Logger::Info(ss.str());
+
+            std::lock_guard<std::mutex> lock(reloadMutex);
+            if (preparedAssembly) domainsToUnload.push_back(preparedAssembly->appDomain); // never applied
+            preparedAssembly = std::move(prepared);
+        }
+
+        if (change != INVALID_HANDLE_VALUE) FindCloseChangeNotification(change);
+
+        UnloadStaleDomains(false);
+        mono_thread_detach(mono_thread_current());
+    }
+
+    void MonoAPI::UnloadStaleDomains(bool discardPrepared)
+    {
+        std::vector<MonoDomain*> domains{};
+        {
+            std::lock_guard<std::mutex> lock(reloadMutex);
+            domains.swap(domainsToUnload);
+
+            if (discardPrepared && preparedAssembly)
+            {
+                domains.push_back(preparedAssembly->appDomain);
+                preparedAssembly.reset();
+            }
+        }
+
+        for (MonoDomain* stale : domains)
+        {
+            if (stale != nullptr) mono_domain_unload(stale);
+        }
     }
 
     //void MonoAPI::ReloadAssembly()
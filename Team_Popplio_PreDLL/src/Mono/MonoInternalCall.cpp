@@ -50,6 +50,7 @@ Technology is prohibited.
 #include "../Hierarchy/HierarchySystem.h"
 #include "../Camera/CameraManager.h"
 #include "../Particles/ParticleSystem.h"
+#include "../Graphic/RenderSystem.h"
 
 #include <mono/jit/jit.h>
 #include <mono/metadata/debug-helpers.h>
@@ -219,6 +220,8 @@ namespace PopplioScriptAPI
         mono_add_internal_call("Team_Popplio.ECS.Entity::BelongsToGroup", PopplioECS::BelongsToGroup);
         //mono_add_internal_call("Team_Popplio.ECS.Entity::GetId", PopplioECS::GetId);
         mono_add_internal_call("Team_Popplio.ECS.Entity::Exists", PopplioECS::Exists);
+        mono_add_internal_call("Team_Popplio.ECS.Entity::GetHandle", PopplioECS::GetHandle);
+        mono_add_internal_call("Team_Popplio.ECS.Entity::IsAlive", PopplioECS::IsAlive);
         //mono_add_internal_call("Team_Popplio.ECS.Entity::OnScriptDestroy", PopplioECS::OnScriptDestroy);
 
         // C# API //
@@ -265,6 +268,8 @@ namespace PopplioScriptAPI
         mono_add_internal_call("Team_Popplio.Components.Transform2D::SetScaleY", PopplioComponentTrans::SetScaleY);
         mono_add_internal_call("Team_Popplio.Components.Transform2D::GetRotation", PopplioComponentTrans::GetRotation);
         mono_add_internal_call("Team_Popplio.Components.Transform2D::SetRotation", PopplioComponentTrans::SetRotation);
+        mono_add_internal_call("Team_Popplio.Components.Transform2D::GetTransforms", PopplioComponentTrans::GetTransforms);
+        mono_add_internal_call("Team_Popplio.Components.Transform2D::SetTransforms", PopplioComponentTrans::SetTransforms);
 
         // Graphic/GraphicComponent.h // Render Component
         mono_add_internal_call("Team_Popplio.Components.Render2D::GetColorR", PopplioComponentRender::GetColorR);
@@ -309,6 +314,8 @@ namespace PopplioScriptAPI
         mono_add_internal_call("Team_Popplio.Components.RigidBody2D::SetUseGravity", PopplioComponentRB::SetUseGravity);
         mono_add_internal_call("Team_Popplio.Components.RigidBody2D::GetDragCoefficient", PopplioComponentRB::GetDragCoefficient);
         mono_add_internal_call("Team_Popplio.Components.RigidBody2D::SetDragCoefficient", PopplioComponentRB::SetDragCoefficient);
+        mono_add_internal_call("Team_Popplio.Components.RigidBody2D::GetRigidBodies", PopplioComponentRB::GetRigidBodies);
+        mono_add_internal_call("Team_Popplio.Components.RigidBody2D::SetRigidBodies", PopplioComponentRB::SetRigidBodies);
 
         // Collision/BoxColliderComponent.h //
         mono_add_internal_call("Team_Popplio.Components.BoxCollider2D::GetSizeX", PopplioComponentBoxCollider::GetSizeX);
@@ -1818,6 +1825,15 @@ namespace PopplioScriptAPI
             {
                 return reg->EntityExists(instance);
             }
+            static uint64_t GetHandle(int instance)
+            {
+                if (!reg->EntityExists(instance)) return Popplio::INVALID_ENTITY_HANDLE;
+                return Popplio::MakeEntityHandle(instance, reg->GetEntityGeneration(instance));
+            }
+            static bool IsAlive(uint64_t handle)
+            {
+                return reg->IsAlive(handle);
+            }
             //static void OnScriptDestroy(int instance)
             //{
             //    reg->GetSystem<Popplio::LogicSystem>().CSRemoveScriptObj(instance);
@@ -1846,7 +1862,8 @@ namespace PopplioScriptAPI
                     int newId = reg->GetSystem<Popplio::RuntimeSystem>().InstantiateEntity(entity);
                     event->EmitEvent<Popplio::EntityRuntimeChangeEvent>(Popplio::EntityRuntimeChangeEvent::Change::ADDED, newId);
                    
-                    //reg->RuntimeUpdate(reg->GetEntityById(newId));
+                    // scripts use the clone and its children right away, add them to their systems now
+                    reg->Update();
                     if (!reg->EntityExists(newId)) Popplio::Logger::Error("MonoInternalCall.cpp | InstEnt : Entity does not exist");
                     return newId;
                 }
@@ -2076,6 +2093,14 @@ namespace PopplioScriptAPI
 
     namespace PopplioComponentTrans
     {
+        static void UpdateParentedTransform(Popplio::Entity const& entity, Popplio::TransformComponent const& transform)
+        {
+            Popplio::ParentComponent* parent = reg->TryGetComponent<Popplio::ParentComponent>(entity);
+            if (parent == nullptr || !parent->parent.Exists() || !parent->inheritTransform) return;
+
+            parent->UpdateLocalTransform(transform, parent->parent.GetComponent<Popplio::TransformComponent>());
+        }
+
         extern "C" // Transform Component
         {
             static float GetPositionX(int instance)
@@ -2086,14 +2111,7 @@ namespace PopplioScriptAPI
             {
                 auto entity = reg->GetEntityById(instance);
                 entity.GetComponent<Popplio::TransformComponent>().position.x = value;
-                if (entity.HasComponent<Popplio::ParentComponent>() &&
-                    entity.GetComponent<Popplio::ParentComponent>().parent.Exists() &&
-                    entity.GetComponent<Popplio::ParentComponent>().inheritTransform)
-                {
-                    entity.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
-                        entity.GetComponent<Popplio::TransformComponent>(),
-                        entity.GetComponent<Popplio::ParentComponent>().parent.GetComponent<Popplio::TransformComponent>());
-                }
+                UpdateParentedTransform(entity, entity.GetComponent<Popplio::TransformComponent>());
             }
             static float GetPositionY(int instance)
             {
@@ -2103,14 +2121,7 @@ namespace PopplioScriptAPI
             {
                 auto entity = reg->GetEntityById(instance);
                 entity.GetComponent<Popplio::TransformComponent>().position.y = value;
-                if (entity.HasComponent<Popplio::ParentComponent>() &&
-                    entity.GetComponent<Popplio::ParentComponent>().parent.Exists() &&
-                    entity.GetComponent<Popplio::ParentComponent>().inheritTransform)
-                {
-                    entity.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
-                        entity.GetComponent<Popplio::TransformComponent>(),
-                        entity.GetComponent<Popplio::ParentComponent>().parent.GetComponent<Popplio::TransformComponent>());
-                }
+                UpdateParentedTransform(entity, entity.GetComponent<Popplio::TransformComponent>());
             }
             static float GetScaleX(int instance)
             {
@@ -2120,14 +2131,7 @@ namespace PopplioScriptAPI
             {
                 auto entity = reg->GetEntityById(instance);
                 entity.GetComponent<Popplio::TransformComponent>().scale.x = value;
-                if (entity.HasComponent<Popplio::ParentComponent>() &&
-                    entity.GetComponent<Popplio::ParentComponent>().parent.Exists() &&
-                    entity.GetComponent<Popplio::ParentComponent>().inheritTransform)
-                {
-                    entity.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
-                        entity.GetComponent<Popplio::TransformComponent>(),
-                        entity.GetComponent<Popplio::ParentComponent>().parent.GetComponent<Popplio::TransformComponent>());
-                }
+                UpdateParentedTransform(entity, entity.GetComponent<Popplio::TransformComponent>());
             }
             static float GetScaleY(int instance)
             {
@@ -2137,14 +2141,7 @@ namespace PopplioScriptAPI
             {
                 auto entity = reg->GetEntityById(instance);
                 entity.GetComponent<Popplio::TransformComponent>().scale.y = value;
-                if (entity.HasComponent<Popplio::ParentComponent>() &&
-                    entity.GetComponent<Popplio::ParentComponent>().parent.Exists() &&
-                    entity.GetComponent<Popplio::ParentComponent>().inheritTransform)
-                {
-                    entity.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
-                        entity.GetComponent<Popplio::TransformComponent>(),
-                        entity.GetComponent<Popplio::ParentComponent>().parent.GetComponent<Popplio::TransformComponent>());
-                }
+                UpdateParentedTransform(entity, entity.GetComponent<Popplio::TransformComponent>());
             }
             static double GetRotation(int instance)
             {
@@ -2154,14 +2151,47 @@ namespace PopplioScriptAPI
             {
                 auto entity = reg->GetEntityById(instance);
                 entity.GetComponent<Popplio::TransformComponent>().rotation = value;
-                if (entity.HasComponent<Popplio::ParentComponent>() &&
-                    entity.GetComponent<Popplio::ParentComponent>().parent.Exists() &&
-                    entity.GetComponent<Popplio::ParentComponent>().inheritTransform)
+                UpdateParentedTransform(entity, entity.GetComponent<Popplio::TransformComponent>());
+            }
+
+            static int GetTransforms(int const* instances, TransformData* data, int count)
+            {
+                int copied{};
+                for (int i{}; i < count; ++i)
+                {
+                    if (!reg->EntityExists(instances[i])) continue;
+                    Popplio::TransformComponent const* transform =
+                        reg->TryGetComponent<Popplio::TransformComponent>(reg->GetEntityById(instances[i]));
+                    if (transform == nullptr) continue;
+
+                    data[i].positionX = transform->position.x;
+                    data[i].positionY = transform->position.y;
+                    data[i].scaleX = transform->scale.x;
+                    data[i].scaleY = transform->scale.y;
+                    data[i].rotation = transform->rotation;
+                    ++copied;
+                }
+                return copied;
+            }
+            static int SetTransforms(int const* instances, TransformData const* data, int count)
+            {
+                int written{};
+                for (int i{}; i < count; ++i)
                 {
-                    entity.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
-                        entity.GetComponent<Popplio::TransformComponent>(),
-                        entity.GetComponent<Popplio::ParentComponent>().parent.GetComponent<Popplio::TransformComponent>());
+                    if (!reg->EntityExists(instances[i])) continue;
+                    Popplio::Entity entity = reg->GetEntityById(instances[i]);
+                    Popplio::TransformComponent* transform = reg->TryGetComponent<Popplio::TransformComponent>(entity);
+                    if (transform == nullptr) continue;
+
+                    transform->position.x = data[i].positionX;
+                    transform->position.y = data[i].positionY;
+                    transform->scale.x = data[i].scaleX;
+                    transform->scale.y = data[i].scaleY;
+                    transform->rotation = data[i].rotation;
+                    UpdateParentedTransform(entity, *transform);
+                    ++written;
                 }
+                return written;
             }
         }
     }
@@ -2211,6 +2241,7 @@ namespace PopplioScriptAPI
             static void SetMeshType(int instance, int value)
             {
                 reg->GetEntityById(instance).GetComponent<Popplio::RenderComponent>().meshType = static_cast<Popplio::MeshType>(value);
+                reg->GetSystem<Popplio::RenderSystem>().ReclassifyForCulling(reg->GetEntityById(instance));
             }
             static bool GetActive(int instance)
             {
@@ -2347,6 +2378,57 @@ namespace PopplioScriptAPI
             {
                 reg->GetEntityById(instance).GetComponent<Popplio::RigidBodyComponent>().dragCoefficient = value;
             }
+
+            static int GetRigidBodies(int const* instances, RigidBodyData* data, int count)
+            {
+                int copied{};
+                for (int i{}; i < count; ++i)
+                {
+                    if (!reg->EntityExists(instances[i])) continue;
+                    Popplio::RigidBodyComponent const* body =
+                        reg->TryGetComponent<Popplio::RigidBodyComponent>(reg->GetEntityById(instances[i]));
+                    if (body == nullptr) continue;
+
+                    data[i].velocityX = body->velocity.x;
+                    data[i].velocityY = body->velocity.y;
+                    data[i].accelerationX = body->acceleration.x;
+                    data[i].accelerationY = body->acceleration.y;
+                    data[i].forceX = body->force.x;
+                    data[i].forceY = body->force.y;
+                    data[i].mass = body->mass;
+                    data[i].gravityScale = body->gravityScale;
+                    data[i].dragCoefficient = body->dragCoefficient;
+                    data[i].active = body->isActive ? 1 : 0;
+                    data[i].useGravity = body->useGravity ? 1 : 0;
+                    ++copied;
+                }
+                return copied;
+            }
+            static int SetRigidBodies(int const* instances, RigidBodyData const* data, int count)
+            {
+                int written{};
+                for (int i{}; i < count; ++i)
+                {
+                    if (!reg->EntityExists(instances[i])) continue;
+                    Popplio::RigidBodyComponent* body =
+                        reg->TryGetComponent<Popplio::RigidBodyComponent>(reg->GetEntityById(instances[i]));
+                    if (body == nullptr) continue;
+
+                    body->velocity.x = data[i].velocityX;
+                    body->velocity.y = data[i].velocityY;
+                    body->acceleration.x = data[i].accelerationX;
+                    body->acceleration.y = data[i].accelerationY;
+                    body->force.x = data[i].forceX;
+                    body->force.y = data[i].forceY;
+                    body->mass = data[i].mass;
+                    body->gravityScale = data[i].gravityScale;
+                    body->dragCoefficient = data[i].dragCoefficient;
+                    body->isActive = data[i].active != 0;
+                    body->useGravity = data[i].useGravity != 0;
+                    ++written;
+                }
+                return written;
+            }
         }
     }
 
@@ -3371,7 +3453,7 @@ namespace PopplioScriptAPI
             {
                 MonoToString(name, strMS);
                 std::optional<Popplio::Entity> ent = prefab->InstantiatePrefab(*reg, strMS);
-                //if (ent != std::nullopt) reg->RuntimeUpdate(ent.value());
+                if (ent != std::nullopt) reg->Update(); // scripts use the instance right away
                 if (ent == std::nullopt) return -1;
                 else return ent->GetId();
             }
@@ -3391,6 +3473,7 @@ namespace PopplioScriptAPI
             static void SetUIType(int instance, int value)
             {
                 reg->GetEntityById(instance).GetComponent<Popplio::UIComponent>().type = static_cast<Popplio::UIType>(value);
+                reg->GetSystem<Popplio::RenderSystem>().ReclassifyForCulling(reg->GetEntityById(instance));
             }
 
             static bool GetActive(int instance)
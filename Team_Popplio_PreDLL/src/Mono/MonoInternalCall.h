@@ -365,6 +365,14 @@ namespace PopplioScriptAPI
             *   check if entity exists
             */
             static bool Exists(int instance);
+            /*
+            *   get generational handle of entity (generation << 32 | id)
+            */
+            static uint64_t GetHandle(int instance);
+            /*
+            *   check if entity referred to by handle is still alive (id not recycled)
+            */
+            static bool IsAlive(uint64_t handle);
 
             //static void OnScriptDestroy(int instance);
         }
@@ -514,6 +522,24 @@ namespace PopplioScriptAPI
 
     namespace PopplioComponentTrans
     {
+        /*
+        *   blittable copy of a transform, laid out like Team_Popplio.Components.TransformData
+        */
+        struct TransformData
+        {
+            float positionX;
+            float positionY;
+            float scaleX;
+            float scaleY;
+            double rotation;
+        };
+        static_assert(sizeof(TransformData) == 24, "TransformData must match the C# layout");
+
+        /*
+        *   recomputes the local transform of a child after its world transform was written
+        */
+        static void UpdateParentedTransform(Popplio::Entity const& entity, Popplio::TransformComponent const& transform);
+
         extern "C" // Transform Component
         {
             static float GetPositionX(int instance);
@@ -535,6 +561,20 @@ namespace PopplioScriptAPI
             static double GetRotation(int instance);
 
             static void SetRotation(int instance, double value);
+
+            /*
+            *   copies the transforms of count entities into data, one transition for the whole set
+            *   entries of entities without a transform are left untouched
+            *   returns the number of transforms copied
+            */
+            static int GetTransforms(int const* instances, TransformData* data, int count);
+
+            /*
+            *   writes the transforms of count entities from data in order, updating the local transform of children
+            *   entities without a transform are skipped
+            *   returns the number of transforms written
+            */
+            static int SetTransforms(int const* instances, TransformData const* data, int count);
         }
     }
 
@@ -586,6 +626,26 @@ namespace PopplioScriptAPI
 
     namespace PopplioComponentRB
     {
+        /*
+        *   blittable copy of a rigid body, laid out like Team_Popplio.Components.RigidBodyData
+        *   bools are ints to keep the struct blittable
+        */
+        struct RigidBodyData
+        {
+            float velocityX;
+            float velocityY;
+            float accelerationX;
+            float accelerationY;
+            float forceX;
+            float forceY;
+            float mass;
+            float gravityScale;
+            float dragCoefficient;
+            int active;
+            int useGravity;
+        };
+        static_assert(sizeof(RigidBodyData) == 44, "RigidBodyData must match the C# layout");
+
         extern "C"
         {
             static float GetVelocityX(int instance);
@@ -635,6 +695,20 @@ namespace PopplioScriptAPI
             static float GetDragCoefficient(int instance);
 
             static void SetDragCoefficient(int instance, float value);
+
+            /*
+            *   copies the rigid bodies of count entities into data, one transition for the whole set
+            *   entries of entities without a rigid body are left untouched
+            *   returns the number of rigid bodies copied
+            */
+            static int GetRigidBodies(int const* instances, RigidBodyData* data, int count);
+
+            /*
+            *   writes the rigid bodies of count entities from data, the force manager is kept
+            *   entities without a rigid body are skipped
+            *   returns the number of rigid bodies written
+            */
+            static int SetRigidBodies(int const* instances, RigidBodyData const* data, int count);
         }
     }
 
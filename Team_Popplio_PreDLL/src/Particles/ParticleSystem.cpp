@@ -48,16 +48,17 @@ namespace Popplio
 		static int fixedSteps{};
 		fixedSteps = 0;
 
+		auto view = reg.View<ActiveComponent, ParticleComponent>(*this);
+
 		while (fixedSteps < Engine::timer.GetCurrentNumberOfSteps())
 		{
-			for (auto& entity : GetSystemEntities())
+			view.Each([this, &dt](Entity entity, ActiveComponent& active, ParticleComponent& comp)
 			{
-				if (!entity.GetComponent<ActiveComponent>().isActive) continue;
-                if (!entity.HasComponent<ParticleComponent>()) continue;
+				if (!active.isActive) return;
 
 				//pSystem.Update(dt);
-				UpdateEnt(entity, dt);
-			}
+				UpdateEnt(entity, comp, dt);
+			});
 
             ++fixedSteps;
 		}
@@ -148,8 +149,11 @@ namespace Popplio
 
 	void ParticleSystem::UpdateEnt(Entity& ent, double const& dt)
 	{
-        ParticleComponent& comp = ent.GetComponent<ParticleComponent>();
+		UpdateEnt(ent, ent.GetComponent<ParticleComponent>(), dt);
+	}
 
+	void ParticleSystem::UpdateEnt(Entity& ent, ParticleComponent& comp, double const& dt)
+	{
 		for (Particle& p : comp.pool)
 		{
 			if (p.alive)
@@ -90,6 +90,9 @@ namespace Popplio
 
 		void UpdateEnt(Entity& ent, double const& dt);
 
+		// same as above with the particle component already looked up
+		void UpdateEnt(Entity& ent, ParticleComponent& comp, double const& dt);
+
         // Helper functions
 
 		int NewPart(ParticleComponent& comp);
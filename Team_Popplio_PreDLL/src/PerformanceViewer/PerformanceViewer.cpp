@@ -20,21 +20,11 @@ Technology is prohibited.
 #include <pch.h>
 #include "PerformanceViewer.h"
 
-#include "../Engine/Engine.h"
-
-#define POPPLIO_PERFORMANCE_REFRESH 2.0f // i dunno why its not in secs since i tested it
-
-#define POPPLIO_PERFORMANCE_TIMEOUT 0.5 // secs
-
 namespace Popplio
 {
 	const std::string PerformanceViewer::_MainEngine{ "engine" };
 	PerformanceViewer* PerformanceViewer::_instance = nullptr;
 
-	static float refreshRate = 0.f;
-
-	// pointer to track where 
-
 	PerformanceViewer* Popplio::PerformanceViewer::GetInstance()
 	{
 		if (_instance == nullptr)
@@ -50,102 +40,20 @@ namespace Popplio
 		delete _instance;
 	}
 
-	void PerformanceViewer::start(std::string sysType)
-	{
-		bool isNew = false;
-		if (!systemIntervalPair.contains(sysType))
-			isNew = true;
-
-		systemStartTimePair[sysType] = std::chrono::steady_clock::now();
-
-		if (isNew)
-		{
-			while (systemIntervalPair[sysType].size() < maxPolls)
-			{
-				systemIntervalPair[sysType].push(std::chrono::duration<double, std::micro>{0});
-				microSystemIntervalPair[sysType].push(0);
-			}
-		}
-	}
-
-	std::chrono::microseconds PerformanceViewer::end(std::string sysType)
-	{
-		// refresh rate to display / update the performance viewer
-		if (sysType == _MainEngine) refreshRate += static_cast<float>(Engine::timer.GetSystemFixedDeltaTime());
-		if (refreshRate >= POPPLIO_PERFORMANCE_REFRESH) refreshRate = 0.0;
-		//if (refreshRate < POPPLIO_PERFORMANCE_REFRESH)
-		//	return std::chrono::duration_cast<std::chrono::microseconds>(systemIntervalPair[sysType].front());
-		//else refreshRate = 0.0;
-
-
-		const std::chrono::duration<double> diff = std::chrono::steady_clock::now() - systemStartTimePair[sysType];
-
-		// would this affect performance?
-		while (systemIntervalPair[sysType].size() >= maxPolls)
-		{
-			// remove the front stored data
-			systemIntervalPair[sysType].pop();
-			microSystemIntervalPair[sysType].pop();
-		}
-
-		// update if refreshed
-		if (refreshRate <= 0.0)
-		{
-			systemIntervalPair[sysType].push(diff);
-			microSystemIntervalPair[sysType].push(static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(diff).count()));
-		}
-
-		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-		std::vector<std::string> toDelete{};
-		if (sysType == _MainEngine)
-		{
-			for (auto& it : systemIntervalPair)
-			{
-				if (std::chrono::duration<double>(now - systemStartTimePair[it.first]) >
-					std::chrono::duration<double>(POPPLIO_PERFORMANCE_TIMEOUT))
-				{
-					toDelete.push_back(it.first);
-				}
-			}
-		}
-		for (auto& sys : toDelete)
-		{
-			systemStartTimePair.erase(sys);
-			systemIntervalPair.erase(sys);
-			microSystemIntervalPair.erase(sys);
-		}
-		toDelete.clear();
-
-		return std::chrono::duration_cast<std::chrono::microseconds>(diff);
-	}
-
-	std::chrono::microseconds PerformanceViewer::GetSystemTime(std::string sysType)
-	{
-		if (systemIntervalPair[sysType].size() <= 0)
-			return std::chrono::microseconds{};
-		else
-			return duration_cast<std::chrono::microseconds>(systemIntervalPair[sysType].back());
-	}
-
-	std::queue<int> const& PerformanceViewer::GetSystemTimeQueue(std::string sysName)
+	void PerformanceViewer::start(const std::string& sysType)
 	{
-		// TODO: insert return statement here
-		return microSystemIntervalPair[sysName];
-	}
+		auto it = zones.find(sysType);
+		if (it == zones.end()) it = zones.emplace(sysType, Profiler::InternZone(sysType)).first;
 
-	double PerformanceViewer::GetSystemTimePercentage(std::string sysName)
-	{
-		return GetSystemTime(_MainEngine).count() <= 0 ? 0.0 : ((double)(GetSystemTime(sysName).count()) / (double)(GetSystemTime(_MainEngine).count())) * 100.0;
+		Profiler::BeginZone(it->second);
 	}
 
-	size_t PerformanceViewer::GetNumSystemsRegistered()
+	std::chrono::microseconds PerformanceViewer::end(const std::string& sysType)
 	{
-		return systemIntervalPair.size();
-	}
+		auto it = zones.find(sysType);
+		if (it == zones.end()) return std::chrono::microseconds{};
 
-	std::unordered_map<std::string, std::queue<int>> const& PerformanceViewer::GetAllSystemTimeMap()
-	{
-		return microSystemIntervalPair;
+		return std::chrono::duration_cast<std::chrono::microseconds>(Profiler::EndZone(it->second));
 	}
 
 	void PerformanceViewer::StartRealTime(const std::string& name)
@@ -172,5 +80,13 @@ namespace Popplio
 		return duration;
 	}
 
+	void PerformanceViewer::SetCounter(const std::string& name, size_t value)
+	{
+		counters[name] = value;
+	}
 
-}
\ No newline at end of file
+	std::unordered_map<std::string, size_t> const& PerformanceViewer::GetAllCounters()
+	{
+		return counters;
+	}
+}
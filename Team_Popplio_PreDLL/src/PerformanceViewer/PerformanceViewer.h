@@ -20,12 +20,11 @@ Technology is prohibited.
 #ifndef PERFORMANCE_VIEWER_HEADER
 #define PERFORMANCE_VIEWER_HEADER
 #include "../Logging/Logger.h"
+#include "Profiler.h"
 
 #include <chrono>
 #include <unordered_map>
 #include <string>
-#include <typeindex>
-#include <queue>
 
 namespace Popplio
 {
@@ -35,25 +34,18 @@ namespace Popplio
 
 		static PerformanceViewer* _instance;
 
-		// maximum number of polls the system can keep before deleting the oldest recorded poll
-		size_t maxPolls;
-
-		// map to store the start time of recording of each system
-		std::unordered_map<std::string, std::chrono::steady_clock::time_point> systemStartTimePair;
-
-		// map to store duration of each system's run time
-		std::unordered_map<std::string, std::queue<std::chrono::duration<double>>> systemIntervalPair;
-
-		// map to store system time in microseconds
-		std::unordered_map<std::string, std::queue<int>> microSystemIntervalPair;
+		// profiler zone of each system name, so a name is only interned once
+		std::unordered_map<std::string, ProfileZoneId> zones;
 
 		std::unordered_map<std::string, std::chrono::system_clock::time_point> timers;
 
+		// latest value of the counters reported by systems (e.g. culled entities)
+		std::unordered_map<std::string, size_t> counters;
+
 	public:
 		static const std::string _MainEngine;
 
-		// TODO: change maxPolls to be modifiable outside of this class, to change max num of polls per cycle
-		PerformanceViewer() : maxPolls(100) {};
+		PerformanceViewer() {};
 		~PerformanceViewer() { };
 
 		// gets an instance of PerformanceViewer, creates a new instance if not yet existing
@@ -61,26 +53,21 @@ namespace Popplio
 
 		static void DestroyInstance();
 
-		// starts the timer for type sysType
-		void start(std::string sysType);
-
-		// ends the timer for type sysType & returns how long this system took in microseconds (ms)
-		std::chrono::microseconds end(std::string sysType);
-
-		// returns the most recent poll in microseconds (ms)
-		std::chrono::microseconds GetSystemTime(std::string sysType);
+		// starts the timer for type sysType, a profiler zone nested in the zones open on the thread
+		// prefer POPPLIO_PROFILE_ZONE where the name is a literal
+		void start(const std::string& sysType);
 
-		std::queue<int> const& GetSystemTimeQueue(std::string sysName);
-
-		double GetSystemTimePercentage(std::string sysName);
-
-		size_t GetNumSystemsRegistered();
-
-		std::unordered_map<std::string, std::queue<int>> const& GetAllSystemTimeMap();
+		// ends the timer for type sysType & returns how long this system took in microseconds (us)
+		std::chrono::microseconds end(const std::string& sysType);
 
 		void StartRealTime(const std::string& name);
 
 		std::chrono::duration<double> EndRealTime(const std::string& name);
+
+		// sets the latest value of counter name
+		void SetCounter(const std::string& name, size_t value);
+
+		std::unordered_map<std::string, size_t> const& GetAllCounters();
 	};
 
 }
@@ -0,0 +1,539 @@
+/******************************************************************************/
+/*!
+\file   Profiler.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This source file defines the Profiler class.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+#include "Profiler.h"
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/writer.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace Popplio
+{
+	namespace
+	{
+		using ProfileClock = std::chrono::steady_clock;
+
+		// A closed zone, times in nanoseconds since the profiler started
+		struct ZoneEvent
+		{
+			std::uint64_t path; // the zone and the zones it is nested in
+			std::uint64_t parentPath;
+			std::int64_t start;
+			std::int64_t end;
+			ProfileZoneId zone;
+			std::uint32_t depth;
+		};
+
+		struct OpenZone
+		{
+			ProfileZoneId zone;
+			std::uint64_t path;
+			ProfileClock::time_point start;
+		};
+
+		struct EventBuffer
+		{
+			std::vector<ZoneEvent> events{};
+			size_t dropped = 0;
+		};
+
+		// The owner thread is the only writer of the active buffer, EndFrame flips
+		// the active index and takes the other one once the owner is not writing
+		struct ThreadBuffer
+		{
+			std::array<EventBuffer, 2> buffers{};
+			std::atomic<std::uint32_t> active{ 0 };
+			std::atomic<bool> writing{ false };
+
+			std::mutex nameMutex;
+			std::string name{};
+
+			std::vector<OpenZone> open{}; // owner thread only
+			std::uint64_t rootPath = 0;
+			std::uint32_t index = 0;
+			std::atomic<bool> exited{ false };
+		};
+
+		struct ThreadBufferHolder
+		{
+			std::shared_ptr<ThreadBuffer> buffer{};
+			~ThreadBufferHolder() { if (buffer) buffer->exited.store(true, std::memory_order_release); }
+		};
+
+		// Path of a zone nested in parentPath, never 0
+		std::uint64_t PathOf(std::uint64_t parentPath, std::uint64_t zone)
+		{
+			std::uint64_t x = parentPath ^ ((zone + 1) * 0x9E3779B97F4A7C15ull);
+			x ^= x >> 31;
+			x *= 0xBF58476D1CE4E5B9ull;
+			x ^= x >> 27;
+			return x | 1;
+		}
+	}
+
+	struct Profiler::Backend
+	{
+		struct Node
+		{
+			std::uint64_t path = 0;
+			std::uint64_t parentPath = 0;
+			const char* name = "";
+			ProfileZoneId zone = 0;
+			std::uint32_t depth = 0;
+			std::uint32_t threadIndex = 0;
+			size_t order = 0; // when it first ran, orders the children
+
+			std::array<float, HISTORY_FRAMES> history{}; // ms per frame it ran
+			size_t historyCount = 0;
+			size_t historyHead = 0;
+
+			size_t frame = 0; // last frame it ran
+			double frameMs = 0.0;
+			std::uint32_t frameCalls = 0;
+			ProfileZoneStats stats{};
+		};
+
+		struct CaptureEvent
+		{
+			std::int64_t start;
+			std::int64_t end;
+			ProfileZoneId zone;
+			std::uint32_t threadIndex;
+		};
+
+		ProfileClock::time_point epoch = ProfileClock::now();
+
+		std::mutex zoneMutex;
+		std::vector<const char*> zoneNames{};
+		std::unordered_map<std::string_view, ProfileZoneId> zoneIds{}; // views of zoneNames
+		std::deque<std::string> ownedNames{}; // names interned from strings
+
+		std::mutex threadMutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> threads{};
+		std::uint32_t nextThreadIndex = 0;
+
+		// main thread
+		size_t frame = 0;
+		size_t nextOrder = 0;
+		std::vector<ZoneEvent> collected{};
+		std::vector<Node> nodes{};
+		std::unordered_map<std::uint64_t, size_t> nodeIndex{}; // by path
+		std::vector<size_t> touched{}; // nodes that ran this frame
+		std::vector<std::vector<size_t>> children{};
+		std::vector<size_t> treeOrder{};
+		bool treeDirty = false;
+		std::vector<ProfileZoneStats> stats{};
+		std::array<float, HISTORY_FRAMES> sortScratch{};
+		size_t dropped = 0;
+
+		bool capturing = false;
+		bool captureFull = false;
+		std::vector<CaptureEvent> capture{};
+		std::vector<std::string> captureThreadNames{}; // by thread index
+
+		ThreadBuffer& LocalBuffer()
+		{
+			static thread_local ThreadBufferHolder holder{};
+			if (!holder.buffer)
+			{
+				holder.buffer = std::make_shared<ThreadBuffer>();
+				for (EventBuffer& events : holder.buffer->buffers) events.events.reserve(1024);
+
+				std::lock_guard<std::mutex> lock(threadMutex);
+				holder.buffer->index = nextThreadIndex++;
+				holder.buffer->rootPath = PathOf(0, ~static_cast<std::uint64_t>(holder.buffer->index));
+				holder.buffer->name = "Thread " + std::to_string(holder.buffer->index);
+				threads.push_back(holder.buffer);
+			}
+			return *holder.buffer;
+		}
+
+		ProfileZoneId Intern(std::string_view name, const char* stored)
+		{
+			std::lock_guard<std::mutex> lock(zoneMutex);
+			auto it = zoneIds.find(name);
+			if (it != zoneIds.end()) return it->second;
+
+			if (!stored) stored = ownedNames.emplace_back(name).c_str();
+			const ProfileZoneId id = static_cast<ProfileZoneId>(zoneNames.size());
+			zoneNames.push_back(stored);
+			zoneIds.emplace(std::string_view(stored, name.size()), id);
+			return id;
+		}
+
+		void Collect(std::uint32_t threadIndex)
+		{
+			for (const ZoneEvent& e : collected)
+			{
+				auto [it, inserted] = nodeIndex.try_emplace(e.path, nodes.size());
+				if (inserted)
+				{
+					Node& node = nodes.emplace_back();
+					node.path = e.path;
+					node.parentPath = e.parentPath;
+					node.zone = e.zone;
+					node.depth = e.depth;
+					node.threadIndex = threadIndex;
+					node.order = nextOrder++;
+					{
+						std::lock_guard<std::mutex> lock(zoneMutex);
+						node.name = zoneNames[e.zone];
+					}
+					treeDirty = true;
+				}
+
+				Node& node = nodes[it->second];
+				if (node.frame != frame)
+				{
+					node.frame = frame;
+					node.frameMs = 0.0;
+					node.frameCalls = 0;
+					touched.push_back(it->second);
+				}
+				node.frameMs += static_cast<double>(e.end - e.start) / 1.0e6;
+				++node.frameCalls;
+
+				if (capturing && !captureFull)
+				{
+					if (capture.size() < MAX_CAPTURE_EVENTS) capture.push_back({ e.start, e.end, e.zone, threadIndex });
+					else
+					{
+						captureFull = true;
+						Logger::Warning("Profiler capture is full, later zones are not recorded");
+					}
+				}
+			}
+			collected.clear();
+		}
+
+		void UpdateStats(Node& node)
+		{
+			node.history[node.historyHead] = static_cast<float>(node.frameMs);
+			node.historyHead = (node.historyHead + 1) % HISTORY_FRAMES;
+			if (node.historyCount < HISTORY_FRAMES) ++node.historyCount;
+
+			const size_t count = node.historyCount;
+			std::copy_n(node.history.begin(), count, sortScratch.begin()); // the filled slots, in any order
+			double total = 0.0;
+			float minMs = sortScratch[0], maxMs = sortScratch[0];
+			for (size_t i{}; i < count; ++i)
+			{
+				total += sortScratch[i];
+				minMs = std::min(minMs, sortScratch[i]);
+				maxMs = std::max(maxMs, sortScratch[i]);
+			}
+
+			// nearest rank
+			const size_t rank = (count * 95 + 99) / 100 - 1;
+			std::nth_element(sortScratch.begin(), sortScratch.begin() + rank, sortScratch.begin() + count);
+
+			ProfileZoneStats& stats = node.stats;
+			stats.name = node.name;
+			stats.zone = node.zone;
+			stats.depth = node.depth;
+			stats.threadIndex = node.threadIndex;
+			stats.calls = node.frameCalls;
+			stats.lastMs = node.frameMs;
+			stats.minMs = minMs;
+			stats.avgMs = total / static_cast<double>(count);
+			stats.p95Ms = sortScratch[rank];
+			stats.maxMs = maxMs;
+		}
+
+		// Drops the nodes that did not run over the whole history
+		void RemoveStale()
+		{
+			for (size_t i{}; i < nodes.size();)
+			{
+				if (frame - nodes[i].frame <= HISTORY_FRAMES)
+				{
+					++i;
+					continue;
+				}
+
+				nodeIndex.erase(nodes[i].path);
+				if (i != nodes.size() - 1)
+				{
+					nodes[i] = nodes.back();
+					nodeIndex[nodes[i].path] = i;
+				}
+				nodes.pop_back();
+				treeDirty = true;
+			}
+		}
+
+		void AppendSubtree(size_t node)
+		{
+			treeOrder.push_back(node);
+			for (size_t child : children[node]) AppendSubtree(child);
+		}
+
+		void BuildTree()
+		{
+			children.assign(nodes.size(), {});
+			std::vector<size_t> sorted(nodes.size());
+			for (size_t i{}; i < sorted.size(); ++i) sorted[i] = i;
+			std::sort(sorted.begin(), sorted.end(), [this](size_t a, size_t b)
+			{
+				if (nodes[a].threadIndex != nodes[b].threadIndex) return nodes[a].threadIndex < nodes[b].threadIndex;
+				return nodes[a].order < nodes[b].order;
+			});
+
+			std::vector<size_t> roots{};
+			for (size_t i : sorted)
+			{
+				// a parent that closed in another frame can be gone, shown as a root
+				auto parent = nodes[i].depth > 0 ? nodeIndex.find(nodes[i].parentPath) : nodeIndex.end();
+				if (parent == nodeIndex.end()) roots.push_back(i);
+				else children[parent->second].push_back(i);
+			}
+
+			treeOrder.clear();
+			for (size_t root : roots) AppendSubtree(root);
+			treeDirty = false;
+		}
+	};
+
+	Profiler::Backend& Profiler::GetBackend()
+	{
+		static Backend backend{};
+		return backend;
+	}
+
+	ProfileZoneId Profiler::InternZone(const char* name)
+	{
+		return GetBackend().Intern(name, name);
+	}
+
+	ProfileZoneId Profiler::InternZone(const std::string& name)
+	{
+		return GetBackend().Intern(name, nullptr);
+	}
+
+	const char* Profiler::GetZoneName(ProfileZoneId zone)
+	{
+		Backend& backend = GetBackend();
+		std::lock_guard<std::mutex> lock(backend.zoneMutex);
+		return zone < backend.zoneNames.size() ? backend.zoneNames[zone] : "";
+	}
+
+	void Profiler::BeginZone(ProfileZoneId zone)
+	{
+		ThreadBuffer& buffer = GetBackend().LocalBuffer();
+		const std::uint64_t parentPath = buffer.open.empty() ? buffer.rootPath : buffer.open.back().path;
+		buffer.open.push_back({ zone, PathOf(parentPath, zone), ProfileClock::now() });
+	}
+
+	std::chrono::nanoseconds Profiler::EndZone(ProfileZoneId zone)
+	{
+		const ProfileClock::time_point now = ProfileClock::now();
+		Backend& backend = GetBackend();
+		ThreadBuffer& buffer = backend.LocalBuffer();
+
+		size_t index = buffer.open.size();
+		while (index > 0 && buffer.open[index - 1].zone != zone) --index;
+		if (index == 0) return std::chrono::nanoseconds{ 0 };
+
+		const std::int64_t end = std::chrono::duration_cast<std::chrono::nanoseconds>(now - backend.epoch).count();
+		std::chrono::nanoseconds elapsed{};
+
+		// Set before reading which buffer is active, EndFrame waits for it after flipping them
+		buffer.writing.store(true);
+		EventBuffer& out = buffer.buffers[buffer.active.load()];
+		while (buffer.open.size() >= index)
+		{
+			const OpenZone& open = buffer.open.back();
+			const std::uint32_t depth = static_cast<std::uint32_t>(buffer.open.size() - 1);
+			const std::uint64_t parentPath = depth > 0 ? buffer.open[depth - 1].path : buffer.rootPath;
+			elapsed = now - open.start;
+
+			if (out.events.size() < MAX_EVENTS_PER_THREAD)
+			{
+				const std::int64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(open.start - backend.epoch).count();
+				out.events.push_back({ open.path, parentPath, start, end, open.zone, depth });
+			}
+			else ++out.dropped;
+
+			buffer.open.pop_back();
+		}
+		buffer.writing.store(false, std::memory_order_release);
+		return elapsed;
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadBuffer& buffer = GetBackend().LocalBuffer();
+		std::lock_guard<std::mutex> lock(buffer.nameMutex);
+		buffer.name = name;
+	}
+
+	void Profiler::EndFrame()
+	{
+		Backend& backend = GetBackend();
+		++backend.frame;
+		backend.touched.clear();
+
+		{
+			std::lock_guard<std::mutex> threadLock(backend.threadMutex);
+			for (size_t i{}; i < backend.threads.size();)
+			{
+				ThreadBuffer& buffer = *backend.threads[i];
+				const bool exited = buffer.exited.load(std::memory_order_acquire);
+				{
+					// A zone closing while flipping may still write to the old buffer, wait for it
+					const std::uint32_t taken = buffer.active.load(std::memory_order_relaxed);
+					buffer.active.store(taken ^ 1u);
+					while (buffer.writing.load()) std::this_thread::yield();
+
+					EventBuffer& events = buffer.buffers[taken];
+					backend.collected.swap(events.events);
+					backend.dropped += events.dropped;
+					events.dropped = 0;
+
+					if (backend.capturing)
+					{
+						std::lock_guard<std::mutex> lock(buffer.nameMutex);
+						if (backend.captureThreadNames.size() <= buffer.index) backend.captureThreadNames.resize(buffer.index + 1);
+						backend.captureThreadNames[buffer.index] = buffer.name;
+					}
+				}
+				backend.Collect(buffer.index);
+
+				// the events were taken above, nothing more can arrive from an exited thread
+				if (exited)
+				{
+					backend.threads[i] = backend.threads.back();
+					backend.threads.pop_back();
+				}
+				else ++i;
+			}
+		}
+
+		for (size_t node : backend.touched) backend.UpdateStats(backend.nodes[node]);
+		backend.RemoveStale();
+		if (backend.treeDirty) backend.BuildTree();
+
+		backend.stats.resize(backend.treeOrder.size());
+		for (size_t i{}; i < backend.treeOrder.size(); ++i) backend.stats[i] = backend.nodes[backend.treeOrder[i]].stats;
+	}
+
+	const std::vector<ProfileZoneStats>& Profiler::GetZoneStats()
+	{
+		return GetBackend().stats;
+	}
+
+	void Profiler::StartCapture()
+	{
+		Backend& backend = GetBackend();
+		backend.capture.clear();
+		backend.captureThreadNames.clear();
+		backend.captureFull = false;
+		backend.capturing = true;
+	}
+
+	bool Profiler::StopCapture(const std::string& path)
+	{
+		Backend& backend = GetBackend();
+		backend.capturing = false;
+
+		std::ofstream ofs(path);
+		if (!ofs.is_open())
+		{
+			Logger::Error("Profiler could not write capture to " + path);
+			return false;
+		}
+
+		std::vector<const char*> names{};
+		{
+			std::lock_guard<std::mutex> lock(backend.zoneMutex);
+			names = backend.zoneNames;
+		}
+
+		rapidjson::OStreamWrapper osw(ofs);
+		rapidjson::Writer<rapidjson::OStreamWrapper> writer(osw);
+
+		writer.StartObject();
+		writer.Key("displayTimeUnit");
+		writer.String("ms");
+		writer.Key("traceEvents");
+		writer.StartArray();
+
+		for (size_t i{}; i < backend.captureThreadNames.size(); ++i)
+		{
+			if (backend.captureThreadNames[i].empty()) continue;
+			writer.StartObject();
+			writer.Key("name"); writer.String("thread_name");
+			writer.Key("ph"); writer.String("M");
+			writer.Key("pid"); writer.Uint(1);
+			writer.Key("tid"); writer.Uint(static_cast<unsigned>(i));
+			writer.Key("args");
+			writer.StartObject();
+			writer.Key("name"); writer.String(backend.captureThreadNames[i].c_str());
+			writer.EndObject();
+			writer.EndObject();
+		}
+
+		// complete events, nesting is taken from the times on each thread
+		for (const Backend::CaptureEvent& e : backend.capture)
+		{
+			writer.StartObject();
+			writer.Key("name"); writer.String(names[e.zone]);
+			writer.Key("cat"); writer.String("popplio");
+			writer.Key("ph"); writer.String("X");
+			writer.Key("ts"); writer.Double(static_cast<double>(e.start) / 1000.0);
+			writer.Key("dur"); writer.Double(static_cast<double>(e.end - e.start) / 1000.0);
+			writer.Key("pid"); writer.Uint(1);
+			writer.Key("tid"); writer.Uint(e.threadIndex);
+			writer.EndObject();
+		}
+
+		writer.EndArray();
+		writer.EndObject();
+		ofs.flush();
+
+		std::stringstream ss{};
+		ss << "Profiler capture of " << backend.capture.size() << " zones written to " << path;
+		Logger::Info(ss.str());
+
+		backend.capture.clear();
+		backend.capture.shrink_to_fit();
+		return ofs.good();
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return GetBackend().capturing;
+	}
+
+	size_t Profiler::GetCaptureEventCount()
+	{
+		return GetBackend().capture.size();
+	}
+
+	size_t Profiler::GetDroppedEventCount()
+	{
+		return GetBackend().dropped;
+	}
+}
@@ -0,0 +1,191 @@
+/******************************************************************************/
+/*!
+\file   Profiler.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+		This header file declares the Profiler class, a hierarchical CPU
+		profiler of scoped zones, and the POPPLIO_PROFILE_ZONE macro.
+
+		Zone names are interned once per macro site, every thread records the
+		zones it closes into its own double buffer without locking and the main
+		thread swaps and collects the buffers once per frame into a tree of zones with min / avg / p95 / max
+		times over the last frames. Frames can be captured and saved as a
+		Chrome trace (chrome://tracing, Perfetto).
+
+		Define POPPLIO_DISABLE_PROFILER to compile the zones out.
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define POPPLIO_PROFILE_CONCAT_INNER(a, b) a##b
+#define POPPLIO_PROFILE_CONCAT(a, b) POPPLIO_PROFILE_CONCAT_INNER(a, b)
+
+#ifndef POPPLIO_DISABLE_PROFILER
+#define POPPLIO_PROFILE_ZONE_IMPL(name, counter) \
+	static const ::Popplio::ProfileZoneId POPPLIO_PROFILE_CONCAT(popplioZoneId, counter) = ::Popplio::Profiler::InternZone(name); \
+	const ::Popplio::ProfileScope POPPLIO_PROFILE_CONCAT(popplioZone, counter){ POPPLIO_PROFILE_CONCAT(popplioZoneId, counter) }
+
+// Times the rest of the enclosing scope as a zone, name must outlive the program (a literal)
+#define POPPLIO_PROFILE_ZONE(name) POPPLIO_PROFILE_ZONE_IMPL(name, __COUNTER__)
+#else
+#define POPPLIO_PROFILE_ZONE(name) do {} while (false)
+#endif
+
+namespace Popplio
+{
+	using ProfileZoneId = std::uint32_t;
+
+	/*!*****************************************************************************
+	\brief
+	Times of one node of the zone tree over the frames in the history,
+	only counting the frames the zone ran in.
+
+	*******************************************************************************/
+	struct ProfileZoneStats
+	{
+		const char* name = "";
+		ProfileZoneId zone = 0;
+		std::uint32_t depth = 0; // 0 for the zones opened outside any other zone
+		std::uint32_t threadIndex = 0;
+		std::uint32_t calls = 0; // in the last frame it ran
+		double lastMs = 0.0; // total of the calls in the last frame it ran
+		double minMs = 0.0;
+		double avgMs = 0.0;
+		double p95Ms = 0.0;
+		double maxMs = 0.0;
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Hierarchical profiler of scoped zones.
+
+	Zones can be opened and closed on any thread, the stats and capture are
+	only touched by the thread calling EndFrame (the main thread).
+
+	*******************************************************************************/
+	class Profiler
+	{
+	public:
+		static constexpr size_t HISTORY_FRAMES = 120;
+		static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 18; // zones closed between two frames
+		static constexpr size_t MAX_CAPTURE_EVENTS = 1 << 22;
+
+		/*!*****************************************************************************
+		\brief
+		Gets the id of a zone name, adding it the first time.
+		The macro calls this once per site, the pointer is kept as the name.
+
+		*******************************************************************************/
+		static ProfileZoneId InternZone(const char* name);
+
+		/*!*****************************************************************************
+		\brief
+		Gets the id of a zone name held in a string, adding a copy the first
+		time. Slower than the macro, for names only known at runtime.
+
+		*******************************************************************************/
+		static ProfileZoneId InternZone(const std::string& name);
+
+		static const char* GetZoneName(ProfileZoneId zone);
+
+		/*!*****************************************************************************
+		\brief
+		Opens a zone on the calling thread, nested in the zone open on it.
+
+		*******************************************************************************/
+		static void BeginZone(ProfileZoneId zone);
+
+		/*!*****************************************************************************
+		\brief
+		Closes the innermost open zone with this id on the calling thread,
+		closing the zones opened inside it that were left open.
+
+		\return
+		The time the zone was open, zero if it was not open.
+
+		*******************************************************************************/
+		static std::chrono::nanoseconds EndZone(ProfileZoneId zone);
+
+		/*!*****************************************************************************
+		\brief
+		Names the calling thread in the stats and traces.
+
+		*******************************************************************************/
+		static void SetThreadName(const std::string& name);
+
+		/*!*****************************************************************************
+		\brief
+		Collects the zones closed on every thread since the last call, updates
+		the stats and appends them to the capture if one is running.
+		Called once per frame by the main thread, after the frame zone closed.
+
+		*******************************************************************************/
+		static void EndFrame();
+
+		/*!*****************************************************************************
+		\brief
+		Gets the zone tree, depth first, children in the order they first ran.
+		Updated by EndFrame.
+
+		*******************************************************************************/
+		static const std::vector<ProfileZoneStats>& GetZoneStats();
+
+		/*!*****************************************************************************
+		\brief
+		Starts recording every zone into the capture, clearing the previous one.
+
+		*******************************************************************************/
+		static void StartCapture();
+
+		/*!*****************************************************************************
+		\brief
+		Stops the capture and writes it as Chrome trace event JSON.
+
+		\return
+		Whether the file was written.
+
+		*******************************************************************************/
+		static bool StopCapture(const std::string& path);
+
+		static bool IsCapturing();
+		static size_t GetCaptureEventCount();
+		static size_t GetDroppedEventCount(); // zones lost to full thread buffers since the start
+
+	private:
+		struct Backend;
+		static Backend& GetBackend();
+	};
+
+	/*!*****************************************************************************
+	\brief
+	Opens a zone for its lifetime, used through POPPLIO_PROFILE_ZONE.
+
+	*******************************************************************************/
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(ProfileZoneId id) : zone(id) { Profiler::BeginZone(zone); }
+		~ProfileScope() { Profiler::EndZone(zone); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		ProfileZoneId zone;
+	};
+}
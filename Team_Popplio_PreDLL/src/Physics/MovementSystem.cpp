@@ -58,7 +58,7 @@ namespace Popplio
 			bool isDynamic1 = rigidBody1.useGravity;
 			bool isDynamic2 = rigidBody2.useGravity;
 			// Add debug logging
-			Logger::Debug("Passes through this function", LogDestination::IMGUI_CONSOLE);
+			POPPLIO_LOG_DEBUG("Passes through this function", LogDestination::IMGUI_CONSOLE);
 			// Calculate minimum distance needed between objects based on their scales
 			float minDistanceX = (scale1X + scale2X) * 0.5f;
 			float minDistanceY = (scale1Y + scale2Y) * 0.5f;
@@ -134,7 +134,7 @@ namespace Popplio
 			bool isDynamic1 = rigidBody1.useGravity;
 			bool isDynamic2 = rigidBody2.useGravity;
 			// Add debug logging
-			Logger::Debug("Passes through this function", LogDestination::IMGUI_CONSOLE);
+			POPPLIO_LOG_DEBUG("Passes through this function", LogDestination::IMGUI_CONSOLE);
 			// Calculate minimum distance needed between objects based on their scales
 			float minDistanceX = (transform1.scale.x + transform2.scale.x) * 0.5f;
 			float minDistanceY = (transform1.scale.y + transform2.scale.y) * 0.5f;
@@ -86,6 +86,7 @@ namespace Popplio
 			}
 			const Prefab& prefab = prefabOpt->get();
 
+			// Snapshot, syncing components can update the registry and change this system's entities
 			for (auto entity : GetSystemEntities())
 			{
 				auto& instanceComponent = entity.GetComponent<PrefabInstanceComponent>();
@@ -185,6 +186,7 @@ namespace Popplio
 	void PrefabSyncSystem::HandlePrefabDeletion(const std::string& prefabName)
 	{
 		int instancesDetached = 0;
+		// Snapshot, detaching removes the entity from this system
 		for (auto entity : GetSystemEntities())
 		{
 			auto& instanceComponent = entity.GetComponent<PrefabInstanceComponent>();
@@ -26,6 +26,8 @@ namespace Popplio
     namespace
     {
         static std::vector<void*> csParams{}; // params for C# scripts
+        static std::vector<int> csEventIds{}; // batched event entities / ids for C# scripts
+        static std::vector<double> csEventTimes{}; // batched event times for C# scripts
     }
 
     void LogicSystem::LoadCSScripts()
@@ -424,8 +426,7 @@ namespace Popplio
         csScriptsToBeDeleted.clear();
         csLoadedScriptsEntityId.clear();
         csEntityLoadedScripts.clear();
-        csScriptNames.clear();
-        csScriptsOverridden.clear();
+        CSClearScriptSlots();
     }
 
     void LogicSystem::CSDeleteScripts()
@@ -442,6 +443,16 @@ namespace Popplio
             if (iter1 != csLoadedScripts.end()) csLoadedScripts.erase(iter1);
             else continue;
 
+            // C# drops its reference in the next phase
+            auto slot = csScriptSlots.find(*i);
+            if (slot != csScriptSlots.end())
+            {
+                csScriptStates[slot->second] = static_cast<int>(CSScriptState::DESTROYED);
+                csScriptEntities[slot->second] = -1;
+                csDestroyedSlots.push_back(slot->second);
+                csScriptSlots.erase(slot);
+            }
+
             //int id = csLoadedScriptsEntityId[*i];
 
             if (csEntityLoadedScripts.find(csLoadedScriptsEntityId[*i]) != csEntityLoadedScripts.end())
@@ -466,14 +477,23 @@ namespace Popplio
         //monoAPI.ClearInvalidGC(); // may cause crash?
     }
 
-    void LogicSystem::CSOnCollision(CollisionEvent& event)
+    void LogicSystem::CSOnCollision(EventBatch<CollisionEvent>& batch)
     {
         if (csLoadedScripts.empty()) return;
         try
         {
-            csParams.clear();
-            monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnCollision2D",
-                csParams, event.entity1Id, event.entity2Id, event.collisionTime, static_cast<int>(event.eventID));
+            // (entity 1, entity 2, event id) per collision, marshalled as one array
+            csEventIds.clear();
+            csEventTimes.clear();
+            for (CollisionEvent const& event : batch.events)
+            {
+                csEventIds.insert(csEventIds.end(), { event.entity1Id, event.entity2Id, static_cast<int>(event.eventID) });
+                csEventTimes.push_back(event.collisionTime);
+            }
+
+            monoAPI.CallThunk(GetCSEventMethods().onCollision2DBatch,
+                PopplioScriptAPI::ArrayToMono1D(csEventIds, &monoAPI.GetAppDomain()),
+                PopplioScriptAPI::ArrayToMono1D(csEventTimes, &monoAPI.GetAppDomain()));
         }
         catch (const std::exception& e)
         {
@@ -483,14 +503,23 @@ namespace Popplio
         }
     }
 
-    void LogicSystem::CSOnTrigger(TriggerEvent& event)
+    void LogicSystem::CSOnTrigger(EventBatch<TriggerEvent>& batch)
     {
         if (csLoadedScripts.empty()) return;
         try
         {
-            csParams.clear();
-            monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnTrigger2D",
-                csParams, event.entity1Id, event.entity2Id, event.triggerTime, static_cast<int>(event.eventID));
+            // (entity 1, entity 2, event id) per trigger, marshalled as one array
+            csEventIds.clear();
+            csEventTimes.clear();
+            for (TriggerEvent const& event : batch.events)
+            {
+                csEventIds.insert(csEventIds.end(), { event.entity1Id, event.entity2Id, static_cast<int>(event.eventID) });
+                csEventTimes.push_back(event.triggerTime);
+            }
+
+            monoAPI.CallThunk(GetCSEventMethods().onTrigger2DBatch,
+                PopplioScriptAPI::ArrayToMono1D(csEventIds, &monoAPI.GetAppDomain()),
+                PopplioScriptAPI::ArrayToMono1D(csEventTimes, &monoAPI.GetAppDomain()));
         }
         catch (const std::exception& e)
         {
@@ -505,9 +534,7 @@ namespace Popplio
         if (csLoadedScripts.empty()) return;
         try
         {
-            csParams.clear();
-            monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnEntityChange",
-                csParams, event.id, static_cast<int>(event.change));
+            monoAPI.CallThunk(GetCSEventMethods().onEntityChange, event.id, static_cast<int>(event.change));
         }
         catch (const std::exception& e)
         {
@@ -525,8 +552,7 @@ namespace Popplio
             CSAddToLoadedScripts(entity);
             try
             {
-                csParams.clear();
-                monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnEntityCreate", csParams, entity);
+                monoAPI.CallThunk(GetCSEventMethods().onEntityCreate, entity);
             }
             catch (const std::exception& e)
             {
@@ -540,8 +566,7 @@ namespace Popplio
         if (csLoadedScripts.empty()) return;
         try
         {
-            csParams.clear();
-            monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnEntityDestroy", csParams, entity);
+            monoAPI.CallThunk(GetCSEventMethods().onEntityDestroy, entity);
 
             // free GC handle?
 
@@ -571,18 +596,24 @@ namespace Popplio
         e.GetComponent<LogicComponent>().currIsActive = IsScriptActive(e);
         //bool b = IsScriptActive(e);
         if (csLoadedScripts.empty()) return;
+
+        // scripts in the scheduler get OnEnable / OnDisable in the phase call
+        auto loaded = csEntityLoadedScripts.find(e.GetId());
+        if (loaded != csEntityLoadedScripts.end() && csScriptSlots.find(loaded->second) != csScriptSlots.end())
+        {
+            CSSetScriptState(loaded->second, IsScriptActive(e) ? CSScriptState::ENABLE : CSScriptState::DISABLE);
+            return;
+        }
        
         try
         {
-            csParams.clear();
-
             if (IsScriptActive(e))
             {
-                monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnEnable", csParams, e.GetId());
+                monoAPI.CallThunk(GetCSEventMethods().onEnable, e.GetId());
             }
             else
             {
-                monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnDisable", csParams, e.GetId());
+                monoAPI.CallThunk(GetCSEventMethods().onDisable, e.GetId());
             }
         }
         catch (const std::exception& e)
@@ -600,7 +631,7 @@ namespace Popplio
         if (csLoadedScripts.empty()) return;
         try
         {
-            monoAPI.CallMethod(monoAPI.GetAssClass("Team_Popplio", "Events"), "OnAppQuit");
+            monoAPI.CallThunk(GetCSEventMethods().onAppQuit);
         }
         catch (const std::exception& e)
         {
@@ -625,31 +656,11 @@ namespace Popplio
             return;
         }
 
-        csScriptNames[handle] = mono_class_get_name(mono_object_get_class(obj));
-
-        csScriptsOverridden[0][csScriptNames[handle]] =
-            monoAPI.IsOverridden(mono_object_get_class(obj),
-                monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "Setup");
-
-        csScriptsOverridden[1][csScriptNames[handle]] =
-            monoAPI.IsOverridden(mono_object_get_class(obj),
-                monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "Init");
-
-        csScriptsOverridden[2][csScriptNames[handle]] =
-            monoAPI.IsOverridden(mono_object_get_class(obj),
-                monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "Update");
-
-        csScriptsOverridden[3][csScriptNames[handle]] =
-            monoAPI.IsOverridden(mono_object_get_class(obj),
-                monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "FixedUpdate");
-
-        csScriptsOverridden[4][csScriptNames[handle]] =
-            monoAPI.IsOverridden(mono_object_get_class(obj),
-                monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "End");
-
         int id = monoAPI.Get<int>(obj, mono_class_get_field_from_name(mono_object_get_class(obj), "EntID"));
         csEntityLoadedScripts[id] = handle;
         csLoadedScriptsEntityId[handle] = id;
+
+        CSRegisterScript(handle, obj, id);
     }
 
     void LogicSystem::CSAddToLoadedScripts(int id)
@@ -684,6 +695,192 @@ namespace Popplio
         //}
     }
 
+    void LogicSystem::CSCheckMethods()
+    {
+        if (csMethodsGeneration == monoAPI.GetAssemblyGeneration()) return;
+
+        // slots of the previous assembly are gone with its domain
+        csScriptSlots.clear();
+        csScriptStates.clear();
+        csScriptEntities.clear();
+        csFreeSlots.clear();
+        csDestroyedSlots.clear();
+        csScriptOrder.clear();
+
+        csEventMethods = {};
+        csSchedulerMethods = {};
+
+        MonoClass* events = monoAPI.GetAssClass("Team_Popplio", "Events");
+        if (events == nullptr)
+        {
+            Logger::Error("LogicSystem: CSCheckMethods | Failed to get Team_Popplio.Events");
+        }
+        else
+        {
+            csEventMethods.onEnable = monoAPI.GetMethodThunk<int>(mono_class_get_method_from_name(events, "OnEnable", 1));
+            csEventMethods.onDisable = monoAPI.GetMethodThunk<int>(mono_class_get_method_from_name(events, "OnDisable", 1));
+            csEventMethods.onEntityCreate = 
+                monoAPI.GetMethodThunk<int>(mono_class_get_method_from_name(events, "OnEntityCreate", 1));
+            csEventMethods.onEntityDestroy = 
+                monoAPI.GetMethodThunk<int>(mono_class_get_method_from_name(events, "OnEntityDestroy", 1));
+            csEventMethods.onEntityChange = 
+                monoAPI.GetMethodThunk<int, int>(mono_class_get_method_from_name(events, "OnEntityChange", 2));
+            csEventMethods.onCollision2DBatch = monoAPI.GetMethodThunk<MonoArray*, MonoArray*>(
+                mono_class_get_method_from_name(events, "OnCollision2DBatch", 2));
+            csEventMethods.onTrigger2DBatch = monoAPI.GetMethodThunk<MonoArray*, MonoArray*>(
+                mono_class_get_method_from_name(events, "OnTrigger2DBatch", 2));
+            csEventMethods.onAppQuit = monoAPI.GetMethodThunk<>(mono_class_get_method_from_name(events, "OnAppQuit", 0));
+        }
+
+        MonoClass* scheduler = monoAPI.GetAssClass("Team_Popplio", "ScriptScheduler");
+        if (scheduler == nullptr)
+        {
+            Logger::Error("LogicSystem: CSCheckMethods | Failed to get Team_Popplio.ScriptScheduler");
+        }
+        else
+        {
+            csSchedulerMethods.registerScript = 
+                monoAPI.GetMethodThunk<int, MonoObject*>(mono_class_get_method_from_name(scheduler, "RegisterScript", 2));
+            csSchedulerMethods.clearScripts = 
+                monoAPI.GetMethodThunk<>(mono_class_get_method_from_name(scheduler, "ClearScripts", 0));
+            csSchedulerMethods.runScripts = 
+                monoAPI.GetMethodThunk<int, int*, int*, int*, int>(mono_class_get_method_from_name(scheduler, "RunScripts", 5));
+        }
+
+        csMethodsGeneration = monoAPI.GetAssemblyGeneration();
+    }
+
+    CSEventMethods const& LogicSystem::GetCSEventMethods()
+    {
+        CSCheckMethods();
+        return csEventMethods;
+    }
+
+    void LogicSystem::CSRegisterScript(uint32_t handle, MonoObject* obj, int entity)
+    {
+        CSCheckMethods();
+
+        // growing the slot buffers now would free them under C#
+        if (csRunningPhase)
+        {
+            csPendingScripts.emplace_back(handle, entity);
+            return;
+        }
+
+        int slot{};
+        auto found = csScriptSlots.find(handle);
+        if (found != csScriptSlots.end()) slot = found->second;
+        else if (!csFreeSlots.empty())
+        {
+            slot = csFreeSlots.back();
+            csFreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<int>(csScriptStates.size());
+            csScriptStates.push_back(static_cast<int>(CSScriptState::FREE));
+            csScriptEntities.push_back(-1);
+        }
+
+        if (!monoAPI.CallThunk(csSchedulerMethods.registerScript, slot, obj))
+        {
+            if (found == csScriptSlots.end()) csFreeSlots.push_back(slot);
+            Logger::Error("LogicSystem: CSRegisterScript | Failed to register script");
+            return;
+        }
+
+        if (found == csScriptSlots.end()) csScriptOrder.push_back(slot);
+        csScriptSlots[handle] = slot;
+        csScriptStates[slot] = static_cast<int>(CSScriptState::INACTIVE);
+        csScriptEntities[slot] = entity;
+    }
+
+    void LogicSystem::CSSetScriptState(uint32_t handle, CSScriptState state)
+    {
+        auto found = csScriptSlots.find(handle);
+        if (found == csScriptSlots.end()) return;
+
+        csScriptStates[found->second] = static_cast<int>(state);
+    }
+
+    void LogicSystem::CSBeginLoopPhase()
+    {
+        for (int& state : csScriptStates)
+        {
+            if (state == static_cast<int>(CSScriptState::ACTIVE)) state = static_cast<int>(CSScriptState::INACTIVE);
+        }
+    }
+
+    void LogicSystem::CSRunLoopPhase(CSLoopMethod method)
+    {
+        CSCheckMethods();
+        if (csScriptOrder.empty()) return;
+
+        const bool nested = csRunningPhase;
+        csRunningPhase = true;
+        try
+        {
+            monoAPI.CallThunk(csSchedulerMethods.runScripts, static_cast<int>(method), csScriptOrder.data(),
+                csScriptStates.data(), csScriptEntities.data(), static_cast<int>(csScriptOrder.size()));
+        }
+        catch (...)
+        {
+            csRunningPhase = nested;
+            if (!nested) CSApplyPendingScripts();
+            throw;
+        }
+        csRunningPhase = nested;
+        if (nested) return;
+
+        CSApplyPendingScripts();
+    }
+
+    void LogicSystem::CSApplyPendingScripts()
+    {
+        if (csClearPending)
+        {
+            csClearPending = false;
+            CSClearScriptSlots();
+        }
+
+        // slots released by C# in the call can be reused
+        std::erase_if(csDestroyedSlots, [this](int slot)
+        {
+            if (csScriptStates[slot] != static_cast<int>(CSScriptState::FREE)) return false;
+            csFreeSlots.push_back(slot);
+            std::erase(csScriptOrder, slot);
+            return true;
+        });
+
+        std::vector<std::pair<uint32_t, int>> pending{};
+        pending.swap(csPendingScripts);
+        for (auto const& [handle, entity] : pending) CSRegisterScript(handle, mono_gchandle_get_target(handle), entity);
+    }
+
+    void LogicSystem::CSClearScriptSlots()
+    {
+        // C# is walking the buffers, stop every slot now and release them after the phase
+        if (csRunningPhase)
+        {
+            std::fill(csScriptStates.begin(), csScriptStates.end(), static_cast<int>(CSScriptState::FREE));
+            std::fill(csScriptEntities.begin(), csScriptEntities.end(), -1);
+            csScriptSlots.clear();
+            csDestroyedSlots.clear();
+            csPendingScripts.clear();
+            csClearPending = true;
+            return;
+        }
+
+        csScriptSlots.clear();
+        csScriptStates.clear();
+        csScriptEntities.clear();
+        csFreeSlots.clear();
+        csDestroyedSlots.clear();
+        csScriptOrder.clear();
+
+        if (csMethodsGeneration == monoAPI.GetAssemblyGeneration()) monoAPI.CallThunk(csSchedulerMethods.clearScripts);
+    }
+
     void LogicSystem::CSUpdateLogicObjects()
     {
         for (auto i = csLoadedScripts.begin(); i != csLoadedScripts.end(); ++i)
@@ -73,9 +73,9 @@ namespace Popplio
     void LogicSystem::SubscribeToEvents(EventBus& event)
     {
         event.SubscribeToEvent<CollisionEvent>(&(*this), &LogicSystem::CPPOnCollision);
-        event.SubscribeToEvent<CollisionEvent>(&(*this), &LogicSystem::CSOnCollision);
+        event.SubscribeToEvent<EventBatch<CollisionEvent>>(&(*this), &LogicSystem::CSOnCollision);
         event.SubscribeToEvent<TriggerEvent>(&(*this), &LogicSystem::CPPOnTrigger);
-        event.SubscribeToEvent<TriggerEvent>(&(*this), &LogicSystem::CSOnTrigger);
+        event.SubscribeToEvent<EventBatch<TriggerEvent>>(&(*this), &LogicSystem::CSOnTrigger);
         event.SubscribeToEvent<EntityRuntimeChangeEvent>(&(*this), &LogicSystem::CPPOnEntityChange);
         event.SubscribeToEvent<EntityRuntimeChangeEvent>(&(*this), &LogicSystem::CSOnEntityChange);
         event.SubscribeToEvent<PopplioUtil::OnAppQuit>(&(*this), &LogicSystem::CPPOnAppQuit);
@@ -97,7 +97,8 @@ namespace Popplio
             reloadMono = false;
         }
 
-		entities = GetSystemEntities(); // get entities
+		SystemEntities systemEntities = GetSystemEntities();
+		entities.assign(systemEntities.begin(), systemEntities.end()); // get entities
 
         // initialize
 
@@ -205,10 +206,7 @@ namespace Popplio
 
         //static std::vector<MonoObject*> scriptsToBeDeleted{};
 
-        csScriptsOverridden.clear();
-        csScriptsOverridden = std::vector<std::unordered_map<std::string, bool>>(5);
-
-        csScriptNames.clear();
+        CSClearScriptSlots();
         csEntityLoadedScripts.clear();
         csLoadedScriptsEntityId.clear();
         csScriptsToBeDeleted.clear();
@@ -246,11 +244,10 @@ namespace Popplio
 
         // get all scripts loaded in with "BassNKick" namespace and base class of "PopplioMonoScript"
         // use mono funcs
+        CSBeginLoopPhase();
         currentLoop = csLoadedScripts;
         for (uint32_t handle : currentLoop)
         {
-            MonoObject* obj = mono_gchandle_get_target(handle);
-
             auto ent = reg.GetEntityById(csLoadedScriptsEntityId[handle]);
             if (!ent.Exists())
             {
@@ -283,19 +280,18 @@ namespace Popplio
 
             if (!(ent.GetComponent<LogicComponent>().isActive)) continue;
 
+            CSSetScriptState(handle, CSScriptState::ACTIVE);
+        }
 
-            if (!csScriptsOverridden[0][csScriptNames[handle]]) continue;
-
-            try
-            {
-                monoAPI.CallMethod(obj, "Setup");
-            }
-            catch (const std::exception& e)
-            {
-                std::stringstream ss{ "" };
-                ss << "LogicSystem: Setup | Exception in C# script: " << std::string(e.what());
-                Logger::Error(ss.str());
-            }
+        try
+        {
+            CSRunLoopPhase(CSLoopMethod::SETUP);
+        }
+        catch (const std::exception& e)
+        {
+            std::stringstream ss{ "" };
+            ss << "LogicSystem: Setup | Exception in C# script: " << std::string(e.what());
+            Logger::Error(ss.str());
         }
 
         // delete scripts
@@ -343,6 +339,7 @@ namespace Popplio
         //static std::vector<MonoObject*> scriptsToBeDeleted{};
         // update logic components with current object addresses
         CSUpdateLogicObjects();
+        CSBeginLoopPhase();
         currentLoop = csLoadedScripts;
         for (uint32_t handle : currentLoop)
         {
@@ -381,29 +378,18 @@ namespace Popplio
             //if (!(monoAPI.GetPtr<Entity>(obj, mono_object_get_class(obj), "EntP")->
             //    GetComponent<LogicComponent>().isActive)) continue;
 
-            try
-            {
-                //if (ent.GetComponent<LogicComponent>().currIsActive != IsScriptActive(ent))
-                //{
-                //    CSOnActiveChange(ent, obj); // OnEnable / OnDisable
-                //}
-                //else
-                //{
-                //    if (!csScriptsOverridden[1][csScriptNames[obj]]) continue;
-
-                //    monoAPI.CallMethod(obj, "Init");
-                //}
-
-                if (!csScriptsOverridden[1][csScriptNames[handle]]) continue;
+            CSSetScriptState(handle, CSScriptState::ACTIVE);
+        }
 
-                monoAPI.CallMethod(obj, "Init");
-            }
-            catch (const std::exception& e)
-            {
-                std::stringstream ss{ "" };
-                ss << "LogicSystem: Init | Exception in C# script: " << std::string(e.what());
-                Logger::Error(ss.str());
-            }
+        try
+        {
+            CSRunLoopPhase(CSLoopMethod::INIT);
+        }
+        catch (const std::exception& e)
+        {
+            std::stringstream ss{ "" };
+            ss << "LogicSystem: Init | Exception in C# script: " << std::string(e.what());
+            Logger::Error(ss.str());
         }
 
         // delete scripts
@@ -447,6 +433,7 @@ namespace Popplio
         //static std::vector<MonoObject*> scriptsToBeDeleted{};
         // update logic components with current object addresses
         CSUpdateLogicObjects();
+        CSBeginLoopPhase();
         currentLoop = csLoadedScripts;
         for (uint32_t handle : currentLoop)
         {
@@ -462,7 +449,7 @@ namespace Popplio
             //auto& ent = *monoAPI.GetPtr<Entity>(obj, mono_object_get_class(obj), "EntP");
             //auto& ent = *monoAPI.GetPtr<Entity>(obj, monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript"), "EntP");
 
-            if (!reg.EntityExists(csLoadedScriptsEntityId[handle]) || !monoAPI.IsObjValid(obj))
+            if (!reg.EntityExists(csLoadedScriptsEntityId[handle]) || !monoAPI.IsObjValid(handle))
             {
                 csScriptsToBeDeleted.push_back(handle);
                 continue;
@@ -487,28 +474,18 @@ namespace Popplio
 
             if (!ent.GetComponent<LogicComponent>().currIsActive) continue;
 
-            try
-            {
-                //if (ent.GetComponent<LogicComponent>().currIsActive != IsScriptActive(ent))
-                //{
-                //    CSOnActiveChange(ent, obj); // OnEnable / OnDisable
-                //}
-                //else
-                //{
-                //    if (!csScriptsOverridden[2][csScriptNames[obj]]) continue;
-                //    std::string str = csScriptNames[obj];
-                //    monoAPI.CallMethod(obj, "Update");
-                //}
-                if (!csScriptsOverridden[2][csScriptNames[handle]]) continue;
-                std::string str = csScriptNames[handle];
-                monoAPI.CallMethod(obj, "Update");
-            }
-            catch (const std::exception& e)
-            {
-                std::stringstream ss{ "" };
-                ss << "LogicSystem: Update | Exception in C# script: " << std::string(e.what());
-                Logger::Error(ss.str());
-            }
+            CSSetScriptState(handle, CSScriptState::ACTIVE);
+        }
+
+        try
+        {
+            CSRunLoopPhase(CSLoopMethod::UPDATE);
+        }
+        catch (const std::exception& e)
+        {
+            std::stringstream ss{ "" };
+            ss << "LogicSystem: Update | Exception in C# script: " << std::string(e.what());
+            Logger::Error(ss.str());
         }
 
         // delete scripts
@@ -556,6 +533,7 @@ namespace Popplio
             //static std::vector<MonoObject*> scriptsToBeDeleted{};
             // update logic components with current object addresses
             CSUpdateLogicObjects();
+            CSBeginLoopPhase();
             currentLoop = csLoadedScripts;
             for (uint32_t handle : currentLoop)
             {
@@ -570,7 +548,7 @@ namespace Popplio
 
                 //auto& ent = *monoAPI.GetPtr<Entity>(obj, mono_object_get_class(obj), "EntP");
 
-                if (!reg.EntityExists(csLoadedScriptsEntityId[handle]) || !monoAPI.IsObjValid(obj))
+                if (!reg.EntityExists(csLoadedScriptsEntityId[handle]) || !monoAPI.IsObjValid(handle))
                 {
                     csScriptsToBeDeleted.push_back(handle);
                     continue;
@@ -595,29 +573,18 @@ namespace Popplio
 
                 if (!ent.GetComponent<LogicComponent>().currIsActive) continue;
 
-                try
-                {
-                    //if (ent.GetComponent<LogicComponent>().currIsActive != IsScriptActive(ent))
-                    //{
-                    //    CSOnActiveChange(ent, obj); // OnEnable / OnDisable
-                    //}
-                    //else
-                    //{
-                    //    if (!csScriptsOverridden[3][csScriptNames[obj]]) continue;
-
-                    //    monoAPI.CallMethod(obj, "FixedUpdate");
-                    //}
-
-                    if (!csScriptsOverridden[3][csScriptNames[handle]]) continue;
+                CSSetScriptState(handle, CSScriptState::ACTIVE);
+            }
 
-                    monoAPI.CallMethod(obj, "FixedUpdate");
-                }
-                catch (const std::exception& e)
-                {
-                    std::stringstream ss{ "" };
-                    ss << "LogicSystem: FixedUpdate | Exception in C# script: " << std::string(e.what());
-                    Logger::Error(ss.str());
-                }
+            try
+            {
+                CSRunLoopPhase(CSLoopMethod::FIXED_UPDATE);
+            }
+            catch (const std::exception& e)
+            {
+                std::stringstream ss{ "" };
+                ss << "LogicSystem: FixedUpdate | Exception in C# script: " << std::string(e.what());
+                Logger::Error(ss.str());
             }
 
             // delete scripts
@@ -671,10 +638,10 @@ namespace Popplio
         //static std::vector<MonoObject*> scriptsToBeDeleted{};
         // update logic components with current object addresses
         CSUpdateLogicObjects();
+        CSBeginLoopPhase();
         currentLoop = csLoadedScripts;
         for (uint32_t handle : currentLoop)
         {
-            MonoObject* obj = mono_gchandle_get_target(handle);
             auto ent = reg.GetEntityById(csLoadedScriptsEntityId[handle]);
             if (!ent.Exists())
             {
@@ -692,24 +659,23 @@ namespace Popplio
 
             if (!(ent.GetComponent<LogicComponent>().isActive)) continue;
 
-            if (!csScriptsOverridden[4][csScriptNames[handle]]) continue;
+            CSSetScriptState(handle, CSScriptState::ACTIVE);
+        }
 
-            try
-            {
-                monoAPI.CallMethod(obj, "End");
-            }
-            catch (const std::exception& e)
-            {
-                std::stringstream ss{ "" };
-                ss << "LogicSystem: End | Exception in C# script: " << std::string(e.what());
-                Logger::Error(ss.str());
-            }
+        try
+        {
+            CSRunLoopPhase(CSLoopMethod::END);
+        }
+        catch (const std::exception& e)
+        {
+            std::stringstream ss{ "" };
+            ss << "LogicSystem: End | Exception in C# script: " << std::string(e.what());
+            Logger::Error(ss.str());
         }
 
         CSDeleteScripts();
 
-        csScriptsOverridden.clear();
-        csScriptNames.clear();
+        CSClearScriptSlots();
         csEntityLoadedScripts.clear();
         csLoadedScriptsEntityId.clear();
         csScriptsToBeDeleted.clear();
@@ -117,6 +117,57 @@ namespace Popplio
 
     static DataRegistry dataReg{}; // registry for scripts
 
+    /*
+    *   loop methods of c# scripts, same values as Team_Popplio.ScriptPhase
+    */
+    enum class CSLoopMethod : int
+    {
+        SETUP,
+        INIT,
+        UPDATE,
+        FIXED_UPDATE,
+        END,
+        COUNT
+    };
+
+    /*
+    *   c# script slot states shared with Team_Popplio.ScriptScheduler, same values as Team_Popplio.ScriptState
+    */
+    enum class CSScriptState : int
+    {
+        FREE,
+        INACTIVE,
+        ACTIVE,
+        ENABLE,     // OnEnable in the next phase, loop method skipped
+        DISABLE,    // OnDisable in the next phase, loop method skipped
+        DESTROYED   // released in the next phase
+    };
+
+    /*
+    *   static methods of Team_Popplio.ScriptScheduler, resolved once per assembly load
+    */
+    struct CSSchedulerMethods
+    {
+        PopplioScriptAPI::MonoThunk<int, MonoObject*> registerScript{};
+        PopplioScriptAPI::MonoThunk<> clearScripts{};
+        PopplioScriptAPI::MonoThunk<int, int*, int*, int*, int> runScripts{};
+    };
+
+    /*
+    *   static methods of Team_Popplio.Events called by the engine, resolved once per assembly load
+    */
+    struct CSEventMethods
+    {
+        PopplioScriptAPI::MonoThunk<int> onEnable{};
+        PopplioScriptAPI::MonoThunk<int> onDisable{};
+        PopplioScriptAPI::MonoThunk<int> onEntityCreate{};
+        PopplioScriptAPI::MonoThunk<int> onEntityDestroy{};
+        PopplioScriptAPI::MonoThunk<int, int> onEntityChange{};
+        PopplioScriptAPI::MonoThunk<MonoArray*, MonoArray*> onCollision2DBatch{};
+        PopplioScriptAPI::MonoThunk<MonoArray*, MonoArray*> onTrigger2DBatch{};
+        PopplioScriptAPI::MonoThunk<> onAppQuit{};
+    };
+
     /*
     *   logic system of c++ and c# scripts
     */
@@ -145,7 +196,23 @@ namespace Popplio
         std::vector<uint32_t> csLoadedScripts; // cs scripts loaded in current run
         std::vector<uint32_t> csScriptsToBeDeleted; // scripts to be deleted
 
-        std::unordered_map<uint32_t, std::string> csScriptNames{}; // script names
+        // script slots of the managed scheduler, states and entities are read by C# during a phase
+        std::unordered_map<uint32_t, int> csScriptSlots{}; // slot per loaded script
+        std::vector<int> csScriptStates{}; // CSScriptState per slot
+        std::vector<int> csScriptEntities{}; // entity per slot
+        std::vector<int> csFreeSlots{};
+        std::vector<int> csDestroyedSlots{}; // free once C# has released them
+        std::vector<int> csScriptOrder{}; // registered slots in load order, the order C# runs them in
+
+        // C# holds pointers into the slot buffers during a phase, so scripts loaded or cleared
+        // by a script in the phase are applied once it returns
+        bool csRunningPhase{};
+        bool csClearPending{};
+        std::vector<std::pair<uint32_t, int>> csPendingScripts{}; // handle, entity
+
+        CSEventMethods csEventMethods{};
+        CSSchedulerMethods csSchedulerMethods{};
+        unsigned csMethodsGeneration{}; // assembly generation the methods were resolved in, 0 if none
         std::unordered_map<int, uint32_t> csEntityLoadedScripts{}; // entity scripts
         std::unordered_map<uint32_t, int> csLoadedScriptsEntityId{}; // script entity ids
 
@@ -154,8 +221,6 @@ namespace Popplio
         //std::vector<MonoClass*> csScripts; // cs scripts from mono
         //std::vector<MonoObject*> csLoadedScripts; // cs scripts loaded in current run
         //std::vector<MonoObject*> csScriptsToBeDeleted; // scripts to be deleted
-        std::vector<std::unordered_map<std::string, bool>> csScriptsOverridden
-            {std::vector<std::unordered_map<std::string, bool>>(5)}; // scripts that have overridden loop methods
         //std::unordered_map<MonoObject*, std::string> csScriptNames{}; // script names
         //std::unordered_map<int, MonoObject*> csEntityLoadedScripts{}; // entity scripts
         //std::unordered_map<MonoObject*, int> csLoadedScriptsEntityId{}; // script entity ids
@@ -313,14 +378,14 @@ namespace Popplio
         void CSDeleteScripts();
 
         /*
-        *   collision handler
+        *   collision handler, all collisions of the frame in one call to C#
         */
-        void CSOnCollision(CollisionEvent& event);
+        void CSOnCollision(EventBatch<CollisionEvent>& batch);
 
         /*
-        *   trigger handler
+        *   trigger handler, all triggers of the frame in one call to C#
         */
-        void CSOnTrigger(TriggerEvent& event);
+        void CSOnTrigger(EventBatch<TriggerEvent>& batch);
 
         /*
         *   entity change handler
@@ -365,6 +430,47 @@ namespace Popplio
         void CSAddToLoadedScripts(int id);
 
         void CSUpdateLogicObjects();
+
+        /*
+        *   get the Team_Popplio.Events methods
+        */
+        CSEventMethods const& GetCSEventMethods();
+
+        /*
+        *   give a loaded c# script a slot in the managed scheduler
+        */
+        void CSRegisterScript(uint32_t handle, MonoObject* obj, int entity);
+
+        /*
+        *   set the state of a loaded c# script for the next phase
+        */
+        void CSSetScriptState(uint32_t handle, CSScriptState state);
+
+        /*
+        *   mark every live script inactive, the phase loop then marks the ones to run
+        */
+        void CSBeginLoopPhase();
+
+        /*
+        *   run a loop phase on every active script, one call to C#
+        */
+        void CSRunLoopPhase(CSLoopMethod method);
+
+        /*
+        *   release every script slot on both sides
+        */
+        void CSClearScriptSlots();
+
+        /*
+        *   apply the clear and the registrations requested during the phase that just ran
+        */
+        void CSApplyPendingScripts();
+
+        private:
+        /*
+        *   drop the resolved methods if the assembly was reloaded since
+        */
+        void CSCheckMethods();
     };
 }
 
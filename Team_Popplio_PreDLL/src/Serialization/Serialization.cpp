@@ -32,6 +32,7 @@ Technology is prohibited.
 #include "../PerformanceViewer/PerformanceViewer.h"
 
 #include "../Cloning/CloneSystem.h"
+#include "../Collision/CollisionSystem.h"
 
 #include <filesystem>
 
@@ -120,6 +121,10 @@ namespace Popplio
 		DeserializeLayers();
 		DeserializeEntities();
 		DeserializeCameraSettings(cameraMgr);
+		DeserializeCollisionSettings();
+
+		// Add the loaded entities to their systems before the scene loaded handlers run
+		registry.Update();
 
 		//registry.RestorePersistentEntities(signatures); // Restore persistent entities after deserializing scene
 
@@ -132,10 +137,10 @@ namespace Popplio
 
 		Logger::Info("Successfully loaded level data from: " + filename);
 		std::filesystem::current_path(std::filesystem::path(Popplio::Engine::programPath));
-		PerformanceViewer::GetInstance()->end("Serializer");
+		const std::chrono::microseconds loadTime = PerformanceViewer::GetInstance()->end("Serializer");
 
 		Logger::Info("Scene Load | Time taken: " +
-			std::to_string(PerformanceViewer::GetInstance()->GetSystemTime("Serializer").count() / 1000000.0) +
+			std::to_string(loadTime.count() / 1000000.0) +
 			" seconds");
 
 		return true;
@@ -190,6 +195,11 @@ namespace Popplio
 			configuration.vSync = document["v-sync"].GetBool();
 		}
 
+		if (document.HasMember("archetype storage") && document["archetype storage"].IsBool())
+		{
+			configuration.archetypeStorage = document["archetype storage"].GetBool();
+		}
+
 		if (document.HasMember("safe mode") && document["safe mode"].IsBool())
 		{
 			configuration.safeMode = document["safe mode"].GetBool();
@@ -216,6 +226,7 @@ namespace Popplio
             << ", App Version: " << configuration.appVer
 			<< ", Window: " << configuration.width << "x" << configuration.height
 			<< ", V-Sync: " << (configuration.vSync ? "On" : "Off")
+			<< ", Archetype Storage: " << (configuration.archetypeStorage ? "On" : "Off")
 			<< ", Safe Mode: " << (configuration.safeMode ? "On" : "Off")
 			<< ", Last Scene: " << (configuration.lastScene)
 			<< ", Start Scene: " << (configuration.startScene)
@@ -1187,6 +1198,7 @@ namespace Popplio
 		SerializeEntities();
 		SerializeLayers();
 		SerializeCameraSettings(cameraMgr);
+		SerializeCollisionSettings();
 
 		rapidjson::StringBuffer buffer;
 		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
@@ -1889,4 +1901,47 @@ namespace Popplio
 			camera.SetZoom(cameraSettings["zoom"].GetFloat());
 		}
 	}
+
+	void Serializer::SerializeCollisionSettings()
+	{
+		if (!registry.HasSystem<CollisionSystem>()) return;
+
+		auto& allocator = document.GetAllocator();
+		const auto& collisionSystem = registry.GetSystem<CollisionSystem>();
+
+		rapidjson::Value collisionSettings(rapidjson::kObjectType);
+		collisionSettings.AddMember("broad phase",
+			rapidjson::Value(BroadPhaseTypeToString(collisionSystem.GetBroadPhaseType()).c_str(), allocator).Move(), allocator);
+		collisionSettings.AddMember("cell size", collisionSystem.GetCellSize(), allocator);
+
+		document.AddMember("collision_settings", collisionSettings, allocator);
+	}
+
+	void Serializer::DeserializeCollisionSettings()
+	{
+		if (!registry.HasSystem<CollisionSystem>()) return;
+
+		// Scenes saved before the broad phase was added use the default
+		BroadPhaseType type = BroadPhaseType::SORT_AND_SWEEP;
+		float cellSize = CollisionSystem::DEFAULT_CELL_SIZE;
+
+		if (document.HasMember("collision_settings"))
+		{
+			const auto& collisionSettings = document["collision_settings"];
+
+			if (collisionSettings.HasMember("broad phase") && collisionSettings["broad phase"].IsString())
+			{
+				type = BroadPhaseTypeFromString(collisionSettings["broad phase"].GetString());
+			}
+			if (collisionSettings.HasMember("cell size") && collisionSettings["cell size"].IsNumber())
+			{
+				cellSize = collisionSettings["cell size"].GetFloat();
+			}
+		}
+
+		registry.GetSystem<CollisionSystem>().SetBroadPhase(type, cellSize);
+
+		// Contacts of the previous scene would give the new entities reusing their ids stale events
+		registry.GetSystem<CollisionSystem>().ClearContacts();
+	}
 }
\ No newline at end of file
@@ -65,6 +65,7 @@ namespace Popplio
 		int width; /**< The width of the configuration. */
 		int height; /**< The height of the configuration. */
 		bool vSync; /**< The vSync flag of the configuration. */
+		bool archetypeStorage = false; /**< The ECS archetype storage flag of the configuration. */
 
 		// editor
 		bool safeMode; /**< The safe mode flag (editor) of the configuration. */
@@ -349,6 +350,9 @@ namespace Popplio
 		void SerializeCameraSettings(CameraManager& cameraManager);
 		void DeserializeCameraSettings(CameraManager& cameraManager);
 
+		void SerializeCollisionSettings();
+		void DeserializeCollisionSettings();
+
 		Registry& registry; /**< The registry to access entities. */
 		rapidjson::Document document; /**< The JSON document. */
 		Config configuration; /**< The configuration settings. */
@@ -24,40 +24,33 @@ Technology is prohibited.
 
 namespace Popplio
 {
-	TransformationSystem::TransformationSystem()
+	TransformationSystem::TransformationSystem(Registry& r) : reg(r)
 	{
 		RequireComponent<TransformComponent>();
 	}
 
 	void TransformationSystem::Update()
 	{
-		for (auto& entity : GetSystemEntities())
+		reg.View<TransformComponent>(*this).Each([this](Entity entity, TransformComponent& transform)
 		{
-			auto& transform = entity.GetComponent<TransformComponent>();
-
-   //         static PopplioMath::M3x3f prevModelMatrix;
-			//prevModelMatrix = transform.modelMatrix;
-
+			const PopplioMath::M3x3f previous = transform.modelMatrix;
 			UpdateModelMatrix(transform);
-
-			//// If entity is a child and inherits transform
-			//if (prevModelMatrix != transform.modelMatrix)
-			//{
-			//	if (entity.HasComponent<ParentComponent>() && entity.GetComponent<ParentComponent>().parent.Exists() &&
-			//		entity.GetComponent<ParentComponent>().inheritTransform)
-			//	{
-			//		entity.GetComponent<ParentComponent>().UpdateLocalTransform(
-			//			transform, entity.GetComponent<ParentComponent>().parent.GetComponent<TransformComponent>());
-			//	}
-			//}
-
-			// If the entity has a BoxColliderComponent, update its matrix too
-			if (entity.HasComponent<BoxColliderComponent>())
-			{
-				auto& collider = entity.GetComponent<BoxColliderComponent>();
-				UpdateColliderMatrix(transform, collider);
-			}
-		}
+			if (transform.modelMatrix == previous) return;
+
+			// Recorded once until taken, however many updates run in between
+			const int id = entity.GetId();
+			if (static_cast<size_t>(id) >= isMoved.size()) isMoved.resize(static_cast<size_t>(id) + 1, 0);
+			if (isMoved[id]) return;
+			isMoved[id] = 1;
+			movedEntities.push_back(id);
+		});
+
+		// If the entity has a BoxColliderComponent, update its matrix too
+		reg.View<TransformComponent, BoxColliderComponent>(*this).Each(
+			[this](TransformComponent& transform, BoxColliderComponent& collider)
+		{
+			UpdateColliderMatrix(transform, collider);
+		});
 	}
 
 	void TransformationSystem::UpdateModelMatrix(TransformComponent& transform)
@@ -99,6 +92,13 @@ namespace Popplio
 
 
 
+	void TransformationSystem::TakeMovedEntities(std::vector<int>& moved)
+	{
+		moved.clear();
+		moved.swap(movedEntities);
+		for (int id : moved) isMoved[id] = 0;
+	}
+
 	void TransformationSystem::UpdateColliderMatrix(const TransformComponent& transform, BoxColliderComponent& collider)
 	{
 		PopplioMath::M3x3f translateMat, scaleMat;
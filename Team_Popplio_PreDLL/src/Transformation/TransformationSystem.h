@@ -24,17 +24,30 @@ Technology is prohibited.
 #include "../Math/Matrix2D.h"
 #include "../EventBus/EventBus.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace Popplio
 {
     class TransformationSystem : public System
     {
+        Registry& reg;
+
     public:
-        TransformationSystem();
+        TransformationSystem(Registry& r);
 
         void Update();
 
         void UpdateModelMatrix(TransformComponent& transform);
 
         void UpdateColliderMatrix(const TransformComponent& transform, BoxColliderComponent& collider);
+
+        // Hands over the ids of the entities whose model matrix changed since the last call, each once
+        // moved is cleared first and keeps its capacity for the next call
+        void TakeMovedEntities(std::vector<int>& moved);
+
+    private:
+        std::vector<int> movedEntities;
+        std::vector<std::uint8_t> isMoved; // by entity id, 1 if in movedEntities
     };
 }
\ No newline at end of file
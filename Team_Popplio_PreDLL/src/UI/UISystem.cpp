@@ -97,6 +97,7 @@ namespace Popplio {
         worldPos = cameraManager.GetGameCamera().ScreenToWorld(mousePos);
 #endif    
 
+        // Snapshot, click callbacks can spawn or kill UI entities
         for (auto& entity : GetSystemEntities())
         {
             if (!entity.GetComponent<ActiveComponent>().isActive) continue;
@@ -130,24 +131,28 @@ namespace Popplio {
                 }
             }
 
-            Logger::Debug("[DEBUG] UI Button Actions: ");
-            std::string log = "";
-            for (const auto& action : uiComponent.onClickActions)
-            {
-                log += action + ", ";
-            }
-            Logger::Debug(log);
-
             auto& registry = FunctionRegistry::GetInstance();
 
-            auto availableFunctions = registry.GetAllFunctionNames();
-            Logger::Debug("[DEBUG] Available Functions: ");
-            log = "";
-            for (const auto& func : availableFunctions)
+            // Built every frame per element, only when debug messages are logged
+            if (Logger::IsEnabled(LogLevel::DEBUG_LOG))
             {
-                log += func + ", ";
+                Logger::Debug("[DEBUG] UI Button Actions: ");
+                std::string log = "";
+                for (const auto& action : uiComponent.onClickActions)
+                {
+                    log += action + ", ";
+                }
+                Logger::Debug(log);
+
+                auto availableFunctions = registry.GetAllFunctionNames();
+                Logger::Debug("[DEBUG] Available Functions: ");
+                log = "";
+                for (const auto& func : availableFunctions)
+                {
+                    log += func + ", ";
+                }
+                Logger::Debug(log);
             }
-            Logger::Debug(log);
 
             if (isMouseClickDragged)
             {
@@ -198,11 +198,13 @@ namespace Popplio
 
 			// Log to engine logger if available
 			Logger::Critical("Application crashed. Crash report saved to: " + logFileName, LogDestination::WINDOWS_CONSOLE);
+			Logger::Flush();
 		}
 		catch (...)
 		{
 			// If we fail to write the crash log, at least try to log the error
 			Logger::Critical("Failed to write crash report", LogDestination::WINDOWS_CONSOLE);
+			Logger::Flush();
 		}
 
 		return EXCEPTION_CONTINUE_SEARCH;
@@ -0,0 +1,110 @@
+/******************************************************************************/
+/*!
+\file   TestAssets.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for asset loading benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestAssets.h"
+
+#include "../src/AssetStore/AssetBatchLoader.h"
+
+#include <cstring>
+#include <thread>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        struct LoadResult
+        {
+            size_t workers{};
+            double loadMs{};
+            double uploadMs{};
+        };
+
+        LoadResult TimeLoad(Popplio::AudioSystem& audioSystem, Popplio::LogicSystem& logicSystem, size_t workers)
+        {
+            Popplio::AssetBatchLoader loader(audioSystem, logicSystem, workers);
+            loader.SetStoreResults(false);
+            loader.ScanAssets();
+            loader.StartLoading(nullptr);
+            while (loader.ProcessBatch()) {}
+
+            return { loader.GetWorkerCount(), loader.GetLoadTimeMs(), loader.GetUploadTimeMs() };
+        }
+
+        // the flip on load is per thread, a worker must decode the same pixels as the main thread
+        bool CheckWorkerDecode()
+        {
+            std::filesystem::path texturePath{};
+            for (auto const& entry : std::filesystem::recursive_directory_iterator(std::filesystem::current_path()))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".png")
+                {
+                    texturePath = entry.path();
+                    break;
+                }
+            }
+            if (texturePath.empty()) return true;
+
+            Popplio::TextureImage workerImage{};
+            std::thread worker([&workerImage, &texturePath] { workerImage = Popplio::Texture::Decode(texturePath.string()); });
+            worker.join();
+            Popplio::TextureImage mainImage = Popplio::Texture::Decode(texturePath.string());
+
+            return workerImage.pixels && mainImage.pixels &&
+                workerImage.width == mainImage.width && workerImage.height == mainImage.height &&
+                std::memcmp(workerImage.pixels.get(), mainImage.pixels.get(), static_cast<size_t>(mainImage.width) * mainImage.height * 4) == 0;
+        }
+    }
+
+    void BenchmarkAssetLoading(Popplio::AudioSystem& audioSystem, Popplio::LogicSystem& logicSystem)
+    {
+        Popplio::Logger::Info("Starting asset loading benchmark");
+
+        // the first pass reads the files from disk, unless they were read since the OS started
+        // (the editor loads the same assets at startup, so it is usually warm as well)
+        const LoadResult first = TimeLoad(audioSystem, logicSystem, 8);
+        {
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3) << "first pass (cold if the files were not cached): " << first.workers
+                << " workers | wall: " << first.loadMs << " ms | main thread: " << first.uploadMs << " ms";
+            Popplio::Logger::Info(ss.str());
+        }
+
+        // the worker counts are compared warm, with every file in the OS file cache after the first pass,
+        // so disk speed and cache state do not favour the later runs
+        std::vector<LoadResult> results{};
+        for (size_t workers : { 1, 4, 8 }) results.push_back(TimeLoad(audioSystem, logicSystem, workers));
+
+        for (LoadResult const& result : results)
+        {
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3) << "warm: " << result.workers << " workers"
+                << " | wall: " << result.loadMs << " ms (" << std::setprecision(2) << results.front().loadMs / result.loadMs << "x)"
+                << std::setprecision(3) << " | main thread: " << result.uploadMs << " ms";
+            Popplio::Logger::Info(ss.str());
+        }
+
+        if (!CheckWorkerDecode()) Popplio::Logger::Error("Asset loading worker decode mismatch");
+        else Popplio::Logger::Info("Asset loading decode checks passed");
+
+        Popplio::Logger::Info("Asset loading benchmark completed");
+    }
+}
@@ -0,0 +1,37 @@
+/******************************************************************************/
+/*!
+\file   TestAssets.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for asset loading benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace Popplio
+{
+    class AudioSystem;
+    class LogicSystem;
+}
+
+namespace PopplioTest
+{
+    /*
+    *   loads every asset under the working directory with the batch loader, uploading the textures and fonts then
+    *   releasing them instead of storing them, logs the wall time and the main thread time of a first (cold unless
+    *   cached) pass at 8 worker threads then of warm passes at 1 / 4 / 8 worker threads, and checks a texture decoded on a worker matches the same texture decoded on this thread
+    */
+    void BenchmarkAssetLoading(Popplio::AudioSystem& audioSystem, Popplio::LogicSystem& logicSystem);
+}
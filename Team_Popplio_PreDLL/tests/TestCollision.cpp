@@ -0,0 +1,268 @@
+/******************************************************************************/
+/*!
+\file   TestCollision.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for collision micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestCollision.h"
+
+#include "../src/Collision/CollisionSystem.h"
+#include "../src/Collision/ContactPairTable.h"
+
+#include <random>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        // scatters bodies over a grid with one body per 96 x 96 cell, a quarter of them circles
+        void PopulateBodies(Popplio::Registry& reg, int count)
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> jitter(-24.f, 24.f);
+
+            const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+            for (int i{}; i < count; ++i)
+            {
+                const float x = static_cast<float>(i % columns) * 96.f + jitter(rng);
+                const float y = static_cast<float>(i / columns) * 96.f + jitter(rng);
+
+                Popplio::Entity e = reg.CreateEntity();
+                e.GetComponent<Popplio::TransformComponent>().position = PopplioMath::Vec2f(x, y);
+                e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+                if (i % 4 == 0) e.AddComponent<Popplio::CircleColliderComponent>(16.f);
+                else e.AddComponent<Popplio::BoxColliderComponent>(32.f, 32.f);
+            }
+            reg.Update();
+        }
+
+        // the spatial hash must find the same overlapping pairs as an exhaustive test when bounds are
+        // NaN, infinite or too far away for an int cell coordinate
+        bool CheckSpatialHashNonFinite()
+        {
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            const float inf = std::numeric_limits<float>::infinity();
+            const std::vector<Popplio::BroadPhaseProxy> proxies{
+                { 0, 0.f, 0.f, 32.f, 32.f },
+                { 1, 16.f, 16.f, 48.f, 48.f },
+                { 2, nan, 0.f, nan, 32.f },
+                { 3, -inf, -inf, inf, inf },
+                { 4, 1e30f, 1e30f, 1e30f + 32.f, 1e30f + 32.f },
+                { 5, 1e30f, 1e30f, 2e30f, 2e30f },
+                { 6, -1e30f, 0.f, -1e30f, 32.f } };
+
+            std::vector<Popplio::BroadPhasePair> expected{};
+            for (size_t a{}; a < proxies.size(); ++a)
+            {
+                for (size_t b = a + 1; b < proxies.size(); ++b)
+                {
+                    Popplio::BroadPhaseProxy const& pa = proxies[a];
+                    Popplio::BroadPhaseProxy const& pb = proxies[b];
+                    if (pa.minX <= pb.maxX && pb.minX <= pa.maxX && pa.minY <= pb.maxY && pb.minY <= pa.maxY)
+                        expected.emplace_back(pa.body, pb.body);
+                }
+            }
+
+            std::vector<Popplio::BroadPhasePair> pairs{};
+            Popplio::SpatialHashBroadPhase(64.f).FindPairs(proxies, pairs);
+            return pairs == expected;
+        }
+    }
+
+    void BenchmarkBroadPhase()
+    {
+        Popplio::Logger::Info("Starting broad phase benchmark");
+
+        static const float deltaTime = 1.f / 60.f;
+        static const Popplio::BroadPhaseType types[] = { Popplio::BroadPhaseType::BRUTE_FORCE,
+            Popplio::BroadPhaseType::SPATIAL_HASH, Popplio::BroadPhaseType::SORT_AND_SWEEP };
+
+        for (int count : { 100, 1000, 10000 })
+        {
+            // brute force at 10k tests ~50M pairs per step
+            const int steps = count >= 10000 ? 1 : 10;
+
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3) << count << " bodies";
+            for (Popplio::BroadPhaseType type : types)
+            {
+                Popplio::Registry reg{};
+                Popplio::EventBus bus{};
+                Popplio::LayerManager layers{};
+                Popplio::CollisionSystem collision(bus, layers);
+                collision.SetBroadPhase(type, 64.f);
+                PopulateBodies(reg, count);
+
+                auto start = BenchClock::now();
+                collision.Simulate(reg, deltaTime, steps);
+                double ms = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count() / steps;
+
+                ss << " | " << Popplio::BroadPhaseTypeToString(type) << ": "
+                    << collision.GetPairsTested() << " pairs, " << ms << " ms/step";
+            }
+            Popplio::Logger::Info(ss.str());
+        }
+
+        if (!CheckSpatialHashNonFinite()) Popplio::Logger::Error("Spatial hash non-finite bounds mismatch");
+
+        Popplio::Logger::Info("Broad phase benchmark completed");
+    }
+
+    void BenchmarkLayerFiltering()
+    {
+        Popplio::Logger::Info("Starting layer filtering benchmark");
+
+        static const int entityCount = 1000;
+        static const int layerCount = 8;
+
+        Popplio::Registry reg{};
+        Popplio::LayerManager layers{};
+        for (int l{}; l < layerCount; ++l) layers.AddLayer("Layer " + std::to_string(l));
+        for (int l{}; l < layerCount; l += 2)
+            layers.SetLayerInteraction("Layer " + std::to_string(l), "Layer " + std::to_string(l + 1), false);
+
+        std::vector<Popplio::Entity> entities{};
+        for (int i{}; i < entityCount; ++i)
+        {
+            entities.push_back(reg.CreateEntity());
+            // leave some entities without a layer
+            if (i % 10 != 0) layers.AddEntityToLayer(entities.back(), "Layer " + std::to_string(i % layerCount));
+        }
+
+        // previous per pair filter: look up both layer names, then the nested interaction map
+        int stringPasses{};
+        auto start = BenchClock::now();
+        for (Popplio::Entity const& e1 : entities)
+        {
+            std::string layer1 = layers.GetEntityLayer(e1);
+            for (Popplio::Entity const& e2 : entities)
+            {
+                std::string layer2 = layers.GetEntityLayer(e2);
+                if (layer1.empty() || layer2.empty() || layers.ShouldLayersInteract(layer1, layer2)) ++stringPasses;
+            }
+        }
+        double stringMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        int maskPasses{};
+        start = BenchClock::now();
+        for (Popplio::Entity const& e1 : entities)
+        {
+            const int layer1 = layers.GetEntityLayerId(e1.GetId());
+            for (Popplio::Entity const& e2 : entities)
+            {
+                if (layers.ShouldLayerIdsInteract(layer1, layers.GetEntityLayerId(e2.GetId()))) ++maskPasses;
+            }
+        }
+        double maskMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << entityCount * entityCount << " pairs"
+            << " | layer names: " << stringMs << " ms (" << stringPasses << " pass)"
+            << " | layer masks: " << maskMs << " ms (" << maskPasses << " pass)";
+        Popplio::Logger::Info(ss.str());
+
+        if (stringPasses != maskPasses) Popplio::Logger::Error("Layer filtering mismatch");
+
+        Popplio::Logger::Info("Layer filtering benchmark completed");
+    }
+
+    void BenchmarkContactPairs()
+    {
+        Popplio::Logger::Info("Starting contact pair benchmark");
+
+        static const int contactCount = 10000;
+        static const int steps = 100;
+
+        // the contacts of each step: most stay, a tenth are replaced by new pairs
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> entity(0, 4999);
+        std::vector<std::vector<std::pair<int, int>>> frames(steps);
+        std::vector<std::pair<int, int>> contacts{};
+        for (int i{}; i < contactCount; ++i) contacts.emplace_back(entity(rng), entity(rng));
+        for (auto& frame : frames)
+        {
+            for (int i{}; i < contactCount / 10; ++i) contacts[rng() % contactCount] = { entity(rng), entity(rng) };
+            frame = contacts;
+        }
+
+        // previous tracking: set of pairs, exits found by a lookup per tracked pair
+        size_t setEnters{}, setExits{};
+        auto start = BenchClock::now();
+        {
+            std::set<std::pair<int, int>> tracked{}, current{};
+            for (auto const& frame : frames)
+            {
+                current.clear();
+                for (auto const& [a, b] : frame)
+                {
+                    const std::pair<int, int> pair = std::minmax(a, b);
+                    if (tracked.find(pair) == tracked.end() && current.find(pair) == current.end()) ++setEnters;
+                    current.insert(pair);
+                }
+                for (auto const& pair : tracked)
+                {
+                    if (current.find(pair) == current.end()) ++setExits;
+                }
+                tracked.swap(current);
+            }
+        }
+        double setMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        size_t tableEnters{}, tableExits{};
+        start = BenchClock::now();
+        {
+            Popplio::ContactPairTable table{};
+            std::vector<std::uint64_t> exited{};
+            for (auto const& frame : frames)
+            {
+                table.BeginStep();
+                for (auto const& [a, b] : frame)
+                {
+                    if (!table.Touch(a, b)) ++tableEnters;
+                }
+                table.EndStep(exited);
+                tableExits += exited.size();
+            }
+        }
+        double tableMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << contactCount << " contacts x " << steps << " steps"
+            << " | pair set: " << setMs << " ms (" << setEnters << " enters, " << setExits << " exits)"
+            << " | pair table: " << tableMs << " ms (" << tableEnters << " enters, " << tableExits << " exits)";
+        Popplio::Logger::Info(ss.str());
+
+        if (setEnters != tableEnters || setExits != tableExits) Popplio::Logger::Error("Contact pair mismatch");
+
+        // a cleared table (scene change) forgets its pairs without exits
+        Popplio::ContactPairTable cleared{};
+        std::vector<std::uint64_t> clearedExits{};
+        cleared.BeginStep();
+        cleared.Touch(1, 2);
+        cleared.Clear();
+        cleared.BeginStep();
+        const bool reentered = !cleared.Touch(2, 1);
+        cleared.EndStep(clearedExits);
+        if (!reentered || !clearedExits.empty() || cleared.Size() != 1) Popplio::Logger::Error("Contact pair clear mismatch");
+
+        Popplio::Logger::Info("Contact pair benchmark completed");
+    }
+}
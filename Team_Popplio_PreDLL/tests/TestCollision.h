@@ -0,0 +1,43 @@
+/******************************************************************************/
+/*!
+\file   TestCollision.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for collision micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioTest
+{
+    /*
+    *   compares the pairs passed to the narrow phase and the time per collision step
+    *   of every broad phase at 100 / 1k / 10k bodies, and checks the spatial hash against an exhaustive test
+    *   for NaN, infinite and far away bounds
+    */
+    void BenchmarkBroadPhase();
+
+    /*
+    *   compares filtering 1M entity pairs by layer names against the layer id interaction masks
+    */
+    void BenchmarkLayerFiltering();
+
+    /*
+    *   compares tracking 10k contacts over 100 steps (10% of contacts changing per step)
+    *   in a set of id pairs against the contact pair table, and checks they report the same exits
+    *   and that a cleared table reports no exits
+    */
+    void BenchmarkContactPairs();
+}
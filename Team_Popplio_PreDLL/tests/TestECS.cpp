@@ -0,0 +1,517 @@
+/******************************************************************************/
+/*!
+\file   TestECS.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for ECS tests & micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestECS.h"
+
+#include "../src/Transformation/TransformationSystem.h"
+#include "../src/Graphic/RenderSystem.h"
+#include "../src/Physics/GravitySystem.h"
+#include "../src/Physics/MovementSystem.h"
+
+#include <random>
+#include <set>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        // milliseconds elapsed since start
+        double ElapsedMs(BenchClock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        // component used by the pool benchmarks, sized like a small engine component
+        struct BenchComponent
+        {
+            float x{}, y{}, z{}, w{};
+        };
+
+        // component whose constructor throws on request, for the archetype move checks
+        struct ThrowingComponent
+        {
+            explicit ThrowingComponent(bool fail)
+            {
+                if (fail) throw std::runtime_error("ThrowingComponent");
+            }
+        };
+
+        // component built from a reference to another component of the same entity
+        struct TransformCopyComponent
+        {
+            explicit TransformCopyComponent(Popplio::TransformComponent const& source) : transform(source) {}
+            Popplio::TransformComponent transform;
+        };
+
+        // system keeping transforms that counts the rigid body changes of its entities
+        class WatchingSystem : public Popplio::System
+        {
+        public:
+            WatchingSystem()
+            {
+                RequireComponent<Popplio::TransformComponent>();
+                WatchComponent<Popplio::RigidBodyComponent>();
+            }
+
+            void OnWatchedComponentChanged(Popplio::Entity) override { ++changes; }
+
+            int changes{};
+        };
+
+        // pool implementation prior to the sparse set (kept for comparison)
+        template <typename T>
+        class LegacyPool
+        {
+        public:
+            void Set(int entityId, T&& object)
+            {
+                int index = static_cast<int>(data.size());
+                entityIdToIndex.emplace(entityId, index);
+                indexToEntityId.emplace(index, entityId);
+                data.push_back(std::move(object));
+            }
+
+            T& Get(int entityId)
+            {
+                auto it = entityIdToIndex.find(entityId);
+                if (it == entityIdToIndex.end())
+                {
+                    throw std::out_of_range("Trying to get non-existent component");
+                }
+                return data[it->second];
+            }
+
+        private:
+            std::vector<T> data;
+            std::unordered_map<int, int> entityIdToIndex;
+            std::unordered_map<int, int> indexToEntityId;
+        };
+
+        // random access pattern shared by both pools
+        std::vector<int> ShuffledIds(int count)
+        {
+            std::vector<int> ids(count);
+            for (int i{}; i < count; ++i) ids[i] = i;
+            std::shuffle(ids.begin(), ids.end(), std::mt19937(1234));
+            return ids;
+        }
+
+        template <typename TPool>
+        double TimeGets(TPool& pool, std::vector<int> const& ids, int passes, float& sink)
+        {
+            auto start = BenchClock::now();
+            for (int p{}; p < passes; ++p)
+            {
+                for (int id : ids)
+                {
+                    sink += pool.Get(id).x;
+                }
+            }
+            return ElapsedMs(start);
+        }
+
+        // fills the registry with renderable bodies, churning components so pools are not in entity order
+        void PopulateStorageBench(Popplio::Registry& reg, int count)
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+
+            std::vector<Popplio::Entity> created{};
+            created.reserve(count);
+            for (int i{}; i < count; ++i)
+            {
+                Popplio::Entity e = reg.CreateEntity();
+                e.AddComponent<Popplio::ActiveComponent>();
+                e.AddComponent<Popplio::TransformComponent>(pos(rng), pos(rng), 32.f, 32.f, static_cast<double>(i % 360));
+                e.AddComponent<Popplio::RenderComponent>(Popplio::MeshType::Quad, "default_shader", "", true);
+                e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+                created.push_back(e);
+            }
+
+            // components removed and re-added during gameplay end up at the back of their pools
+            std::shuffle(created.begin(), created.end(), rng);
+            for (int i{}; i < count / 2; ++i)
+            {
+                Popplio::TransformComponent transform = created[i].GetComponent<Popplio::TransformComponent>();
+                created[i].RemoveComponent<Popplio::TransformComponent>();
+                created[i].AddComponent<Popplio::TransformComponent>(transform);
+            }
+        }
+
+        // a loop over a system's entities that removes and adds members must still visit each entity it started with once
+        bool CheckMembershipChangesWhileIterating()
+        {
+            static const int count = 1000;
+
+            Popplio::Registry reg{};
+            reg.AddSystem<Popplio::MovementSystem>();
+            for (int i{}; i < count; ++i)
+            {
+                reg.CreateEntity().AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+            }
+            // created entities only join their systems on Update(), so the entities gaining members are made up front
+            std::vector<Popplio::Entity> spare{};
+            for (int i{}; i < count; ++i) spare.push_back(reg.CreateEntity());
+            reg.Update();
+
+            std::vector<int> visits(count * 2, 0);
+            int visited{};
+            for (Popplio::Entity e : reg.GetSystem<Popplio::MovementSystem>().GetSystemEntities())
+            {
+                if (e.GetId() < 0 || e.GetId() >= count) return false;
+                ++visits[e.GetId()];
+                ++visited;
+
+                // swap-removes this entity from the system and appends a spare one, both update the registry
+                e.RemoveComponent<Popplio::RigidBodyComponent>();
+                spare[e.GetId()].AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+            }
+
+            return visited == count && std::all_of(visits.begin(), visits.begin() + count, [](int v) { return v == 1; }) &&
+                reg.GetSystem<Popplio::MovementSystem>().GetSystemEntities().size() == static_cast<size_t>(count);
+        }
+
+        // a system's view must skip entities stashed out of the systems, which keep their components in the pools
+        bool CheckSystemViewSkipsStashed()
+        {
+            static const int count = 100;
+
+            Popplio::Registry reg{};
+            reg.AddSystem<Popplio::MovementSystem>();
+            std::set<Popplio::Entity> persistent{};
+            for (int i{}; i < count; ++i)
+            {
+                Popplio::Entity e = reg.CreateEntity();
+                e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+                if (i % 10 == 0) persistent.insert(e);
+            }
+            reg.Update();
+            reg.StashPersistentEntities(persistent);
+
+            Popplio::MovementSystem const& system = reg.GetSystem<Popplio::MovementSystem>();
+            int inSystem{}, inPools{};
+            bool stashedVisited{};
+            reg.View<Popplio::RigidBodyComponent>(system).Each([&](Popplio::Entity e, Popplio::RigidBodyComponent&)
+            {
+                ++inSystem;
+                stashedVisited |= persistent.count(e) != 0;
+            });
+            reg.View<Popplio::RigidBodyComponent>().Each([&](Popplio::RigidBodyComponent&) { ++inPools; });
+
+            return !stashedVisited && inSystem == count - static_cast<int>(persistent.size()) && inPools == count &&
+                static_cast<size_t>(inSystem) == system.GetSystemEntities().size();
+        }
+
+        // a system must hear of watched components added or removed on its entities, directly or deferred,
+        // but not of the components an entity is created with
+        bool CheckWatchedComponents()
+        {
+            Popplio::Registry reg{};
+            reg.AddSystem<WatchingSystem>();
+            WatchingSystem& system = reg.GetSystem<WatchingSystem>();
+
+            Popplio::Entity e = reg.CreateEntity();
+            reg.CreateEntity().AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+            reg.Update();
+            if (system.changes != 0 || system.GetSystemEntities().size() != 2) return false;
+
+            e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+            e.RemoveComponent<Popplio::RigidBodyComponent>();
+            reg.DeferAddComponent<Popplio::RigidBodyComponent>(e, 1.f, false, 1.f, 0.f, 0.f);
+            reg.Update();
+            return system.changes == 3 && e.HasComponent<Popplio::RigidBodyComponent>();
+        }
+
+        // adding a component in archetype storage must leave the entity intact if the constructor throws,
+        // and must construct from arguments referring to the entity's current row before that row moves
+        bool CheckArchetypeAdd()
+        {
+            Popplio::Registry reg{};
+            reg.SetStorageMode(Popplio::Registry::StorageMode::ARCHETYPE);
+
+            Popplio::Entity e = reg.CreateEntity();
+            e.AddComponent<Popplio::TransformComponent>(12.f, 34.f);
+            reg.CreateEntity().AddComponent<Popplio::TransformComponent>(56.f, 78.f);
+
+            bool threw{};
+            try
+            {
+                e.AddComponent<ThrowingComponent>(true);
+            }
+            catch (std::runtime_error const&)
+            {
+                threw = true;
+            }
+            if (!threw || e.HasComponent<ThrowingComponent>() || reg.View<Popplio::TransformComponent>().SizeHint() != 2 ||
+                e.GetComponent<Popplio::TransformComponent>().position.x != 12.f)
+            {
+                return false;
+            }
+
+            e.AddComponent<TransformCopyComponent>(e.GetComponent<Popplio::TransformComponent>());
+            return e.GetComponent<TransformCopyComponent>().transform.position.x == 12.f &&
+                e.GetComponent<TransformCopyComponent>().transform.position.y == 34.f &&
+                e.GetComponent<Popplio::TransformComponent>().position.y == 34.f;
+        }
+
+        // builds per-instance data the way RenderSystem::RenderInstanced does
+        void BatchInstances(Popplio::Registry& reg, std::vector<Popplio::InstanceData>& instances)
+        {
+            instances.clear();
+            reg.View<Popplio::ActiveComponent, Popplio::TransformComponent, Popplio::RenderComponent>().Each(
+                [&](Popplio::ActiveComponent& active, Popplio::TransformComponent& transform, Popplio::RenderComponent& render)
+            {
+                if (!active.isActive || !render.isActive) return;
+                instances.push_back({ transform.modelMatrix.ToGLM(), render.color, render.alpha,
+                    glm::vec4(0.f, 0.f, 1.f, 1.f) });
+            });
+        }
+    }
+
+    void BenchmarkPoolGetComponent()
+    {
+        Popplio::Logger::Info("Starting Pool GetComponent benchmark");
+
+        static const int passes = 20;
+        for (int count : { 10000, 100000 })
+        {
+            Popplio::Pool<BenchComponent> pool{};
+            LegacyPool<BenchComponent> legacy{};
+            for (int i{}; i < count; ++i)
+            {
+                pool.Set(i, BenchComponent{ static_cast<float>(i) });
+                legacy.Set(i, BenchComponent{ static_cast<float>(i) });
+            }
+
+            std::vector<int> ids = ShuffledIds(count);
+            float sink{};
+            double legacyMs = TimeGets(legacy, ids, passes, sink);
+            double poolMs = TimeGets(pool, ids, passes, sink);
+
+            double lookups = static_cast<double>(count) * passes;
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(2)
+                << count << " entities | unordered_map: " << lookups / legacyMs / 1000.0 << " M gets/s"
+                << " | sparse set: " << lookups / poolMs / 1000.0 << " M gets/s"
+                << " | speedup x" << legacyMs / poolMs
+                << " (checksum " << sink << ")";
+            Popplio::Logger::Info(ss.str());
+        }
+
+        Popplio::Logger::Info("Pool GetComponent benchmark completed");
+    }
+
+    void BenchmarkStorageModes()
+    {
+        Popplio::Logger::Info("Starting storage mode benchmark");
+
+        static const int count = 50000;
+        static const int passes = 20;
+
+        double transformMs[2]{}, batchMs[2]{}, structuralMs[2]{};
+        size_t instanceCount{};
+        for (int mode{}; mode < 2; ++mode)
+        {
+            Popplio::Registry reg{};
+            reg.SetStorageMode(mode == 0 ? Popplio::Registry::StorageMode::SPARSE_SET :
+                Popplio::Registry::StorageMode::ARCHETYPE);
+            PopulateStorageBench(reg, count);
+
+            Popplio::TransformationSystem transformation(reg);
+            std::vector<Popplio::InstanceData> instances{};
+            instances.reserve(count);
+
+            for (int p{}; p < passes; ++p)
+            {
+                auto start = BenchClock::now();
+                transformation.Update();
+                transformMs[mode] += ElapsedMs(start);
+
+                start = BenchClock::now();
+                BatchInstances(reg, instances);
+                batchMs[mode] += ElapsedMs(start);
+            }
+            instanceCount = instances.size();
+
+            // remove and add a component of every body through the public API, which moves rows between archetypes
+            std::vector<Popplio::Entity> bodies{};
+            reg.View<Popplio::RigidBodyComponent>().Each([&](Popplio::Entity e, Popplio::RigidBodyComponent&) { bodies.push_back(e); });
+            for (int p{}; p < passes; ++p)
+            {
+                auto start = BenchClock::now();
+                for (Popplio::Entity e : bodies) e.RemoveComponent<Popplio::RigidBodyComponent>();
+                for (Popplio::Entity e : bodies) e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+                structuralMs[mode] += ElapsedMs(start);
+            }
+        }
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3)
+            << count << " entities (" << instanceCount << " instances)"
+            << " | transform pass: sparse set " << transformMs[0] / passes << " ms, archetype " << transformMs[1] / passes
+            << " ms (x" << transformMs[0] / transformMs[1] << ")"
+            << " | render batching: sparse set " << batchMs[0] / passes << " ms, archetype " << batchMs[1] / passes
+            << " ms (x" << batchMs[0] / batchMs[1] << ")"
+            << " | remove + add: sparse set " << structuralMs[0] / passes << " ms, archetype " << structuralMs[1] / passes
+            << " ms (x" << structuralMs[0] / structuralMs[1] << ")";
+        Popplio::Logger::Info(ss.str());
+
+        if (!CheckArchetypeAdd()) Popplio::Logger::Error("Archetype add check failed");
+
+        Popplio::Logger::Info("Storage mode benchmark completed");
+    }
+
+    void BenchmarkStructuralChanges()
+    {
+        Popplio::Logger::Info("Starting structural change benchmark");
+
+        static const int count = 20000;
+
+        double spawnMs[2]{}, killMs[2]{};
+        Popplio::Registry::StructuralChangeStats stats[2]{};
+        for (int deferred{}; deferred < 2; ++deferred)
+        {
+            Popplio::Registry reg{};
+            reg.AddSystem<Popplio::TransformationSystem>(reg);
+            reg.AddSystem<Popplio::GravitySystem>();
+            reg.AddSystem<Popplio::MovementSystem>();
+            reg.BeginFrame();
+
+            std::vector<Popplio::Entity> created{};
+            created.reserve(count);
+
+            auto start = BenchClock::now();
+            for (int i{}; i < count; ++i)
+            {
+                Popplio::Entity e = reg.CreateEntity();
+                if (deferred)
+                {
+                    reg.DeferAddComponent<Popplio::RenderComponent>(e, Popplio::MeshType::Quad, "default_shader", "", true);
+                    reg.DeferAddComponent<Popplio::RigidBodyComponent>(e, 1.f, false, 1.f, 0.f, 0.f);
+                }
+                else
+                {
+                    e.AddComponent<Popplio::RenderComponent>(Popplio::MeshType::Quad, "default_shader", "", true);
+                    e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+                }
+                created.push_back(e);
+            }
+            reg.Update();
+            spawnMs[deferred] = ElapsedMs(start);
+
+            start = BenchClock::now();
+            for (Popplio::Entity e : created)
+            {
+                reg.KillEntity(e);
+            }
+            reg.Update();
+            killMs[deferred] = ElapsedMs(start);
+
+            reg.BeginFrame();
+            stats[deferred] = reg.GetStructuralChangeStats();
+        }
+
+        for (int deferred{}; deferred < 2; ++deferred)
+        {
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3)
+                << (deferred ? "deferred" : "immediate") << " | " << count << " bodies"
+                << " | spawn " << spawnMs[deferred] << " ms, kill " << killMs[deferred] << " ms"
+                << " | created " << stats[deferred].entitiesCreated << ", destroyed " << stats[deferred].entitiesDestroyed
+                << ", components added " << stats[deferred].componentsAdded
+                << ", commands " << stats[deferred].deferredCommands;
+            Popplio::Logger::Info(ss.str());
+        }
+
+        Popplio::Logger::Info("Structural change benchmark completed");
+    }
+
+    void StressTestEntityChurn()
+    {
+        Popplio::Logger::Info("Starting entity churn stress test");
+
+        static const int count = 100000;
+
+        Popplio::Registry reg{};
+        reg.AddSystem<Popplio::TransformationSystem>(reg);
+        reg.AddSystem<Popplio::GravitySystem>();
+        reg.AddSystem<Popplio::MovementSystem>();
+
+        std::vector<Popplio::Entity> created{};
+        created.reserve(count);
+
+        auto start = BenchClock::now();
+        for (int i{}; i < count; ++i)
+        {
+            Popplio::Entity e = reg.CreateEntity();
+            e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 1.f, 0.f, 0.f);
+            created.push_back(e);
+        }
+        reg.Update();
+        double createMs = ElapsedMs(start);
+
+        size_t tracked = reg.GetSystem<Popplio::MovementSystem>().GetSystemEntities().size();
+
+        // kill in random order so removals hit the middle of the system arrays
+        std::shuffle(created.begin(), created.end(), std::mt19937(1234));
+        start = BenchClock::now();
+        for (Popplio::Entity e : created)
+        {
+            reg.KillEntity(e);
+        }
+        reg.Update();
+        double destroyMs = ElapsedMs(start);
+
+        size_t remaining = reg.GetSystem<Popplio::TransformationSystem>().GetSystemEntities().size() +
+            reg.GetSystem<Popplio::GravitySystem>().GetSystemEntities().size() +
+            reg.GetSystem<Popplio::MovementSystem>().GetSystemEntities().size();
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3)
+            << count << " entities | create " << createMs << " ms, destroy " << destroyMs << " ms"
+            << " | tracked by movement " << tracked << ", left in systems " << remaining;
+        Popplio::Logger::Info(ss.str());
+
+        if (tracked != static_cast<size_t>(count) || remaining != 0 || reg.GetNumEntities() != 0)
+        {
+            Popplio::Logger::Error("Entity churn stress test failed: system membership out of sync");
+        }
+        else if (!CheckMembershipChangesWhileIterating())
+        {
+            Popplio::Logger::Error("Entity churn stress test failed: membership changes while iterating a system");
+        }
+        else if (!CheckSystemViewSkipsStashed())
+        {
+            Popplio::Logger::Error("Entity churn stress test failed: system view visited an entity outside the system");
+        }
+        else if (!CheckWatchedComponents())
+        {
+            Popplio::Logger::Error("Entity churn stress test failed: watched component changes were not reported");
+        }
+        else
+        {
+            Popplio::Logger::Info("Entity churn stress test passed");
+        }
+    }
+}
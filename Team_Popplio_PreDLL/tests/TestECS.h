@@ -0,0 +1,52 @@
+/******************************************************************************/
+/*!
+\file   TestECS.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for ECS tests & micro-benchmarks
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "../src/ECS/ECS.h"
+
+namespace PopplioTest
+{
+    /*
+    *   compares component lookup throughput of the sparse set Pool
+    *   against the previous unordered_map indexed pool at 10k / 100k entities
+    */
+    void BenchmarkPoolGetComponent();
+
+    /*
+    *   compares the transformation system pass, render instance batching pass and removing + adding a
+    *   component of every entity over 50k Transformation + Render entities in sparse set and archetype storage,
+    *   and checks an archetype move survives a throwing constructor and arguments taken from the moving row
+    */
+    void BenchmarkStorageModes();
+
+    /*
+    *   compares spawning and killing 20k bodies with immediate AddComponent calls
+    *   against the deferred command buffer applied in one registry Update()
+    */
+    void BenchmarkStructuralChanges();
+
+    /*
+    *   stress test creating and destroying 100k physics bodies,
+    *   checking that every system is empty afterwards and that a loop over a system's
+    *   entities visits each of them once while it adds and removes system members, and that a system's
+    *   view skips entities stashed out of the systems
+    */
+    void StressTestEntityChurn();
+}
@@ -0,0 +1,283 @@
+/******************************************************************************/
+/*!
+\file   TestEvent.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for event bus micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestEvent.h"
+
+#include "../src/EventBus/EventBus.h"
+
+#include <list>
+#include <map>
+#include <typeindex>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        struct BenchEvent : public Popplio::Event
+        {
+            int value;
+            BenchEvent(int v) : value(v) {}
+        };
+
+        struct OtherEvent : public Popplio::Event {};
+
+        struct ContactEvent : public Popplio::Event
+        {
+            int entity1Id, entity2Id;
+            ContactEvent(int e1, int e2) : entity1Id(e1), entity2Id(e2) {}
+        };
+
+        struct BenchListener
+        {
+            long long sum{};
+            int calls{};
+            void OnEvent(BenchEvent& e) { sum += e.value; ++calls; }
+        };
+
+        // previous dispatch: handler list looked up by type_index and copied on every emit
+        class LegacyEventBus
+        {
+        public:
+            template <typename TEvent, typename TOwner>
+            void SubscribeToEvent(TOwner* ownerInstance, void (TOwner::* callbackFunction)(TEvent&))
+            {
+                subscribers[typeid(TEvent)].push_back(
+                    std::make_shared<Popplio::MemberFunctionEventCallback<TOwner, TEvent>>(ownerInstance, callbackFunction));
+            }
+
+            template <typename TEvent, typename ...TArgs>
+            void EmitEvent(TArgs&& ...args)
+            {
+                auto handlers = subscribers[typeid(TEvent)];
+                if (!handlers.empty())
+                {
+                    TEvent event(std::forward<TArgs>(args)...);
+                    for (auto& handler : handlers) handler->Call(event);
+                }
+            }
+
+        private:
+            std::map<std::type_index, std::list<std::shared_ptr<Popplio::IEventCallback>>> subscribers;
+        };
+
+        bool CheckReentrancy()
+        {
+            bool passed = true;
+            auto expect = [&passed](bool condition, const char* what)
+            {
+                if (condition) return;
+                Popplio::Logger::Error(std::string("Event bus check failed: ") + what);
+                passed = false;
+            };
+
+            Popplio::EventBus bus{};
+            BenchListener listener{};
+            int first{}, second{}, late{};
+            Popplio::SubscriptionHandle secondHandle{};
+
+            // the first handler removes the second and subscribes a new one mid dispatch
+            bus.SubscribeToEvent<BenchEvent>([&](BenchEvent&)
+            {
+                ++first;
+                if (first != 1) return;
+                bus.UnsubscribeToEvent(secondHandle);
+                bus.SubscribeToEvent<BenchEvent>([&late](BenchEvent&) { ++late; });
+            });
+            secondHandle = bus.SubscribeToEvent<BenchEvent>([&second](BenchEvent&) { ++second; });
+            bus.SubscribeToEvent<BenchEvent>(&listener, &BenchListener::OnEvent);
+
+            bus.EmitEvent<BenchEvent>(1);
+            expect(first == 1 && second == 0 && late == 0 && listener.calls == 1, "unsubscribe / subscribe during dispatch");
+            expect(bus.GetHandlerCount<BenchEvent>() == 3, "handler count after dispatch");
+
+            bus.EmitEvent<BenchEvent>(1);
+            expect(first == 2 && second == 0 && late == 1 && listener.calls == 2, "handler subscribed during dispatch");
+
+            bus.UnsubscribeToEvent<BenchEvent>(&listener, &BenchListener::OnEvent);
+            bus.UnsubscribeToEvent(secondHandle); // already removed
+            bus.EmitEvent<BenchEvent>(1);
+            expect(listener.calls == 2 && first == 3 && late == 2, "unsubscribe member function");
+
+            // nested emits of the same type, the inner one removes every handler
+            Popplio::EventBus nested{};
+            int outer{}, inner{};
+            nested.SubscribeToEvent<BenchEvent>([&](BenchEvent& e)
+            {
+                ++outer;
+                if (e.value == 0) nested.EmitEvent<BenchEvent>(1);
+            });
+            nested.SubscribeToEvent<BenchEvent>([&](BenchEvent& e)
+            {
+                ++inner;
+                if (e.value == 1) nested.Reset();
+            });
+            nested.EmitEvent<BenchEvent>(0);
+            expect(outer == 2 && inner == 1, "reset during nested dispatch");
+            expect(nested.GetHandlerCount<BenchEvent>() == 0, "handlers erased after nested dispatch");
+
+            int others{};
+            nested.SubscribeToEvent<OtherEvent>([&others](OtherEvent&) { ++others; });
+            nested.EmitEvent<BenchEvent>(0);
+            nested.EmitEvent<OtherEvent>();
+            expect(outer == 2 && others == 1, "event types kept apart");
+
+            return passed;
+        }
+
+        template <typename TBus>
+        double TimeEmits(int handlerCount, int emits, long long& sum)
+        {
+            TBus bus{};
+            std::vector<BenchListener> listeners(static_cast<size_t>(handlerCount));
+            for (BenchListener& listener : listeners) bus.SubscribeToEvent(&listener, &BenchListener::OnEvent);
+
+            auto start = BenchClock::now();
+            for (int i{}; i < emits; ++i) bus.template EmitEvent<BenchEvent>(i & 7);
+            double ms = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+            sum = 0;
+            for (BenchListener const& listener : listeners) sum += listener.sum;
+            return ms;
+        }
+    }
+
+    void BenchmarkEventBus()
+    {
+        Popplio::Logger::Info("Starting event bus benchmark");
+
+        static const int emits = 1000000;
+
+        for (int handlerCount : { 1, 4, 16 })
+        {
+            long long legacySum{}, busSum{};
+            double legacyMs = TimeEmits<LegacyEventBus>(handlerCount, emits, legacySum);
+            double busMs = TimeEmits<Popplio::EventBus>(handlerCount, emits, busSum);
+
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3) << emits << " emits x " << handlerCount << " handlers"
+                << " | copied list: " << legacyMs << " ms (" << std::setprecision(0) << emits / (legacyMs / 1000.0) << " emits/s)"
+                << std::setprecision(3) << " | event bus: " << busMs << " ms (" << std::setprecision(0) << emits / (busMs / 1000.0) << " emits/s)";
+            Popplio::Logger::Info(ss.str());
+
+            if (legacySum != busSum) Popplio::Logger::Error("Event bus mismatch");
+        }
+
+        if (CheckReentrancy()) Popplio::Logger::Info("Event bus dispatch checks passed");
+
+        Popplio::Logger::Info("Event bus benchmark completed");
+    }
+
+    void BenchmarkQueuedEvents()
+    {
+        Popplio::Logger::Info("Starting queued events benchmark");
+
+        static const int contacts = 10000;
+        static const int steps = 4;
+        static const int frames = 60;
+
+        // stands in for the cost of marshalling into a script call
+        long long immediateSum{}, immediateCalls{};
+        double immediateMs{};
+        {
+            Popplio::EventBus bus{};
+            bus.SubscribeToEvent<ContactEvent>([&](ContactEvent& e)
+            {
+                immediateSum += e.entity1Id ^ e.entity2Id;
+                ++immediateCalls;
+            });
+
+            auto start = BenchClock::now();
+            for (int f{}; f < frames; ++f)
+            {
+                for (int s{}; s < steps; ++s)
+                {
+                    for (int c{}; c < contacts; ++c) bus.EmitEvent<ContactEvent>(c, c + s);
+                }
+            }
+            immediateMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        long long queuedSum{}, queuedCalls{};
+        size_t delivered{};
+        bool ordered = true;
+        double queuedMs{};
+        {
+            Popplio::EventBus bus{};
+            bus.SubscribeToEvent<Popplio::EventBatch<ContactEvent>>([&](Popplio::EventBatch<ContactEvent>& batch)
+            {
+                for (size_t i{}; i < batch.events.size(); ++i)
+                {
+                    const ContactEvent& e = batch.events[i];
+                    queuedSum += e.entity1Id ^ e.entity2Id;
+                    if (e.entity1Id != static_cast<int>(i % contacts)) ordered = false;
+                }
+                ++queuedCalls;
+            });
+
+            auto start = BenchClock::now();
+            for (int f{}; f < frames; ++f)
+            {
+                for (int s{}; s < steps; ++s)
+                {
+                    for (int c{}; c < contacts; ++c) bus.QueueEvent<ContactEvent>(c, c + s);
+                }
+                delivered += bus.DeliverQueuedEvents();
+            }
+            queuedMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << contacts << " contacts x " << steps << " steps x " << frames << " frames"
+            << " | immediate: " << immediateMs << " ms (" << immediateCalls << " handler calls)"
+            << " | queued: " << queuedMs << " ms (" << queuedCalls << " handler calls, " << delivered << " events)";
+        Popplio::Logger::Info(ss.str());
+
+        if (immediateSum != queuedSum || !ordered || delivered != static_cast<size_t>(contacts) * steps * frames)
+            Popplio::Logger::Error("Queued events mismatch");
+
+        // per-event and batch handlers of one type, a handler queueing while delivering
+        Popplio::EventBus bus{};
+        int single{}, batches{}, requeued{};
+        bus.SubscribeToEvent<ContactEvent>([&](ContactEvent& e)
+        {
+            ++single;
+            if (e.entity1Id == 0) bus.QueueEvent<ContactEvent>(1, 1);
+        });
+        bus.SubscribeToEvent<Popplio::EventBatch<ContactEvent>>([&](Popplio::EventBatch<ContactEvent>& batch)
+        {
+            ++batches;
+            requeued += static_cast<int>(batch.events.size());
+        });
+        bus.QueueEvent<ContactEvent>(0, 0);
+        bus.EmitEvent<OtherEvent>(); // no handlers, dropped
+        const size_t first = bus.DeliverQueuedEvents();
+        const size_t second = bus.DeliverQueuedEvents();
+        const size_t third = bus.DeliverQueuedEvents();
+        if (first != 1 || second != 1 || third != 0 || single != 2 || batches != 2 || requeued != 2 || bus.GetQueuedEventCount() != 0)
+            Popplio::Logger::Error("Queued events delivery check failed");
+        else Popplio::Logger::Info("Queued events delivery checks passed");
+
+        Popplio::Logger::Info("Queued events benchmark completed");
+    }
+}
@@ -0,0 +1,38 @@
+/******************************************************************************/
+/*!
+\file   TestEvent.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for event bus micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioTest
+{
+    /*
+    *   compares emits per second of the event bus against the previous map of handler lists
+    *   (copied on every emit) with 1 / 4 / 16 handlers, and checks subscribing and unsubscribing
+    *   from inside a handler and unsubscribing by handle / member function
+    */
+    void BenchmarkEventBus();
+
+    /*
+    *   delivers 10k contact events per step (4 steps a frame, 60 frames) emitted immediately to a per-event
+    *   handler and queued to a batch handler, compares the time and handler calls, and checks the batches
+    *   keep the queue order and events queued while delivering arrive with the next delivery
+    */
+    void BenchmarkQueuedEvents();
+}
@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*!
+\file   TestLogging.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for logging micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestLogging.h"
+
+#include "../src/Logging/LogQueue.h"
+
+#include <ctime>
+#include <thread>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        // discards everything written to it, stands in for the console
+        class NullBuffer : public std::streambuf
+        {
+        protected:
+            int overflow(int c) override { return c; }
+            std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+        };
+
+        // previous logger: timestamp, concatenation and write on the logging thread
+        void WriteInPlace(std::ostream& out, std::mutex& mutex, const std::string& message)
+        {
+            std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            char buffer[32];
+            struct tm timeinfo;
+            localtime_s(&timeinfo, &now);
+            std::strftime(buffer, sizeof(buffer), "%d-%b-%Y %H:%M:%S", &timeinfo);
+
+            std::string origin = "ENGINE | ";
+            std::string logMessage = origin + std::string(buffer) + " " + "[" + std::string("INFO") + "]" + " " + message;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            out << logMessage << std::endl;
+        }
+
+        std::string MakeMessage(int thread, int index)
+        {
+            return "Component added to Entity ID: " + std::to_string(index) + ", thread " + std::to_string(thread);
+        }
+    }
+
+    void BenchmarkLogger()
+    {
+        Popplio::Logger::Info("Starting logger benchmark");
+
+        static const int messages = 100000;
+
+        for (int threads : { 1, 4 })
+        {
+            const int perThread = messages / threads;
+
+            NullBuffer nullBuffer{};
+            std::ostream nullStream(&nullBuffer);
+            std::mutex writeMutex{};
+
+            auto start = BenchClock::now();
+            {
+                std::vector<std::thread> producers{};
+                for (int t{}; t < threads; ++t)
+                {
+                    producers.emplace_back([&, t]()
+                    {
+                        for (int i{}; i < perThread; ++i) WriteInPlace(nullStream, writeMutex, MakeMessage(t, i));
+                    });
+                }
+                for (std::thread& producer : producers) producer.join();
+            }
+            double inPlaceMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+            // the consumer formats like the writer thread and checks the order of each thread
+            Popplio::LogQueue queue{ Popplio::Logger::LOG_QUEUE_CAPACITY };
+            std::atomic<bool> producing{ true };
+            std::vector<int> nextIndex(static_cast<size_t>(threads), 0);
+            size_t received{}, outOfOrder{};
+            std::thread consumer([&]()
+            {
+                Popplio::LogRecord record{};
+                for (;;)
+                {
+                    const bool done = !producing.load(std::memory_order_acquire);
+                    while (queue.TryPop(record))
+                    {
+                        const std::string_view text = record.Text();
+                        const int t = text.back() - '0';
+                        const int index = std::stoi(std::string(text.substr(30)));
+                        if (index != nextIndex[t]) ++outOfOrder;
+                        nextIndex[t] = index + 1;
+                        ++received;
+                        nullStream << text << '\n';
+                    }
+                    queue.MarkWritten();
+                    if (done) return;
+                    std::this_thread::yield();
+                }
+            });
+
+            double queuedMs{};
+            {
+                std::vector<double> threadMs(static_cast<size_t>(threads), 0.0);
+                std::vector<std::thread> producers{};
+                for (int t{}; t < threads; ++t)
+                {
+                    producers.emplace_back([&, t]()
+                    {
+                        auto threadStart = BenchClock::now();
+                        for (int i{}; i < perThread; ++i)
+                        {
+                            Popplio::LogRecord record;
+                            record.time = std::chrono::system_clock::now();
+                            record.level = Popplio::LogLevel::INFO_LOG;
+                            record.SetText(MakeMessage(t, i));
+                            while (!queue.TryPush(std::move(record))) std::this_thread::yield();
+                        }
+                        threadMs[t] = std::chrono::duration<double, std::milli>(BenchClock::now() - threadStart).count();
+                    });
+                }
+                for (std::thread& producer : producers) producer.join();
+                for (double ms : threadMs) queuedMs = std::max(queuedMs, ms);
+            }
+            producing = false;
+            consumer.join();
+
+            std::stringstream ss{};
+            ss << std::fixed << std::setprecision(3) << messages << " messages x " << threads << " threads"
+                << " | in place: " << inPlaceMs << " ms"
+                << " | queued: " << queuedMs << " ms (slowest thread, " << received << " written)";
+            Popplio::Logger::Info(ss.str());
+
+            if (received != static_cast<size_t>(perThread * threads) || outOfOrder != 0 || !queue.IsEmpty())
+                Popplio::Logger::Error("Log queue mismatch");
+        }
+
+        // the ring keeps the newest entries in order
+        Popplio::LogRing<int> ring{ 1000 };
+        for (int i{}; i < 2500; ++i) ring.Push(int(i));
+        bool ringOrdered = ring.Size() == 1000;
+        for (size_t i{}; i < ring.Size() && ringOrdered; ++i) ringOrdered = ring[i] == 1500 + static_cast<int>(i);
+        if (!ringOrdered) Popplio::Logger::Error("Log ring mismatch");
+
+        // long messages go through the queue whole, short ones stay inline
+        Popplio::LogQueue longQueue{ 4 };
+        const std::string longMessage = std::string(1000, 'a') + "end";
+        Popplio::LogRecord longRecord;
+        longRecord.SetText(longMessage);
+        Popplio::LogRecord shortRecord;
+        shortRecord.SetText("short");
+        longQueue.TryPush(std::move(longRecord));
+        longQueue.TryPush(std::move(shortRecord));
+        Popplio::LogRecord popped;
+        bool longKept = longQueue.TryPop(popped) && popped.Text() == longMessage;
+        longKept = longKept && longQueue.TryPop(popped) && popped.Text() == "short" && popped.longMessage.empty();
+        if (!longKept) Popplio::Logger::Error("Log record long message mismatch");
+
+        // filtered out debug messages, the macro does not build the message
+        static const int filtered = 1000000;
+        const Popplio::LogLevel level = Popplio::Logger::GetLogLevel();
+        Popplio::Logger::SetLogLevel(Popplio::LogLevel::ERROR_LOG);
+
+        auto start = BenchClock::now();
+        for (int i{}; i < filtered; ++i) Popplio::Logger::Debug("Component added to Entity ID: " + std::to_string(i));
+        double directMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        start = BenchClock::now();
+        for (int i{}; i < filtered; ++i) POPPLIO_LOG_DEBUG("Component added to Entity ID: " + std::to_string(i));
+        double macroMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        Popplio::Logger::SetLogLevel(level);
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << filtered << " filtered debug messages"
+            << " | Logger::Debug: " << directMs << " ms | POPPLIO_LOG_DEBUG: " << macroMs << " ms";
+        Popplio::Logger::Info(ss.str());
+
+        Popplio::Logger::Info("Logger benchmark completed");
+    }
+}
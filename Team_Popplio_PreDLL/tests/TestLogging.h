@@ -0,0 +1,34 @@
+/******************************************************************************/
+/*!
+\file   TestLogging.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for logging micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioTest
+{
+    /*
+    *   compares the time on the logging thread of 100k messages formatted and written in place
+    *   (previous logger, to a discarding stream) against pushing them to the log queue with 1 / 4 threads
+    *   and a consumer thread, checks no message is lost or reordered per thread and that the log ring
+    *   keeps the newest entries and that long
+    *   messages are queued whole, then times 1M filtered-out debug messages called directly and through
+    *   POPPLIO_LOG_DEBUG
+    */
+    void BenchmarkLogger();
+}
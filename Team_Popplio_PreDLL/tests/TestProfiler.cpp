@@ -0,0 +1,302 @@
+/******************************************************************************/
+/*!
+\file   TestProfiler.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for profiler micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestProfiler.h"
+
+#include "../src/PerformanceViewer/Profiler.h"
+
+#include <atomic>
+#include <thread>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        // previous timers: names by value, a map lookup per call, a queue of polls per name
+        class LegacyTimers
+        {
+        public:
+            void start(std::string sysType)
+            {
+                bool isNew = !intervals.contains(sysType);
+                startTimes[sysType] = BenchClock::now();
+                if (isNew)
+                {
+                    while (intervals[sysType].size() < 100) intervals[sysType].push(std::chrono::duration<double>{ 0 });
+                }
+            }
+
+            std::chrono::microseconds end(std::string sysType)
+            {
+                const std::chrono::duration<double> diff = BenchClock::now() - startTimes[sysType];
+                while (intervals[sysType].size() >= 100) intervals[sysType].pop();
+                intervals[sysType].push(diff);
+
+                const BenchClock::time_point now = BenchClock::now();
+                std::vector<std::string> toDelete{};
+                if (sysType == "engine")
+                {
+                    for (auto& it : intervals)
+                    {
+                        if (std::chrono::duration<double>(now - startTimes[it.first]) > std::chrono::duration<double>(0.5))
+                            toDelete.push_back(it.first);
+                    }
+                }
+                for (auto& sys : toDelete)
+                {
+                    startTimes.erase(sys);
+                    intervals.erase(sys);
+                }
+                return std::chrono::duration_cast<std::chrono::microseconds>(diff);
+            }
+
+        private:
+            std::unordered_map<std::string, BenchClock::time_point> startTimes;
+            std::unordered_map<std::string, std::queue<std::chrono::duration<double>>> intervals;
+        };
+
+        const Popplio::ProfileZoneStats* FindZone(std::vector<Popplio::ProfileZoneStats> const& stats, size_t from, const char* name)
+        {
+            for (size_t i = from; i < stats.size(); ++i)
+            {
+                if (std::strcmp(stats[i].name, name) == 0) return &stats[i];
+            }
+            return nullptr;
+        }
+
+        bool CheckZones()
+        {
+            bool passed = true;
+            auto expect = [&passed](bool condition, const char* what)
+            {
+                if (condition) return;
+                Popplio::Logger::Error(std::string("Profiler check failed: ") + what);
+                passed = false;
+            };
+
+            // root { child x3, other { child } }
+            for (int frame{}; frame < 10; ++frame)
+            {
+                {
+                    POPPLIO_PROFILE_ZONE("test root");
+                    for (int i{}; i < 3; ++i)
+                    {
+                        POPPLIO_PROFILE_ZONE("test child");
+                    }
+                    {
+                        POPPLIO_PROFILE_ZONE("test other");
+                        POPPLIO_PROFILE_ZONE("test child");
+                    }
+                }
+                Popplio::Profiler::EndFrame();
+            }
+
+            std::vector<Popplio::ProfileZoneStats> const& stats = Popplio::Profiler::GetZoneStats();
+            size_t rootIndex = stats.size();
+            for (size_t i{}; i < stats.size(); ++i)
+            {
+                if (std::strcmp(stats[i].name, "test root") == 0) rootIndex = i;
+            }
+            expect(rootIndex + 4 <= stats.size(), "zone tree");
+            if (rootIndex + 4 > stats.size()) return false;
+
+            // depth first, children in the order they first ran
+            const Popplio::ProfileZoneStats& root = stats[rootIndex];
+            const Popplio::ProfileZoneStats& child = stats[rootIndex + 1];
+            const Popplio::ProfileZoneStats& other = stats[rootIndex + 2];
+            const Popplio::ProfileZoneStats& nested = stats[rootIndex + 3];
+            expect(std::strcmp(child.name, "test child") == 0 && child.depth == root.depth + 1 && child.calls == 3, "child zone");
+            expect(std::strcmp(other.name, "test other") == 0 && other.depth == root.depth + 1 && other.calls == 1, "other zone");
+            expect(std::strcmp(nested.name, "test child") == 0 && nested.depth == root.depth + 2 && nested.calls == 1, "zone nested twice");
+            expect(root.minMs <= root.p95Ms && root.p95Ms <= root.maxMs && root.minMs <= root.avgMs && root.avgMs <= root.maxMs, "root stats");
+            expect(root.lastMs >= child.lastMs + other.lastMs, "parent time covers the children");
+
+            // a zone closed while a zone opened inside it is still open closes both
+            const Popplio::ProfileZoneId outer = Popplio::Profiler::InternZone("test outer");
+            const Popplio::ProfileZoneId inner = Popplio::Profiler::InternZone(std::string("test inner"));
+            Popplio::Profiler::BeginZone(outer);
+            Popplio::Profiler::BeginZone(inner);
+            const bool closed = Popplio::Profiler::EndZone(outer).count() > 0;
+            expect(closed && Popplio::Profiler::EndZone(inner).count() == 0, "zone left open");
+            expect(Popplio::Profiler::InternZone("test inner") == inner, "names interned once");
+
+            std::thread worker([]()
+            {
+                Popplio::Profiler::SetThreadName("Test Worker");
+                POPPLIO_PROFILE_ZONE("test worker");
+            });
+            worker.join();
+            Popplio::Profiler::EndFrame();
+
+            const Popplio::ProfileZoneStats* innerStats = FindZone(Popplio::Profiler::GetZoneStats(), 0, "test inner");
+            const Popplio::ProfileZoneStats* workerStats = FindZone(Popplio::Profiler::GetZoneStats(), 0, "test worker");
+            const Popplio::ProfileZoneStats* rootStats = FindZone(Popplio::Profiler::GetZoneStats(), 0, "test root");
+            expect(innerStats && innerStats->calls == 1, "zone closed by its parent");
+            expect(workerStats && rootStats && workerStats->depth == 0 && workerStats->threadIndex != rootStats->threadIndex, "worker thread zone");
+
+            return passed;
+        }
+
+        bool CheckCapture()
+        {
+            const std::string path = (std::filesystem::temp_directory_path() / "popplio_profiler_test.json").string();
+
+            Popplio::Profiler::StartCapture();
+            for (int frame{}; frame < 3; ++frame)
+            {
+                {
+                    POPPLIO_PROFILE_ZONE("test capture");
+                    for (int i{}; i < 4; ++i)
+                    {
+                        POPPLIO_PROFILE_ZONE("test capture child");
+                    }
+                }
+                Popplio::Profiler::EndFrame();
+            }
+            if (!Popplio::Profiler::StopCapture(path)) return false;
+
+            std::ifstream ifs(path);
+            std::stringstream contents{};
+            contents << ifs.rdbuf();
+            ifs.close();
+            std::filesystem::remove(path);
+
+            rapidjson::Document document;
+            document.Parse(contents.str().c_str());
+            if (document.HasParseError() || !document.HasMember("traceEvents") || !document["traceEvents"].IsArray()) return false;
+
+            // every child lies inside a parent on the same thread
+            int parents{}, children{}, contained{};
+            std::vector<std::pair<double, double>> parentSpans{};
+            for (auto const& e : document["traceEvents"].GetArray())
+            {
+                if (std::strcmp(e["ph"].GetString(), "X") != 0) continue;
+                if (std::strcmp(e["name"].GetString(), "test capture") == 0)
+                {
+                    ++parents;
+                    parentSpans.emplace_back(e["ts"].GetDouble(), e["ts"].GetDouble() + e["dur"].GetDouble());
+                }
+            }
+            for (auto const& e : document["traceEvents"].GetArray())
+            {
+                if (std::strcmp(e["ph"].GetString(), "X") != 0 || std::strcmp(e["name"].GetString(), "test capture child") != 0) continue;
+                ++children;
+                const double start = e["ts"].GetDouble(), end = start + e["dur"].GetDouble();
+                for (auto const& [spanStart, spanEnd] : parentSpans)
+                {
+                    if (spanStart <= start && end <= spanEnd)
+                    {
+                        ++contained;
+                        break;
+                    }
+                }
+            }
+            return parents == 3 && children == 12 && contained == 12;
+        }
+
+        // a worker closing zones while the main thread collects frames loses none of them
+        bool CheckConcurrentFrames()
+        {
+            static const size_t workerZones = 100000;
+
+            std::atomic<bool> done{ false };
+            Popplio::Profiler::StartCapture();
+            std::thread worker([&done]()
+            {
+                for (size_t i{}; i < workerZones; ++i)
+                {
+                    POPPLIO_PROFILE_ZONE("test concurrent");
+                }
+                done = true;
+            });
+            while (!done) Popplio::Profiler::EndFrame();
+            worker.join();
+            Popplio::Profiler::EndFrame();
+
+            const bool collected = Popplio::Profiler::GetCaptureEventCount() == workerZones;
+            const std::string path = (std::filesystem::temp_directory_path() / "popplio_profiler_concurrent.json").string();
+            Popplio::Profiler::StopCapture(path);
+            std::filesystem::remove(path);
+            return collected;
+        }
+    }
+
+    void BenchmarkProfiler()
+    {
+        Popplio::Logger::Info("Starting profiler benchmark");
+
+        static const int frames = 1000;
+        static const int zonesPerFrame = 1000; // outer and inner pairs, half each
+
+        LegacyTimers legacy{};
+        auto start = BenchClock::now();
+        for (int f{}; f < frames; ++f)
+        {
+            legacy.start("engine");
+            for (int i{}; i < zonesPerFrame / 2; ++i)
+            {
+                legacy.start("bench system");
+                legacy.start("bench step");
+                legacy.end("bench step");
+                legacy.end("bench system");
+            }
+            legacy.end("engine");
+        }
+        double legacyMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        start = BenchClock::now();
+        for (int f{}; f < frames; ++f)
+        {
+            {
+                POPPLIO_PROFILE_ZONE("bench frame");
+                for (int i{}; i < zonesPerFrame / 2; ++i)
+                {
+                    POPPLIO_PROFILE_ZONE("bench system");
+                    POPPLIO_PROFILE_ZONE("bench step");
+                }
+            }
+            Popplio::Profiler::EndFrame();
+        }
+        double zoneMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        const long long zones = static_cast<long long>(frames) * zonesPerFrame;
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << zones << " zones x " << frames << " frames"
+            << " | string timers: " << legacyMs << " ms (" << legacyMs * 1.0e6 / zones << " ns/zone)"
+            << " | profiler zones: " << zoneMs << " ms (" << zoneMs * 1.0e6 / zones << " ns/zone, frame collection included)";
+        Popplio::Logger::Info(ss.str());
+
+        const Popplio::ProfileZoneStats* step = FindZone(Popplio::Profiler::GetZoneStats(), 0, "bench step");
+        if (!step || step->calls != static_cast<std::uint32_t>(zonesPerFrame / 2)) Popplio::Logger::Error("Profiler zone count mismatch");
+
+        const bool zonesPassed = CheckZones();
+        const bool capturePassed = CheckCapture();
+        if (!capturePassed) Popplio::Logger::Error("Profiler check failed: Chrome trace capture");
+        const bool concurrentPassed = CheckConcurrentFrames();
+        if (!concurrentPassed) Popplio::Logger::Error("Profiler check failed: zones closed while collecting frames");
+        if (zonesPassed && capturePassed && concurrentPassed) Popplio::Logger::Info("Profiler checks passed");
+
+        Popplio::Logger::Info("Profiler benchmark completed");
+    }
+}
@@ -0,0 +1,32 @@
+/******************************************************************************/
+/*!
+\file   TestProfiler.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for profiler micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioTest
+{
+    /*
+    *   compares the time of 1M nested timed zones (1000 frames) through the previous string-keyed timers
+    *   against POPPLIO_PROFILE_ZONE, then checks the zone tree, calls and stats, zones left open being
+    *   closed by their parent, zones of another thread, the Chrome trace written for a capture and
+    *   that no zone of a worker is lost while the main thread collects frames
+    */
+    void BenchmarkProfiler();
+}
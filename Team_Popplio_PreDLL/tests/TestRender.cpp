@@ -0,0 +1,553 @@
+/******************************************************************************/
+/*!
+\file   TestRender.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for rendering micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestRender.h"
+
+#include "../src/Graphic/RenderQueue.h"
+#include "../src/Graphic/SpriteBatcher.h"
+#include "../src/Graphic/Texture/TextureAtlas.h"
+#include "../src/Graphic/Font/TextLayout.h"
+#include "../src/Graphic/CullingGrid.h"
+
+#include <random>
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+
+        struct StateChanges
+        {
+            size_t shaders{};
+            size_t textures{};
+        };
+
+        // shader / texture changes when drawing the commands in order
+        StateChanges CountStateChanges(std::vector<Popplio::RenderCommand> const& commands)
+        {
+            StateChanges changes{};
+            std::uint32_t shader = ~0u, texture = ~0u;
+            for (Popplio::RenderCommand const& command : commands)
+            {
+                if (Popplio::RenderQueue::GetShader(command.key) != shader) ++changes.shaders;
+                if (Popplio::RenderQueue::GetTexture(command.key) != texture) ++changes.textures;
+                shader = Popplio::RenderQueue::GetShader(command.key);
+                texture = Popplio::RenderQueue::GetTexture(command.key);
+            }
+            return changes;
+        }
+    }
+
+    void BenchmarkRenderQueue()
+    {
+        Popplio::Logger::Info("Starting render queue benchmark");
+
+        static const int commandCount = 100000;
+        static const int iterations = 10;
+
+        // 8 layers, 4 shaders, 64 textures, 3 meshes, in entity order like the render system queues them
+        std::mt19937 rng(1234);
+        Popplio::RenderQueue queue{};
+        for (int i{}; i < commandCount; ++i)
+        {
+            queue.Push(Popplio::RenderQueue::MakeKey(rng() % 8, Popplio::RenderQueue::PASS_SPRITE,
+                rng() % 4 + 1, rng() % 64 + 1, rng() % 3, static_cast<std::uint32_t>(i)), static_cast<std::uint32_t>(i));
+        }
+        const std::vector<Popplio::RenderCommand> unsorted = queue.GetCommands();
+
+        double radixMs{};
+        for (int it{}; it < iterations; ++it)
+        {
+            queue.Clear();
+            for (Popplio::RenderCommand const& command : unsorted) queue.Push(command.key, command.payload);
+
+            auto start = BenchClock::now();
+            queue.Sort();
+            radixMs += std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        std::vector<Popplio::RenderCommand> reference{};
+        double stdMs{};
+        for (int it{}; it < iterations; ++it)
+        {
+            reference = unsorted;
+
+            auto start = BenchClock::now();
+            std::stable_sort(reference.begin(), reference.end(),
+                [](Popplio::RenderCommand const& a, Popplio::RenderCommand const& b) { return a.key < b.key; });
+            stdMs += std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        bool same = reference.size() == queue.Size();
+        for (size_t i{}; same && i < reference.size(); ++i)
+        {
+            same = reference[i].key == queue.GetCommands()[i].key && reference[i].payload == queue.GetCommands()[i].payload;
+        }
+
+        StateChanges before = CountStateChanges(unsorted);
+        StateChanges after = CountStateChanges(queue.GetCommands());
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << commandCount << " commands"
+            << " | radix sort: " << radixMs / iterations << " ms"
+            << " | std::stable_sort: " << stdMs / iterations << " ms"
+            << " | shader switches: " << before.shaders << " -> " << after.shaders
+            << " | texture binds: " << before.textures << " -> " << after.textures;
+        Popplio::Logger::Info(ss.str());
+
+        if (!same) Popplio::Logger::Error("Render queue order mismatch");
+
+        Popplio::Logger::Info("Render queue benchmark completed");
+    }
+
+    void BenchmarkSpriteBatching()
+    {
+        Popplio::Logger::Info("Starting sprite batching benchmark");
+
+        static const int spriteCount = 100000;
+        static const int iterations = 10;
+        static const char* shaderNames[] = { "default_shader", "animation_shader", "instanced_shader" };
+
+        // Sprites in entity order, all keyed with the batch shader like the render system queues them
+        std::mt19937 rng(1234);
+        std::vector<Popplio::TransformComponent> transforms{};
+        std::vector<Popplio::RenderComponent> renders{};
+        std::vector<std::uint32_t> textures{};
+        Popplio::RenderQueue queue{};
+        for (int i{}; i < spriteCount; ++i)
+        {
+            const bool instanced = rng() % 3 == 0;
+            Popplio::RenderComponent render(Popplio::MeshType::Quad, shaderNames[instanced ? 2 : rng() % 2], "sprite", instanced);
+            textures.push_back(rng() % 64 + 1);
+            transforms.emplace_back(static_cast<float>(rng() % 1000), static_cast<float>(rng() % 1000));
+            renders.push_back(render);
+
+            queue.Push(Popplio::RenderQueue::MakeKey(rng() % 8, Popplio::RenderQueue::PASS_SPRITE,
+                1, textures.back(), Popplio::MeshType::Quad, static_cast<std::uint32_t>(i)), static_cast<std::uint32_t>(i));
+        }
+        queue.Sort();
+
+        Popplio::SpriteBatcher batcher{};
+        double buildMs{};
+        for (int it{}; it < iterations; ++it)
+        {
+            auto start = BenchClock::now();
+            batcher.Begin();
+            std::vector<Popplio::RenderCommand> const& commands = queue.GetCommands();
+            for (std::uint32_t c{}; c < static_cast<std::uint32_t>(commands.size()); ++c)
+            {
+                const std::uint32_t sprite = commands[c].payload;
+                batcher.AddSprite(c, textures[sprite], Popplio::SpriteBatcher::MakeSpriteInstance(
+                    Popplio::SpriteBatcher::GetSpriteShader(renders[sprite]), transforms[sprite], renders[sprite],
+                    nullptr, nullptr, nullptr));
+            }
+            buildMs += std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+
+        // Every sprite is in exactly one batch, of its own texture
+        bool valid = batcher.GetInstances().size() == static_cast<size_t>(spriteCount);
+        std::uint32_t nextInstance{};
+        for (Popplio::SpriteDrawStep const& step : batcher.GetSteps())
+        {
+            valid = valid && step.spriteBatch && step.firstInstance == nextInstance;
+            for (std::uint32_t i{}; valid && i < step.instanceCount; ++i)
+            {
+                valid = textures[queue.GetCommands()[step.command + i].payload] == step.texture;
+            }
+            nextInstance += step.instanceCount;
+        }
+        valid = valid && nextInstance == static_cast<std::uint32_t>(spriteCount);
+
+        // State the non-instanced path sets as uniforms
+        Popplio::TransformComponent transform(10.f, 20.f, 64.f, 32.f);
+        Popplio::RenderComponent nineSlice(Popplio::MeshType::Quad, "default_shader", "panel", false, glm::vec3(1.f), 0.5f,
+            128, 64, true, 4.f, 5.f, 6.f, 7.f);
+        Popplio::InstanceData instance = Popplio::SpriteBatcher::MakeSpriteInstance(Popplio::SpriteShader::DEFAULT,
+            transform, nineSlice, nullptr, nullptr, nullptr);
+        bool stateValid = instance.flags == glm::vec2(1.f, 1.f) && instance.alpha == 0.25f &&
+            instance.borderSize == glm::vec4(4.f, 5.f, 7.f, 6.f) && instance.textureSize == glm::vec2(128.f, 64.f) &&
+            instance.spriteSize == glm::vec2(64.f, 32.f);
+
+        Popplio::RenderComponent button(Popplio::MeshType::Quad, "animation_shader", "button");
+        Popplio::UIComponent hover(Popplio::UIType::BUTTON);
+        hover.hasHoverEffect = true;
+        hover.isHovered = true;
+        hover.totalColumns = 2;
+        hover.sheetWidth = 64.f;
+        hover.sheetHeight = 32.f;
+        hover.hoverFrameX = 1;
+        instance = Popplio::SpriteBatcher::MakeSpriteInstance(Popplio::SpriteShader::ANIMATION,
+            transform, button, nullptr, &hover, nullptr);
+        stateValid = stateValid && instance.uvRect == hover.GetCurrentUV() && instance.flags.y == 0.f;
+
+        // Same button packed in the right half of an atlas page
+        instance = Popplio::SpriteBatcher::MakeSpriteInstance(Popplio::SpriteShader::ANIMATION,
+            transform, button, nullptr, &hover, nullptr, Popplio::TextureRegion{ 1, glm::vec4(0.5f, 0.f, 1.f, 1.f) });
+        stateValid = stateValid && instance.uvRect == glm::vec4(0.75f, 0.f, 1.f, 1.f);
+
+        Popplio::UIComponent checkbox(Popplio::UIType::CHECKBOX);
+        checkbox.checked = true;
+        instance = Popplio::SpriteBatcher::MakeSpriteInstance(Popplio::SpriteShader::DEFAULT,
+            transform, button, nullptr, &checkbox, nullptr);
+        stateValid = stateValid && instance.color == glm::vec3(0.0f, 0.7f, 0.0f);
+
+        Popplio::TransformComponent track(100.f, 0.f, 200.f, 10.f);
+        Popplio::UIComponent handle(Popplio::UIType::SLIDER_HANDLE);
+        handle.sliderValue = 0.25f;
+        instance = Popplio::SpriteBatcher::MakeSpriteInstance(Popplio::SpriteShader::DEFAULT,
+            transform, button, nullptr, &handle, &track);
+        stateValid = stateValid && instance.modelMatrix[2][0] == 50.f;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << spriteCount << " sprites"
+            << " | draw calls: " << batcher.GetSteps().size()
+            << " | build: " << buildMs / iterations << " ms";
+        Popplio::Logger::Info(ss.str());
+
+        if (!valid) Popplio::Logger::Error("Sprite batches do not match the sorted sprites");
+        if (!stateValid) Popplio::Logger::Error("Sprite instance data does not match the non-instanced path");
+
+        Popplio::Logger::Info("Sprite batching benchmark completed");
+    }
+
+    void BenchmarkAtlasPacking()
+    {
+        Popplio::Logger::Info("Starting atlas packing benchmark");
+
+        static const int imageCount = 2000;
+
+        std::mt19937 rng(1234);
+        std::vector<Popplio::AtlasImage> images{};
+        for (int i{}; i < imageCount; ++i)
+        {
+            images.push_back({ "image_" + std::to_string(i), static_cast<int>(rng() % 249 + 8), static_cast<int>(rng() % 249 + 8) });
+        }
+
+        auto start = BenchClock::now();
+        Popplio::AtlasManifest manifest = Popplio::AtlasPacker::Pack(images);
+        double packMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        // Every region with its padding is inside its page and does not overlap another
+        bool valid = manifest.regions.size() == images.size();
+        const int half = manifest.padding / 2;
+        std::vector<Popplio::AtlasRegion const*> regions{};
+        double area{};
+        for (auto const& [name, region] : manifest.regions)
+        {
+            valid = valid && region.x - half >= 0 && region.y - half >= 0 &&
+                region.x + region.width + half <= manifest.pageSize && region.y + region.height + half <= manifest.pageSize;
+            regions.push_back(&region);
+            area += static_cast<double>(region.width) * region.height;
+        }
+        for (size_t i{}; valid && i < regions.size(); ++i)
+        {
+            for (size_t j = i + 1; valid && j < regions.size(); ++j)
+            {
+                Popplio::AtlasRegion const& a = *regions[i];
+                Popplio::AtlasRegion const& b = *regions[j];
+                valid = a.page != b.page ||
+                    a.x + a.width + half <= b.x - half || b.x + b.width + half <= a.x - half ||
+                    a.y + a.height + half <= b.y - half || b.y + b.height + half <= a.y - half;
+            }
+        }
+
+        // Manifest round trip, and repacking when a texture changes size
+        std::filesystem::path manifestPath = std::filesystem::temp_directory_path() / "PopplioTestAtlas.atlas";
+        Popplio::AtlasManifest loaded{};
+        bool manifestValid = manifest.Save(manifestPath) && loaded.Load(manifestPath) &&
+            loaded.pageCount == manifest.pageCount && loaded.regions.size() == manifest.regions.size() &&
+            Popplio::AtlasPacker::IsUpToDate(loaded, images);
+        for (auto const& [name, region] : manifest.regions)
+        {
+            auto it = loaded.regions.find(name);
+            manifestValid = manifestValid && it != loaded.regions.end() && it->second.page == region.page &&
+                it->second.x == region.x && it->second.y == region.y &&
+                it->second.width == region.width && it->second.height == region.height;
+        }
+        images[0].width += 1;
+        manifestValid = manifestValid && !Popplio::AtlasPacker::IsUpToDate(loaded, images);
+        std::filesystem::remove(manifestPath);
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << imageCount << " textures"
+            << " | pages: " << manifest.pageCount
+            << " | fill: " << 100.0 * area / (static_cast<double>(manifest.pageSize) * manifest.pageSize * manifest.pageCount) << "%"
+            << " | pack: " << packMs << " ms";
+        Popplio::Logger::Info(ss.str());
+
+        // The project's own textures, as an asset build would pack them
+        if (std::filesystem::exists("Assets/Textures"))
+        {
+            std::vector<Popplio::AtlasImage> projectImages = Popplio::AtlasPacker::ScanImages("Assets/Textures");
+            Popplio::AtlasManifest projectManifest = Popplio::AtlasPacker::Pack(projectImages);
+            Popplio::Logger::Info("Project: " + std::to_string(projectManifest.regions.size()) + " textures packed into " +
+                std::to_string(projectManifest.pageCount) + " pages");
+        }
+
+        if (!valid) Popplio::Logger::Error("Atlas regions overlap or leave their page");
+        if (!manifestValid) Popplio::Logger::Error("Atlas manifest does not round-trip");
+
+        Popplio::Logger::Info("Atlas packing benchmark completed");
+    }
+
+    void BenchmarkTextLayout()
+    {
+        Popplio::Logger::Info("Starting text layout benchmark");
+
+        static const int textCount = 10000;
+        static const int batchedTextCount = 1000;
+
+        // Printable ASCII glyphs with random metrics, the space has no bitmap
+        std::mt19937 rng(1234);
+        Popplio::GlyphSet glyphs{};
+        glyphs.texture = 1;
+        glyphs.id = 1;
+        std::vector<Popplio::AtlasImage> images{};
+        for (int c = 32; c < 127; ++c)
+        {
+            const glm::ivec2 size = c == ' ' ? glm::ivec2(0) : glm::ivec2(rng() % 20 + 4, rng() % 24 + 6);
+            const glm::ivec2 bearing(static_cast<int>(rng() % 3), size.y - static_cast<int>(rng() % 6));
+            glyphs.characters[static_cast<char>(c)] = { glyphs.texture, size, bearing,
+                static_cast<unsigned int>(size.x + 2) << 6, glm::vec4(0.f) };
+            if (c != ' ') images.push_back({ std::to_string(c), size.x, size.y });
+        }
+        Popplio::AtlasManifest manifest = Popplio::PackGlyphAtlas(images);
+        for (auto& [c, ch] : glyphs.characters)
+        {
+            auto it = manifest.regions.find(std::to_string(static_cast<int>(c)));
+            if (it == manifest.regions.end()) continue;
+            glm::vec4 uv = manifest.GetUVRect(it->second);
+            ch.uvRect = glm::vec4(uv.x, uv.w, uv.z, uv.y);
+        }
+        bool atlasValid = manifest.pageCount == 1 && manifest.regions.size() == images.size();
+
+        std::vector<std::string> strings{};
+        for (int i{}; i < textCount; ++i)
+        {
+            std::string str(rng() % 24 + 1, ' ');
+            for (char& c : str) c = static_cast<char>(rng() % 95 + 32);
+            strings.push_back(str);
+        }
+
+        // Quads against the per-glyph placement of the old text path, at the origin
+        bool layoutValid = true;
+        std::vector<Popplio::TextLayout> layouts(textCount);
+        auto start = BenchClock::now();
+        for (int i{}; i < textCount; ++i) layouts[i].Build(strings[i], glyphs);
+        double buildMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        for (int i{}; layoutValid && i < textCount; ++i)
+        {
+            float totalWidth{}, maxAscent{}, maxDescent{};
+            for (char c : strings[i])
+            {
+                Popplio::Character const& ch = glyphs.characters[c];
+                totalWidth += static_cast<float>(ch.Advance >> 6);
+                maxAscent = std::max(maxAscent, static_cast<float>(ch.Bearing.y));
+                maxDescent = std::max(maxDescent, static_cast<float>(ch.Size.y) - static_cast<float>(ch.Bearing.y));
+            }
+            float x = -totalWidth / 2.0f;
+            const float baseline = (maxAscent - maxDescent) / 2.0f;
+
+            size_t quad{};
+            for (char c : strings[i])
+            {
+                Popplio::Character const& ch = glyphs.characters[c];
+                if (c != ' ')
+                {
+                    Popplio::GlyphQuad const& q = layouts[i].GetQuads()[quad++];
+                    layoutValid = layoutValid && q.rect == glm::vec4(x + ch.Bearing.x,
+                        baseline - ch.Size.y + ch.Bearing.y, ch.Size.x, ch.Size.y) && q.uvRect == ch.uvRect;
+                }
+                x += static_cast<float>(ch.Advance >> 6);
+            }
+            layoutValid = layoutValid && quad == layouts[i].GetQuads().size() &&
+                layouts[i].GetWidth() == totalWidth && layouts[i].GetHeight() == maxAscent + maxDescent;
+        }
+
+        // A frame of unchanged texts only compares the strings
+        size_t rebuilt{};
+        start = BenchClock::now();
+        for (int i{}; i < textCount; ++i)
+        {
+            if (!layouts[i].IsBuiltFor(strings[i], glyphs))
+            {
+                layouts[i].Build(strings[i], glyphs);
+                ++rebuilt;
+            }
+        }
+        double cachedMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        Popplio::GlyphSet otherSize = glyphs;
+        otherSize.id = 2;
+        bool cacheValid = rebuilt == 0 && !layouts[0].IsBuiltFor(strings[0] + "!", glyphs) &&
+            !layouts[0].IsBuiltFor(strings[0], otherSize);
+
+        // The glyphs of texts sharing the atlas are one batch, whatever their position and color
+        Popplio::SpriteBatcher batcher{};
+        batcher.Begin();
+        size_t glyphCount{};
+        for (std::uint32_t i{}; i < static_cast<std::uint32_t>(batchedTextCount); ++i)
+        {
+            Popplio::TransformComponent transform(static_cast<float>(rng() % 1000), static_cast<float>(rng() % 1000));
+            Popplio::TextComponent text(strings[i], "default", 32, 0.5f, glm::vec3(1.f, 0.f, 0.f));
+            for (Popplio::GlyphQuad const& glyph : layouts[i].GetQuads())
+            {
+                batcher.AddSprite(i, layouts[i].GetTexture(), Popplio::SpriteBatcher::MakeGlyphInstance(glyph, transform, text));
+            }
+            glyphCount += layouts[i].GetQuads().size();
+        }
+        bool batchValid = batcher.GetSteps().size() == 1 && batcher.GetInstances().size() == glyphCount;
+
+        Popplio::TransformComponent transform(100.f, 50.f);
+        Popplio::TextComponent text("A", "default", 32, 0.5f, glm::vec3(1.f, 0.f, 0.f));
+        Popplio::GlyphQuad const& glyph = layouts[0].GetQuads().front();
+        Popplio::InstanceData instance = Popplio::SpriteBatcher::MakeGlyphInstance(glyph, transform, text);
+        batchValid = batchValid && instance.uvRect == glyph.uvRect && instance.alpha == 0.5f &&
+            instance.color == glm::vec3(1.f, 0.f, 0.f) && instance.modelMatrix[0][0] == glyph.rect.z &&
+            instance.modelMatrix[1][1] == glyph.rect.w &&
+            instance.modelMatrix[2][0] == 100.f + glyph.rect.x + glyph.rect.z * 0.5f &&
+            instance.modelMatrix[2][1] == 50.f + glyph.rect.y + glyph.rect.w * 0.5f;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << textCount << " texts"
+            << " | glyph atlas: " << manifest.pageSize << "x" << manifest.pageSize
+            << " | build: " << buildMs << " ms | cached: " << cachedMs << " ms"
+            << " | " << glyphCount << " glyphs of " << batchedTextCount << " texts in " << batcher.GetSteps().size() << " draws";
+        Popplio::Logger::Info(ss.str());
+
+        if (!atlasValid) Popplio::Logger::Error("Glyphs do not fit one glyph atlas page");
+        if (!layoutValid) Popplio::Logger::Error("Text layout does not match the per-glyph placement");
+        if (!cacheValid) Popplio::Logger::Error("Text layouts are not rebuilt exactly when their text or glyphs change");
+        if (!batchValid) Popplio::Logger::Error("Text glyphs are not batched into one draw");
+
+        Popplio::Logger::Info("Text layout benchmark completed");
+    }
+
+    void BenchmarkCulling()
+    {
+        Popplio::Logger::Info("Starting culling benchmark");
+
+        static const int noteCount = 20000;
+        static const int tileCount = 2000;
+        static const int frames = 120;
+        static const float scrollSpeed = 40.f;
+
+        // Notes on 4 lanes spread far above the view, tiles on a static grid around it
+        std::mt19937 rng(1234);
+        std::vector<glm::mat3> models{};
+        for (int i{}; i < noteCount; ++i)
+        {
+            glm::mat3 model(1.f);
+            model[0][0] = 96.f;
+            model[1][1] = 32.f;
+            model[2][0] = -300.f + static_cast<float>(rng() % 4) * 200.f;
+            model[2][1] = static_cast<float>(rng() % 400000) * 0.5f - 600.f;
+            models.push_back(model);
+        }
+        for (int i{}; i < tileCount; ++i)
+        {
+            glm::mat3 model(1.f);
+            model[0][0] = model[1][1] = 128.f;
+            model[2][0] = static_cast<float>(i % 50) * 128.f - 3200.f;
+            model[2][1] = static_cast<float>(i / 50) * 128.f - 2560.f;
+            models.push_back(model);
+        }
+        const Popplio::CullBounds view{ -960.f, -540.f, 960.f, 540.f };
+
+        // Tiles are added once, only the moving notes are updated each frame
+        Popplio::CullingGrid grid{};
+        for (int i = noteCount; i < static_cast<int>(models.size()); ++i)
+        {
+            grid.Update(i, Popplio::CullBounds::FromModelMatrix(models[i]));
+        }
+
+        double cullMs{};
+        size_t visible{}, culled{}, moves{};
+        bool valid = true;
+        for (int frame{}; frame < frames; ++frame)
+        {
+            for (int i{}; i < noteCount; ++i) models[i][2][1] -= scrollSpeed;
+
+            auto start = BenchClock::now();
+            for (int i{}; i < noteCount; ++i)
+            {
+                grid.Update(i, Popplio::CullBounds::FromModelMatrix(models[i]));
+            }
+            moves += grid.GetCellMoves();
+            grid.Query(view);
+            cullMs += std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+            size_t expectedVisible{};
+            for (int i{}; valid && i < static_cast<int>(models.size()); ++i)
+            {
+                const bool inView = Popplio::CullBounds::FromModelMatrix(models[i]).Overlaps(view);
+                expectedVisible += inView ? 1 : 0;
+                valid = grid.IsCulled(i) != inView;
+            }
+            valid = valid && grid.GetVisibleCount() == expectedVisible;
+            visible += grid.GetVisibleCount();
+            culled += grid.GetEntityCount() - grid.GetVisibleCount();
+        }
+
+        // Removed entities leave the grid and are not reported as culled
+        grid.Remove(0);
+        grid.Query(view);
+        bool removeValid = grid.GetEntityCount() == models.size() - 1 && !grid.IsCulled(0) && !grid.Contains(0);
+
+        // NaN bounds are never visible, infinite bounds always are, far away bounds are clamped to the outer cells
+        const int first = static_cast<int>(models.size());
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float inf = std::numeric_limits<float>::infinity();
+        grid.Update(first, Popplio::CullBounds{ nan, nan, nan, nan });
+        grid.Update(first + 1, Popplio::CullBounds{ -inf, -inf, inf, inf });
+        grid.Update(first + 2, Popplio::CullBounds{ 1e30f, 1e30f, 1e30f + 64.f, 1e30f + 64.f });
+        grid.Update(first + 3, Popplio::CullBounds{ -1e30f, -1e30f, 1e30f, 1e30f });
+        grid.Query(view);
+        bool nonFiniteValid = grid.IsCulled(first) && !grid.IsCulled(first + 1) && grid.IsCulled(first + 2) && !grid.IsCulled(first + 3);
+        grid.Query(Popplio::CullBounds{ nan, nan, nan, nan });
+        nonFiniteValid = nonFiniteValid && grid.GetVisibleCount() == 0;
+
+        // Rotated by 45 degrees, a 2x2 square spans sqrt(2) each way
+        glm::mat3 rotated(1.f);
+        const float c = 2.f * std::cos(glm::radians(45.f));
+        rotated[0][0] = c; rotated[0][1] = c;
+        rotated[1][0] = -c; rotated[1][1] = c;
+        Popplio::CullBounds rotatedBounds = Popplio::CullBounds::FromModelMatrix(rotated);
+        bool boundsValid = std::abs(rotatedBounds.maxX - std::sqrt(2.f)) < 1e-4f && std::abs(rotatedBounds.minY + std::sqrt(2.f)) < 1e-4f;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << models.size() << " entities over " << frames << " frames"
+            << " | visible: " << visible / frames << " | culled: " << culled / frames
+            << " | cell moves: " << moves / frames
+            << " | cull: " << cullMs / frames << " ms";
+        Popplio::Logger::Info(ss.str());
+
+        if (!valid) Popplio::Logger::Error("Culled entities do not match testing every entity against the view");
+        if (!removeValid) Popplio::Logger::Error("Removed entities are still in the culling grid");
+        if (!nonFiniteValid) Popplio::Logger::Error("Culling grid mishandles NaN, infinite or far away bounds");
+        if (!boundsValid) Popplio::Logger::Error("Bounds of a rotated model matrix are wrong");
+
+        Popplio::Logger::Info("Culling benchmark completed");
+    }
+}
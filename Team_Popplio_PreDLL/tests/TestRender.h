@@ -0,0 +1,64 @@
+/******************************************************************************/
+/*!
+\file   TestRender.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for rendering micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioTest
+{
+    /*
+    *   sorts 100k render commands with the render queue radix sort and std::stable_sort,
+    *   checks both give the same order and counts the state changes before / after sorting
+    *   does not need a GL context
+    */
+    void BenchmarkRenderQueue();
+
+    /*
+    *   batches 100k quad sprites (default / animation / instanced shaders, 64 textures) after sorting,
+    *   checks every sprite lands in a batch of its texture, and the instance data of
+    *   nine-slice sprites, hovered buttons, checkboxes and slider handles
+    *   does not need a GL context
+    */
+    void BenchmarkSpriteBatching();
+
+    /*
+    *   packs 2000 random textures into atlas pages, checks every region is inside its page
+    *   without overlapping another (padding included) and that the manifest round-trips,
+    *   then packs the project textures under Assets/Textures
+    *   does not need a GL context
+    */
+    void BenchmarkAtlasPacking();
+
+    /*
+    *   lays out 10k strings with a generated glyph set packed into one glyph atlas, checks the glyph
+    *   quads are placed like the per-glyph text path placed them, that layouts are only rebuilt when
+    *   the text or glyph set changes, and that the glyphs of 1000 texts sharing an atlas are one batch
+    *   does not need a GL context
+    */
+    void BenchmarkTextLayout();
+
+    /*
+    *   scrolls 20k notes down a highway past 2k static background tiles for 120 frames, updating only
+    *   the notes in the culling grid and culling against a 1920x1080 view, checks the visible entities
+    *   match testing every entity against the view, that removed entities leave the grid and that
+    *   NaN, infinite and far away bounds are handled
+    *   does not need a GL context
+    */
+    void BenchmarkCulling();
+}
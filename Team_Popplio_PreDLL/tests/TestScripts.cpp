@@ -0,0 +1,305 @@
+/******************************************************************************/
+/*!
+\file   TestScripts.cpp
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the source file for C# script dispatch micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <pch.h>
+
+#include "TestScripts.h"
+
+#include "../src/Script/LogicSystem.h"
+#include "../src/Mono/MonoUtilities.h"
+#include "../src/Hierarchy/ParentComponent.h"
+#include "../src/Physics/RigidBodyComponent.h"
+
+namespace PopplioTest
+{
+    namespace
+    {
+        using BenchClock = std::chrono::steady_clock;
+    }
+
+    void BenchmarkScriptDispatch(PopplioScriptAPI::MonoAPI& monoAPI)
+    {
+        Popplio::Logger::Info("Starting script dispatch benchmark");
+
+        static const int scripts = 1000;
+        static const int frames = 60;
+
+        MonoClass* classObj = monoAPI.GetAssClass("BassNKick", "TestDispatch");
+        MonoClass* base = monoAPI.GetAssClass("Team_Popplio", "PopplioMonoScript");
+        if (classObj == nullptr || base == nullptr)
+        {
+            Popplio::Logger::Error("Script dispatch benchmark needs BassNKick.TestDispatch in the loaded assembly");
+            return;
+        }
+
+        std::vector<uint32_t> handles{};
+        handles.reserve(scripts);
+        for (int i{}; i < scripts; ++i)
+        {
+            MonoObject* obj = monoAPI.InstClass("BassNKick", "TestDispatch");
+            if (obj != nullptr) handles.push_back(monoAPI.GetGC(obj, false));
+        }
+
+        // previous dispatch: overridden flags looked up by script name, method looked up by name on every call
+        std::unordered_map<uint32_t, std::string> names{};
+        std::vector<std::unordered_map<std::string, bool>> overridden(5);
+        for (uint32_t handle : handles)
+        {
+            names[handle] = mono_class_get_name(classObj);
+            overridden[2][names[handle]] = monoAPI.IsOverridden(classObj, base, "Update");
+        }
+
+        auto start = BenchClock::now();
+        for (int f{}; f < frames; ++f)
+        {
+            for (uint32_t handle : handles)
+            {
+                MonoObject* obj = mono_gchandle_get_target(handle);
+                if (!monoAPI.IsObjValid(obj)) continue;
+                if (!overridden[2][names[handle]]) continue;
+                std::string str = names[handle];
+                monoAPI.CallMethod(obj, "Update");
+            }
+        }
+        double legacyMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        // cached thunk: method resolved once per class, one call into C# per script
+        PopplioScriptAPI::MonoThunk<MonoObject*> update =
+            monoAPI.GetMethodThunk<MonoObject*>(monoAPI.GetOverride(classObj, base, "Update", 0));
+
+        std::unordered_map<uint32_t, PopplioScriptAPI::MonoThunk<MonoObject*> const*> scriptMethods{};
+        for (uint32_t handle : handles) scriptMethods[handle] = &update;
+
+        start = BenchClock::now();
+        for (int f{}; f < frames; ++f)
+        {
+            for (uint32_t handle : handles)
+            {
+                MonoObject* obj = mono_gchandle_get_target(handle);
+                if (!monoAPI.IsObjValid(handle)) continue;
+                auto found = scriptMethods.find(handle);
+                if (found == scriptMethods.end()) continue;
+                monoAPI.CallThunk(*found->second, obj);
+            }
+        }
+        double thunkMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        // batched: scripts registered in a scheduler once, states written natively, one call into C# per frame
+        double batchedMs{};
+        MonoObject* scheduler = monoAPI.InstClass("Team_Popplio", "ScriptScheduler");
+        MonoClass* schedulerClass = scheduler ? mono_object_get_class(scheduler) : nullptr;
+        PopplioScriptAPI::MonoThunk<MonoObject*, int, MonoObject*> registerScript{};
+        PopplioScriptAPI::MonoThunk<MonoObject*, int, int*, int*, int*, int> run{};
+        if (schedulerClass != nullptr)
+        {
+            registerScript = monoAPI.GetMethodThunk<MonoObject*, int, MonoObject*>(
+                mono_class_get_method_from_name(schedulerClass, "Register", 2));
+            run = monoAPI.GetMethodThunk<MonoObject*, int, int*, int*, int*, int>(
+                mono_class_get_method_from_name(schedulerClass, "Run", 5));
+        }
+        uint32_t schedulerHandle = scheduler ? monoAPI.GetGC(scheduler, false) : 0;
+
+        if (registerScript && run)
+        {
+            std::unordered_map<uint32_t, int> slots{};
+            std::vector<int> states(handles.size(), static_cast<int>(Popplio::CSScriptState::INACTIVE));
+            std::vector<int> entities(handles.size(), -1);
+            std::vector<int> order(handles.size());
+            for (size_t i{}; i < handles.size(); ++i)
+            {
+                order[i] = static_cast<int>(i);
+                slots[handles[i]] = static_cast<int>(i);
+                monoAPI.CallThunk(registerScript, mono_gchandle_get_target(schedulerHandle), static_cast<int>(i),
+                    mono_gchandle_get_target(handles[i]));
+            }
+
+            start = BenchClock::now();
+            for (int f{}; f < frames; ++f)
+            {
+                for (uint32_t handle : handles)
+                {
+                    if (!monoAPI.IsObjValid(handle)) continue;
+                    auto found = slots.find(handle);
+                    if (found == slots.end()) continue;
+                    states[found->second] = static_cast<int>(Popplio::CSScriptState::ACTIVE);
+                }
+                monoAPI.CallThunk(run, mono_gchandle_get_target(schedulerHandle), static_cast<int>(Popplio::CSLoopMethod::UPDATE),
+                    order.data(), states.data(), entities.data(), static_cast<int>(order.size()));
+            }
+            batchedMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        }
+        else Popplio::Logger::Error("Script dispatch benchmark failed to get Team_Popplio.ScriptScheduler");
+
+        // every script got its Update from every path
+        MonoClassField* updates = mono_class_get_field_from_name(classObj, "Updates");
+        int missed{};
+        for (uint32_t handle : handles)
+        {
+            if (monoAPI.Get<int>(mono_gchandle_get_target(handle), updates) != frames * 3) ++missed;
+        }
+
+        for (uint32_t handle : handles) monoAPI.RemoveGC(handle);
+        if (schedulerHandle != 0) monoAPI.RemoveGC(schedulerHandle);
+
+        const double calls = static_cast<double>(handles.size()) * frames;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << handles.size() << " scripts x " << frames << " frames"
+            << " | name lookup + CallMethod: " << legacyMs << " ms (" << std::setprecision(0) << legacyMs * 1000000.0 / calls
+            << " ns per script per frame)" << std::setprecision(3) << " | cached thunk: " << thunkMs << " ms ("
+            << std::setprecision(0) << thunkMs * 1000000.0 / calls << " ns per script per frame)" << std::setprecision(3)
+            << " | batched: " << batchedMs << " ms (" << std::setprecision(0) << batchedMs * 1000000.0 / calls
+            << " ns per script per frame)";
+        Popplio::Logger::Info(ss.str());
+
+        if (handles.size() != static_cast<size_t>(scripts) || missed != 0 || !update)
+            Popplio::Logger::Error("Script dispatch mismatch");
+
+        Popplio::Logger::Info("Script dispatch benchmark completed");
+    }
+
+    void BenchmarkComponentAccess(PopplioScriptAPI::MonoAPI& monoAPI, Popplio::Registry& registry)
+    {
+        Popplio::Logger::Info("Starting component access benchmark");
+
+        static const int count = 1000;
+        static const int frames = 60;
+        static const float velocityX = 1.f, velocityY = .5f;
+
+        MonoClass* classObj = monoAPI.GetAssClass("BassNKick", "TestComponentAccess");
+        if (classObj == nullptr)
+        {
+            Popplio::Logger::Error("Component access benchmark needs BassNKick.TestComponentAccess in the loaded assembly");
+            return;
+        }
+
+        PopplioScriptAPI::MonoThunk<MonoArray*, int> perField =
+            monoAPI.GetMethodThunk<MonoArray*, int>(mono_class_get_method_from_name(classObj, "MovePerField", 2));
+        PopplioScriptAPI::MonoThunk<MonoArray*, int> bulk =
+            monoAPI.GetMethodThunk<MonoArray*, int>(mono_class_get_method_from_name(classObj, "MoveBulk", 2));
+        if (!perField || !bulk)
+        {
+            Popplio::Logger::Error("Component access benchmark failed to get the BassNKick.TestComponentAccess methods");
+            return;
+        }
+
+        // the second entity stays still as a child of the first, its local transform follows the parent
+        std::vector<Popplio::Entity> entities{};
+        std::vector<int> ids{};
+        for (int i{}; i < count; ++i)
+        {
+            Popplio::Entity e = registry.CreateEntity();
+            e.GetComponent<Popplio::TransformComponent>().position = PopplioMath::Vec2f(static_cast<float>(i), 0.f);
+            if (i == 1) e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 0.f, 0.f, 0.f);
+            else e.AddComponent<Popplio::RigidBodyComponent>(1.f, false, 0.f, velocityX, velocityY);
+            entities.push_back(e);
+            ids.push_back(e.GetId());
+        }
+        Popplio::Entity parent = entities[0], child = entities[1];
+        parent.AddComponent<Popplio::ParentComponent>();
+        parent.GetComponent<Popplio::ParentComponent>().AddChild(child, parent);
+        child.GetComponent<Popplio::ParentComponent>().UpdateLocalTransform(
+            child.GetComponent<Popplio::TransformComponent>(), parent.GetComponent<Popplio::TransformComponent>());
+
+        uint32_t idsHandle = monoAPI.GetGC(reinterpret_cast<MonoObject*>(
+            PopplioScriptAPI::ArrayToMono1D(ids, &monoAPI.GetAppDomain())), false);
+
+        auto start = BenchClock::now();
+        monoAPI.CallThunk(perField, reinterpret_cast<MonoArray*>(mono_gchandle_get_target(idsHandle)), frames);
+        double perFieldMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        start = BenchClock::now();
+        monoAPI.CallThunk(bulk, reinterpret_cast<MonoArray*>(mono_gchandle_get_target(idsHandle)), frames);
+        double bulkMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        monoAPI.RemoveGC(idsHandle);
+
+        // both paths moved every entity but the child
+        int missed{};
+        for (int i{}; i < count; ++i)
+        {
+            PopplioMath::Vec2f const& position = entities[i].GetComponent<Popplio::TransformComponent>().position;
+            const float expectedX = static_cast<float>(i) + (i == 1 ? 0.f : velocityX * frames * 2);
+            const float expectedY = i == 1 ? 0.f : velocityY * frames * 2;
+            if (std::abs(position.x - expectedX) > .001f || std::abs(position.y - expectedY) > .001f) ++missed;
+        }
+        PopplioMath::Vec2f const& local = child.GetComponent<Popplio::ParentComponent>().localPosition;
+        const bool parented = std::abs(local.x - (1.f - velocityX * frames * 2)) < .001f &&
+            std::abs(local.y + velocityY * frames * 2) < .001f;
+
+        // the child goes with its parent
+        for (Popplio::Entity& e : entities)
+        {
+            if (e.GetId() != child.GetId()) registry.KillEntity(e);
+        }
+        registry.Update();
+
+        const double accesses = static_cast<double>(count) * frames;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << count << " entities x " << frames << " frames"
+            << " | per field: " << perFieldMs << " ms (" << std::setprecision(0) << perFieldMs * 1000000.0 / accesses
+            << " ns per entity per frame)" << std::setprecision(3) << " | bulk: " << bulkMs << " ms ("
+            << std::setprecision(0) << bulkMs * 1000000.0 / accesses << " ns per entity per frame)";
+        Popplio::Logger::Info(ss.str());
+
+        if (missed != 0 || !parented) Popplio::Logger::Error("Component access mismatch");
+
+        Popplio::Logger::Info("Component access benchmark completed");
+    }
+
+    void BenchmarkAssemblyReload(PopplioScriptAPI::MonoAPI& monoAPI)
+    {
+        Popplio::Logger::Info("Starting assembly reload benchmark");
+
+        // a waiting prepared assembly would turn the blocking reload into a swap
+        monoAPI.ApplyPreparedAssembly();
+
+        const unsigned generation = monoAPI.GetAssemblyGeneration();
+
+        auto start = BenchClock::now();
+        monoAPI.UnloadAssembly();
+        monoAPI.StartMono();
+        double blockingMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        monoAPI.StartObserving();
+        monoAPI.RequestPrepare();
+
+        start = BenchClock::now();
+        while (!monoAPI.IsAssemblyPrepared() && BenchClock::now() - start < std::chrono::seconds(10))
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        double waitMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+
+        const bool swapped = monoAPI.ApplyPreparedAssembly();
+        const bool resolved = monoAPI.GetAssClass("BassNKick", "TestDispatch") != nullptr &&
+            monoAPI.GetAssClass("Team_Popplio", "ScriptScheduler") != nullptr;
+
+        std::stringstream ss{};
+        ss << std::fixed << std::setprecision(3) << "blocking reload: " << blockingMs << " ms on the main thread"
+            << " | hot reload: prepared in " << monoAPI.GetLastPrepareMs() << " ms off the main thread (ready after "
+            << waitMs << " ms), swapped in " << monoAPI.GetLastSwapMs() << " ms on the main thread";
+        Popplio::Logger::Info(ss.str());
+
+        if (!swapped || !resolved || monoAPI.GetAssemblyGeneration() != generation + 2)
+            Popplio::Logger::Error("Assembly reload mismatch");
+
+        Popplio::Logger::Info("Assembly reload benchmark completed");
+    }
+}
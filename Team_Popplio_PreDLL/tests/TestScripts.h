@@ -0,0 +1,55 @@
+/******************************************************************************/
+/*!
+\file   TestScripts.h
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        This is the header file for C# script dispatch micro-benchmarks
+        Results are written to the logger
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace PopplioScriptAPI
+{
+    class MonoAPI;
+}
+
+namespace Popplio
+{
+    class Registry;
+}
+
+namespace PopplioTest
+{
+    /*
+    *   calls Update on 1000 BassNKick.TestDispatch scripts for 60 frames through the previous per-frame name
+    *   lookups and CallMethod, through a cached thunk per script and through one Team_Popplio.ScriptScheduler
+    *   call per frame, logs the cost per script per frame and checks every call reached the scripts
+    */
+    void BenchmarkScriptDispatch(PopplioScriptAPI::MonoAPI& monoAPI);
+
+    /*
+    *   moves 1000 entities by their rigid body velocity for 60 frames from BassNKick.TestComponentAccess
+    *   through the per field Transform2D / RigidBody2D wrappers and through the bulk struct calls, logs the
+    *   cost per entity per frame and checks the positions and the local transform of a parented entity
+    *   the entities are created in the registry and killed after
+    */
+    void BenchmarkComponentAccess(PopplioScriptAPI::MonoAPI& monoAPI, Popplio::Registry& registry);
+
+    /*
+    *   reloads the assembly on the main thread, then has the observer thread prepare it and swaps it in,
+    *   logs the main thread stall of both and checks the classes resolve in the swapped in assembly
+    */
+    void BenchmarkAssemblyReload(PopplioScriptAPI::MonoAPI& monoAPI);
+}
@@ -0,0 +1,163 @@
+﻿/******************************************************************************/
+/*!
+\file   ScriptScheduler.cs
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        C# file for running the loop methods of the loaded scripts for Team_Popplio engine
+        C++ makes one call per loop phase instead of one call per script
+
+        C++ keeps the state and entity of every script slot in native buffers,
+        enable / disable / destroy are read from the states during the call
+        Slots are visited in the order given by C++, the order the scripts loaded
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+using System;
+
+using Team_Popplio.Libraries;
+
+namespace Team_Popplio
+{
+	/*
+	*   loop phases, same values as CSLoopMethod in LogicSystem.h
+	*/
+	public enum ScriptPhase : int
+	{
+		Setup,
+		Init,
+		Update,
+		FixedUpdate,
+		End
+	}
+
+	/*
+	*   script slot states, same values as CSScriptState in LogicSystem.h
+	*/
+	public enum ScriptState : int
+	{
+		Free,
+		Inactive,
+		Active,
+		Enable,		// OnEnable this phase, loop method skipped
+		Disable,	// OnDisable this phase, loop method skipped
+		Destroyed	// slot released this phase
+	}
+
+	/*
+	*   loaded scripts by slot, runs a loop phase on every active slot
+	*/
+	public sealed class ScriptScheduler
+	{
+		private static readonly ScriptScheduler main = new ScriptScheduler();
+
+		private PopplioMonoScript?[] scripts = new PopplioMonoScript?[64];
+
+		#region C++ interface
+		private static void RegisterScript(int slot, PopplioMonoScript script) // called by C++
+		{
+			main.Register(slot, script);
+		}
+
+		private static void ClearScripts() // called by C++
+		{
+			main.Clear();
+		}
+
+		private static unsafe void RunScripts(int phase, int* order, int* states, int* entities, int count) // called by C++
+		{
+			main.Run(phase, order, states, entities, count);
+		}
+		#endregion
+
+		/*
+		*   puts script in slot, replacing the previous one
+		*/
+		public void Register(int slot, PopplioMonoScript script)
+		{
+			if (slot < 0) return;
+
+			if (slot >= scripts.Length)
+			{
+				int size = scripts.Length;
+				while (size <= slot) size *= 2;
+				Array.Resize(ref scripts, size);
+			}
+
+			scripts[slot] = script;
+		}
+
+		/*
+		*   releases every script
+		*/
+		public void Clear()
+		{
+			Array.Clear(scripts, 0, scripts.Length);
+		}
+
+		/*
+		*   runs phase on the count slots listed in order
+		*   states are consumed: enable / disable become inactive and destroyed becomes free
+		*/
+		public unsafe void Run(int phase, int* order, int* states, int* entities, int count)
+		{
+			for (int k = 0; k < count; ++k)
+			{
+				int i = order[k];
+				if (i < 0 || i >= scripts.Length) continue;
+
+				switch ((ScriptState)states[i])
+				{
+					case ScriptState.Active:
+						break;
+
+					case ScriptState.Enable:
+						states[i] = (int)ScriptState.Inactive;
+						Events.OnEnable(entities[i]);
+						continue;
+
+					case ScriptState.Disable:
+						states[i] = (int)ScriptState.Inactive;
+						Events.OnDisable(entities[i]);
+						continue;
+
+					case ScriptState.Destroyed:
+						states[i] = (int)ScriptState.Free;
+						scripts[i] = null;
+						continue;
+
+					default:
+						continue;
+				}
+
+				PopplioMonoScript? script = scripts[i];
+				if (script == null) continue;
+
+				try
+				{
+					switch ((ScriptPhase)phase)
+					{
+						case ScriptPhase.Setup:			script.Setup();			break;
+						case ScriptPhase.Init:			script.Init();			break;
+						case ScriptPhase.Update:		script.Update();		break;
+						case ScriptPhase.FixedUpdate:	script.FixedUpdate();	break;
+						case ScriptPhase.End:			script.End();			break;
+					}
+				}
+				catch (Exception e)
+				{
+					Logger.EngineError($"C# | {script.GetType().FullName}.{(ScriptPhase)phase} | {e.Message}");
+				}
+			}
+		}
+	}
+}
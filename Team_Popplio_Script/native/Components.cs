@@ -27,6 +27,7 @@ Technology is prohibited.
 
 using System;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using System.Collections.Generic;
 using System.Collections.Concurrent;
 using System.Linq;
@@ -59,6 +60,17 @@ namespace Team_Popplio.Components
 	}
 
 	#region Transform Component ================================================= 
+	// blittable copy of a transform, laid out like the native PopplioComponentTrans::TransformData
+	[StructLayout(LayoutKind.Sequential)]
+	public struct TransformData
+	{
+		public float PositionX;
+		public float PositionY;
+		public float ScaleX;
+		public float ScaleY;
+		public double Rotation;
+	}
+
 	public class Transform2D : Component, IDisposable
 	{
 		private bool _disposed = false;
@@ -189,6 +201,48 @@ namespace Team_Popplio.Components
 			Position += translation;
 		}
 
+		// bulk access // -----------------------------------------------------
+		// one internal call for a whole set of entities instead of one per field per entity
+
+		// copies the transforms of the first count entities into data
+		// entries of entities without a transform are left untouched, returns the number copied
+		public static unsafe int GetTransforms(int[] entities, TransformData[] data, int count)
+		{
+			if (count < 0 || count > entities.Length || count > data.Length)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			fixed (int* ids = entities)
+			fixed (TransformData* transforms = data)
+			{
+				return GetTransforms(ids, transforms, count);
+			}
+		}
+
+		public static int GetTransforms(int[] entities, TransformData[] data)
+		{
+			return GetTransforms(entities, data, entities.Length);
+		}
+
+		// writes the transforms of the first count entities from data, in order
+		// children get their local transform updated like with the single field setters
+		// entities without a transform are skipped, returns the number written
+		public static unsafe int SetTransforms(int[] entities, TransformData[] data, int count)
+		{
+			if (count < 0 || count > entities.Length || count > data.Length)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			fixed (int* ids = entities)
+			fixed (TransformData* transforms = data)
+			{
+				return SetTransforms(ids, transforms, count);
+			}
+		}
+
+		public static int SetTransforms(int[] entities, TransformData[] data)
+		{
+			return SetTransforms(entities, data, entities.Length);
+		}
+
 		// bridges
 
 		[MethodImpl(MethodImplOptions.InternalCall)]
@@ -213,6 +267,10 @@ namespace Team_Popplio.Components
 		private static extern void SetRotation(int instance, double value);
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void UpdateLocalTransform(int instance);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern unsafe int GetTransforms(int* instances, TransformData* data, int count);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern unsafe int SetTransforms(int* instances, TransformData* data, int count);
 	}
 	#endregion // Transform Component // ================================
 
@@ -390,6 +448,24 @@ namespace Team_Popplio.Components
 	#endregion // Render Component // ================================
 
 	#region RigidBody Component =================================================
+	// blittable copy of a rigid body, laid out like the native PopplioComponentRB::RigidBodyData
+	// the flags are ints since bool is not blittable
+	[StructLayout(LayoutKind.Sequential)]
+	public struct RigidBodyData
+	{
+		public float VelocityX;
+		public float VelocityY;
+		public float AccelerationX;
+		public float AccelerationY;
+		public float ForceX;
+		public float ForceY;
+		public float Mass;
+		public float GravityScale;
+		public float DragCoefficient;
+		public int Active;
+		public int UseGravity;
+	}
+
 	public class RigidBody2D : Component, IDisposable
 	{
 		private bool _disposed = false;
@@ -560,6 +636,47 @@ namespace Team_Popplio.Components
 			set { SetDragCoefficient(NativeID, value); }
 		}
 
+		// bulk access // -----------------------------------------------------
+		// one internal call for a whole set of entities instead of one per field per entity
+
+		// copies the rigid bodies of the first count entities into data
+		// entries of entities without a rigid body are left untouched, returns the number copied
+		public static unsafe int GetRigidBodies(int[] entities, RigidBodyData[] data, int count)
+		{
+			if (count < 0 || count > entities.Length || count > data.Length)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			fixed (int* ids = entities)
+			fixed (RigidBodyData* bodies = data)
+			{
+				return GetRigidBodies(ids, bodies, count);
+			}
+		}
+
+		public static int GetRigidBodies(int[] entities, RigidBodyData[] data)
+		{
+			return GetRigidBodies(entities, data, entities.Length);
+		}
+
+		// writes the rigid bodies of the first count entities from data
+		// entities without a rigid body are skipped, returns the number written
+		public static unsafe int SetRigidBodies(int[] entities, RigidBodyData[] data, int count)
+		{
+			if (count < 0 || count > entities.Length || count > data.Length)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			fixed (int* ids = entities)
+			fixed (RigidBodyData* bodies = data)
+			{
+				return SetRigidBodies(ids, bodies, count);
+			}
+		}
+
+		public static int SetRigidBodies(int[] entities, RigidBodyData[] data)
+		{
+			return SetRigidBodies(entities, data, entities.Length);
+		}
+
 		// bridges
 
 		[MethodImpl(MethodImplOptions.InternalCall)]
@@ -610,6 +727,10 @@ namespace Team_Popplio.Components
 		private static extern float GetDragCoefficient(int instance);
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void SetDragCoefficient(int instance, float value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern unsafe int GetRigidBodies(int* instances, RigidBodyData* data, int count);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern unsafe int SetRigidBodies(int* instances, RigidBodyData* data, int count);
 	}
 	#endregion // RigidBody Component // ================================
 
@@ -157,6 +157,15 @@ namespace Team_Popplio.ECS
 			return Entities[-1];
 		}
 
+		// Entity handles // ids are recycled, so store the handle (not the id or Entity) to refer
+		// to an entity across frames, and check IsAlive before using it
+
+		public static Entity FromHandle(ulong handle)
+		{
+			if (!IsAlive(handle)) return GetNullEntity();
+			return GetEntity((int)(handle & 0xFFFFFFFFUL));
+		}
+
 		public static Entity GetEntity(int id)
 		{
 			if (!Exists(id))
@@ -358,6 +367,11 @@ namespace Team_Popplio.ECS
 			return e.Exists();
 		}
 
+		public ulong GetHandle() // generation << 32 | id, stays unique after the id is reused
+		{
+			return GetHandle(NativeID);
+		}
+
 		// bridges // -----------------------------------------------------
 
 		[MethodImpl(MethodImplOptions.InternalCall)]
@@ -376,6 +390,10 @@ namespace Team_Popplio.ECS
 		private static extern bool BelongsToGroup(int instance, string group);
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		public static extern bool Exists(int instance);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern ulong GetHandle(int instance);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		public static extern bool IsAlive(ulong handle);
 		//[MethodImpl(MethodImplOptions.InternalCall)]
 		//private static extern void OnScriptDestroy(int instance);
 		#endregion
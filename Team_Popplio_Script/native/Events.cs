@@ -52,6 +52,13 @@ namespace Team_Popplio
 			}
 		}
 
+		// All collisions of a frame: (entity 1, entity 2, action) per collision in contacts
+		public static void OnCollision2DBatch(int[] contacts, double[] collisionTimes)
+		{
+			for (int i = 0; i < collisionTimes.Length; ++i)
+				OnCollision2D(contacts[i * 3], contacts[i * 3 + 1], collisionTimes[i], contacts[i * 3 + 2]);
+		}
+
 		public static event Action<int, int, double>? OnTrigger2DEnter;
 		public static event Action<int, int, double>? OnTrigger2DStay;
 		public static event Action<int, int, double>? OnTrigger2DExit;
@@ -73,6 +80,13 @@ namespace Team_Popplio
 			}
 		}
 
+		// All triggers of a frame: (entity 1, entity 2, action) per trigger in contacts
+		public static void OnTrigger2DBatch(int[] contacts, double[] triggerTimes)
+		{
+			for (int i = 0; i < triggerTimes.Length; ++i)
+				OnTrigger2D(contacts[i * 3], contacts[i * 3 + 1], triggerTimes[i], contacts[i * 3 + 2]);
+		}
+
 		public static event Action<int, int>? OnEntityChangeEvent;
 
 		public static void OnEntityChange(int id, int change)
@@ -0,0 +1,77 @@
+﻿/******************************************************************************/
+/*!
+\file   TestComponentAccess.cs
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        C# file used by the engine component access benchmark for Team_Popplio engine
+        Moves entities by their velocity through the per field wrappers and through the bulk calls
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+using Team_Popplio.Components;
+using Team_Popplio.Libraries;
+
+namespace BassNKick
+{
+	public static class TestComponentAccess
+	{
+		// position += velocity, one internal call per field per entity
+		public static void MovePerField(int[] entities, int frames)
+		{
+			Transform2D[] transforms = new Transform2D[entities.Length];
+			RigidBody2D[] bodies = new RigidBody2D[entities.Length];
+			for (int i = 0; i < entities.Length; ++i)
+			{
+				transforms[i] = new Transform2D(entities[i]);
+				bodies[i] = new RigidBody2D(entities[i]);
+			}
+
+			for (int f = 0; f < frames; ++f)
+			{
+				for (int i = 0; i < entities.Length; ++i)
+				{
+					Vector2<float> velocity = bodies[i].Velocity;
+					Vector2<float> position = transforms[i].Position;
+					transforms[i].Position = new Vector2<float>(position.X + velocity.X, position.Y + velocity.Y);
+				}
+			}
+
+			for (int i = 0; i < entities.Length; ++i)
+			{
+				transforms[i].End();
+				bodies[i].End();
+			}
+		}
+
+		// position += velocity, three internal calls per frame for every entity
+		public static void MoveBulk(int[] entities, int frames)
+		{
+			TransformData[] transforms = new TransformData[entities.Length];
+			RigidBodyData[] bodies = new RigidBodyData[entities.Length];
+
+			for (int f = 0; f < frames; ++f)
+			{
+				Transform2D.GetTransforms(entities, transforms);
+				RigidBody2D.GetRigidBodies(entities, bodies);
+
+				for (int i = 0; i < entities.Length; ++i)
+				{
+					transforms[i].PositionX += bodies[i].VelocityX;
+					transforms[i].PositionY += bodies[i].VelocityY;
+				}
+
+				Transform2D.SetTransforms(entities, transforms);
+			}
+		}
+	}
+}
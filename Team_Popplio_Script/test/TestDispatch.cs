@@ -0,0 +1,34 @@
+﻿/******************************************************************************/
+/*!
+\file   TestDispatch.cs
+\author Team Popplio
+\author Bryan Ang Wei Ze
+\contribution Bryan - 100%
+\par    Course : CSD2401 / UXGD2400 / DAA2402
+\par    Section : A
+\date   2025/03/20
+\brief
+        C# file used by the engine script dispatch benchmark for Team_Popplio engine
+        Counts the loop method calls it receives
+
+Copyright (C) 2024 - 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/******************************************************************************/
+
+using Team_Popplio;
+
+namespace BassNKick
+{
+	public class TestDispatch : PopplioMonoScript
+	{
+		public int Updates = 0;
+
+		public override void Update()
+		{
+			++Updates;
+		}
+	}
+}